@@ -1042,14 +1042,18 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         // SUBTRACT PLATED COPPER FROM (UNPLATED) COPPER
         if( m_layers_poly.find( F_Cu ) != m_layers_poly.end() )
         {
-            m_layers_poly[F_Cu]->BooleanSubtract( *m_frontPlatedPadPolys, SHAPE_POLY_SET::PM_FAST );
-            m_layers_poly[F_Cu]->BooleanSubtract( *m_frontPlatedCopperPolys, SHAPE_POLY_SET::PM_FAST );
+            m_layers_poly[F_Cu]->BooleanSubtractTiled( *m_frontPlatedPadPolys,
+                                                          SHAPE_POLY_SET::PM_FAST );
+            m_layers_poly[F_Cu]->BooleanSubtractTiled( *m_frontPlatedCopperPolys,
+                                                          SHAPE_POLY_SET::PM_FAST );
         }
 
         if( m_layers_poly.find( B_Cu ) != m_layers_poly.end() )
         {
-            m_layers_poly[B_Cu]->BooleanSubtract( *m_backPlatedPadPolys, SHAPE_POLY_SET::PM_FAST );
-            m_layers_poly[B_Cu]->BooleanSubtract( *m_backPlatedCopperPolys, SHAPE_POLY_SET::PM_FAST );
+            m_layers_poly[B_Cu]->BooleanSubtractTiled( *m_backPlatedPadPolys,
+                                                          SHAPE_POLY_SET::PM_FAST );
+            m_layers_poly[B_Cu]->BooleanSubtractTiled( *m_backPlatedCopperPolys,
+                                                          SHAPE_POLY_SET::PM_FAST );
         }
 
         m_frontPlatedPadPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
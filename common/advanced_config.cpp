@@ -103,6 +103,13 @@ static const wxChar EnableGit[] = wxT( "EnableGit" );
 static const wxChar EnableEeschemaPrintCairo[] = wxT( "EnableEeschemaPrintCairo" );
 static const wxChar DisambiguationTime[] = wxT( "DisambiguationTime" );
 static const wxChar PcbSelectionVisibilityRatio[] = wxT( "PcbSelectionVisibilityRatio" );
+static const wxChar IncrementalZoneFill[] = wxT( "IncrementalZoneFill" );
+static const wxChar ZoneFillDiskCache[] = wxT( "ZoneFillDiskCache" );
+static const wxChar ParallelBoardLoad[] = wxT( "ParallelBoardLoad" );
+static const wxChar ParallelBoardSave[] = wxT( "ParallelBoardSave" );
+static const wxChar ParallelSchematicLoad[] = wxT( "ParallelSchematicLoad" );
+static const wxChar LineChainIndexMinSegments[] = wxT( "LineChainIndexMinSegments" );
+static const wxChar PolygonTileVertices[] = wxT( "PolygonTileVertices" );
 } // namespace KEYS
 
 
@@ -245,6 +252,14 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_PcbSelectionVisibilityRatio = 1.0;
 
+    m_IncrementalZoneFill       = true;
+    m_ZoneFillDiskCache         = false;
+    m_ParallelBoardLoad         = true;
+    m_ParallelBoardSave         = true;
+    m_ParallelSchematicLoad     = true;
+    m_LineChainIndexMinSegments = 16;
+    m_PolygonTileVertices       = 0;
+
     loadFromConfigFile();
 }
 
@@ -437,6 +452,31 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   &m_PcbSelectionVisibilityRatio,
                                                   m_PcbSelectionVisibilityRatio, 0.0, 1.0 ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalZoneFill,
+                                                &m_IncrementalZoneFill, m_IncrementalZoneFill ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneFillDiskCache,
+                                                &m_ZoneFillDiskCache, m_ZoneFillDiskCache ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardLoad,
+                                                &m_ParallelBoardLoad, m_ParallelBoardLoad ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardSave,
+                                                &m_ParallelBoardSave, m_ParallelBoardSave ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelSchematicLoad,
+                                                &m_ParallelSchematicLoad,
+                                                m_ParallelSchematicLoad ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::LineChainIndexMinSegments,
+                                               &m_LineChainIndexMinSegments,
+                                               m_LineChainIndexMinSegments,
+                                               0, std::numeric_limits<int>::max() ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::PolygonTileVertices,
+                                               &m_PolygonTileVertices, m_PolygonTileVertices,
+                                               0, std::numeric_limits<int>::max() ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     wxString traceMasks;
@@ -58,6 +58,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
+    lineIsView( false ),
     reader( nullptr ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
@@ -76,6 +77,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
+    lineIsView( false ),
     reader( nullptr ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
@@ -95,6 +97,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
+    lineIsView( false ),
     reader( nullptr ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
@@ -113,6 +116,7 @@ DSNLEXER::DSNLEXER( const std::string& aSExpression, const wxString& aSource ) :
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
+    lineIsView( false ),
     reader( nullptr ),
     keywords( empty_keywords ),
     keywordCount( 0 ),
@@ -175,6 +179,7 @@ bool DSNLEXER::SyncLineReaderWith( DSNLEXER& aLexer )
     start = aLexer.start;
     next = aLexer.next;
     limit = aLexer.limit;
+    lineIsView = aLexer.lineIsView;
 
     // Sync these parameters is not mandatory, but could help
     // for instance in debug
@@ -190,6 +195,7 @@ void DSNLEXER::PushReader( LINE_READER* aLineReader )
     readerStack.push_back( aLineReader );
     reader = aLineReader;
     start  = (const char*) (*reader);
+    lineIsView = false;
 
     // force a new readLine() as first thing.
     limit = start;
@@ -210,6 +216,7 @@ LINE_READER* DSNLEXER::PopReader()
         {
             reader = readerStack.back();
             start  = reader->Line();
+            lineIsView = false;
 
             // force a new readLine() as first thing.
             limit = start;
@@ -220,6 +227,7 @@ LINE_READER* DSNLEXER::PopReader()
             reader = nullptr;
             start  = dummy;
             limit  = dummy;
+            lineIsView = false;
         }
     }
     return ret;
@@ -636,7 +644,7 @@ L_read:
                     case 'v':   c = '\x0b';     break;
 
                     case 'x':   // 1 or 2 byte hex escape sequence
-                        for( i = 0; i < 2; ++i )
+                        for( i = 0; i < 2 && head + i < limit; ++i )
                         {
                             if( !isxdigit( head[i] ) )
                                 break;
@@ -657,7 +665,7 @@ L_read:
                     default:    // 1-3 byte octal escape sequence
                         --head;
 
-                        for( i=0; i<3; ++i )
+                        for( i = 0; i < 3 && head + i < limit; ++i )
                         {
                             if( head[i] < '0' || head[i] > '7' )
                                 break;
@@ -687,7 +695,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy the run up to the next escape or delimiter in one go
+                    const char* run = head;
+
+                    while( head < limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -768,13 +784,14 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    curText.assign( cur, head );
+
+    if( isNumber( cur, head ) )
     {
         curTok = DSN_NUMBER;
         goto exit;
@@ -877,3 +894,36 @@ double DSNLEXER::parseDouble()
     return dval;
 #endif
 }
+
+
+long DSNLEXER::parseLong( int aBase )
+{
+    const char* cp = curText.data();
+    const char* end = cp + curText.size();
+
+    while( cp < end && isSpace( *cp ) )
+        ++cp;
+
+    // strtol() accepts a leading '+' but std::from_chars() doesn't
+    if( end - cp > 1 && cp[0] == '+' && cp[1] != '-' )
+        ++cp;
+
+    if( aBase == 16 && end - cp > 2 && cp[0] == '0' && ( cp[1] == 'x' || cp[1] == 'X' )
+            && isxdigit( (unsigned char) cp[2] ) )
+    {
+        cp += 2;
+    }
+
+    long                   val = 0;
+    std::from_chars_result res = std::from_chars( cp, end, val, aBase );
+
+    // Leave the odd cases (out of range, "-0x..."), to strtol() so that the results match.  The
+    // s-expression formats never use the locale dependent parts of it.
+    if( res.ec == std::errc::result_out_of_range
+            || ( aBase == 16 && res.ptr < end && ( *res.ptr == 'x' || *res.ptr == 'X' ) ) )
+    {
+        return strtol( curText.c_str(), nullptr, aBase );
+    }
+
+    return val;
+}
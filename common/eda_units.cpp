@@ -25,7 +25,9 @@
 #include <fmt/core.h>
 #include <math/util.h>      // for KiROUND
 #include <macros.h>
+#include <algorithm>
 #include <charconv>
+#include <cstdint>
 #include <wx/translation.h>
 
 bool EDA_UNIT_UTILS::IsImperialUnit( EDA_UNITS aUnit )
@@ -150,36 +152,110 @@ std::string EDA_UNIT_UTILS::FormatAngle( const EDA_ANGLE& aAngle )
 }
 
 
-std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+/**
+ * @return the number of decimals of values in \a aIuPerMm units converted to mm, or -1 if
+ *         \a aIuPerMm isn't a power of ten.
+ */
+static int fixedPointDecimals( double aIuPerMm )
 {
-    std::string buf;
-    double engUnits = aValue;
+    double scale = 1.0;
+
+    for( int decimals = 0; decimals <= 9; ++decimals, scale *= 10.0 )
+    {
+        if( aIuPerMm == scale )
+            return decimals;
+    }
+
+    return -1;
+}
 
-    engUnits /= aIuScale.IU_PER_MM;
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+char* EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue, char* aBuf )
+{
+    int decimals = fixedPointDecimals( aIuScale.IU_PER_MM );
+
+    if( decimals < 0 )
     {
-        buf = fmt::format( "{:.10f}", engUnits );
+        double      engUnits = aValue / aIuScale.IU_PER_MM;
+        std::string buf;
 
-        // remove trailing zeros
-        while( !buf.empty() && buf[buf.size() - 1] == '0' )
+        if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
         {
-            buf.pop_back();
-        }
+            buf = fmt::format( "{:.10f}", engUnits );
+
+            // remove trailing zeros
+            while( !buf.empty() && buf[buf.size() - 1] == '0' )
+                buf.pop_back();
 
-        // if the value was really small
-        // we may have just stripped all the zeros after the decimal
-        if( buf[buf.size() - 1] == '.' )
+            // if the value was really small
+            // we may have just stripped all the zeros after the decimal
+            if( buf[buf.size() - 1] == '.' )
+                buf.pop_back();
+        }
+        else
         {
-            buf.pop_back();
+            buf = fmt::format( "{:.10g}", engUnits );
         }
+
+        return std::copy( buf.begin(), buf.end(), aBuf );
+    }
+
+    // An int has at most 10 significant digits, so the "{:.10g}" of the floating point
+    // quotient is always the exact decimal value without trailing zeros.  Build that directly.
+    char* out = aBuf;
+
+    if( aValue == 0 )
+    {
+        *out++ = '0';
+        return out;
+    }
+
+    uint32_t magnitude = aValue < 0 ? 0u - (uint32_t) aValue : (uint32_t) aValue;
+    char     digits[10];    // least significant first
+    int      count = 0;
+
+    do
+    {
+        digits[count++] = char( '0' + magnitude % 10 );
+        magnitude /= 10;
+    } while( magnitude );
+
+    // The value isn't zero, so this stops at a digit
+    int firstDecimal = 0;
+
+    while( firstDecimal < decimals && digits[firstDecimal] == '0' )
+        ++firstDecimal;
+
+    if( aValue < 0 )
+        *out++ = '-';
+
+    if( count > decimals )
+    {
+        for( int ii = count - 1; ii >= decimals; --ii )
+            *out++ = digits[ii];
     }
     else
     {
-        buf = fmt::format( "{:.10g}", engUnits );
+        *out++ = '0';
+    }
+
+    if( firstDecimal < decimals )
+    {
+        *out++ = '.';
+
+        for( int ii = decimals - 1; ii >= firstDecimal; --ii )
+            *out++ = ii < count ? digits[ii] : '0';
     }
 
-    return buf;
+    return out;
+}
+
+
+std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    char buf[FORMAT_IU_MAX_CHARS];
+
+    return std::string( buf, FormatInternalUnits( aIuScale, aValue, buf ) );
 }
 
 
@@ -59,6 +59,9 @@ FONT* FONT::s_defaultFont = nullptr;
 
 std::map< std::tuple<wxString, bool, bool>, FONT*> FONT::s_fontMap;
 
+// Fonts may be looked up from several threads, e.g. when loading a board in parallel
+static std::recursive_mutex s_fontMapMutex;
+
 class MARKUP_CACHE
 {
 public:
@@ -136,6 +139,8 @@ FONT::FONT()
 
 FONT* FONT::getDefaultFont()
 {
+    std::lock_guard<std::recursive_mutex> lock( s_fontMapMutex );
+
     if( !s_defaultFont )
         s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
 
@@ -150,6 +155,8 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic )
 
     std::tuple<wxString, bool, bool> key = { aFontName, aBold, aItalic };
 
+    std::lock_guard<std::recursive_mutex> lock( s_fontMapMutex );
+
     FONT* font = nullptr;
 
     if( s_fontMap.find( key ) != s_fontMap.end() )
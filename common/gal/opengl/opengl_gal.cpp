@@ -48,7 +48,7 @@
 
 #include <macros.h>
 #include <geometry/geometry_utils.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 
 #include <core/profile.h>
 #include <trace_helpers.h>
@@ -2892,23 +2892,17 @@ void OPENGL_GAL::DrawGlyphs( const std::vector<std::unique_ptr<KIFONT::GLYPH>>&
 
         if( aGlyphs.size() > 0 )
         {
-            thread_pool& tp = GetKiCadThreadPool();
-
-            tp.push_loop( aGlyphs.size(),
-                    [&]( const int a, const int b)
+            ParallelFor( GetKiCadTaskScheduler(), 0, aGlyphs.size(),
+                    [&]( size_t ii )
                     {
-                        for( int ii = a; ii < b; ++ii )
-                        {
-                            auto glyph = static_cast<KIFONT::OUTLINE_GLYPH*>( aGlyphs.at( ii ).get() );
+                        auto glyph = static_cast<KIFONT::OUTLINE_GLYPH*>( aGlyphs.at( ii ).get() );
 
-                            // Only call CacheTriangulation() if it has never been done before.
-                            // Otherwise we'll hash the triangulation to see if it has been edited,
-                            // and all our glpyh editing ops update the triangulation anyway.
-                            if( glyph->TriangulatedPolyCount() == 0 )
-                                glyph->CacheTriangulation( false );
-                        }
+                        // Only call CacheTriangulation() if it has never been done before.
+                        // Otherwise we'll hash the triangulation to see if it has been edited,
+                        // and all our glpyh editing ops update the triangulation anyway.
+                        if( glyph->TriangulatedPolyCount() == 0 )
+                            glyph->CacheTriangulation( false );
                     } );
-            tp.wait_for_tasks();
         }
 
         for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aGlyphs )
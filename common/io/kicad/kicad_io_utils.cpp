@@ -35,11 +35,17 @@ void FormatBool( OUTPUTFORMATTER* aOut, int aNestLevel, const wxString& aKey, bo
 
 void FormatUuid( OUTPUTFORMATTER* aOut, const KIID& aUuid, char aSuffix )
 {
+    // Every item has one, so don't go through Print()
+    char  buf[48] = "(uuid \"";
+    char* end = aUuid.AsChars( buf + 7 );
+
+    *end++ = '"';
+    *end++ = ')';
+
     if( aSuffix )
-        aOut->Print( 0, "(uuid \"%s\")%c", TO_UTF8( aUuid.AsString() ), aSuffix );
-    else
-        aOut->Print( 0, "(uuid \"%s\")", TO_UTF8( aUuid.AsString() ) );
+        *end++ = aSuffix;
 
+    aOut->Append( std::string_view( buf, end - buf ) );
 }
 
 /*
@@ -87,6 +87,9 @@ public:
     int m_gerberPrecision;
 
     bool m_generateMap;
+
+    ///< Number of drill and map files written concurrently, 0 for one per CPU
+    int m_jobs;
 };
 
 #endif
@@ -25,6 +25,7 @@ JOB_EXPORT_PCB_GERBERS::JOB_EXPORT_PCB_GERBERS( bool aIsCli ) :
         JOB_EXPORT_PCB_GERBER( "gerbers", aIsCli ),
         m_layersIncludeOnAll(),
         m_layersIncludeOnAllSet( false ),
-        m_useBoardPlotParams( false )
+        m_useBoardPlotParams( false ),
+        m_jobs( 1 )
 {
 }
\ No newline at end of file
@@ -36,6 +36,9 @@ public:
 
     bool m_layersIncludeOnAllSet;
     bool m_useBoardPlotParams;
+
+    ///< Number of layers plotted concurrently, 0 for one per CPU
+    int m_jobs;
 };
 
 #endif
\ No newline at end of file
@@ -260,6 +260,24 @@ wxString KIID::AsString() const
 }
 
 
+char* KIID::AsChars( char* aBuf ) const
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    // The layout of boost::uuids::to_string()
+    for( size_t ii = 0; ii < m_uuid.size(); ++ii )
+    {
+        if( ii == 4 || ii == 6 || ii == 8 || ii == 10 )
+            *aBuf++ = '-';
+
+        *aBuf++ = hexDigits[( m_uuid.data[ii] >> 4 ) & 0x0F];
+        *aBuf++ = hexDigits[m_uuid.data[ii] & 0x0F];
+    }
+
+    return aBuf;
+}
+
+
 wxString KIID::AsLegacyTimestampString() const
 {
     return wxString::Format( "%8.8lX", (unsigned long) AsLegacyTimestamp() );
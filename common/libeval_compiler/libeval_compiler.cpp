@@ -18,6 +18,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <deque>
 #include <memory>
 #include <set>
 #include <vector>
@@ -169,6 +170,14 @@ wxString UOP::Format() const
         str = wxString::Format( "FCALL" );
         break;
 
+    case TR_UOP_JUMP_IF_FALSE:
+        str = wxString::Format( "JUMP IF FALSE [%d]", (int) m_jumpTarget );
+        break;
+
+    case TR_UOP_JUMP_IF_TRUE:
+        str = wxString::Format( "JUMP IF TRUE [%d]", (int) m_jumpTarget );
+        break;
+
     default:
         str = wxString::Format( "%s %d", formatOpName( m_op ).c_str(), m_op );
         break;
@@ -201,6 +210,203 @@ wxString UCODE::Dump() const
 };
 
 
+void UCODE::Optimize()
+{
+    struct NODE
+    {
+        UOP*               op;
+        std::vector<NODE*> args;
+    };
+
+    std::deque<NODE>   nodes;
+    std::vector<NODE*> stack;
+
+    // Rebuild the expression tree from the post-order ucode.  Anything we don't fully
+    // understand (such as the output of a failed compilation) is left alone.
+    for( UOP* op : m_ucode )
+    {
+        size_t argCount;
+
+        if( op->m_op == TR_UOP_PUSH_VAR || op->m_op == TR_UOP_PUSH_VALUE )
+            argCount = 0;
+        else if( op->m_op == TR_OP_METHOD_CALL )
+            argCount = op->m_argCount;
+        else if( op->m_op & TR_OP_BINARY_MASK )
+            argCount = 2;
+        else if( op->m_op & TR_OP_UNARY_MASK )
+            argCount = 1;
+        else
+            return;
+
+        if( stack.size() < argCount )
+            return;
+
+        NODE& node = nodes.emplace_back( NODE{ op, {} } );
+
+        node.args.assign( stack.end() - argCount, stack.end() );
+        stack.resize( stack.size() - argCount );
+        stack.push_back( &node );
+    }
+
+    if( stack.size() != 1 )
+        return;
+
+    std::function<void( NODE* )> fold =
+            [&]( NODE* aNode )
+            {
+                for( NODE* arg : aNode->args )
+                    fold( arg );
+
+                if( aNode->op->m_op == TR_OP_METHOD_CALL || aNode->args.empty() )
+                    return;
+
+                for( NODE* arg : aNode->args )
+                {
+                    if( arg->op->m_op != TR_UOP_PUSH_VALUE || !arg->op->m_value )
+                        return;
+                }
+
+                // Leave mismatched operands to the run-time evaluation, which reports them
+                if( aNode->args.size() == 2 && aNode->args[0]->op->m_value->GetType()
+                                                       != aNode->args[1]->op->m_value->GetType() )
+                {
+                    return;
+                }
+
+                CONTEXT ctx;
+
+                for( NODE* arg : aNode->args )
+                    arg->op->Exec( &ctx );
+
+                aNode->op->Exec( &ctx );
+
+                double result = ctx.Pop()->AsDouble();
+
+                for( NODE* arg : aNode->args )
+                    delete arg->op;
+
+                delete aNode->op;
+
+                aNode->op = new UOP( TR_UOP_PUSH_VALUE, std::make_unique<VALUE>( result ) );
+                aNode->args.clear();
+            };
+
+    // A rough estimate of the evaluation time.  Properties are fetched through introspection
+    // and functions may have to search the board.
+    std::function<int( NODE* )> cost =
+            [&]( NODE* aNode )
+            {
+                int c = 1;
+
+                if( aNode->op->m_op == TR_UOP_PUSH_VALUE )
+                    c = 0;
+                else if( aNode->op->m_op == TR_UOP_PUSH_VAR )
+                    c = 2;
+                else if( aNode->op->m_op == TR_OP_METHOD_CALL )
+                    c = 20;
+
+                for( NODE* arg : aNode->args )
+                    c += cost( arg );
+
+                return c;
+            };
+
+    std::function<void( NODE*, int, std::vector<NODE*>&, std::vector<NODE*>& )> flatten =
+            [&]( NODE* aNode, int aOp, std::vector<NODE*>& aOperands, std::vector<NODE*>& aChain )
+            {
+                for( NODE* arg : aNode->args )
+                {
+                    if( arg->op->m_op == aOp )
+                    {
+                        flatten( arg, aOp, aOperands, aChain );
+                        aChain.push_back( arg );
+                    }
+                    else
+                    {
+                        aOperands.push_back( arg );
+                    }
+                }
+            };
+
+    // The operands of a chain of && (or of ||) can be evaluated in any order as they all
+    // reduce to 0 or 1.  Cheapest first makes the short-circuits below skip the costly ones.
+    std::function<void( NODE* )> reorder =
+            [&]( NODE* aNode )
+            {
+                int op = aNode->op->m_op;
+
+                if( op != TR_OP_BOOL_AND && op != TR_OP_BOOL_OR )
+                {
+                    for( NODE* arg : aNode->args )
+                        reorder( arg );
+
+                    return;
+                }
+
+                std::vector<NODE*> operands;
+                std::vector<NODE*> chain;
+
+                flatten( aNode, op, operands, chain );
+                chain.push_back( aNode );
+
+                std::vector<std::pair<int, NODE*>> sorted;
+
+                for( NODE* operand : operands )
+                {
+                    reorder( operand );
+                    sorted.emplace_back( cost( operand ), operand );
+                }
+
+                std::stable_sort( sorted.begin(), sorted.end(),
+                                  []( const std::pair<int, NODE*>& a,
+                                      const std::pair<int, NODE*>& b )
+                                  {
+                                      return a.first < b.first;
+                                  } );
+
+                chain[0]->args = { sorted[0].second, sorted[1].second };
+
+                for( size_t ii = 1; ii < chain.size(); ++ii )
+                    chain[ii]->args = { chain[ii - 1], sorted[ii + 1].second };
+            };
+
+    std::vector<UOP*> ucode;
+
+    std::function<void( NODE* )> emit =
+            [&]( NODE* aNode )
+            {
+                int op = aNode->op->m_op;
+
+                if( ( op == TR_OP_BOOL_AND || op == TR_OP_BOOL_OR )
+                        && aNode->args[1]->op->m_op != TR_UOP_PUSH_VALUE )
+                {
+                    bool isAnd = op == TR_OP_BOOL_AND;
+                    UOP* jump = new UOP( isAnd ? TR_UOP_JUMP_IF_FALSE : TR_UOP_JUMP_IF_TRUE,
+                                         std::make_unique<VALUE>( isAnd ? 0.0 : 1.0 ) );
+
+                    emit( aNode->args[0] );
+                    ucode.push_back( jump );
+                    emit( aNode->args[1] );
+                    ucode.push_back( aNode->op );
+
+                    jump->m_jumpTarget = ucode.size();
+                    return;
+                }
+
+                for( NODE* arg : aNode->args )
+                    emit( arg );
+
+                ucode.push_back( aNode->op );
+            };
+
+    fold( stack.back() );
+    reorder( stack.back() );
+    emit( stack.back() );
+
+    m_ucode = std::move( ucode );
+}
+
+
 wxString TOKENIZER::GetString()
 {
     wxString rv;
@@ -975,6 +1181,7 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
                         stack.push_back( pnode );
 
                     node->leaf[1]->SetUop( TR_OP_METHOD_CALL, func, std::move( vref ) );
+                    node->leaf[1]->uop->SetArgCount( (int) params.size() );
                     node->isTerminal = false;
                     break;
                 }
@@ -1106,13 +1313,16 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
         stack.pop_back();
     }
 
+    if( !m_errorStatus.pendingError )
+        aCode->Optimize();
+
     libeval_dbg(2,"dump: \n%s\n", aCode->Dump().c_str() );
 
     return true;
 }
 
 
-void UOP::Exec( CONTEXT* ctx )
+bool UOP::Exec( CONTEXT* ctx )
 {
     switch( m_op )
     {
@@ -1121,7 +1331,7 @@ void UOP::Exec( CONTEXT* ctx )
         VALUE* value = nullptr;
 
         if( m_ref )
-            value = ctx->StoreValue( m_ref->GetValue( ctx ) );
+            value = m_ref->GetValue( ctx );
         else
             value = ctx->AllocValue();
 
@@ -1131,11 +1341,32 @@ void UOP::Exec( CONTEXT* ctx )
 
     case TR_UOP_PUSH_VALUE:
         ctx->Push( m_value.get() );
-        return;
+        return false;
 
     case TR_OP_METHOD_CALL:
         m_func( ctx, m_ref.get() );
-        return;
+        return false;
+
+    case TR_UOP_JUMP_IF_FALSE:
+    case TR_UOP_JUMP_IF_TRUE:
+    {
+        // Error reporting wants every operand evaluated
+        if( ctx->HasErrorCallback() )
+            return false;
+
+        VALUE* arg = ctx->Pop();
+        bool   isTrue = arg && arg->AsDouble() != 0.0;
+
+        if( isTrue == ( m_op == TR_UOP_JUMP_IF_TRUE ) )
+        {
+            // m_value holds the result of the && or || we're skipping to the end of
+            ctx->Push( m_value.get() );
+            return true;
+        }
+
+        ctx->Push( arg );
+        return false;
+    }
 
     default:
         break;
@@ -1221,7 +1452,7 @@ void UOP::Exec( CONTEXT* ctx )
         auto rp = ctx->AllocValue();
         rp->Set( result );
         ctx->Push( rp );
-        return;
+        return false;
     }
     else if( m_op & TR_OP_UNARY_MASK )
     {
@@ -1242,8 +1473,10 @@ void UOP::Exec( CONTEXT* ctx )
         auto rp = ctx->AllocValue();
         rp->Set( result );
         ctx->Push( rp );
-        return;
+        return false;
     }
+
+    return false;
 }
 
 
@@ -1253,8 +1486,15 @@ VALUE* UCODE::Run( CONTEXT* ctx )
 
     try
     {
-        for( UOP* op : m_ucode )
-            op->Exec( ctx );
+        size_t pc = 0;
+
+        while( pc < m_ucode.size() )
+        {
+            UOP* op = m_ucode[pc++];
+
+            if( op->Exec( ctx ) )
+                pc = op->m_jumpTarget;
+        }
     }
     catch(...)
     {
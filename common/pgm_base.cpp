@@ -61,7 +61,6 @@
 #include <settings/settings_manager.h>
 #include <string_utils.h>
 #include <systemdirsappend.h>
-#include <core/thread_pool.h>
 #include <trace_helpers.h>
 
 #include <widgets/wx_splash.h>
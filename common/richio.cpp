@@ -23,11 +23,15 @@
  */
 
 
+#include <algorithm>
+#include <charconv>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <kiplatform/io.h>
 #include <core/ignore.h>
+#include <eda_units.h>
 #include <richio.h>
 #include <errno.h>
 #include <io/kicad/kicad_io_utils.h>
@@ -275,6 +279,106 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+VIEW_LINE_READER::VIEW_LINE_READER( std::string_view aText, const wxString& aSource,
+                                    unsigned aStartingLineNumber, unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ),
+    m_text( aText ),
+    m_pos( 0 )
+{
+    m_source  = aSource;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+VIEW_LINE_READER::VIEW_LINE_READER( unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ),
+    m_pos( 0 )
+{
+}
+
+
+bool VIEW_LINE_READER::ReadLineView( std::string_view& aLine )
+{
+    size_t      remaining = m_text.size() - m_pos;
+    const char* line = m_text.data() + m_pos;
+    const char* nl = remaining ? static_cast<const char*>( memchr( line, '\n', remaining ) )
+                               : nullptr;
+    size_t      length = nl ? nl - line + 1 : remaining;     // include the newline
+
+    if( length > m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    aLine = std::string_view( line, length );
+    m_pos += length;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return true;
+}
+
+
+char* VIEW_LINE_READER::ReadLine()
+{
+    std::string_view line;
+
+    ReadLineView( line );
+
+    m_length = 0;   // nothing worth keeping when the buffer grows
+
+    if( line.size() + 1 > m_capacity )   // +1 for terminating nul
+        expandCapacity( line.size() + 1 );
+
+    memcpy( m_line, line.data(), line.size() );
+    m_length = line.size();
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : nullptr;
+}
+
+
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aMaxLineLength ) :
+    VIEW_LINE_READER( aMaxLineLength )
+{
+    if( KIPLATFORM::IO::MapFile( aFileName, m_mapping ) )
+    {
+        m_text = std::string_view( m_mapping.m_Data, m_mapping.m_Size );
+    }
+    else
+    {
+        // Empty files, or file systems which don't support mapping
+        FILE* fp = KIPLATFORM::IO::SeqFOpen( aFileName, wxT( "rb" ) );
+
+        if( !fp )
+        {
+            wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                             aFileName.GetData() );
+            THROW_IO_ERROR( msg );
+        }
+
+        char   buf[65536];
+        size_t count;
+
+        while( ( count = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+            m_buffer.append( buf, count );
+
+        fclose( fp );
+
+        m_text = m_buffer;
+    }
+
+    m_source = aFileName;
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    KIPLATFORM::IO::UnmapFile( m_mapping );
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -455,10 +559,10 @@ int OUTPUTFORMATTER::sprint( const char* fmt, ... )
 }
 
 
-int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
-{
 #define NESTWIDTH           2   ///< how many spaces per nestLevel
 
+int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
+{
     va_list     args;
 
     va_start( args, fmt );
@@ -466,12 +570,12 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
     int result = 0;
     int total  = 0;
 
-    for( int i = 0; i < nestLevel; ++i )
+    if( nestLevel > 0 )
     {
         // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        AppendIndent( nestLevel );
 
-        total += result;
+        total += nestLevel * NESTWIDTH;
     }
 
     // no error checking needed, an exception indicates an error.
@@ -484,6 +588,81 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 }
 
 
+void OUTPUTFORMATTER::AppendIndent( int aNestLevel )
+{
+    static const char spaces[] = "                                                                ";
+    constexpr int     maxCount = sizeof( spaces ) - 1;
+
+    for( int count = aNestLevel * NESTWIDTH; count > 0; count -= maxCount )
+        write( spaces, std::min( count, maxCount ) );
+}
+
+
+void OUTPUTFORMATTER::AppendInt( long long aValue )
+{
+    char buf[24];
+
+    write( buf, (int) ( std::to_chars( buf, buf + sizeof( buf ), aValue ).ptr - buf ) );
+}
+
+
+void OUTPUTFORMATTER::AppendIU( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    char buf[EDA_UNIT_UTILS::FORMAT_IU_MAX_CHARS];
+
+    write( buf, (int) ( EDA_UNIT_UTILS::FormatInternalUnits( aIuScale, aValue, buf ) - buf ) );
+}
+
+
+void OUTPUTFORMATTER::AppendIU( const EDA_IU_SCALE& aIuScale, const VECTOR2I& aPoint )
+{
+    char  buf[2 * EDA_UNIT_UTILS::FORMAT_IU_MAX_CHARS];
+    char* end = EDA_UNIT_UTILS::FormatInternalUnits( aIuScale, aPoint.x, buf );
+
+    *end++ = ' ';
+    end = EDA_UNIT_UTILS::FormatInternalUnits( aIuScale, aPoint.y, end );
+
+    write( buf, (int) ( end - buf ) );
+}
+
+
+void OUTPUTFORMATTER::AppendQuoted( const wxString& aText )
+{
+    // Same escapes as Quotew(), but written in runs rather than built up in a copy.  Like
+    // Quotew(), stop at the first nul.
+    wxScopedCharBuffer utf8 = aText.utf8_str();
+    const char*        run = utf8.data();
+    const char*        end = run + strlen( run );
+
+    write( "\"", 1 );
+
+    for( const char* it = run; it != end; ++it )
+    {
+        const char* escape = nullptr;
+
+        switch( *it )
+        {
+        case '\n': escape = "\\n";  break;
+        case '\r': escape = "\\r";  break;
+        case '\\': escape = "\\\\"; break;
+        case '"':  escape = "\\\""; break;
+        default:                     continue;
+        }
+
+        if( it > run )
+            write( run, (int) ( it - run ) );
+
+        write( escape, 2 );
+        run = it + 1;
+    }
+
+    if( end > run )
+        write( run, (int) ( end - run ) );
+
+    write( "\"", 1 );
+}
+
+
 std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee ) const
 {
     std::string ret;
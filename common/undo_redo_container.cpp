@@ -197,6 +197,15 @@ EDA_ITEM_FLAGS PICKED_ITEMS_LIST::GetPickerFlags( unsigned aIdx ) const
 }
 
 
+VECTOR2I PICKED_ITEMS_LIST::GetPickedItemPosition( unsigned aIdx ) const
+{
+    if( aIdx < m_ItemsList.size() )
+        return m_ItemsList[aIdx].GetPosition();
+
+    return VECTOR2I( 0, 0 );
+}
+
+
 bool PICKED_ITEMS_LIST::SetPickedItem( EDA_ITEM* aItem, unsigned aIdx )
 {
     if( aIdx < m_ItemsList.size() )
@@ -258,6 +267,18 @@ bool PICKED_ITEMS_LIST::SetPickerFlags( EDA_ITEM_FLAGS aFlags, unsigned aIdx )
 }
 
 
+bool PICKED_ITEMS_LIST::SetPickedItemPosition( const VECTOR2I& aPosition, unsigned aIdx )
+{
+    if( aIdx < m_ItemsList.size() )
+    {
+        m_ItemsList[aIdx].SetPosition( aPosition );
+        return true;
+    }
+
+    return false;
+}
+
+
 bool PICKED_ITEMS_LIST::RemovePicker( unsigned aIdx )
 {
     if( aIdx >= m_ItemsList.size() )
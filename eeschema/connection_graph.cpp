@@ -21,7 +21,6 @@
  */
 
 #include <list>
-#include <future>
 #include <vector>
 #include <unordered_map>
 #include <core/profile.h>
@@ -46,7 +45,7 @@
 #include <project/net_settings.h>
 #include <widgets/ui_common.h>
 #include <string_utils.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <wx/log.h>
 
 #include <advanced_config.h> // for realtime connectivity switch in release builds
@@ -1109,15 +1108,11 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
             return 1;
         };
 
-        thread_pool& tp = GetKiCadThreadPool();
-
-        tp.push_loop( connection_vec.size(),
-                [&]( const int a, const int b)
-                {
-                    for( int ii = a; ii < b; ++ii )
-                        update_lambda( connection_vec[ii] );
-                });
-        tp.wait_for_tasks();
+        ParallelFor( GetKiCadTaskScheduler(), 0, connection_vec.size(),
+                     [&]( size_t ii )
+                     {
+                         update_lambda( connection_vec[ii] );
+                     } );
     }
 }
 
@@ -1222,8 +1217,6 @@ void CONNECTION_GRAPH::resolveAllDrivers()
                       return candidate->m_dirty;
                   } );
 
-    std::vector<std::future<size_t>> returns( dirty_graphs.size() );
-
     auto update_lambda = []( CONNECTION_SUBGRAPH* subgraph ) -> size_t
     {
         if( !subgraph->m_dirty )
@@ -1263,15 +1256,11 @@ void CONNECTION_GRAPH::resolveAllDrivers()
         return 1;
     };
 
-    thread_pool& tp = GetKiCadThreadPool();
-
-    tp.push_loop( dirty_graphs.size(),
-            [&]( const int a, const int b)
-            {
-                for( int ii = a; ii < b; ++ii )
-                    update_lambda( dirty_graphs[ii] );
-            });
-    tp.wait_for_tasks();
+    ParallelFor( GetKiCadTaskScheduler(), 0, dirty_graphs.size(),
+                 [&]( size_t ii )
+                 {
+                     update_lambda( dirty_graphs[ii] );
+                 } );
 
     // Now discard any non-driven subgraphs from further consideration
 
@@ -1892,15 +1881,11 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
     for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
         m_sheet_to_subgraphs_map[ subgraph->m_sheet ].emplace_back( subgraph );
 
-    thread_pool& tp = GetKiCadThreadPool();
-
-    tp.push_loop( m_driver_subgraphs.size(),
-            [&]( const int a, const int b)
-            {
-                for( int ii = a; ii < b; ++ii )
-                    m_driver_subgraphs[ii]->UpdateItemConnections();
-            });
-    tp.wait_for_tasks();
+    ParallelFor( GetKiCadTaskScheduler(), 0, m_driver_subgraphs.size(),
+                 [&]( size_t ii )
+                 {
+                     m_driver_subgraphs[ii]->UpdateItemConnections();
+                 } );
 
     // Next time through the subgraphs, we do some post-processing to handle things like
     // connecting bus members to their neighboring subgraphs, and then propagate connections
@@ -2098,13 +2083,11 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
                 return 1;
             };
 
-    tp.push_loop( m_driver_subgraphs.size(),
-            [&]( const int a, const int b)
-            {
-                for( int ii = a; ii < b; ++ii )
-                    updateItemConnectionsTask( m_driver_subgraphs[ii] );
-            });
-    tp.wait_for_tasks();
+    ParallelFor( GetKiCadTaskScheduler(), 0, m_driver_subgraphs.size(),
+                 [&]( size_t ii )
+                 {
+                     updateItemConnectionsTask( m_driver_subgraphs[ii] );
+                 } );
 
     m_net_code_to_subgraphs_map.clear();
     m_net_name_to_subgraphs_map.clear();
@@ -21,6 +21,8 @@
  */
 
 #include <algorithm>
+#include <mutex>
+#include <set>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code.
@@ -31,6 +33,7 @@
 #include <advanced_config.h>
 #include <base_units.h>
 #include <build_version.h>
+#include <core/task_scheduler.h>
 #include <trace_helpers.h>
 #include <locale_io.h>
 #include <sch_bitmap.h>
@@ -95,6 +98,7 @@ void SCH_IO_KICAD_SEXPR::init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aPr
     m_cache           = nullptr;
     m_out             = nullptr;
     m_nextFreeFieldId = 100; // number arbitrarily > MANDATORY_FIELDS or SHEET_MANDATORY_FIELDS
+    m_preloaded.clear();
 }
 
 
@@ -171,6 +175,7 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
     wxASSERT( m_currentPath.size() == 1 );  // only the project path should remain
 
     m_currentPath.pop(); // Clear the path stack for next call to Load
+    m_preloaded.clear(); // Screens of files which were never reached (recursive sheets)
 
     return sheet;
 }
@@ -240,24 +245,50 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+            auto preloaded = m_preloaded.find( fileName.GetFullPath() );
 
-            try
+            if( preloaded != m_preloaded.end() )
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                aSheet->SetScreen( preloaded->second.m_Holder->GetScreen() );
+
+                if( !preloaded->second.m_Error.IsEmpty() )
+                {
+                    if( !m_error.IsEmpty() )
+                        m_error += "\n";
+
+                    m_error += preloaded->second.m_Error;
+                }
+
+                m_preloaded.erase( preloaded );
             }
-            catch( const IO_ERROR& ioe )
+            else
             {
-                // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw;
+                aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
 
-                // For all subsheets, queue up the error message for the caller.
-                if( !m_error.IsEmpty() )
-                    m_error += "\n";
+                try
+                {
+                    loadFile( fileName.GetFullPath(), aSheet );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    // If there is a problem loading the root sheet, there is no recovery.
+                    if( aSheet == m_rootSheet )
+                        throw;
+
+                    // For all subsheets, queue up the error message for the caller.
+                    if( !m_error.IsEmpty() )
+                        m_error += "\n";
 
-                m_error += ioe.What();
+                    m_error += ioe.What();
+                }
+
+                if( aSheet == m_rootSheet && !m_appending
+                        && ADVANCED_CFG::GetCfg().m_ParallelSchematicLoad
+                        && GetKiCadTaskScheduler().GetThreadCount() > 1 )
+                {
+                    preloadSheets( aSheet );
+                }
             }
 
             if( fileName.FileExists() )
@@ -296,7 +327,7 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 
 void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 {
-    FILE_LINE_READER reader( aFileName );
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
     size_t lineCount = 0;
 
@@ -307,7 +338,9 @@ void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
+        std::string_view line;
+
+        while( reader.ReadLineView( line ) && !line.empty() )
             lineCount++;
 
         reader.Rewind();
@@ -320,6 +353,102 @@ void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet
 }
 
 
+void SCH_IO_KICAD_SEXPR::preloadSheets( SCH_SHEET* aRootSheet )
+{
+    TASK_GROUP         workers( GetKiCadTaskScheduler() );
+    std::mutex         lock;
+    std::set<wxString> queued = { aRootSheet->GetScreen()->GetFileName() };
+
+    std::function<void( SCH_SCREEN* )> queueSheets;
+
+    auto parseFile =
+            [&]( const wxString& aFileName )
+            {
+                PRELOADED_SCREEN preloaded;
+                SCH_SHEET*       holder = new SCH_SHEET( m_schematic );
+
+                preloaded.m_Holder.reset( holder );
+                holder->SetScreen( new SCH_SCREEN( m_schematic ) );
+                holder->GetScreen()->SetFileName( aFileName );
+
+                try
+                {
+                    // No progress reporter: it can only be refreshed from the main thread
+                    MAPPED_FILE_LINE_READER   reader( aFileName );
+                    SCH_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, 0, m_rootSheet,
+                                                      m_appending );
+
+                    parser.ParseSchematic( holder );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    preloaded.m_Error = ioe.What();
+                }
+
+                // Sheet instances are stored in the sheet, so a file which has them must be
+                // parsed into the sheet which loads it.
+                if( !holder->GetInstances().empty() )
+                    return;
+
+                queueSheets( holder->GetScreen() );
+
+                std::lock_guard<std::mutex> guard( lock );
+                m_preloaded.emplace( aFileName, std::move( preloaded ) );
+            };
+
+    // Child sheet file names are relative to the file of their parent, as in loadHierarchy()
+    queueSheets =
+            [&]( SCH_SCREEN* aScreen )
+            {
+                wxString path = wxFileName( aScreen->GetFileName() ).GetPath();
+
+                for( SCH_ITEM* item : aScreen->Items().OfType( SCH_SHEET_T ) )
+                {
+                    wxFileName fileName = static_cast<SCH_SHEET*>( item )->GetFileName();
+
+                    if( !fileName.IsAbsolute() )
+                        fileName.MakeAbsolute( path );
+
+                    wxString fullPath = fileName.GetFullPath();
+
+                    {
+                        std::lock_guard<std::mutex> guard( lock );
+
+                        if( !queued.insert( fullPath ).second )
+                            continue;
+                    }
+
+                    workers.Run(
+                            [&parseFile, fullPath]()
+                            {
+                                parseFile( fullPath );
+                            } );
+                }
+            };
+
+    queueSheets( aRootSheet->GetScreen() );
+
+    if( m_progressReporter )
+    {
+        m_progressReporter->Report( _( "Loading schematic sheets..." ) );
+
+        while( !workers.WaitFor( std::chrono::milliseconds( 100 ) ) )
+        {
+            if( !m_progressReporter->KeepRefreshing() )
+            {
+                workers.Cancel();
+                workers.Wait();
+                THROW_IO_ERROR( _( "Open cancelled by user." ) );
+            }
+        }
+    }
+    else
+    {
+        workers.Wait();
+    }
+}
+
+
 void SCH_IO_KICAD_SEXPR::LoadContent( LINE_READER& aReader, SCH_SHEET* aSheet, int aFileVersion )
 {
     wxCHECK( aSheet, /* void */ );
@@ -1227,16 +1356,14 @@ void SCH_IO_KICAD_SEXPR::saveLine( SCH_LINE* aLine, int aNestLevel )
         UNIMPLEMENTED_FOR( LayerName( aLine->GetLayer() ) );
     }
 
-    m_out->Print( aNestLevel, "(%s (pts (xy %s %s) (xy %s %s))\n",
-                  TO_UTF8( lineType ),
-                  EDA_UNIT_UTILS::FormatInternalUnits( schIUScale,
-                                                       aLine->GetStartPoint().x ).c_str(),
-                  EDA_UNIT_UTILS::FormatInternalUnits( schIUScale,
-                                                       aLine->GetStartPoint().y ).c_str(),
-                  EDA_UNIT_UTILS::FormatInternalUnits( schIUScale,
-                                                       aLine->GetEndPoint().x ).c_str(),
-                  EDA_UNIT_UTILS::FormatInternalUnits( schIUScale,
-                                                       aLine->GetEndPoint().y ).c_str() );
+    m_out->AppendIndent( aNestLevel );
+    m_out->Append( "(" );
+    m_out->Append( TO_UTF8( lineType ) );
+    m_out->Append( " (pts (xy " );
+    m_out->AppendIU( schIUScale, aLine->GetStartPoint() );
+    m_out->Append( ") (xy " );
+    m_out->AppendIU( schIUScale, aLine->GetEndPoint() );
+    m_out->Append( "))\n" );
 
     line_stroke.Format( m_out, schIUScale, aNestLevel + 1 );
     m_out->Print( 0, "\n" );
@@ -23,6 +23,7 @@
 #ifndef SCH_IO_KICAD_SEXPR_H_
 #define SCH_IO_KICAD_SEXPR_H_
 
+#include <map>
 #include <memory>
 #include <sch_io/sch_io.h>
 #include <sch_io/sch_io_mgr.h>
@@ -140,6 +141,13 @@ private:
     void loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SCH_SHEET* aSheet );
     void loadFile( const wxString& aFileName, SCH_SHEET* aSheet );
 
+    /**
+     * Parse every sheet file below \a aRootSheet (whose screen must already be loaded) once,
+     * on the thread pool.  loadHierarchy() then uses the parsed screens instead of loading the
+     * files itself.
+     */
+    void preloadSheets( SCH_SHEET* aRootSheet );
+
     void saveSymbol( SCH_SYMBOL* aSymbol, const SCHEMATIC& aSchematic, int aNestLevel,
                      bool aForClipboard, const SCH_SHEET_PATH* aRelativePath = nullptr );
     void saveField( SCH_FIELD* aField, int aNestLevel );
@@ -173,6 +181,15 @@ protected:
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
 
+    struct PRELOADED_SCREEN
+    {
+        std::unique_ptr<SCH_SHEET> m_Holder;    ///< Owns the screen until it's used.
+        wxString                   m_Error;     ///< Why the file couldn't be fully loaded.
+    };
+
+    /// Screens parsed by preloadSheets(), by full file name.
+    std::map<wxString, PRELOADED_SCREEN> m_preloaded;
+
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aProperties = nullptr );
 };
@@ -284,9 +284,9 @@ void formatBezier( OUTPUTFORMATTER* aFormatter, int aNestLevel, EDA_SHAPE* aBezi
     for( const VECTOR2I& pt : { aBezier->GetStart(), aBezier->GetBezierC1(),
                                 aBezier->GetBezierC2(), aBezier->GetEnd() } )
     {
-        aFormatter->Print( 0, " (xy %s %s)",
-                           EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, pt.x ).c_str(),
-                           EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, pt.y ).c_str() );
+        aFormatter->Append( " (xy " );
+        aFormatter->AppendIU( schIUScale, pt );
+        aFormatter->Append( ")" );
     }
 
     aFormatter->Print( 0, ")\n" );  // Closes pts token on same line.
@@ -317,20 +317,20 @@ void formatPoly( OUTPUTFORMATTER* aFormatter, int aNestLevel, EDA_SHAPE* aPolyLi
     {
         if( newLine == 4 || !ADVANCED_CFG::GetCfg().m_CompactSave )
         {
-            aFormatter->Print( 0, "\n" );
-            aFormatter->Print( aNestLevel + 2, "(xy %s %s)",
-                               EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, pt.x ).c_str(),
-                               EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, pt.y ).c_str() );
+            aFormatter->Append( "\n" );
+            aFormatter->AppendIndent( aNestLevel + 2 );
+            aFormatter->Append( "(xy " );
             newLine = 0;
             lineCount += 1;
         }
         else
         {
-            aFormatter->Print( 0, " (xy %s %s)",
-                               EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, pt.x ).c_str(),
-                               EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, pt.y ).c_str() );
+            aFormatter->Append( " (xy " );
         }
 
+        aFormatter->AppendIU( schIUScale, pt );
+        aFormatter->Append( ")" );
+
         newLine += 1;
     }
 
@@ -122,12 +122,12 @@ private:
     inline long parseHex()
     {
         NextTok();
-        return strtol( CurText(), nullptr, 16 );
+        return parseLong( 16 );
     }
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        return (int) parseLong( 10 );
     }
 
     inline int parseInt( const char* aExpected )
@@ -442,6 +442,9 @@ public:
     /**
      * Use the new incremental netlister for realtime jobs.
      *
+     * In the board editor, commits only search the connectivity clusters of the items they
+     * touched instead of the whole board.
+     *
      * Setting name: "IncrementalConnectivity"
      * Valid values: 0 or 1
      * Default value: 0
@@ -498,6 +501,78 @@ public:
      * Default value: 1
      */
     double m_PcbSelectionVisibilityRatio;
+
+    /**
+     * Reuse the copper clearance knockouts of the previous fill outside the areas touched by
+     * a commit when automatically refilling zones.
+     *
+     * Setting name: "IncrementalZoneFill"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_IncrementalZoneFill;
+
+    /**
+     * Store zone fills in a content-addressed cache directory next to the board file and
+     * reuse them when a zone is filled again with identical inputs.
+     *
+     * Setting name: "ZoneFillDiskCache"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_ZoneFillDiskCache;
+
+    /**
+     * Parse the footprints and zones of board files on worker threads.
+     *
+     * Setting name: "ParallelBoardLoad"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardLoad;
+
+    /**
+     * Format the footprints, tracks and zones of board files on worker threads when saving.
+     *
+     * Setting name: "ParallelBoardSave"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardSave;
+
+    /**
+     * Parse the sheet files of schematic hierarchies on worker threads.
+     *
+     * Setting name: "ParallelSchematicLoad"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelSchematicLoad;
+
+    /**
+     * Line chains with at least this many segments index them for point in polygon and
+     * collision tests.  Shorter ones are searched linearly.  The crossover can be measured with
+     * the line_chain_benchmark QA tool.
+     *
+     * Setting name: "LineChainIndexMinSegments"
+     * Valid values: 0 to INT_MAX
+     * Default value: 16
+     */
+    int m_LineChainIndexMinSegments;
+
+    /**
+     * Number of vertices per tile of the tiled polygon operations, which split large boolean
+     * operations and offsets by a grid processed in parallel.  Operations on fewer than twice
+     * this many vertices aren't tiled.  0 disables tiling.
+     *
+     * Intersections on edges crossing the tiles can be a unit off from the untiled ones, so
+     * this is off by default.
+     *
+     * Setting name: "PolygonTileVertices"
+     * Valid values: 0 to INT_MAX
+     * Default value: 0
+     */
+    int m_PolygonTileVertices;
 ///@}
 
 
@@ -29,6 +29,7 @@
 #include <cstdio>
 #include <hashtables.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <richio.h>
@@ -409,6 +410,14 @@ public:
         return curText;
     }
 
+    /**
+     * Return the current token as a std::string_view, valid until the next NextTok().
+     */
+    std::string_view CurStrView() const
+    {
+        return curText;
+    }
+
     /**
      * Return the current token text as a wxString, assuming that the input byte stream
      * is UTF8 encoded.
@@ -431,6 +440,13 @@ public:
      */
     const char* CurLine() const
     {
+        // Lines read as views aren't nul terminated, nor copied to the reader's line buffer
+        if( lineIsView )
+        {
+            curLine.assign( start, limit );
+            return curLine.c_str();
+        }
+
         return (const char*)(*reader);
     }
 
@@ -463,6 +479,20 @@ protected:
     {
         if( reader )
         {
+            std::string_view line;
+
+            // Tokenize straight from the reader's memory when it can
+            if( reader->ReadLineView( line ) )
+            {
+                lineIsView = true;
+                start = line.empty() ? dummy : line.data();
+                next  = start;
+                limit = next + line.size();
+
+                return line.size();
+            }
+
+            lineIsView = false;
             reader->ReadLine();
 
             unsigned len = reader->Length();
@@ -479,6 +509,24 @@ protected:
         return 0;
     }
 
+    /**
+     * @return the position of the current token in the reader's memory if its line was read
+     *         with LINE_READER::ReadLineView(), else nullptr.
+     */
+    const char* curTokenView() const
+    {
+        return lineIsView ? start + curOffset : nullptr;
+    }
+
+    /**
+     * Discard the rest of the current line, so that the next token comes from the reader's
+     * next line (e.g. after repositioning the reader).
+     */
+    void discardLine()
+    {
+        next = limit;
+    }
+
     /**
      * Take @a aToken string and looks up the string in the keywords table.
      *
@@ -520,11 +568,22 @@ protected:
         return parseDouble( GetTokenText( aToken ) );
     }
 
+    /**
+     * Parse the current token as an integer in base @a aBase, skipping leading whitespace, a
+     * '+' sign and, in base 16, a "0x" prefix.  Gives the same results as strtol(), i.e. 0 for
+     * text which isn't a number and LONG_MIN or LONG_MAX for numbers out of range, but
+     * without depending on the locale.
+     */
+    long parseLong( int aBase = 10 );
+
     bool                iOwnReaders;            ///< on readerStack, should I delete them?
     const char*         start;
     const char*         next;
     const char*         limit;
     char                dummy[1];               ///< when there is no reader.
+    bool                lineIsView;             ///< start..limit is in the reader's memory,
+                                                ///< see LINE_READER::ReadLineView()
+    mutable std::string curLine;                ///< nul terminated copy for CurLine()
 
     typedef std::vector<LINE_READER*>  READER_STACK;
 
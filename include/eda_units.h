@@ -126,6 +126,19 @@ namespace EDA_UNIT_UTILS
     KICOMMON_API std::string FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                   const VECTOR2I&     aPoint );
 
+    /**
+     * Write \a aValue as FormatInternalUnits() would to \a aBuf, without allocating.
+     *
+     * Scales which are a power of ten (all of KiCad's) are converted with integer arithmetic.
+     *
+     * @param aBuf must hold at least FORMAT_IU_MAX_CHARS chars.
+     * @return the end of the written text, which isn't nul-terminated.
+     */
+    KICOMMON_API char* FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue,
+                                            char* aBuf );
+
+    constexpr size_t FORMAT_IU_MAX_CHARS = 32;
+
 #if 0   // No support for std::from_chars on MacOS yet
     /**
      * Converts \a aInput string to internal units when reading from a file.
@@ -65,6 +65,14 @@ public:
     wxString AsString() const;
     wxString AsLegacyTimestampString() const;
 
+    /**
+     * Write the same text as AsString() to \a aBuf without allocating.
+     *
+     * @param aBuf must hold at least 36 chars.
+     * @return the end of the text, which isn't nul-terminated.
+     */
+    char* AsChars( char* aBuf ) const;
+
     /**
      * Returns true if a string has the correct formatting to be a KIID.
      */
@@ -21,11 +21,16 @@
 #ifndef __LIBEVAL_COMPILER_H
 #define __LIBEVAL_COMPILER_H
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <map>
+#include <memory>
+#include <new>
 #include <string>
 #include <stack>
+#include <type_traits>
+#include <vector>
 
 #include <base_units.h>
 #include <wx/intl.h>
@@ -55,6 +60,8 @@
 #define TR_OP_METHOD_CALL 25
 #define TR_UOP_PUSH_VAR 1
 #define TR_UOP_PUSH_VALUE 2
+#define TR_UOP_JUMP_IF_FALSE 26
+#define TR_UOP_JUMP_IF_TRUE 27
 
 // This namespace is used for the lemon parser
 namespace LIBEVAL
@@ -187,6 +194,7 @@ public:
     VALUE() :
         m_type( VT_UNDEFINED ),
         m_valueDbl( 0 ),
+        m_valueStrRef( nullptr ),
         m_stringIsWildcard( false ),
         m_isDeferredDbl( false ),
         m_isDeferredStr( false )
@@ -196,6 +204,7 @@ public:
         m_type( VT_STRING ),
         m_valueDbl( 0 ),
         m_valueStr( aStr ),
+        m_valueStrRef( nullptr ),
         m_stringIsWildcard( aIsWildcard ),
         m_isDeferredDbl( false ),
         m_isDeferredStr( false )
@@ -204,6 +213,7 @@ public:
     VALUE( const double aVal ) :
         m_type( VT_NUMERIC ),
         m_valueDbl( aVal ),
+        m_valueStrRef( nullptr ),
         m_stringIsWildcard( false ),
         m_isDeferredDbl( false ),
         m_isDeferredStr( false )
@@ -231,7 +241,7 @@ public:
             m_isDeferredStr = false;
         }
 
-        return m_valueStr;
+        return m_valueStrRef ? *m_valueStrRef : m_valueStr;
     }
 
     virtual bool EqualTo( CONTEXT* aCtx, const VALUE* b ) const;
@@ -257,6 +267,7 @@ public:
     void SetDeferredEval( std::function<wxString()> aLambda )
     {
         m_type = VT_STRING;
+        m_valueStrRef = nullptr;
         m_lambdaStr = aLambda;
         m_isDeferredStr = true;
     }
@@ -265,6 +276,18 @@ public:
     {
         m_type = VT_STRING;
         m_valueStr = aValue;
+        m_valueStrRef = nullptr;
+    }
+
+    /**
+     * Refer to \a aValue rather than copying it.  The string must outlive the evaluation,
+     * which is the case for names owned by the objects being evaluated, enum labels and the
+     * literals of the expression.
+     */
+    void SetStringRef( const wxString* aValue )
+    {
+        m_type = VT_STRING;
+        m_valueStrRef = aValue;
     }
 
     void Set( const VALUE &val )
@@ -273,13 +296,17 @@ public:
         m_valueDbl = val.m_valueDbl;
 
         if( m_type == VT_STRING )
+        {
             m_valueStr = val.m_valueStr;
+            m_valueStrRef = val.m_valueStrRef;
+        }
     }
 
 private:
     VAR_TYPE_T                m_type;
     mutable double            m_valueDbl;               // mutable to support deferred evaluation
     mutable wxString          m_valueStr;               // mutable to support deferred evaluation
+    const wxString*           m_valueStrRef;            // if set, used instead of m_valueStr
     bool                      m_stringIsWildcard;
 
     mutable bool              m_isDeferredDbl;
@@ -289,6 +316,84 @@ private:
     std::function<wxString()> m_lambdaStr;
 };
 
+/**
+ * A bump allocator for the VALUEs created while running a UCODE.
+ *
+ * The first block is part of the arena itself (and so usually lives on the stack along with
+ * its CONTEXT); evaluating a typical expression never touches the heap.  All values are
+ * destroyed with the arena.
+ */
+class VALUE_ARENA
+{
+public:
+    VALUE_ARENA() :
+            m_block( m_inlineBlock ),
+            m_blockSize( INLINE_SIZE ),
+            m_used( 0 ),
+            m_last( nullptr )
+    {}
+
+    ~VALUE_ARENA()
+    {
+        for( NODE* node = m_last; node; node = node->m_Prev )
+            node->m_Value->~VALUE();
+    }
+
+    VALUE_ARENA( const VALUE_ARENA& ) = delete;
+    VALUE_ARENA& operator=( const VALUE_ARENA& ) = delete;
+
+    template <typename T, typename... ARGS>
+    T* Create( ARGS&&... aArgs )
+    {
+        static_assert( std::is_base_of<VALUE, T>::value, "arena values must derive from VALUE" );
+        static_assert( alignof( T ) <= alignof( std::max_align_t ), "over-aligned value" );
+
+        // Each value is preceded by a node linking it into the list of values to destroy
+        constexpr size_t offset = ( sizeof( NODE ) + alignof( T ) - 1 ) & ~( alignof( T ) - 1 );
+
+        char* mem = static_cast<char*>( allocate( offset + sizeof( T ) ) );
+        T*    value = new( mem + offset ) T( std::forward<ARGS>( aArgs )... );
+
+        m_last = new( mem ) NODE{ m_last, value };
+        return value;
+    }
+
+private:
+    struct NODE
+    {
+        NODE*  m_Prev;
+        VALUE* m_Value;
+    };
+
+    void* allocate( size_t aSize )
+    {
+        constexpr size_t align = alignof( std::max_align_t );
+
+        size_t start = ( m_used + align - 1 ) & ~( align - 1 );
+
+        if( start + aSize > m_blockSize )
+        {
+            m_blockSize = std::max( aSize, 2 * m_blockSize );
+            m_overflow.emplace_back( new std::max_align_t[ m_blockSize / align + 1 ] );
+            m_block = reinterpret_cast<char*>( m_overflow.back().get() );
+            start = 0;
+        }
+
+        m_used = start + aSize;
+        return m_block + start;
+    }
+
+    static constexpr size_t INLINE_SIZE = 4096;
+
+    alignas( std::max_align_t ) char                 m_inlineBlock[INLINE_SIZE];
+    char*                                            m_block;
+    size_t                                           m_blockSize;
+    size_t                                           m_used;
+    NODE*                                            m_last;
+    std::vector<std::unique_ptr<std::max_align_t[]>> m_overflow;
+};
+
+
 class VAR_REF
 {
 public:
@@ -296,6 +401,10 @@ public:
     virtual ~VAR_REF() {};
 
     virtual VAR_TYPE_T GetType() const = 0;
+
+    /**
+     * @return the value of the reference, allocated from \a aCtx (see CONTEXT::AllocValue()).
+     */
     virtual VALUE* GetValue( CONTEXT* aCtx ) = 0;
 };
 
@@ -307,27 +416,19 @@ public:
         m_stack(),
         m_stackPtr( 0 )
     {
-        m_ownedValues.reserve( 20 );
     }
 
     virtual ~CONTEXT()
     {
-        for( VALUE* v : m_ownedValues )
-        {
-            delete v;
-        }
-    }
-
-    VALUE* AllocValue()
-    {
-        m_ownedValues.emplace_back( new VALUE );
-        return m_ownedValues.back();
     }
 
-    VALUE* StoreValue( VALUE* aValue )
+    /**
+     * Create a VALUE (or a subclass of VALUE) owned by the context.
+     */
+    template <typename T = VALUE, typename... ARGS>
+    T* AllocValue( ARGS&&... aArgs )
     {
-        m_ownedValues.emplace_back( aValue );
-        return m_ownedValues.back();
+        return m_values.Create<T>( std::forward<ARGS>( aArgs )... );
     }
 
     void Push( VALUE* v )
@@ -361,7 +462,7 @@ public:
     void ReportError( const wxString& aErrorMsg );
 
 private:
-    std::vector<VALUE*> m_ownedValues;
+    VALUE_ARENA         m_values;
     VALUE*              m_stack[100];       // std::stack not performant enough
     int                 m_stackPtr;
 
@@ -382,6 +483,14 @@ public:
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
 
+    /**
+     * Rewrite the (well-formed) ucode for faster evaluation without changing its results:
+     * constant sub-expressions are folded, the operands of chained && and || are reordered
+     * so that cheap property tests run before function calls, and && and || skip their
+     * second operand when the first one already decides the result.
+     */
+    void Optimize();
+
     virtual std::unique_ptr<VAR_REF> CreateVarRef( const wxString& var, const wxString& field )
     {
         return nullptr;
@@ -404,36 +513,55 @@ public:
     UOP( int op, std::unique_ptr<VALUE> value ) :
         m_op( op ),
         m_ref(nullptr),
-        m_value( std::move( value ) )
+        m_value( std::move( value ) ),
+        m_argCount( 0 ),
+        m_jumpTarget( 0 )
     {};
 
     UOP( int op, std::unique_ptr<VAR_REF> vref ) :
         m_op( op ),
         m_ref( std::move( vref ) ),
-        m_value(nullptr)
+        m_value(nullptr),
+        m_argCount( 0 ),
+        m_jumpTarget( 0 )
     {};
 
     UOP( int op, FUNC_CALL_REF func, std::unique_ptr<VAR_REF> vref = nullptr ) :
         m_op( op ),
         m_func( std::move( func ) ),
         m_ref( std::move( vref ) ),
-        m_value(nullptr)
+        m_value(nullptr),
+        m_argCount( 0 ),
+        m_jumpTarget( 0 )
     {};
 
     ~UOP()
     {
     }
 
-    void Exec( CONTEXT* ctx );
+    /**
+     * @return true if execution continues at the jump target rather than at the next op.
+     */
+    bool Exec( CONTEXT* ctx );
 
     wxString Format() const;
 
+    /**
+     * Set the number of parameters popped by a method call.
+     */
+    void SetArgCount( int aCount ) { m_argCount = aCount; }
+
 private:
+    friend class UCODE;
+
     int                      m_op;
 
     FUNC_CALL_REF            m_func;
     std::unique_ptr<VAR_REF> m_ref;
     std::unique_ptr<VALUE>   m_value;
+
+    int                      m_argCount;
+    size_t                   m_jumpTarget;
 };
 
 class TOKENIZER
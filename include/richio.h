@@ -29,6 +29,7 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <string_view>
 #include <vector>
 #include <core/utf8.h>
 
@@ -40,6 +41,11 @@
 
 #include <ki_exception.h>
 #include <kicommon.h>
+#include <kiplatform/io.h>
+
+struct EDA_IU_SCALE;
+template <class T> class VECTOR2;
+typedef VECTOR2<int> VECTOR2I;
 
 /**
  * This is like sprintf() but the output is appended to a std::string instead of to a
@@ -112,6 +118,22 @@ public:
      */
     virtual char* ReadLine() = 0;
 
+    /**
+     * Read a line of text without copying it, for readers which hold all of their text in
+     * memory.  Increments the line number counter like ReadLine() but doesn't change Line().
+     *
+     * The line includes its end of line character(s), isn't nul terminated and remains valid
+     * for the lifetime of the reader.
+     *
+     * @param aLine is set to the line read, or emptied at EOF.
+     * @return false if this reader can't provide views, in which case use ReadLine().
+     * @throw IO_ERROR when a line is too long.
+     */
+    virtual bool ReadLineView( std::string_view& aLine )
+    {
+        return false;
+    }
+
     /**
      * Returns the name of the source of the lines in an abstract sense.
      *
@@ -246,6 +268,93 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER over text held in memory by someone else, which hands out its lines without
+ * copying them (see ReadLineView()).  The text must outlive the reader.
+ */
+class KICOMMON_API VIEW_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aText is the text to read.
+     * @param aSource describes the source of aText for error reporting purposes.
+     * @param aStartingLineNumber is the line number preceding the first line of @a aText, for
+     *                            reading a part of a larger text.
+     */
+    VIEW_LINE_READER( std::string_view aText, const wxString& aSource,
+                      unsigned aStartingLineNumber = 0,
+                      unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    char* ReadLine() override;
+
+    bool ReadLineView( std::string_view& aLine ) override;
+
+    /**
+     * Go back to the start of the text and reset the line number to zero.
+     */
+    void Rewind()
+    {
+        m_pos = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * Continue reading at @a aPos, which must be the start of a line.
+     *
+     * @param aLineNumber is the number of the line preceding @a aPos.
+     */
+    void Seek( size_t aPos, unsigned aLineNumber )
+    {
+        m_pos = aPos;
+        m_lineNum = aLineNumber;
+    }
+
+    /**
+     * @return all of the text, whatever has been read.
+     */
+    std::string_view GetText() const { return m_text; }
+
+    size_t CurPos() const { return m_pos; }
+
+protected:
+    VIEW_LINE_READER( unsigned aMaxLineLength );
+
+    std::string_view    m_text;
+    size_t              m_pos;      ///< offset of the next line in m_text
+};
+
+
+/**
+ * A #VIEW_LINE_READER of a file mapped into memory.  Files which can't be mapped are read
+ * into memory instead.
+ *
+ * Unlike #FILE_LINE_READER the file is read in binary mode, so lines may end with "\r\n".
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public VIEW_LINE_READER
+{
+public:
+    /**
+     * @param aFileName is the name of the file to read and to use for error reporting purposes.
+     * @param aMaxLineLength is the longest line allowed.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    MAPPED_FILE_LINE_READER( const MAPPED_FILE_LINE_READER& ) = delete;
+    MAPPED_FILE_LINE_READER& operator=( const MAPPED_FILE_LINE_READER& ) = delete;
+
+    size_t FileLength() const { return m_text.size(); }
+
+protected:
+    KIPLATFORM::IO::MAPPED_FILE m_mapping;
+    std::string                 m_buffer;   ///< the file contents when it couldn't be mapped
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -375,6 +484,30 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Typed alternatives to Print() for the busiest parts of the file writers.  They write
+     * exactly what the equivalent Print() format would, but don't parse a format string and
+     * don't allocate (except AppendQuoted(), for the UTF8 conversion).
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Append( std::string_view aText ) { write( aText.data(), (int) aText.size() ); }
+
+    /// Like Print( aNestLevel, "" ).
+    void AppendIndent( int aNestLevel );
+
+    /// Like Print( 0, "%d", aValue ).
+    void AppendInt( long long aValue );
+
+    /// Write \a aValue in mm, like EDA_UNIT_UTILS::FormatInternalUnits().
+    void AppendIU( const EDA_IU_SCALE& aIuScale, int aValue );
+
+    /// Write \a aPoint as "x y" in mm, like EDA_UNIT_UTILS::FormatInternalUnits().
+    void AppendIU( const EDA_IU_SCALE& aIuScale, const VECTOR2I& aPoint );
+
+    /// Like Print( 0, "%s", Quotew( aText ).c_str() ).
+    void AppendQuoted( const wxString& aText );
+
     /**
      * Perform quote character need determination.
      *
@@ -28,6 +28,7 @@
 
 #include <core/typeinfo.h>
 #include <eda_item_flags.h>
+#include <math/vector2d.h>
 #include <functional>
 #include <vector>
 #include <wx/string.h>
@@ -69,7 +70,9 @@ enum class UNDO_REDO {
     PAGESETTINGS,       // page settings or title block changes
     REGROUP,            // new group of items created (NB: can't use GROUP because of collision
                         // with a header on msys2)
-    UNGROUP             // existing group destroyed (items not destroyed)
+    UNGROUP,            // existing group destroyed (items not destroyed)
+    MOVED               // item only moved: undo is made by moving it back to the position
+                        // held by the picker (which then holds the position to redo)
 };
 
 
@@ -99,6 +102,10 @@ public:
 
     EDA_ITEM* GetLink() const { return m_link; }
 
+    void SetPosition( const VECTOR2I& aPosition ) { m_position = aPosition; }
+
+    const VECTOR2I& GetPosition() const { return m_position; }
+
     BASE_SCREEN* GetScreen() const { return m_screen; }
 
 private:
@@ -117,6 +124,9 @@ private:
                                         * copy of an active item) and m_Link points the active
                                         * item in schematic */
 
+    VECTOR2I       m_position;         /* For moved items, the position to move the item to
+                                        * when the command is undone (or redone). */
+
     BASE_SCREEN*   m_screen;           /* For new and deleted items the screen the item should
                                         * be added to/removed from. */
 
@@ -225,6 +235,12 @@ public:
      */
     EDA_ITEM_FLAGS GetPickerFlags( unsigned aIdx ) const;
 
+    /**
+     * @param aIdx Index of the picker in the picked list.
+     * @return The position a moved item is to be moved to, or (0,0) if the picker does not exist.
+     */
+    VECTOR2I GetPickedItemPosition( unsigned aIdx ) const;
+
     /**
      * @param aItem A pointer to the item to pick.
      * @param aIdx Index of the picker in the picked list.
@@ -267,6 +283,15 @@ public:
      */
     bool SetPickerFlags( EDA_ITEM_FLAGS aFlags, unsigned aIdx );
 
+    /**
+     * Set the position a moved item is to be moved to by the next undo or redo.
+     *
+     * @param aPosition The position to store in the picker.
+     * @param aIdx Index of the picker in the picked list.
+     * @return True if the picker exists or false if does not exist.
+     */
+    bool SetPickedItemPosition( const VECTOR2I& aPosition, unsigned aIdx );
+
     /**
      * Remove one entry (one picker) from the list of picked items.
      *
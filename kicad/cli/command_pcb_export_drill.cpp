@@ -40,6 +40,7 @@
 #define ARG_GENERATE_MAP "--generate-map"
 #define ARG_MAP_FORMAT "--map-format"
 #define ARG_DRILL_ORIGIN "--drill-origin"
+#define ARG_JOBS "--jobs"
 
 CLI::PCB_EXPORT_DRILL_COMMAND::PCB_EXPORT_DRILL_COMMAND() : PCB_EXPORT_BASE_COMMAND( "drill",
                                                                                      false, true )
@@ -97,6 +98,13 @@ CLI::PCB_EXPORT_DRILL_COMMAND::PCB_EXPORT_DRILL_COMMAND() : PCB_EXPORT_BASE_COMM
             .help( UTF8STDSTR( _( "Precision of Gerber coordinates (5 or 6)" ) ) )
             .default_value( 6 )
             .scan<'i', int>();
+
+    m_argParser.add_argument( "-j", ARG_JOBS )
+            .help( UTF8STDSTR( _( "Number of drill and map files to write concurrently, 0 for "
+                                  "one per CPU" ) ) )
+            .default_value( 1 )
+            .scan<'i', int>()
+            .metavar( "JOBS" );
 }
 
 
@@ -245,6 +253,14 @@ int CLI::PCB_EXPORT_DRILL_COMMAND::doPerform( KIWAY& aKiway )
         return EXIT_CODES::ERR_ARGS;
     }
 
+    drillJob->m_jobs = m_argParser.get<int>( ARG_JOBS );
+
+    if( drillJob->m_jobs < 0 )
+    {
+        wxFprintf( stderr, _( "Invalid number of jobs\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
     int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, drillJob.get() );
 
     return exitCode;
@@ -33,6 +33,7 @@
 
 #define ARG_COMMON_LAYERS "--common-layers"
 #define ARG_USE_BOARD_PLOT_PARAMS "--board-plot-params"
+#define ARG_JOBS "--jobs"
 
 
 CLI::PCB_EXPORT_GERBERS_COMMAND::PCB_EXPORT_GERBERS_COMMAND() :
@@ -55,6 +56,12 @@ CLI::PCB_EXPORT_GERBERS_COMMAND::PCB_EXPORT_GERBERS_COMMAND() :
             .help( UTF8STDSTR( _( "Use the Gerber plot settings already configured in the "
                                   "board file" ) ) )
             .flag();
+
+    m_argParser.add_argument( "-j", ARG_JOBS )
+            .help( UTF8STDSTR( _( "Number of layers to plot concurrently, 0 for one per CPU" ) ) )
+            .default_value( 1 )
+            .scan<'i', int>()
+            .metavar( "JOBS" );
 }
 
 
@@ -76,6 +83,13 @@ int CLI::PCB_EXPORT_GERBERS_COMMAND::doPerform( KIWAY& aKiway )
     gerberJob->m_layersIncludeOnAll =
             convertLayerStringList( layers, gerberJob->m_layersIncludeOnAllSet );
     gerberJob->m_useBoardPlotParams = m_argParser.get<bool>( ARG_USE_BOARD_PLOT_PARAMS );
+    gerberJob->m_jobs = m_argParser.get<int>( ARG_JOBS );
+
+    if( gerberJob->m_jobs < 0 )
+    {
+        wxFprintf( stderr, _( "Invalid number of jobs\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
 
     LOCALE_IO dummy;
     exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, gerberJob.get() );
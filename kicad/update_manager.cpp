@@ -49,7 +49,7 @@
 
 #include <background_jobs_monitor.h>
 
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 
 #include <build_version.h>
 
@@ -255,6 +255,5 @@ void UPDATE_MANAGER::CheckForUpdate( wxWindow* aNoticeParent )
         m_working = false;
     };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    tp.push_task( update_check );
+    GetKiCadTaskScheduler().Submit( update_check );
 }
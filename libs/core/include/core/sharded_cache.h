@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARDED_CACHE_H
+#define SHARDED_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+
+/**
+ * A thread-safe hash map split into independently locked shards, so that threads looking up or
+ * storing different keys rarely wait for each other.
+ *
+ * Lookups take a shared lock on a single shard and insertions an exclusive one; neither is held
+ * while the caller computes a missing value, so two threads may occasionally compute the same
+ * value and the last one stored wins.  That suits caches of deterministic results.
+ *
+ * Each shard counts its lookups, hits and lock acquisitions which had to wait (contention) so
+ * that the effect of the sharding can be measured.
+ */
+template <typename KEY, typename VALUE, typename HASH = std::hash<KEY>, size_t SHARD_COUNT = 64>
+class SHARDED_CACHE
+{
+public:
+    struct STATS
+    {
+        uint64_t m_Lookups = 0;
+        uint64_t m_Hits = 0;
+        uint64_t m_Contended = 0;
+    };
+
+    /**
+     * Copy the value cached for \a aKey into \a aValue.
+     *
+     * @return false (leaving \a aValue untouched) if \a aKey isn't cached.
+     */
+    bool Find( const KEY& aKey, VALUE& aValue ) const
+    {
+        const SHARD&                        shard = shardFor( aKey );
+        std::shared_lock<std::shared_mutex> lock( shard.m_lock, std::try_to_lock );
+
+        if( !lock.owns_lock() )
+        {
+            shard.m_contended.fetch_add( 1, std::memory_order_relaxed );
+            lock.lock();
+        }
+
+        shard.m_lookups.fetch_add( 1, std::memory_order_relaxed );
+
+        auto it = shard.m_map.find( aKey );
+
+        if( it == shard.m_map.end() )
+            return false;
+
+        shard.m_hits.fetch_add( 1, std::memory_order_relaxed );
+        aValue = it->second;
+        return true;
+    }
+
+    /**
+     * Cache \a aValue for \a aKey, replacing any value already cached.
+     */
+    void Insert( const KEY& aKey, const VALUE& aValue )
+    {
+        SHARD&                              shard = shardFor( aKey );
+        std::unique_lock<std::shared_mutex> lock( shard.m_lock, std::try_to_lock );
+
+        if( !lock.owns_lock() )
+        {
+            shard.m_contended.fetch_add( 1, std::memory_order_relaxed );
+            lock.lock();
+        }
+
+        shard.m_map[ aKey ] = aValue;
+        shard.m_size.store( shard.m_map.size(), std::memory_order_relaxed );
+    }
+
+    /**
+     * Return the value cached for \a aKey, computing it with \a aBuild() and caching it if
+     * needed.  No lock is held while \a aBuild() runs.
+     */
+    template <typename BUILD>
+    VALUE FindOrInsert( const KEY& aKey, BUILD&& aBuild )
+    {
+        VALUE value;
+
+        if( !Find( aKey, value ) )
+        {
+            value = aBuild();
+            Insert( aKey, value );
+        }
+
+        return value;
+    }
+
+    void Clear()
+    {
+        for( SHARD& shard : m_shards )
+        {
+            std::unique_lock<std::shared_mutex> lock( shard.m_lock );
+
+            shard.m_map.clear();
+            shard.m_size.store( 0, std::memory_order_relaxed );
+        }
+    }
+
+    /**
+     * @return true if nothing is cached.  Doesn't lock, so only exact when no other thread is
+     *         inserting.
+     */
+    bool Empty() const
+    {
+        for( const SHARD& shard : m_shards )
+        {
+            if( shard.m_size.load( std::memory_order_relaxed ) > 0 )
+                return false;
+        }
+
+        return true;
+    }
+
+    STATS GetStats() const
+    {
+        STATS stats;
+
+        for( const SHARD& shard : m_shards )
+        {
+            stats.m_Lookups += shard.m_lookups.load( std::memory_order_relaxed );
+            stats.m_Hits += shard.m_hits.load( std::memory_order_relaxed );
+            stats.m_Contended += shard.m_contended.load( std::memory_order_relaxed );
+        }
+
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        for( SHARD& shard : m_shards )
+        {
+            shard.m_lookups.store( 0, std::memory_order_relaxed );
+            shard.m_hits.store( 0, std::memory_order_relaxed );
+            shard.m_contended.store( 0, std::memory_order_relaxed );
+        }
+    }
+
+private:
+    // Each shard gets its own cache lines so that threads working on different shards don't
+    // invalidate each other's locks and counters.
+    struct alignas( 64 ) SHARD
+    {
+        mutable std::shared_mutex            m_lock;
+        std::unordered_map<KEY, VALUE, HASH> m_map;
+        std::atomic<size_t>                  m_size{ 0 };
+        mutable std::atomic<uint64_t>        m_lookups{ 0 };
+        mutable std::atomic<uint64_t>        m_hits{ 0 };
+        mutable std::atomic<uint64_t>        m_contended{ 0 };
+    };
+
+    SHARD& shardFor( const KEY& aKey )
+    {
+        return m_shards[ shardIndex( aKey ) ];
+    }
+
+    const SHARD& shardFor( const KEY& aKey ) const
+    {
+        return m_shards[ shardIndex( aKey ) ];
+    }
+
+    static size_t shardIndex( const KEY& aKey )
+    {
+        // Use different hash bits from the maps' own bucket selection
+        size_t hash = HASH()( aKey );
+
+        return ( hash ^ ( hash >> 17 ) ^ ( hash >> 31 ) ) % SHARD_COUNT;
+    }
+
+private:
+    std::array<SHARD, SHARD_COUNT> m_shards;
+};
+
+#endif // SHARDED_CACHE_H
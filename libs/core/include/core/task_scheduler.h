@@ -0,0 +1,310 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#ifndef INCLUDE_TASK_SCHEDULER_H_
+#define INCLUDE_TASK_SCHEDULER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * A flag shared by the tasks of a job which can be raised to abandon the work not yet started.
+ *
+ * The token can also poll an external source, typically a PROGRESS_REPORTER:
+ *
+ *     CANCELLATION_TOKEN cancel( [&]() { return aReporter && aReporter->IsCancelled(); } );
+ *
+ * Once cancelled it stays cancelled.
+ */
+class CANCELLATION_TOKEN
+{
+public:
+    CANCELLATION_TOKEN( std::function<bool()> aPoll = nullptr ) :
+            m_cancelled( false ),
+            m_poll( std::move( aPoll ) )
+    {}
+
+    void Cancel() { m_cancelled.store( true ); }
+
+    bool IsCancelled() const
+    {
+        if( !m_cancelled.load( std::memory_order_relaxed ) && m_poll && m_poll() )
+            m_cancelled.store( true );
+
+        return m_cancelled.load( std::memory_order_relaxed );
+    }
+
+private:
+    mutable std::atomic<bool> m_cancelled;
+    std::function<bool()>     m_poll;
+};
+
+
+/**
+ * A work-stealing task scheduler.
+ *
+ * Each worker thread owns a deque of tasks.  Tasks submitted from a worker go to the back of
+ * its own deque and are picked up from there (LIFO, so nested work stays cache-warm); idle
+ * workers steal from the front of the other deques (FIFO, the oldest queued tasks).  Tasks
+ * submitted from other threads go to a shared injection queue.  Tasks are not ordered by size.
+ *
+ * Waiting for work (see TASK_GROUP::Wait()) executes pending tasks instead of blocking, so
+ * tasks can themselves start and wait for parallel work without starving the pool.  This is
+ * the only worker pool in KiCad; don't create others, or the CPU gets oversubscribed.
+ */
+class TASK_SCHEDULER
+{
+public:
+    using TASK = std::function<void()>;
+
+    /**
+     * @param aThreadCount is the number of worker threads; 0 means one per hardware thread.
+     */
+    TASK_SCHEDULER( unsigned aThreadCount = 0 );
+
+    ~TASK_SCHEDULER();
+
+    TASK_SCHEDULER( const TASK_SCHEDULER& ) = delete;
+    TASK_SCHEDULER& operator=( const TASK_SCHEDULER& ) = delete;
+
+    unsigned GetThreadCount() const { return (unsigned) m_threads.size(); }
+
+    /**
+     * Queue a task.  Prefer TASK_GROUP::Run(), which allows waiting for completion.
+     */
+    void Submit( TASK aTask );
+
+    /**
+     * Run one pending task on the calling thread, if there is one.
+     *
+     * @return true if a task was run.
+     */
+    bool RunPendingTask();
+
+    /**
+     * @return true if the calling thread is one of this scheduler's workers.
+     */
+    bool IsWorkerThread() const;
+
+private:
+    struct WORKER
+    {
+        std::mutex       m_lock;
+        std::deque<TASK> m_tasks;
+    };
+
+    void workerLoop( unsigned aIndex );
+
+    bool popTask( TASK& aTask );
+
+private:
+    std::vector<std::unique_ptr<WORKER>> m_workers;
+    std::vector<std::thread>             m_threads;
+
+    std::mutex                           m_injectLock;
+    std::deque<TASK>                     m_injected;
+
+    std::mutex                           m_sleepLock;
+    std::condition_variable              m_wake;
+    std::atomic<size_t>                  m_queued;
+    std::atomic<bool>                    m_stop;
+};
+
+
+/**
+ * A set of tasks which can be waited on (and cancelled) together.
+ *
+ * Tasks may add further tasks to their own group.  The group must outlive its tasks, so
+ * the destructor waits for any which are still pending.
+ */
+class TASK_GROUP
+{
+public:
+    TASK_GROUP( TASK_SCHEDULER& aScheduler, const CANCELLATION_TOKEN* aToken = nullptr );
+
+    ~TASK_GROUP();
+
+    TASK_GROUP( const TASK_GROUP& ) = delete;
+    TASK_GROUP& operator=( const TASK_GROUP& ) = delete;
+
+    /**
+     * Queue \a aTask.  It is skipped if the group is cancelled before it starts.
+     */
+    void Run( std::function<void()> aTask );
+
+    /**
+     * Wait for all the tasks of the group, running pending tasks (of any group) on the calling
+     * thread in the meantime.  Rethrows the first exception thrown by a task.
+     *
+     * @warning don't call this while holding a lock which tasks may need.
+     */
+    void Wait();
+
+    /**
+     * Wait up to \a aTimeout for all the tasks of the group.  Intended for the UI thread, which
+     * must keep refreshing the progress reporter, and so doesn't run any tasks itself; called
+     * from a worker it runs pending tasks like Wait() so the pool can't deadlock.
+     *
+     * @return true if all tasks have finished (their exceptions are then rethrown).
+     */
+    bool WaitFor( std::chrono::milliseconds aTimeout );
+
+    /**
+     * Cancel the tasks of the group which haven't started yet.
+     */
+    void Cancel() { m_cancelled.store( true ); }
+
+    bool IsCancelled() const
+    {
+        return m_cancelled.load( std::memory_order_relaxed )
+                || ( m_token && m_token->IsCancelled() );
+    }
+
+private:
+    void finishTask();
+
+    void rethrow();
+
+private:
+    TASK_SCHEDULER&           m_scheduler;
+    const CANCELLATION_TOKEN* m_token;
+    std::atomic<bool>         m_cancelled;
+    std::atomic<size_t>       m_pending;
+    std::mutex                m_lock;
+    std::condition_variable   m_done;
+    std::exception_ptr        m_exception;
+};
+
+
+/**
+ * Call \a aFunc( ii ) for every \a ii in [aBegin, aEnd) on \a aScheduler.
+ *
+ * The range is split recursively down to \a aGrainSize indices so that idle workers can steal
+ * the remaining halves of slow ranges.  May be called from within a task.
+ *
+ * @param aGrainSize is the smallest range worth a task of its own.  0 picks one giving about
+ *                   8 tasks per worker, which suits many cheap iterations.  Use 1 when single
+ *                   iterations can be slow.
+ * @param aToken if given, indices not yet reached when it is cancelled are skipped.
+ */
+template <typename FUNC>
+void ParallelFor( TASK_SCHEDULER& aScheduler, size_t aBegin, size_t aEnd, FUNC&& aFunc,
+                  size_t aGrainSize = 0, const CANCELLATION_TOKEN* aToken = nullptr )
+{
+    if( aBegin >= aEnd )
+        return;
+
+    if( aGrainSize == 0 )
+        aGrainSize = ( aEnd - aBegin ) / ( 8 * (size_t) aScheduler.GetThreadCount() );
+
+    // The group must be destroyed (and so waited on) before anything its tasks use
+    size_t                                grain = std::max<size_t>( aGrainSize, 1 );
+    std::function<void( size_t, size_t )> split;
+    TASK_GROUP                            group( aScheduler, aToken );
+
+    split =
+            [&]( size_t aFirst, size_t aLast )
+            {
+                while( aLast - aFirst > grain )
+                {
+                    size_t mid = aFirst + ( aLast - aFirst ) / 2;
+
+                    group.Run( [&split, mid, aLast]() { split( mid, aLast ); } );
+                    aLast = mid;
+                }
+
+                for( size_t ii = aFirst; ii < aLast && !group.IsCancelled(); ++ii )
+                    aFunc( ii );
+            };
+
+    split( aBegin, aEnd );
+    group.Wait();
+}
+
+
+/**
+ * Call \a aFunc( ii ) for every \a ii in [aBegin, aEnd) on at most \a aMaxThreads threads
+ * (counting the calling one) of \a aScheduler.
+ *
+ * Intended for a few slow iterations writing files, where the user picks the number of
+ * concurrent jobs.  The indices are handed out in order, but may complete in any order.
+ *
+ * @param aMaxThreads of 0 uses all the scheduler's threads; 1 runs serially on the caller.
+ * @param aToken if given, indices not yet reached when it is cancelled are skipped.
+ */
+template <typename FUNC>
+void ParallelForLimited( TASK_SCHEDULER& aScheduler, size_t aBegin, size_t aEnd,
+                         unsigned aMaxThreads, FUNC&& aFunc,
+                         const CANCELLATION_TOKEN* aToken = nullptr )
+{
+    if( aBegin >= aEnd )
+        return;
+
+    if( aMaxThreads == 0 )
+        aMaxThreads = aScheduler.GetThreadCount();
+
+    size_t lanes = std::min<size_t>( aMaxThreads, aEnd - aBegin );
+
+    if( lanes <= 1 )
+    {
+        for( size_t ii = aBegin; ii < aEnd && !( aToken && aToken->IsCancelled() ); ++ii )
+            aFunc( ii );
+
+        return;
+    }
+
+    std::atomic<size_t> next( aBegin );
+
+    ParallelFor( aScheduler, 0, lanes,
+                 [&]( size_t )
+                 {
+                     for( size_t ii = next++; ii < aEnd; ii = next++ )
+                     {
+                         if( aToken && aToken->IsCancelled() )
+                             break;
+
+                         aFunc( ii );
+                     }
+                 },
+                 1, aToken );
+}
+
+
+/**
+ * Get a reference to the shared task scheduler.
+ */
+TASK_SCHEDULER& GetKiCadTaskScheduler();
+
+
+#endif /* INCLUDE_TASK_SCHEDULER_H_ */
@@ -0,0 +1,358 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <core/task_scheduler.h>
+
+#include <utility>
+
+
+// The scheduler (if any) whose worker is the current thread, and the worker's index
+static thread_local const TASK_SCHEDULER* s_currentScheduler = nullptr;
+static thread_local unsigned              s_workerIndex = 0;
+
+
+TASK_SCHEDULER::TASK_SCHEDULER( unsigned aThreadCount ) :
+        m_queued( 0 ),
+        m_stop( false )
+{
+    if( aThreadCount == 0 )
+        aThreadCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+    for( unsigned ii = 0; ii < aThreadCount; ++ii )
+        m_workers.push_back( std::make_unique<WORKER>() );
+
+    for( unsigned ii = 0; ii < aThreadCount; ++ii )
+        m_threads.emplace_back( &TASK_SCHEDULER::workerLoop, this, ii );
+}
+
+
+TASK_SCHEDULER::~TASK_SCHEDULER()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_sleepLock );
+        m_stop.store( true );
+    }
+
+    m_wake.notify_all();
+
+    for( std::thread& thread : m_threads )
+        thread.join();
+}
+
+
+bool TASK_SCHEDULER::IsWorkerThread() const
+{
+    return s_currentScheduler == this;
+}
+
+
+void TASK_SCHEDULER::Submit( TASK aTask )
+{
+    // Count the task before queueing it so that m_queued never underflows; a worker woken
+    // in between just retries.
+    {
+        std::lock_guard<std::mutex> lock( m_sleepLock );
+        m_queued.fetch_add( 1 );
+    }
+
+    if( IsWorkerThread() )
+    {
+        WORKER& worker = *m_workers[s_workerIndex];
+
+        std::lock_guard<std::mutex> lock( worker.m_lock );
+        worker.m_tasks.push_back( std::move( aTask ) );
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock( m_injectLock );
+        m_injected.push_back( std::move( aTask ) );
+    }
+
+    m_wake.notify_one();
+}
+
+
+bool TASK_SCHEDULER::popTask( TASK& aTask )
+{
+    auto take =
+            [&]( std::deque<TASK>& aQueue, bool aBack ) -> bool
+            {
+                if( aQueue.empty() )
+                    return false;
+
+                if( aBack )
+                {
+                    aTask = std::move( aQueue.back() );
+                    aQueue.pop_back();
+                }
+                else
+                {
+                    aTask = std::move( aQueue.front() );
+                    aQueue.pop_front();
+                }
+
+                m_queued.fetch_sub( 1 );
+                return true;
+            };
+
+    size_t   count = m_workers.size();
+    unsigned first = 0;
+
+    // Our own most recent task first
+    if( IsWorkerThread() )
+    {
+        WORKER& worker = *m_workers[s_workerIndex];
+
+        std::lock_guard<std::mutex> lock( worker.m_lock );
+
+        if( take( worker.m_tasks, true ) )
+            return true;
+
+        first = s_workerIndex + 1;
+    }
+
+    // Then work from outside the pool
+    {
+        std::lock_guard<std::mutex> lock( m_injectLock );
+
+        if( take( m_injected, false ) )
+            return true;
+    }
+
+    // Then steal the oldest task of another worker
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        WORKER& victim = *m_workers[( first + ii ) % count];
+
+        std::lock_guard<std::mutex> lock( victim.m_lock );
+
+        if( take( victim.m_tasks, false ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+bool TASK_SCHEDULER::RunPendingTask()
+{
+    TASK task;
+
+    if( !popTask( task ) )
+        return false;
+
+    task();
+    return true;
+}
+
+
+void TASK_SCHEDULER::workerLoop( unsigned aIndex )
+{
+    s_currentScheduler = this;
+    s_workerIndex = aIndex;
+
+    while( true )
+    {
+        TASK task;
+
+        if( popTask( task ) )
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( m_sleepLock );
+
+        m_wake.wait( lock,
+                     [&]()
+                     {
+                         return m_stop.load() || m_queued.load() > 0;
+                     } );
+
+        if( m_stop.load() )
+            return;
+    }
+}
+
+
+TASK_GROUP::TASK_GROUP( TASK_SCHEDULER& aScheduler, const CANCELLATION_TOKEN* aToken ) :
+        m_scheduler( aScheduler ),
+        m_token( aToken ),
+        m_cancelled( false ),
+        m_pending( 0 )
+{
+}
+
+
+TASK_GROUP::~TASK_GROUP()
+{
+    try
+    {
+        Wait();
+    }
+    catch( ... )
+    {
+        // Nowhere to report it; the owner didn't wait so it didn't care.
+    }
+}
+
+
+void TASK_GROUP::Run( std::function<void()> aTask )
+{
+    m_pending.fetch_add( 1 );
+
+    m_scheduler.Submit(
+            [this, task = std::move( aTask )]()
+            {
+                if( !IsCancelled() )
+                {
+                    try
+                    {
+                        task();
+                    }
+                    catch( ... )
+                    {
+                        std::lock_guard<std::mutex> lock( m_lock );
+
+                        if( !m_exception )
+                            m_exception = std::current_exception();
+
+                        // Don't bother with the rest of a failed job
+                        m_cancelled.store( true );
+                    }
+                }
+
+                finishTask();
+            } );
+}
+
+
+void TASK_GROUP::finishTask()
+{
+    // Under the lock so that a waiter can't destroy the group before we're done with it
+    std::lock_guard<std::mutex> lock( m_lock );
+
+    if( m_pending.fetch_sub( 1 ) == 1 )
+        m_done.notify_all();
+}
+
+
+void TASK_GROUP::rethrow()
+{
+    std::exception_ptr exception;
+
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+        exception = std::exchange( m_exception, nullptr );
+    }
+
+    if( exception )
+        std::rethrow_exception( exception );
+}
+
+
+void TASK_GROUP::Wait()
+{
+    while( m_pending.load() > 0 )
+    {
+        if( m_scheduler.RunPendingTask() )
+            continue;
+
+        // Nothing to help with: our remaining tasks are running elsewhere
+        std::unique_lock<std::mutex> lock( m_lock );
+
+        m_done.wait_for( lock, std::chrono::milliseconds( 1 ),
+                         [&]()
+                         {
+                             return m_pending.load() == 0;
+                         } );
+    }
+
+    rethrow();
+}
+
+
+bool TASK_GROUP::WaitFor( std::chrono::milliseconds aTimeout )
+{
+    if( m_scheduler.IsWorkerThread() )
+    {
+        // A blocked worker could be waiting on tasks queued behind it, so help out instead
+        auto deadline = std::chrono::steady_clock::now() + aTimeout;
+
+        while( m_pending.load() > 0 && std::chrono::steady_clock::now() < deadline )
+        {
+            if( m_scheduler.RunPendingTask() )
+                continue;
+
+            std::unique_lock<std::mutex> lock( m_lock );
+
+            m_done.wait_for( lock, std::chrono::milliseconds( 1 ),
+                             [&]()
+                             {
+                                 return m_pending.load() == 0;
+                             } );
+        }
+
+        if( m_pending.load() > 0 )
+            return false;
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock( m_lock );
+
+        if( !m_done.wait_for( lock, aTimeout,
+                              [&]()
+                              {
+                                  return m_pending.load() == 0;
+                              } ) )
+        {
+            return false;
+        }
+    }
+
+    rethrow();
+    return true;
+}
+
+
+// Under mingw, there is a problem with the destructor when creating a static instance
+// of the scheduler: probably the DTOR is called too late, and the application hangs.
+// so we create it on the heap.
+static TASK_SCHEDULER* scheduler = nullptr;
+static std::once_flag  schedulerInit;
+
+TASK_SCHEDULER& GetKiCadTaskScheduler()
+{
+    std::call_once( schedulerInit,
+                    []()
+                    {
+#if 0   // Turn this on to disable multi-threading for debugging
+                        scheduler = new TASK_SCHEDULER( 1 );
+#else
+                        scheduler = new TASK_SCHEDULER;
+#endif
+                    } );
+
+    return *scheduler;
+}
@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __BOX_TREE_H
+#define __BOX_TREE_H
+
+#include <vector>
+
+#include <math/vector2d.h>
+
+
+/**
+ * A static bounding volume hierarchy over items known by their index, built once from their
+ * bounding boxes by splitting them at the median of their centres.
+ *
+ * Unlike the RTree behind #SHAPE_INDEX it can't be edited, but it's much quicker to build and
+ * to search, which suits indexes of geometry that is thrown away when it changes.  Nodes are
+ * stored depth first: the first child of an inner node follows it, the second one is at m_Next.
+ */
+class BOX_TREE
+{
+public:
+    struct BOX
+    {
+        VECTOR2I m_Min;
+        VECTOR2I m_Max;
+    };
+
+    /**
+     * Index \a aBoxes, the bounding box of item ii being aBoxes[ii].
+     */
+    void Build( const std::vector<BOX>& aBoxes );
+
+    /**
+     * Call \a aVisitor( itemIndex ) for each item whose bounding box intersects the box from
+     * \a aMin to \a aMax (inclusive), until it returns false.
+     *
+     * @return false if \a aVisitor stopped the query.
+     */
+    template <typename VISITOR>
+    bool Query( const VECTOR2I& aMin, const VECTOR2I& aMax, VISITOR aVisitor ) const
+    {
+        if( m_nodes.empty() )
+            return true;
+
+        // Median splits keep the tree balanced, so its depth is at most log2 of the (int sized)
+        // item count.
+        int stack[64];
+        int depth = 0;
+
+        stack[depth++] = 0;
+
+        while( depth > 0 )
+        {
+            int         nodeIdx = stack[--depth];
+            const NODE& node = m_nodes[nodeIdx];
+
+            if( node.m_Box.m_Max.x < aMin.x || node.m_Box.m_Min.x > aMax.x
+                    || node.m_Box.m_Max.y < aMin.y || node.m_Box.m_Min.y > aMax.y )
+            {
+                continue;
+            }
+
+            if( node.m_Count > 0 )
+            {
+                for( int ii = node.m_Next; ii < node.m_Next + node.m_Count; ++ii )
+                {
+                    if( !aVisitor( m_items[ii] ) )
+                        return false;
+                }
+            }
+            else
+            {
+                stack[depth++] = node.m_Next;
+                stack[depth++] = nodeIdx + 1;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    struct NODE
+    {
+        BOX m_Box;
+        int m_Next;     ///< First item of a leaf, or second child of an inner node
+        int m_Count;    ///< Item count of a leaf, 0 for an inner node
+    };
+
+    int build( const std::vector<BOX>& aBoxes, int aFirst, int aLast );
+
+    std::vector<NODE> m_nodes;
+    std::vector<int>  m_items;
+};
+
+#endif // __BOX_TREE_H
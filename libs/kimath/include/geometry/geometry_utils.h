@@ -70,7 +70,7 @@ int CircleToEndSegmentDeltaRadius( int aInnerCircleRadius, int aSegCount );
  * when converting them to polygons is not acceptable (the modification can break
  * calculations).
  * So one can disable the shape expansion within a particular scope by allocating
- * a DISABLE_ARC_CORRECTION.
+ * a DISABLE_ARC_CORRECTION.  This only affects the calling thread.
  */
 class DISABLE_ARC_RADIUS_CORRECTION
 {
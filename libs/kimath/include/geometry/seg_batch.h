@@ -0,0 +1,184 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __SEG_BATCH_H
+#define __SEG_BATCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <geometry/seg.h>
+#include <math/vector2d.h>
+
+
+/**
+ * Batch search of the segments of a polyline, stored as a packed array of points like
+ * SHAPE_LINE_CHAIN::CPoints(), for those which may collide with a query shape.
+ *
+ * The exact tests (SEG::Collide(), SEG::SquaredDistance()...) take 64 bit products and
+ * divisions for each segment.  Segments are instead screened a block at a time against the
+ * bounding box of the query shape inflated by the clearance, in a branch-free loop the compiler
+ * vectorizes for the target (SSE2, AVX2, NEON...), and only the remaining few are visited.  A
+ * segment further than the clearance from the box can't collide, so the results are the same.
+ *
+ * Packed arrays of SEGs are screened the same way, and FirstHit() and MinSquaredDistance()
+ * give the usual answers of a search of them.
+ */
+class SEG_BATCH
+{
+public:
+    /// Number of segments screened per call of BoxMask()
+    static constexpr int BLOCK_SIZE = 64;
+
+    /**
+     * Screen the \a aCount segments from aPoints[ii] to aPoints[ii + 1].
+     *
+     * @param aMask is set to 1 for the segments whose bounding box intersects the box from
+     *              \a aMin to \a aMax (inclusive), and to 0 for the others.
+     * @return the number of segments set in \a aMask.
+     */
+    static int BoxMask( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aMin,
+                        const VECTOR2I& aMax, uint8_t* aMask );
+
+    /**
+     * Screen the \a aCount segments of \a aSegs, as BoxMask() does for a polyline.
+     */
+    static int BoxMask( const SEG* aSegs, int aCount, const VECTOR2I& aMin, const VECTOR2I& aMax,
+                        uint8_t* aMask );
+
+    /**
+     * Compute the box from \a aMin to \a aMax inflated by \a aClearance, plus a unit for
+     * rounding, clamped to the coordinate range.
+     */
+    static void InflateBox( const VECTOR2I& aMin, const VECTOR2I& aMax, int aClearance,
+                            VECTOR2I& aBoxMin, VECTOR2I& aBoxMax );
+
+    /**
+     * Compute the bounding box of \a aSeg inflated by \a aClearance, as InflateBox() does.
+     */
+    static void InflateBox( const SEG& aSeg, int aClearance, VECTOR2I& aBoxMin,
+                            VECTOR2I& aBoxMax );
+
+    /**
+     * Find the first of the \a aCount segments of \a aSegs colliding with \a aSeg, as
+     * SEG::Collide() tests them.
+     *
+     * @param aActual is set to the distance to the segment found, if any.
+     * @return the index of the segment found, or -1 if none collides.
+     */
+    static int FirstHit( const SEG* aSegs, int aCount, const SEG& aSeg, int aClearance,
+                         int* aActual = nullptr );
+
+    /**
+     * Find the nearest of the \a aCount segments of \a aSegs to \a aSeg.
+     *
+     * Segments are screened against the box of \a aSeg inflated by the smallest distance found
+     * so far, so only the first block is searched in full.
+     *
+     * @param aIndex is set to the index of the nearest segment, or -1 if \a aCount is 0.
+     * @return the squared distance to the nearest segment, or VECTOR2I::ECOORD_MAX.
+     */
+    static SEG::ecoord MinSquaredDistance( const SEG* aSegs, int aCount, const SEG& aSeg,
+                                           int* aIndex = nullptr );
+
+    /**
+     * Find the nearest of the \a aCount segments of \a aSegs to \a aP.
+     *
+     * @see MinSquaredDistance( const SEG*, int, const SEG&, int* )
+     */
+    static SEG::ecoord MinSquaredDistance( const SEG* aSegs, int aCount, const VECTOR2I& aP,
+                                           int* aIndex = nullptr );
+
+    /**
+     * Call \a aVisitor( segmentIndex ) in order for each segment of the polyline through
+     * \a aPoints (closed by a segment from the last point to the first if \a aClosed) whose
+     * bounding box intersects the box from \a aMin to \a aMax, until it returns false.
+     *
+     * Segment indexes are those of SHAPE_LINE_CHAIN::CSegment().
+     *
+     * @return false if \a aVisitor stopped the search.
+     */
+    template <typename VISITOR>
+    static bool Query( const std::vector<VECTOR2I>& aPoints, bool aClosed, const VECTOR2I& aMin,
+                       const VECTOR2I& aMax, VISITOR aVisitor )
+    {
+        const int pointCount = (int) aPoints.size();
+        uint8_t   mask[BLOCK_SIZE];
+
+        for( int first = 0; first < pointCount - 1; first += BLOCK_SIZE )
+        {
+            const int count = std::min( BLOCK_SIZE, pointCount - 1 - first );
+
+            if( !BoxMask( aPoints.data() + first, count, aMin, aMax, mask ) )
+                continue;
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                if( mask[ii] && !aVisitor( first + ii ) )
+                    return false;
+            }
+        }
+
+        if( aClosed && pointCount > 0 )
+        {
+            const VECTOR2I closing[2] = { aPoints.back(), aPoints.front() };
+
+            if( BoxMask( closing, 1, aMin, aMax, mask ) && !aVisitor( pointCount - 1 ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Call \a aVisitor( index ) in order for each of the \a aCount segments of \a aSegs whose
+     * bounding box intersects the box from \a aMin to \a aMax, until it returns false.
+     *
+     * @return false if \a aVisitor stopped the search.
+     */
+    template <typename VISITOR>
+    static bool Query( const SEG* aSegs, int aCount, const VECTOR2I& aMin, const VECTOR2I& aMax,
+                       VISITOR aVisitor )
+    {
+        uint8_t mask[BLOCK_SIZE];
+
+        for( int first = 0; first < aCount; first += BLOCK_SIZE )
+        {
+            const int count = std::min( BLOCK_SIZE, aCount - first );
+
+            if( !BoxMask( aSegs + first, count, aMin, aMax, mask ) )
+                continue;
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                if( mask[ii] && !aVisitor( first + ii ) )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif // __SEG_BATCH_H
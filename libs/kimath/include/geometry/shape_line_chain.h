@@ -27,6 +27,9 @@
 #define __SHAPE_LINE_CHAIN
 
 
+#include <atomic>
+#include <memory>
+
 #include <clipper.hpp>
 #include <clipper2/clipper.h>
 #include <geometry/seg.h>
@@ -35,6 +38,8 @@
 #include <geometry/corner_strategy.h>
 #include <math/vector2d.h>
 
+class BOX_TREE;
+
 /**
  * Holds information on each point of a SHAPE_LINE_CHAIN that is retrievable
  * after an operation with ClipperLib
@@ -169,7 +174,9 @@ public:
             m_closed( aShape.m_closed ),
             m_width( aShape.m_width ),
             m_bbox( aShape.m_bbox )
-    {}
+    {
+        // The segment index isn't copied; the copy builds its own if it's searched enough
+    }
 
     SHAPE_LINE_CHAIN( const std::vector<int>& aV );
 
@@ -201,8 +208,7 @@ public:
                       const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                       const std::vector<SHAPE_ARC>& aArcBuffer );
 
-    virtual ~SHAPE_LINE_CHAIN()
-    {}
+    virtual ~SHAPE_LINE_CHAIN();
 
     /**
      * Check if point \a aP lies closer to us than \a aClearance.
@@ -234,7 +240,28 @@ public:
     virtual bool Collide( const SEG& aSeg, int aClearance = 0, int* aActual = nullptr,
                           VECTOR2I* aLocation = nullptr ) const override;
 
-    SHAPE_LINE_CHAIN& operator=( const SHAPE_LINE_CHAIN& ) = default;
+    SHAPE_LINE_CHAIN& operator=( const SHAPE_LINE_CHAIN& aOther )
+    {
+        SHAPE_LINE_CHAIN_BASE::operator=( aOther );
+        m_points = aOther.m_points;
+        m_shapes = aOther.m_shapes;
+        m_arcs = aOther.m_arcs;
+        m_closed = aOther.m_closed;
+        m_width = aOther.m_width;
+        m_bbox = aOther.m_bbox;
+        invalidateEdgeIndex();
+        return *this;
+    }
+
+    /**
+     * Check if point \a aPt lies inside the closed chain, with the same result as
+     * SHAPE_LINE_CHAIN_BASE::PointInside().
+     *
+     * Chains with at least ADVANCED_CFG::m_LineChainIndexMinSegments segments which are
+     * searched repeatedly use an index of their segments, dropped when they change.
+     */
+    bool PointInside( const VECTOR2I& aPt, int aAccuracy = 0,
+                      bool aUseBBoxCache = false ) const override;
 
     SHAPE* Clone() const override;
 
@@ -247,6 +274,7 @@ public:
         m_arcs.clear();
         m_shapes.clear();
         m_closed = false;
+        invalidateEdgeIndex();
     }
 
     /**
@@ -258,6 +286,7 @@ public:
     void SetClosed( bool aClosed )
     {
         m_closed = aClosed;
+        invalidateEdgeIndex();
         mergeFirstLastPointIfNeeded();
     }
 
@@ -516,6 +545,7 @@ public:
 
         if( m_points.size() == 0 || aAllowDuplication || CPoint( -1 ) != aP )
         {
+            invalidateEdgeIndex();
             m_points.push_back( aP );
             m_shapes.push_back( SHAPES_ARE_PT );
             m_bbox.Merge( aP );
@@ -740,6 +770,8 @@ public:
 
     void Move( const VECTOR2I& aVector ) override
     {
+        invalidateEdgeIndex();
+
         for( auto& pt : m_points )
             pt += aVector;
 
@@ -976,12 +1008,31 @@ protected:
      */
     void mergeFirstLastPointIfNeeded();
 
+    /**
+     * Return the index of the segments, building it if needed, or nullptr to search them
+     * linearly: for chains too short to be worth indexing and for the first
+     * EDGE_INDEX_MIN_SEARCHES searches, so that chains searched only once or twice don't pay for
+     * building it.
+     */
+    const BOX_TREE* edgeIndex() const;
+
+    /**
+     * Drop the segment index.  Must be called by everything changing the points or closing.
+     */
+    void invalidateEdgeIndex();
+
 private:
 
     static const ssize_t SHAPE_IS_PT;
 
     static const std::pair<ssize_t, ssize_t> SHAPES_ARE_PT;
 
+    /// Building the index costs about as much as this many linear searches.
+    static constexpr int EDGE_INDEX_MIN_SEARCHES = 8;
+
+    /// m_edgeSearches of chains too short to index
+    static constexpr int EDGE_INDEX_NEVER = -1;
+
     /// array of vertices
     std::vector<VECTOR2I> m_points;
 
@@ -1015,6 +1066,13 @@ private:
 
     /// cached bounding box
     mutable BOX2I m_bbox;
+
+    /// Segment index for PointInside() and Collide(), built on demand and owned by the chain.
+    /// It's only set atomically, so const methods may be called from several threads.
+    mutable std::atomic<const BOX_TREE*> m_edgeIndex{ nullptr };
+
+    /// Number of linear searches since the last change (or EDGE_INDEX_NEVER), see edgeIndex()
+    mutable std::atomic<int> m_edgeSearches{ 0 };
 };
 
 
@@ -28,6 +28,7 @@
 #ifndef __SHAPE_POLY_SET_H
 #define __SHAPE_POLY_SET_H
 
+#include <atomic>
 #include <cstdio>
 #include <deque>                        // for deque
 #include <iosfwd>                       // for string, stringstream
@@ -47,6 +48,8 @@
 #include <math/vector2d.h>              // for VECTOR2I
 #include <md5_hash.h>
 
+class SHAPE_POLY_SET_BVH;
+
 
 /**
  * Represent a set of closed polygons. Polygons may be nonconvex, self-intersecting
@@ -1003,6 +1006,28 @@ public:
     void BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                               POLYGON_MODE aFastMode );
 
+    /**
+     * Perform boolean polyset union, difference or intersection like BooleanAdd(),
+     * BooleanSubtract() and BooleanIntersection(), for very large polysets such as a copper
+     * pour less thousands of clearance holes.
+     *
+     * The extents of the result are split by a grid of tiles, which are computed in parallel on
+     * the task scheduler.  The pieces meeting along the tile boundaries are then merged back.
+     * Polysets of fewer than ADVANCED_CFG::m_PolygonTileVertices vertices per tile, polysets
+     * with arcs and the legacy Clipper engine use the untiled operation.
+     *
+     * Edges crossing the tile boundaries are kept whole, but the intersections on them are
+     * found from the part of the edge within each tile and may be a unit off.  The outlines
+     * may also start at different vertices and be in a different order.
+     */
+    void BooleanAddTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode );
+
+    /// Tiled BooleanSubtract(), see BooleanAddTiled()
+    void BooleanSubtractTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode );
+
+    /// Tiled BooleanIntersection(), see BooleanAddTiled()
+    void BooleanIntersectionTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode );
+
     /**
     * Extract all contours from this polygon set, then recreate polygons with holes.
     * Essentially XOR'ing, but faster. Self-intersecting polygons are not supported.
@@ -1032,6 +1057,19 @@ public:
         Inflate( -aAmount, aCornerStrategy, aMaxError );
     }
 
+    /**
+     * Tiled Inflate() (without simplification), see BooleanAddTiled().
+     *
+     * Each tile is offset from the outlines within reach of it, and the offset is then clipped
+     * back to the tile.
+     */
+    void InflateTiled( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError );
+
+    void DeflateTiled( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError )
+    {
+        InflateTiled( -aAmount, aCornerStrategy, aMaxError );
+    }
+
     /**
      * Perform offsetting of a line chain. Replaces this polygon set with the result.
      *
@@ -1078,6 +1116,9 @@ public:
     /// For \a aFastMode meaning, see function booleanOp
     void Simplify( POLYGON_MODE aFastMode );
 
+    /// Tiled Simplify(), see BooleanAddTiled()
+    void SimplifyTiled( POLYGON_MODE aFastMode );
+
     /**
      * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s).
      *
@@ -1217,7 +1258,9 @@ public:
                       bool aUseBBoxCache = false ) const override;
 
     /**
-     * Construct BBoxCaches for Contains(), below.
+     * Construct BBoxCaches for Contains(), below.  For large polygon sets Contains() also uses
+     * an index of the edges, so that it only has to look at a few of them; that is (re)built
+     * by the first call to Contains() which follows.
      *
      * @note These caches **must** be built before a group of calls to Contains().  They are
      *       **not** kept up-to-date by editing actions.
@@ -1477,6 +1520,21 @@ private:
     void booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
                     const SHAPE_POLY_SET& aOtherShape );
 
+    /**
+     * Tiled booleanOp(), see BooleanAddTiled().
+     *
+     * @return false (leaving the polyset untouched) if the operation shouldn't be tiled.
+     */
+    bool booleanOpTiled( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOtherShape );
+
+    /// Tiled inflate2(), without simplification.  See booleanOpTiled().
+    bool inflateTiled( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy );
+
+    /// Replace the polygons by the results of a tiled operation (outlines followed by holes)
+    void importTiles( std::vector<Clipper2Lib::Paths64>&  aPolygons,
+                      const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
+                      const std::vector<SHAPE_ARC>&       aArcBuffer );
+
     /**
      * Check whether the point \a aP is inside the \a aSubpolyIndex-th polygon of the polyset. If
      * the points lies on an edge, the polygon is considered to contain it.
@@ -1526,12 +1584,25 @@ private:
 
     MD5_HASH checksum() const;
 
+    /// Return the BVH over the triangles, building it if needed.  The triangulation must be
+    /// up to date.  Returns nullptr for sets too small to be worth indexing.
+    std::shared_ptr<const SHAPE_POLY_SET_BVH> triangleBVH() const;
+
 private:
     std::vector<POLYGON>                               m_polys;
     std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
 
     bool     m_triangulationValid = false;
     MD5_HASH m_hash;
+
+    /// Index of the edges, built by Contains(), and of the triangles, built by Collide().  They
+    /// are kept apart so that alternating calls don't replace each other's index.  Both are
+    /// shared by copies and replaced (atomically, as those are const) rather than modified.
+    mutable std::shared_ptr<const SHAPE_POLY_SET_BVH> m_edgeBVH;
+    mutable std::shared_ptr<const SHAPE_POLY_SET_BVH> m_triangleBVH;
+
+    /// Set by BuildBBoxCaches(): the next Contains() must rebuild m_edgeBVH.
+    mutable std::atomic<bool> m_edgeBVHStale = false;
 };
 
 #endif // __SHAPE_POLY_SET_H
@@ -0,0 +1,120 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __SHAPE_POLY_SET_BVH_H
+#define __SHAPE_POLY_SET_BVH_H
+
+#include <vector>
+
+#include <geometry/box_tree.h>
+#include <geometry/seg.h>
+#include <math/box2.h>
+#include <math/vector2d.h>
+#include <md5_hash.h>
+
+class SHAPE_POLY_SET;
+
+
+/**
+ * A static bounding volume hierarchy over the edges of a #SHAPE_POLY_SET and, when it has an
+ * up to date triangulation, over its triangles.
+ *
+ * Built once and never modified, so it can be shared between threads and copies of the poly
+ * set.  It's only valid for the geometry (and triangulation) it was built from, which is
+ * recorded as the hash given to the constructor.
+ */
+class SHAPE_POLY_SET_BVH
+{
+public:
+    struct EDGE
+    {
+        SEG m_Seg;         ///< In the order of the contour, as the crossing test depends on it
+        int m_Polygon;
+        int m_Contour;     ///< 0 for the outline, holes from 1
+    };
+
+    /// Polygon sets with fewer edges or triangles than this are as quick to search linearly.
+    static constexpr size_t MIN_INDEXED_ITEMS = 32;
+
+    /**
+     * @param aPolySet is the poly set to index.
+     * @param aHash is the checksum of \a aPolySet.
+     * @param aWithTriangles also indexes the triangulation, which must be up to date.
+     */
+    SHAPE_POLY_SET_BVH( const SHAPE_POLY_SET& aPolySet, const MD5_HASH& aHash,
+                        bool aWithTriangles );
+
+    const MD5_HASH& GetHash() const { return m_hash; }
+
+    bool HasTriangles() const { return m_hasTriangles; }
+
+    /**
+     * Call \a aVisitor( triangulatedPolyIndex, triangleIndex ) for each triangle whose
+     * bounding box intersects \a aBox, until it returns false.
+     *
+     * @return false if \a aVisitor stopped the query.
+     */
+    template <typename VISITOR>
+    bool QueryTriangles( const BOX2I& aBox, VISITOR aVisitor ) const
+    {
+        return m_triangleTree.Query( aBox.GetOrigin(), aBox.GetEnd(),
+                                     [&]( int aItem )
+                                     {
+                                         return aVisitor( m_triangles[aItem].first,
+                                                          m_triangles[aItem].second );
+                                     } );
+    }
+
+    /**
+     * Call \a aVisitor( const EDGE& ) for each edge whose bounding box intersects the box from
+     * \a aMin to \a aMax (inclusive), until it returns false.
+     *
+     * @return false if \a aVisitor stopped the query.
+     */
+    template <typename VISITOR>
+    bool QueryEdges( const VECTOR2I& aMin, const VECTOR2I& aMax, VISITOR aVisitor ) const
+    {
+        return m_edgeTree.Query( aMin, aMax,
+                                 [&]( int aItem )
+                                 {
+                                     return aVisitor( m_edges[aItem] );
+                                 } );
+    }
+
+    /**
+     * Same result as SHAPE_POLY_SET::Contains( aP, aSubpolyIndex, aAccuracy ), but only visits
+     * the edges to the right of \a aP and, for an \a aAccuracy > 1, those close to it.
+     */
+    bool Contains( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy ) const;
+
+private:
+    MD5_HASH                         m_hash;
+    bool                             m_hasTriangles;
+
+    std::vector<EDGE>                m_edges;
+    std::vector<std::pair<int, int>> m_triangles;
+    BOX_TREE                         m_edgeTree;
+    BOX_TREE                         m_triangleTree;
+};
+
+#endif // __SHAPE_POLY_SET_BVH_H
@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/box_tree.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+
+/// Items per leaf.  Testing a few items is cheaper than descending another level.
+static constexpr int LEAF_SIZE = 4;
+
+
+void BOX_TREE::Build( const std::vector<BOX>& aBoxes )
+{
+    m_nodes.clear();
+    m_items.resize( aBoxes.size() );
+    std::iota( m_items.begin(), m_items.end(), 0 );
+
+    if( aBoxes.empty() )
+        return;
+
+    m_nodes.reserve( 2 * aBoxes.size() / LEAF_SIZE + 1 );
+    build( aBoxes, 0, (int) aBoxes.size() );
+}
+
+
+int BOX_TREE::build( const std::vector<BOX>& aBoxes, int aFirst, int aLast )
+{
+    int  nodeIdx = (int) m_nodes.size();
+    NODE node;
+
+    node.m_Box = aBoxes[m_items[aFirst]];
+
+    for( int ii = aFirst + 1; ii < aLast; ++ii )
+    {
+        const BOX& box = aBoxes[m_items[ii]];
+
+        node.m_Box.m_Min.x = std::min( node.m_Box.m_Min.x, box.m_Min.x );
+        node.m_Box.m_Min.y = std::min( node.m_Box.m_Min.y, box.m_Min.y );
+        node.m_Box.m_Max.x = std::max( node.m_Box.m_Max.x, box.m_Max.x );
+        node.m_Box.m_Max.y = std::max( node.m_Box.m_Max.y, box.m_Max.y );
+    }
+
+    if( aLast - aFirst <= LEAF_SIZE )
+    {
+        node.m_Next = aFirst;
+        node.m_Count = aLast - aFirst;
+        m_nodes.push_back( node );
+        return nodeIdx;
+    }
+
+    // Split at the median of the item centres along the longer side of the node
+    const bool alongX = (int64_t) node.m_Box.m_Max.x - node.m_Box.m_Min.x
+                        >= (int64_t) node.m_Box.m_Max.y - node.m_Box.m_Min.y;
+    const int  mid = aFirst + ( aLast - aFirst ) / 2;
+
+    auto centre =
+            [&]( int aItem ) -> int64_t
+            {
+                const BOX& box = aBoxes[aItem];
+
+                return alongX ? (int64_t) box.m_Min.x + box.m_Max.x
+                              : (int64_t) box.m_Min.y + box.m_Max.y;
+            };
+
+    std::nth_element( m_items.begin() + aFirst, m_items.begin() + mid, m_items.begin() + aLast,
+                      [&]( int aLeft, int aRight )
+                      {
+                          return centre( aLeft ) < centre( aRight );
+                      } );
+
+    node.m_Next = 0;
+    node.m_Count = 0;
+    m_nodes.push_back( node );
+
+    build( aBoxes, aFirst, mid );
+    m_nodes[nodeIdx].m_Next = build( aBoxes, mid, aLast );
+
+    return nodeIdx;
+}
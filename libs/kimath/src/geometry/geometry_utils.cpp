@@ -90,8 +90,9 @@ int CircleToEndSegmentDeltaRadius( int aRadius, int aSegCount )
 // calculations).
 // So one can disable the shape expansion within a particular scope by allocating
 // a DISABLE_ARC_CORRECTION.
+// Layers may be plotted concurrently, so the scope only covers the calling thread.
 
-static bool s_disable_arc_correction = false;
+static thread_local bool s_disable_arc_correction = false;
 
 DISABLE_ARC_RADIUS_CORRECTION::DISABLE_ARC_RADIUS_CORRECTION()
 {
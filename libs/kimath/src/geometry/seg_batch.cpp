@@ -0,0 +1,217 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/seg_batch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+
+int SEG_BATCH::BoxMask( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aMin,
+                        const VECTOR2I& aMax, uint8_t* aMask )
+{
+    const int minX = aMin.x;
+    const int minY = aMin.y;
+    const int maxX = aMax.x;
+    const int maxY = aMax.y;
+    int       hits = 0;
+
+    // Keep this free of branches and short-circuits so that it's vectorized.  This file is
+    // built with -ftree-vectorize, which GCC only enables by default from -O3.
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        const int ax = aPoints[ii].x;
+        const int ay = aPoints[ii].y;
+        const int bx = aPoints[ii + 1].x;
+        const int by = aPoints[ii + 1].y;
+
+        const bool outside = ( ( ax < minX ) & ( bx < minX ) )
+                             | ( ( ax > maxX ) & ( bx > maxX ) )
+                             | ( ( ay < minY ) & ( by < minY ) )
+                             | ( ( ay > maxY ) & ( by > maxY ) );
+
+        aMask[ii] = !outside;
+        hits += !outside;
+    }
+
+    return hits;
+}
+
+
+int SEG_BATCH::BoxMask( const SEG* aSegs, int aCount, const VECTOR2I& aMin, const VECTOR2I& aMax,
+                        uint8_t* aMask )
+{
+    const int minX = aMin.x;
+    const int minY = aMin.y;
+    const int maxX = aMax.x;
+    const int maxY = aMax.y;
+    int       hits = 0;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        const int ax = aSegs[ii].A.x;
+        const int ay = aSegs[ii].A.y;
+        const int bx = aSegs[ii].B.x;
+        const int by = aSegs[ii].B.y;
+
+        const bool outside = ( ( ax < minX ) & ( bx < minX ) )
+                             | ( ( ax > maxX ) & ( bx > maxX ) )
+                             | ( ( ay < minY ) & ( by < minY ) )
+                             | ( ( ay > maxY ) & ( by > maxY ) );
+
+        aMask[ii] = !outside;
+        hits += !outside;
+    }
+
+    return hits;
+}
+
+
+void SEG_BATCH::InflateBox( const VECTOR2I& aMin, const VECTOR2I& aMax, int aClearance,
+                            VECTOR2I& aBoxMin, VECTOR2I& aBoxMax )
+{
+    auto clamp =
+            []( int64_t aValue )
+            {
+                return (int) std::clamp<int64_t>( aValue, std::numeric_limits<int>::min(),
+                                                  std::numeric_limits<int>::max() );
+            };
+
+    // Some tests square the clearance, so a negative one may still find collisions
+    int64_t margin = std::abs( (int64_t) aClearance ) + 1;
+
+    aBoxMin = VECTOR2I( clamp( aMin.x - margin ), clamp( aMin.y - margin ) );
+    aBoxMax = VECTOR2I( clamp( aMax.x + margin ), clamp( aMax.y + margin ) );
+}
+
+
+void SEG_BATCH::InflateBox( const SEG& aSeg, int aClearance, VECTOR2I& aBoxMin,
+                            VECTOR2I& aBoxMax )
+{
+    InflateBox( VECTOR2I( std::min( aSeg.A.x, aSeg.B.x ), std::min( aSeg.A.y, aSeg.B.y ) ),
+                VECTOR2I( std::max( aSeg.A.x, aSeg.B.x ), std::max( aSeg.A.y, aSeg.B.y ) ),
+                aClearance, aBoxMin, aBoxMax );
+}
+
+
+int SEG_BATCH::FirstHit( const SEG* aSegs, int aCount, const SEG& aSeg, int aClearance,
+                         int* aActual )
+{
+    VECTOR2I boxMin, boxMax;
+    int      hit = -1;
+
+    InflateBox( aSeg, aClearance, boxMin, boxMax );
+
+    Query( aSegs, aCount, boxMin, boxMax,
+           [&]( int aIndex )
+           {
+               if( !aSegs[aIndex].Collide( aSeg, aClearance, aActual ) )
+                   return true;
+
+               hit = aIndex;
+               return false;
+           } );
+
+    return hit;
+}
+
+
+/**
+ * Search \a aSegs for the smallest of \a aDistance( segment ), screening each block against
+ * the bounding box of the query from \a aMin to \a aMax inflated by the best distance so far.
+ */
+template <typename DISTANCE>
+static SEG::ecoord minSquaredDistance( const SEG* aSegs, int aCount, const VECTOR2I& aMin,
+                                       const VECTOR2I& aMax, int* aIndex, DISTANCE aDistance )
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+    int         bestIndex = -1;
+    uint8_t     mask[SEG_BATCH::BLOCK_SIZE];
+
+    for( int first = 0; first < aCount && best > 0; first += SEG_BATCH::BLOCK_SIZE )
+    {
+        const int count = std::min( SEG_BATCH::BLOCK_SIZE, aCount - first );
+
+        if( bestIndex < 0 )
+        {
+            std::fill( mask, mask + count, 1 );
+        }
+        else
+        {
+            double   dist = std::ceil( std::sqrt( (double) best ) );
+            int      margin = (int) std::min<double>( dist, std::numeric_limits<int>::max() );
+            VECTOR2I boxMin, boxMax;
+
+            SEG_BATCH::InflateBox( aMin, aMax, margin, boxMin, boxMax );
+
+            if( !SEG_BATCH::BoxMask( aSegs + first, count, boxMin, boxMax, mask ) )
+                continue;
+        }
+
+        for( int ii = 0; ii < count; ++ii )
+        {
+            if( !mask[ii] )
+                continue;
+
+            SEG::ecoord dist_sq = aDistance( aSegs[first + ii] );
+
+            if( dist_sq < best )
+            {
+                best = dist_sq;
+                bestIndex = first + ii;
+            }
+        }
+    }
+
+    if( aIndex )
+        *aIndex = bestIndex;
+
+    return best;
+}
+
+
+SEG::ecoord SEG_BATCH::MinSquaredDistance( const SEG* aSegs, int aCount, const SEG& aSeg,
+                                           int* aIndex )
+{
+    VECTOR2I segMin( std::min( aSeg.A.x, aSeg.B.x ), std::min( aSeg.A.y, aSeg.B.y ) );
+    VECTOR2I segMax( std::max( aSeg.A.x, aSeg.B.x ), std::max( aSeg.A.y, aSeg.B.y ) );
+
+    return minSquaredDistance( aSegs, aCount, segMin, segMax, aIndex,
+                               [&]( const SEG& aOther )
+                               {
+                                   return aOther.SquaredDistance( aSeg );
+                               } );
+}
+
+
+SEG::ecoord SEG_BATCH::MinSquaredDistance( const SEG* aSegs, int aCount, const VECTOR2I& aP,
+                                           int* aIndex )
+{
+    return minSquaredDistance( aSegs, aCount, aP, aP, aIndex,
+                               [&]( const SEG& aOther )
+                               {
+                                   return aOther.SquaredDistance( aP );
+                               } );
+}
@@ -27,12 +27,14 @@
 #include <limits>
 
 #include <geometry/seg.h>                         // for SEG
+#include <geometry/seg_batch.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_circle.h>
 #include <geometry/shape_rect.h>
 #include <geometry/shape_segment.h>
+#include <geometry/shape_simple.h>
 #include <geometry/shape_compound.h>
 #include <geometry/shape_poly_set.h>
 #include <math/vector2d.h>
@@ -40,6 +42,44 @@
 typedef VECTOR2I::extended_type ecoord;
 
 
+/**
+ * Call \a aVisitor( segmentIndex ) for the segments of \a aChain which may lie within
+ * \a aClearance of \a aBox, in order, until it returns false.
+ *
+ * Line chains and simple polygons keep their points packed, so SEG_BATCH screens them; other
+ * line chain shapes visit all their segments.
+ */
+template <typename VISITOR>
+static void forEachSegmentNear( const SHAPE_LINE_CHAIN_BASE& aChain, const BOX2I& aBox,
+                                int aClearance, VISITOR aVisitor )
+{
+    const SHAPE_LINE_CHAIN* points = nullptr;
+
+    if( aChain.Type() == SH_LINE_CHAIN )
+        points = static_cast<const SHAPE_LINE_CHAIN*>( &aChain );
+    else if( aChain.Type() == SH_SIMPLE )
+        points = &static_cast<const SHAPE_SIMPLE&>( aChain ).Vertices();
+
+    if( points )
+    {
+        BOX2I    box = aBox;
+        VECTOR2I boxMin, boxMax;
+
+        box.Normalize();
+        SEG_BATCH::InflateBox( box.GetOrigin(), box.GetEnd(), aClearance, boxMin, boxMax );
+        SEG_BATCH::Query( points->CPoints(), points->IsClosed(), boxMin, boxMax, aVisitor );
+    }
+    else
+    {
+        for( size_t s = 0; s < aChain.GetSegmentCount(); s++ )
+        {
+            if( !aVisitor( (int) s ) )
+                break;
+        }
+    }
+}
+
+
 static inline bool Collide( const SHAPE_CIRCLE& aA, const SHAPE_CIRCLE& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
@@ -202,29 +242,32 @@ static inline bool Collide( const SHAPE_CIRCLE& aA, const SHAPE_LINE_CHAIN_BASE&
     }
     else
     {
-        for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
-        {
-            int collision_dist = 0;
-            VECTOR2I pn;
-
-            if( aA.Collide( aB.GetSegment( s ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
+        forEachSegmentNear( aB, aA.BBox(), aClearance,
+                [&]( int s )
                 {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+                    int collision_dist = 0;
+                    VECTOR2I pn;
 
-                if( closest_dist == 0 )
-                    break;
+                    if( aA.Collide( aB.GetSegment( s ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
-                    break;
-            }
-        }
+                    return true;
+                } );
     }
 
     if( closest_dist == 0 || closest_dist < aClearance )
@@ -304,38 +347,54 @@ static inline bool Collide( const SHAPE_LINE_CHAIN_BASE& aA, const SHAPE_LINE_CH
     }
     else
     {
-        for( size_t i = 0; i < aB.GetSegmentCount(); i++ )
-        {
-            int collision_dist = 0;
-            VECTOR2I pn;
+        // aA.Collide() also tests the true arcs of line chains, which may bulge out of the
+        // bounding box of their points
+        BOX2I bboxA = aA.BBox();
 
-            if( aB.Type() == SH_LINE_CHAIN )
-            {
-                const SHAPE_LINE_CHAIN* aB_line_chain = static_cast<const SHAPE_LINE_CHAIN*>( &aB );
+        if( aA.Type() == SH_LINE_CHAIN )
+        {
+            const SHAPE_LINE_CHAIN* aA_line_chain = static_cast<const SHAPE_LINE_CHAIN*>( &aA );
 
-                // ignore arcs - we will collide these separately
-                if( aB_line_chain->IsArcSegment( i ) )
-                    continue;
-            }
+            for( size_t i = 0; i < aA_line_chain->ArcCount(); i++ )
+                bboxA.Merge( aA_line_chain->Arc( i ).BBox() );
+        }
 
-            if( aA.Collide( aB.GetSegment( i ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
+        forEachSegmentNear( aB, bboxA, aClearance,
+                [&]( int i )
                 {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+                    int collision_dist = 0;
+                    VECTOR2I pn;
 
-                if( closest_dist == 0 )
-                    break;
+                    if( aB.Type() == SH_LINE_CHAIN )
+                    {
+                        const SHAPE_LINE_CHAIN* aB_line_chain =
+                                static_cast<const SHAPE_LINE_CHAIN*>( &aB );
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
-                    break;
-            }
-        }
+                        // ignore arcs - we will collide these separately
+                        if( aB_line_chain->IsArcSegment( i ) )
+                            return true;
+                    }
+
+                    if( aA.Collide( aB.GetSegment( i ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
+
+                    return true;
+                } );
 
         if( aB.Type() == SH_LINE_CHAIN )
         {
@@ -386,29 +445,32 @@ static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_LINE_CHAIN_BASE& a
     }
     else
     {
-        for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
-        {
-            int collision_dist = 0;
-            VECTOR2I pn;
-
-            if( aA.Collide( aB.GetSegment( s ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
+        forEachSegmentNear( aB, aA.BBox(), aClearance,
+                [&]( int s )
                 {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+                    int collision_dist = 0;
+                    VECTOR2I pn;
 
-                if( closest_dist == 0 )
-                    break;
+                    if( aA.Collide( aB.GetSegment( s ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
-                    break;
-            }
-        }
+                    return true;
+                } );
     }
 
     if( closest_dist == 0 || closest_dist < aClearance )
@@ -540,33 +602,36 @@ static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN& aB, int
     }
     else
     {
-        for( size_t i = 0; i < aB.GetSegmentCount(); i++ )
-        {
-            int      collision_dist = 0;
-            VECTOR2I pn;
-
-            // ignore arcs - we will collide these separately
-            if( aB.IsArcSegment( i ) )
-                continue;
-
-            if( aA.Collide( aB.GetSegment( i ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
+        forEachSegmentNear( aB, aA.BBox( aA.GetWidth() / 2 ), aClearance,
+                [&]( int i )
                 {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+                    int      collision_dist = 0;
+                    VECTOR2I pn;
 
-                if( closest_dist == 0 )
-                    break;
+                    // ignore arcs - we will collide these separately
+                    if( aB.IsArcSegment( i ) )
+                        return true;
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
-                    break;
-            }
-        }
+                    if( aA.Collide( aB.GetSegment( i ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
+
+                    return true;
+                } );
 
         for( size_t i = 0; i < aB.ArcCount(); i++ )
         {
@@ -630,29 +695,32 @@ static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN_BASE& aB
     }
     else
     {
-        for( size_t i = 0; i < aB.GetSegmentCount(); i++ )
-        {
-            int      collision_dist = 0;
-            VECTOR2I pn;
-
-            if( aA.Collide( aB.GetSegment( i ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
+        forEachSegmentNear( aB, aA.BBox( aA.GetWidth() / 2 ), aClearance,
+                [&]( int i )
                 {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+                    int      collision_dist = 0;
+                    VECTOR2I pn;
 
-                if( closest_dist == 0 )
-                    break;
+                    if( aA.Collide( aB.GetSegment( i ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
-                    break;
-            }
-        }
+                    return true;
+                } );
     }
 
     if( closest_dist == 0 || closest_dist < aClearance )
@@ -27,12 +27,16 @@
 #include <limits>
 #include <math.h>            // for hypot
 #include <map>
+#include <memory>
 #include <string>            // for basic_string
 
+#include <advanced_config.h>
 #include <clipper.hpp>
 #include <clipper2/clipper.h>
 #include <core/kicad_algo.h> // for alg::run_on_pair
+#include <geometry/box_tree.h>
 #include <geometry/seg.h>    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <math/box2.h>       // for BOX2I
@@ -45,6 +49,7 @@ class SHAPE;
 const ssize_t                     SHAPE_LINE_CHAIN::SHAPE_IS_PT = -1;
 const std::pair<ssize_t, ssize_t> SHAPE_LINE_CHAIN::SHAPES_ARE_PT = { SHAPE_IS_PT, SHAPE_IS_PT };
 
+
 SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const std::vector<int>& aV)
     : SHAPE_LINE_CHAIN_BASE( SH_LINE_CHAIN ), m_closed( false ), m_width( 0 )
 {
@@ -213,6 +218,8 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
 
 void SHAPE_LINE_CHAIN::fixIndicesRotation()
 {
+    invalidateEdgeIndex();
+
     wxCHECK( m_shapes.size() == m_points.size(), /*void*/ );
 
     if( m_shapes.size() <= 1 || m_arcs.size() <= 1 )
@@ -237,6 +244,8 @@ void SHAPE_LINE_CHAIN::fixIndicesRotation()
 
 void SHAPE_LINE_CHAIN::mergeFirstLastPointIfNeeded()
 {
+    invalidateEdgeIndex();
+
     if( m_closed )
     {
         if( m_points.size() > 1 && m_points.front() == m_points.back() )
@@ -304,6 +313,8 @@ void SHAPE_LINE_CHAIN::amendArc( size_t aArcIndex, const VECTOR2I& aNewStart,
 
 void SHAPE_LINE_CHAIN::splitArc( ssize_t aPtIndex, bool aCoincident )
 {
+    invalidateEdgeIndex();
+
     if( aPtIndex < 0 )
         aPtIndex += m_shapes.size();
 
@@ -454,29 +465,41 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    // Collide line segments.  Return false to stop looking.
+    auto collideSegment =
+            [&]( int i )
+            {
+                if( IsArcSegment( i ) )
+                    return true;
 
-        const SEG&  s = GetSegment( i );
-        VECTOR2I    pn = s.NearestPoint( aP );
-        SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
+                const SEG&  s = CSegment( i );
+                VECTOR2I    pn = s.NearestPoint( aP );
+                SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
-        if( dist_sq < closest_dist_sq )
-        {
-            nearest = pn;
-            closest_dist_sq = dist_sq;
+                if( dist_sq < closest_dist_sq )
+                {
+                    nearest = pn;
+                    closest_dist_sq = dist_sq;
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return false;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
-    }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return false;
+                }
+
+                return true;
+            };
+
+    VECTOR2I boxMin, boxMax;
+
+    SEG_BATCH::InflateBox( aP, aP, aClearance, boxMin, boxMax );
+
+    if( const BOX_TREE* index = edgeIndex() )
+        index->Query( boxMin, boxMax, collideSegment );
+    else
+        SEG_BATCH::Query( m_points, m_closed, boxMin, boxMax, collideSegment );
 
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
@@ -507,6 +530,8 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
 
 void SHAPE_LINE_CHAIN::Rotate( const EDA_ANGLE& aAngle, const VECTOR2I& aCenter )
 {
+    invalidateEdgeIndex();
+
     for( VECTOR2I& pt : m_points )
         RotatePoint( pt, aCenter, aAngle );
 
@@ -587,30 +612,42 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    // Collide line segments.  Return false to stop looking.
+    auto collideSegment =
+            [&]( int i )
+            {
+                if( IsArcSegment( i ) )
+                    return true;
 
-        const SEG&  s = GetSegment( i );
-        SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
+                const SEG&  s = CSegment( i );
+                SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
-        if( dist_sq < closest_dist_sq )
-        {
-            if( aLocation )
-                nearest = s.NearestPoint( aSeg );
+                if( dist_sq < closest_dist_sq )
+                {
+                    if( aLocation )
+                        nearest = s.NearestPoint( aSeg );
 
-            closest_dist_sq = dist_sq;
+                    closest_dist_sq = dist_sq;
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return false;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
-    }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return false;
+                }
+
+                return true;
+            };
+
+    VECTOR2I boxMin, boxMax;
+
+    SEG_BATCH::InflateBox( aSeg, aClearance, boxMin, boxMax );
+
+    if( const BOX_TREE* index = edgeIndex() )
+        index->Query( boxMin, boxMax, collideSegment );
+    else
+        SEG_BATCH::Query( m_points, m_closed, boxMin, boxMax, collideSegment );
 
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
@@ -639,10 +676,131 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
 }
 
 
+bool SHAPE_LINE_CHAIN::PointInside( const VECTOR2I& aPt, int aAccuracy,
+                                    bool aUseBBoxCache ) const
+{
+    if( !IsClosed() || PointCount() < 3 )
+        return false;
+
+    const BOX_TREE* index = edgeIndex();
+
+    if( !index )
+        return SHAPE_LINE_CHAIN_BASE::PointInside( aPt, aAccuracy, aUseBBoxCache );
+
+    if( aUseBBoxCache && !GetCachedBBox()->Contains( aPt ) )
+        return false;
+
+    // The same crossing test as SHAPE_LINE_CHAIN_BASE::PointInside(), but only the edges
+    // spanning aPt.y to the right of aPt can cross the ray.
+    bool inside = false;
+
+    index->Query( aPt, VECTOR2I( std::numeric_limits<int>::max(), aPt.y ),
+                  [&]( int aSegment )
+                  {
+                      const VECTOR2I& p1 = m_points[aSegment];
+                      const VECTOR2I& p2 = m_points[aSegment + 1 == PointCount() ? 0
+                                                                                  : aSegment + 1];
+                      const VECTOR2I  diff = p2 - p1;
+
+                      if( diff.y != 0 )
+                      {
+                          const int d = rescale( diff.x, ( aPt.y - p1.y ), diff.y );
+
+                          if( ( ( p1.y > aPt.y ) != ( p2.y > aPt.y ) ) && ( aPt.x - p1.x < d ) )
+                              inside = !inside;
+                      }
+
+                      return true;
+                  } );
+
+    if( inside || aAccuracy <= 1 )
+        return inside;
+
+    // PointOnEdge( aPt, aAccuracy ), searching only the nearby edges
+    VECTOR2I boxMin, boxMax;
+
+    SEG_BATCH::InflateBox( aPt, aPt, aAccuracy, boxMin, boxMax );
+
+    return !index->Query( boxMin, boxMax,
+                          [&]( int aSegment )
+                          {
+                              const SEG s = CSegment( aSegment );
+
+                              return !( s.A == aPt || s.B == aPt
+                                        || s.Distance( aPt ) <= aAccuracy + 1 );
+                          } );
+}
+
+
+SHAPE_LINE_CHAIN::~SHAPE_LINE_CHAIN()
+{
+    delete m_edgeIndex.load();
+}
+
+
+void SHAPE_LINE_CHAIN::invalidateEdgeIndex()
+{
+    delete m_edgeIndex.exchange( nullptr );
+    m_edgeSearches.store( 0, std::memory_order_relaxed );
+}
+
+
+const BOX_TREE* SHAPE_LINE_CHAIN::edgeIndex() const
+{
+    if( const BOX_TREE* index = m_edgeIndex.load( std::memory_order_acquire ) )
+        return index;
+
+    int searches = m_edgeSearches.load( std::memory_order_relaxed );
+
+    if( searches == EDGE_INDEX_NEVER )
+        return nullptr;
+
+    if( searches < EDGE_INDEX_MIN_SEARCHES )
+    {
+        m_edgeSearches.fetch_add( 1, std::memory_order_relaxed );
+        return nullptr;
+    }
+
+    // Only read once per chain (until it changes) rather than for every search
+    if( SegmentCount() < ADVANCED_CFG::GetCfg().m_LineChainIndexMinSegments )
+    {
+        m_edgeSearches.store( EDGE_INDEX_NEVER, std::memory_order_relaxed );
+        return nullptr;
+    }
+
+    std::vector<BOX_TREE::BOX> boxes;
+
+    boxes.reserve( SegmentCount() );
+
+    for( int ii = 0; ii < SegmentCount(); ++ii )
+    {
+        const SEG seg = CSegment( ii );
+
+        boxes.push_back( { VECTOR2I( std::min( seg.A.x, seg.B.x ), std::min( seg.A.y, seg.B.y ) ),
+                           VECTOR2I( std::max( seg.A.x, seg.B.x ),
+                                     std::max( seg.A.y, seg.B.y ) ) } );
+    }
+
+    BOX_TREE* newIndex = new BOX_TREE();
+
+    newIndex->Build( boxes );
+
+    // Concurrent searches may each build one; keep the first stored.
+    const BOX_TREE* stored = nullptr;
+
+    if( m_edgeIndex.compare_exchange_strong( stored, newIndex, std::memory_order_acq_rel ) )
+        return newIndex;
+
+    delete newIndex;
+    return stored;
+}
+
+
 const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
 {
     SHAPE_LINE_CHAIN a( *this );
 
+    a.invalidateEdgeIndex();
     reverse( a.m_points.begin(), a.m_points.end() );
     reverse( a.m_shapes.begin(), a.m_shapes.end() );
     reverse( a.m_arcs.begin(), a.m_arcs.end() );
@@ -705,6 +863,8 @@ long long int SHAPE_LINE_CHAIN::Length() const
 
 void SHAPE_LINE_CHAIN::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
+    invalidateEdgeIndex();
+
     for( auto& pt : m_points )
     {
         if( aX )
@@ -721,6 +881,8 @@ void SHAPE_LINE_CHAIN::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 
 void SHAPE_LINE_CHAIN::Mirror( const SEG& axis )
 {
+    invalidateEdgeIndex();
+
     for( auto& pt : m_points )
         pt = axis.ReflectPoint( pt );
 
@@ -739,6 +901,8 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const VECTOR2I&
 
 void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE_CHAIN& aLine )
 {
+    invalidateEdgeIndex();
+
     if( aEndIndex < 0 )
         aEndIndex += PointCount();
 
@@ -809,6 +973,8 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
 
 void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
 {
+    invalidateEdgeIndex();
+
     assert( m_shapes.size() == m_points.size() );
 
     if( aEndIndex < 0 )
@@ -892,6 +1058,8 @@ SEG::ecoord SHAPE_LINE_CHAIN_BASE::SquaredDistance( const VECTOR2I& aP, bool aOu
 
 int SHAPE_LINE_CHAIN::Split( const VECTOR2I& aP, bool aExact )
 {
+    invalidateEdgeIndex();
+
     int ii = -1;
     int min_dist = 2;
 
@@ -1089,6 +1257,8 @@ int SHAPE_LINE_CHAIN::NextShape( int aPointIndex, bool aForwards ) const
 
 void SHAPE_LINE_CHAIN::SetPoint( int aIndex, const VECTOR2I& aPos )
 {
+    invalidateEdgeIndex();
+
     if( aIndex < 0 )
         aIndex += PointCount();
     else if( aIndex >= PointCount() )
@@ -1257,6 +1427,8 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Slice( int aStartIndex, int aEndIndex )
 
 void SHAPE_LINE_CHAIN::Append( const SHAPE_LINE_CHAIN& aOtherLine )
 {
+    invalidateEdgeIndex();
+
     assert( m_shapes.size() == m_points.size() );
 
     if( aOtherLine.PointCount() == 0 )
@@ -1329,6 +1501,8 @@ void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc )
 
 void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc, double aAccuracy )
 {
+    invalidateEdgeIndex();
+
     SEG startToEnd( aArc.GetP0(), aArc.GetP1() );
 
     if( startToEnd.Distance( aArc.GetArcMid() ) < 1 )
@@ -1357,6 +1531,8 @@ void SHAPE_LINE_CHAIN::Append( const SHAPE_ARC& aArc, double aAccuracy )
 
 void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const VECTOR2I& aP )
 {
+    invalidateEdgeIndex();
+
     if( aVertex == m_points.size() )
     {
         Append( aP );
@@ -1378,6 +1554,8 @@ void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const VECTOR2I& aP )
 
 void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const SHAPE_ARC& aArc )
 {
+    invalidateEdgeIndex();
+
     wxCHECK( aVertex < m_points.size(), /* void */ );
 
     if( aVertex > 0 && IsPtOnArc( aVertex ) )
@@ -1768,6 +1946,8 @@ const std::optional<SHAPE_LINE_CHAIN::INTERSECTION> SHAPE_LINE_CHAIN::SelfInters
 
 SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify( bool aRemoveColinear )
 {
+    invalidateEdgeIndex();
+
     std::vector<VECTOR2I> pts_unique;
     std::vector<std::pair<ssize_t, ssize_t>> shapes_unique;
 
@@ -2036,6 +2216,8 @@ SHAPE* SHAPE_LINE_CHAIN::Clone() const
 
 bool SHAPE_LINE_CHAIN::Parse( std::stringstream& aStream )
 {
+    invalidateEdgeIndex();
+
     size_t n_pts;
     size_t n_arcs;
 
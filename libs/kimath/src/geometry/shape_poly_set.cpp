@@ -50,6 +50,7 @@
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_poly_set_bvh.h>
 #include <math/box2.h>                       // for BOX2I
 #include <math/util.h>                       // for KiROUND, rescale
 #include <math/vector2d.h>                   // for VECTOR2I, VECTOR2D, VECTOR2
@@ -98,7 +99,9 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const POLYGON& aPolygon ) :
 
 SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
     SHAPE( aOther ),
-    m_polys( aOther.m_polys )
+    m_polys( aOther.m_polys ),
+    m_edgeBVH( std::atomic_load( &aOther.m_edgeBVH ) ),
+    m_edgeBVHStale( aOther.m_edgeBVHStale.load() )
 {
     if( aOther.IsTriangulationUpToDate() )
     {
@@ -112,6 +115,7 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
 
         m_hash = aOther.GetHash();
         m_triangulationValid = true;
+        m_triangleBVH = std::atomic_load( &aOther.m_triangleBVH );
     }
     else
     {
@@ -1032,6 +1036,36 @@ void SHAPE_POLY_SET::BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET&
 }
 
 
+void SHAPE_POLY_SET::BooleanAddTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
+{
+    if( !ADVANCED_CFG::GetCfg().m_UseClipper2
+            || !booleanOpTiled( Clipper2Lib::ClipType::Union, b ) )
+    {
+        BooleanAdd( b, aFastMode );
+    }
+}
+
+
+void SHAPE_POLY_SET::BooleanSubtractTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
+{
+    if( !ADVANCED_CFG::GetCfg().m_UseClipper2
+            || !booleanOpTiled( Clipper2Lib::ClipType::Difference, b ) )
+    {
+        BooleanSubtract( b, aFastMode );
+    }
+}
+
+
+void SHAPE_POLY_SET::BooleanIntersectionTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
+{
+    if( !ADVANCED_CFG::GetCfg().m_UseClipper2
+            || !booleanOpTiled( Clipper2Lib::ClipType::Intersection, b ) )
+    {
+        BooleanIntersection( b, aFastMode );
+    }
+}
+
+
 void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, CORNER_STRATEGY aCornerStrategy,
                                              int aMaxError, POLYGON_MODE aFastMode )
 {
@@ -1345,6 +1379,18 @@ void SHAPE_POLY_SET::Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int
 }
 
 
+void SHAPE_POLY_SET::InflateTiled( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError )
+{
+    int segCount = GetArcToSegmentCount( std::abs( aAmount ), aMaxError, FULL_CIRCLE );
+
+    if( !ADVANCED_CFG::GetCfg().m_UseClipper2
+            || !inflateTiled( aAmount, segCount, aCornerStrategy ) )
+    {
+        Inflate( aAmount, aCornerStrategy, aMaxError );
+    }
+}
+
+
 void SHAPE_POLY_SET::OffsetLineChain( const SHAPE_LINE_CHAIN& aLine, int aAmount,
                                   CORNER_STRATEGY aCornerStrategy, int aMaxError, bool aSimplify )
 {
@@ -1874,6 +1920,18 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+void SHAPE_POLY_SET::SimplifyTiled( POLYGON_MODE aFastMode )
+{
+    SHAPE_POLY_SET empty;
+
+    if( !ADVANCED_CFG::GetCfg().m_UseClipper2
+            || !booleanOpTiled( Clipper2Lib::ClipType::Union, empty ) )
+    {
+        Simplify( aFastMode );
+    }
+}
+
+
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
     // We are expecting only one main outline, but this main outline can have holes
@@ -2136,27 +2194,60 @@ bool SHAPE_POLY_SET::Collide( const SHAPE* aShape, int aClearance, int* aActual,
     int      actual = INT_MAX;
     VECTOR2I location;
 
-    for( const std::unique_ptr<TRIANGULATED_POLYGON>& tpoly : m_triangulatedPolys )
-    {
-        for( const TRIANGULATED_POLYGON::TRI& tri : tpoly->Triangles() )
-        {
-            if( aActual || aLocation )
+    // Return false if there's no need to look any further
+    auto collideTriangle =
+            [&]( const TRIANGULATED_POLYGON::TRI& tri )
             {
-                int      triActual;
-                VECTOR2I triLocation;
-
-                if( aShape->Collide( &tri, aClearance, &triActual, &triLocation ) )
+                if( aActual || aLocation )
                 {
-                    if( triActual < actual )
+                    int      triActual;
+                    VECTOR2I triLocation;
+
+                    if( aShape->Collide( &tri, aClearance, &triActual, &triLocation ) )
                     {
-                        actual = triActual;
-                        location = triLocation;
+                        if( triActual < actual )
+                        {
+                            actual = triActual;
+                            location = triLocation;
+                        }
                     }
+
+                    return true;
                 }
-            }
-            else    // A much faster version of above
+                else    // A much faster version of above
+                {
+                    return !aShape->Collide( &tri, aClearance );
+                }
+            };
+
+    std::shared_ptr<const SHAPE_POLY_SET_BVH> bvh;
+
+    if( m_triangulationValid )
+        bvh = triangleBVH();
+
+    if( bvh )
+    {
+        // Only triangles within the clearance of aShape's bounding box can collide with it
+        BOX2I box = aShape->BBox( aClearance + 1 );
+
+        box.Normalize();
+
+        bool stopped = !bvh->QueryTriangles( box,
+                [&]( int aPolyIdx, int aTriIdx )
+                {
+                    return collideTriangle( m_triangulatedPolys[aPolyIdx]->Triangles()[aTriIdx] );
+                } );
+
+        if( stopped )
+            return true;
+    }
+    else
+    {
+        for( const std::unique_ptr<TRIANGULATED_POLYGON>& tpoly : m_triangulatedPolys )
+        {
+            for( const TRIANGULATED_POLYGON::TRI& tri : tpoly->Triangles() )
             {
-                if( aShape->Collide( &tri, aClearance ) )
+                if( !collideTriangle( tri ) )
                     return true;
             }
         }
@@ -2261,6 +2352,8 @@ void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 void SHAPE_POLY_SET::DeletePolygonAndTriangulationData( int aIdx, bool aUpdateHash )
 {
     m_polys.erase( m_polys.begin() + aIdx );
+    m_edgeBVH.reset();
+    m_triangleBVH.reset();
 
     if( m_triangulationValid )
     {
@@ -2380,6 +2473,33 @@ void SHAPE_POLY_SET::BuildBBoxCaches() const
         for( int holeIdx = 0; holeIdx < HoleCount( polygonIdx ); holeIdx++ )
             CHole( polygonIdx, holeIdx ).GenerateBBoxCache();
     }
+
+    // The outlines may have been edited since the index was built.  Checking that would cost
+    // about as much as rebuilding it, so leave that to Contains() (if it is called at all).
+    m_edgeBVHStale = true;
+}
+
+
+std::shared_ptr<const SHAPE_POLY_SET_BVH> SHAPE_POLY_SET::triangleBVH() const
+{
+    std::shared_ptr<const SHAPE_POLY_SET_BVH> bvh = std::atomic_load( &m_triangleBVH );
+
+    if( bvh && bvh->GetHash() == m_hash )
+        return bvh;
+
+    size_t triangleCount = 0;
+
+    for( const std::unique_ptr<TRIANGULATED_POLYGON>& tpoly : m_triangulatedPolys )
+        triangleCount += tpoly->GetTriangleCount();
+
+    if( triangleCount < SHAPE_POLY_SET_BVH::MIN_INDEXED_ITEMS )
+        return nullptr;
+
+    // Concurrent callers may both build it; either copy will do.
+    bvh = std::make_shared<SHAPE_POLY_SET_BVH>( *this, m_hash, true );
+    std::atomic_store( &m_triangleBVH, bvh );
+
+    return bvh;
 }
 
 
@@ -2389,6 +2509,27 @@ bool SHAPE_POLY_SET::Contains( const VECTOR2I& aP, int aSubpolyIndex, int aAccur
     if( m_polys.empty() )
         return false;
 
+    // Index the edges of large sets
+    if( aUseBBoxCaches )
+    {
+        // Read the flag first: it's only cleared once the new index has been stored
+        bool                                      stale = m_edgeBVHStale;
+        std::shared_ptr<const SHAPE_POLY_SET_BVH> bvh = std::atomic_load( &m_edgeBVH );
+
+        if( ( !bvh || stale )
+                && (size_t) FullPointCount() >= SHAPE_POLY_SET_BVH::MIN_INDEXED_ITEMS )
+        {
+            // Concurrent callers may both build it; either copy will do.
+            bvh = std::make_shared<SHAPE_POLY_SET_BVH>( *this, m_hash, false );
+            std::atomic_store( &m_edgeBVH, bvh );
+            m_edgeBVHStale = false;
+            stale = false;
+        }
+
+        if( bvh && !stale )
+            return bvh->Contains( aP, aSubpolyIndex, aAccuracy );
+    }
+
     // If there is a polygon specified, check the condition against that polygon
     if( aSubpolyIndex >= 0 )
         return containsSingle( aP, aSubpolyIndex, aAccuracy, aUseBBoxCaches );
@@ -2474,6 +2615,9 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
     for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
         tri->Move( aVector );
 
+    // Unlike the bbox caches, the BVHs aren't moved with the polygons
+    m_edgeBVH.reset();
+    m_triangleBVH.reset();
     m_hash = checksum();
 }
 
@@ -2884,6 +3028,9 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
 
     m_hash = aOther.m_hash;
     m_triangulationValid = aOther.m_triangulationValid;
+    m_edgeBVH = std::atomic_load( &aOther.m_edgeBVH );
+    m_triangleBVH = std::atomic_load( &aOther.m_triangleBVH );
+    m_edgeBVHStale = aOther.m_edgeBVHStale.load();
 
     return *this;
 }
@@ -3043,6 +3190,9 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aSimplify )
                 return triangulationValid;
             };
 
+    // The triangle BVH refers to triangles by index, and the outlines may have changed too
+    m_edgeBVH.reset();
+    m_triangleBVH.reset();
     m_triangulatedPolys.clear();
     m_triangulationValid = true;
 
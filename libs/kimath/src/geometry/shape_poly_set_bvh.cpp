@@ -0,0 +1,181 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set_bvh.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+
+SHAPE_POLY_SET_BVH::SHAPE_POLY_SET_BVH( const SHAPE_POLY_SET& aPolySet, const MD5_HASH& aHash,
+                                        bool aWithTriangles ) :
+        m_hash( aHash ),
+        m_hasTriangles( aWithTriangles )
+{
+    std::vector<BOX_TREE::BOX> boxes;
+
+    auto addBox =
+            [&]( const VECTOR2I& aMin, const VECTOR2I& aMax )
+            {
+                boxes.push_back( { aMin, aMax } );
+            };
+
+    for( int polyIdx = 0; polyIdx < aPolySet.OutlineCount(); ++polyIdx )
+    {
+        for( int contourIdx = 0; contourIdx <= aPolySet.HoleCount( polyIdx ); ++contourIdx )
+        {
+            const SHAPE_LINE_CHAIN& contour = contourIdx == 0
+                                                    ? aPolySet.COutline( polyIdx )
+                                                    : aPolySet.CHole( polyIdx, contourIdx - 1 );
+
+            // SHAPE_LINE_CHAIN_BASE::PointInside() never finds a point inside these
+            if( !contour.IsClosed() || contour.PointCount() < 3 )
+                continue;
+
+            for( int ii = 0; ii < contour.PointCount(); ++ii )
+            {
+                const VECTOR2I& a = contour.CPoint( ii );
+                const VECTOR2I& b = contour.CPoint( ii + 1 == contour.PointCount() ? 0 : ii + 1 );
+
+                m_edges.push_back( { SEG( a, b ), polyIdx, contourIdx } );
+                addBox( VECTOR2I( std::min( a.x, b.x ), std::min( a.y, b.y ) ),
+                        VECTOR2I( std::max( a.x, b.x ), std::max( a.y, b.y ) ) );
+            }
+        }
+    }
+
+    m_edgeTree.Build( boxes );
+
+    if( !aWithTriangles )
+        return;
+
+    boxes.clear();
+
+    for( unsigned ii = 0; ii < aPolySet.TriangulatedPolyCount(); ++ii )
+    {
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tpoly = aPolySet.TriangulatedPolygon( ii );
+
+        for( int jj = 0; jj < (int) tpoly->GetTriangleCount(); ++jj )
+        {
+            VECTOR2I a, b, c;
+
+            tpoly->GetTriangle( jj, a, b, c );
+
+            m_triangles.emplace_back( (int) ii, jj );
+            addBox( VECTOR2I( std::min( { a.x, b.x, c.x } ), std::min( { a.y, b.y, c.y } ) ),
+                    VECTOR2I( std::max( { a.x, b.x, c.x } ), std::max( { a.y, b.y, c.y } ) ) );
+        }
+    }
+
+    m_triangleTree.Build( boxes );
+}
+
+
+bool SHAPE_POLY_SET_BVH::Contains( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy ) const
+{
+    // Count the crossings of a ray from aP in the positive x direction per contour, exactly as
+    // SHAPE_LINE_CHAIN_BASE::PointInside() does.  Only edges spanning aP.y to the right of aP
+    // can cross it.
+    std::vector<std::pair<int, int>> crossings;
+
+    QueryEdges( aP, VECTOR2I( std::numeric_limits<int>::max(), aP.y ),
+                [&]( const EDGE& aEdge )
+                {
+                    if( aSubpolyIndex >= 0 && aEdge.m_Polygon != aSubpolyIndex )
+                        return true;
+
+                    const VECTOR2I& p1 = aEdge.m_Seg.A;
+                    const VECTOR2I& p2 = aEdge.m_Seg.B;
+                    const VECTOR2I  diff = p2 - p1;
+
+                    if( diff.y != 0 )
+                    {
+                        const int d = rescale( diff.x, ( aP.y - p1.y ), diff.y );
+
+                        if( ( ( p1.y > aP.y ) != ( p2.y > aP.y ) ) && ( aP.x - p1.x < d ) )
+                            crossings.emplace_back( aEdge.m_Polygon, aEdge.m_Contour );
+                    }
+
+                    return true;
+                } );
+
+    std::sort( crossings.begin(), crossings.end() );
+
+    std::vector<int> outlines;      // Polygons whose outline contains aP
+    std::vector<int> holes;         // Polygons with a hole containing aP
+
+    for( size_t ii = 0; ii < crossings.size(); )
+    {
+        size_t jj = ii + 1;
+
+        while( jj < crossings.size() && crossings[jj] == crossings[ii] )
+            ++jj;
+
+        if( ( jj - ii ) % 2 )
+        {
+            if( crossings[ii].second == 0 )
+                outlines.push_back( crossings[ii].first );
+            else
+                holes.push_back( crossings[ii].first );
+        }
+
+        ii = jj;
+    }
+
+    // As in SHAPE_LINE_CHAIN_BASE::PointInside(), an accuracy > 1 also accepts points on (or
+    // close to) an outline; holes are always tested with an accuracy of 1.
+    if( aAccuracy > 1 )
+    {
+        const VECTOR2I margin( aAccuracy + 1, aAccuracy + 1 );
+
+        QueryEdges( aP - margin, aP + margin,
+                    [&]( const EDGE& aEdge )
+                    {
+                        if( aEdge.m_Contour != 0 )
+                            return true;
+
+                        if( aSubpolyIndex >= 0 && aEdge.m_Polygon != aSubpolyIndex )
+                            return true;
+
+                        const SEG& seg = aEdge.m_Seg;
+
+                        if( seg.A == aP || seg.B == aP || seg.Distance( aP ) <= aAccuracy + 1 )
+                            outlines.push_back( aEdge.m_Polygon );
+
+                        return true;
+                    } );
+
+        std::sort( outlines.begin(), outlines.end() );
+    }
+
+    for( int polyIdx : outlines )
+    {
+        if( !std::binary_search( holes.begin(), holes.end(), polyIdx ) )
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,979 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file shape_poly_set_tiled.cpp
+ *
+ * Tiled boolean operations and offsets of SHAPE_POLY_SET.
+ *
+ * The extents of the operation are split by a grid.  The contours are clipped to each tile (or,
+ * for offsets, to the tile plus the reach of the offset) and the operation runs on each tile in
+ * parallel.  The results of adjacent tiles meet along the tile boundaries, where the pieces
+ * sharing a boundary edge are merged by a union of their outlines.  Their holes can't be
+ * changed by the merge, so they are left out of it and handed back to the merged outlines.
+ *
+ * The vertices made where edges cross tile boundaries are tagged, and those an edge still runs
+ * straight through after the merge are removed, so the edges come out whole.
+ * The grid only depends on the geometry and ADVANCED_CFG::m_PolygonTileVertices, so the
+ * results don't depend on the machine.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <advanced_config.h>
+#include <clipper2/clipper.h>
+#include <core/task_scheduler.h>
+#include <geometry/seg.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+
+using namespace Clipper2Lib;
+
+
+namespace
+{
+
+/// The Z value of the vertices made where edges cross tile boundaries
+constexpr int64_t SEAM_Z = -1;
+
+/// The most tiles an operation is split into
+constexpr size_t MAX_TILES = 64;
+
+
+/**
+ * Make \a aClipper give the intersections falling on a vertex the Z value of that vertex, so
+ * the vertices made by tile boundaries stay tagged when other edges meet them.  Without a
+ * callback, Clipper gives all intersections a Z of 0.
+ */
+void keepVertexZ( Clipper64& aClipper )
+{
+    aClipper.SetZCallback(
+            []( const Point64&, const Point64&, const Point64&, const Point64&, Point64& )
+            {
+            } );
+}
+
+
+/**
+ * A grid of tiles over the extents of an operation.  Tiles are closed rectangles, adjacent
+ * ones sharing their boundary.
+ */
+struct TILE_GRID
+{
+    TILE_GRID( const Rect64& aExtents, int aTileCount )
+    {
+        const int64_t width = std::max<int64_t>( aExtents.Width(), 1 );
+        const int64_t height = std::max<int64_t>( aExtents.Height(), 1 );
+
+        m_Cols = KiROUND( std::sqrt( aTileCount * (double) width / height ) );
+        m_Cols = std::clamp( m_Cols, 1, aTileCount );
+        m_Rows = std::max( 1, aTileCount / m_Cols );
+
+        for( int ii = 0; ii <= m_Cols; ++ii )
+            m_Xs.push_back( aExtents.left + width * ii / m_Cols );
+
+        for( int ii = 0; ii <= m_Rows; ++ii )
+            m_Ys.push_back( aExtents.top + height * ii / m_Rows );
+    }
+
+    int Count() const { return m_Cols * m_Rows; }
+
+    Rect64 Tile( int aIndex ) const
+    {
+        const int col = aIndex % m_Cols;
+        const int row = aIndex / m_Cols;
+
+        return Rect64( m_Xs[col], m_Ys[row], m_Xs[col + 1], m_Ys[row + 1] );
+    }
+
+    /// The smallest width or height of a tile
+    int64_t MinTileSize() const
+    {
+        return std::min( ( m_Xs.back() - m_Xs.front() ) / m_Cols,
+                         ( m_Ys.back() - m_Ys.front() ) / m_Rows );
+    }
+
+    /**
+     * Find the range of columns (from m_Xs) or rows (from m_Ys) of the tiles touching the
+     * range from \a aMin to \a aMax.
+     *
+     * @return false if there are none.
+     */
+    static bool Span( const std::vector<int64_t>& aEdges, int64_t aMin, int64_t aMax,
+                      int& aFirst, int& aLast )
+    {
+        // Tile ii spans aEdges[ii] to aEdges[ii + 1]
+        aFirst = std::lower_bound( aEdges.begin() + 1, aEdges.end(), aMin ) - aEdges.begin() - 1;
+        aLast = std::upper_bound( aEdges.begin(), aEdges.end() - 1, aMax ) - aEdges.begin() - 1;
+
+        return aFirst <= aLast && aFirst < (int) aEdges.size() - 1 && aLast >= 0;
+    }
+
+    int                  m_Cols;
+    int                  m_Rows;
+    std::vector<int64_t> m_Xs;      ///< Column boundaries, m_Cols + 1 of them
+    std::vector<int64_t> m_Ys;      ///< Row boundaries, m_Rows + 1 of them
+};
+
+
+/**
+ * The number of tiles to split an operation on \a aVertexCount vertices into, or less than 2
+ * if it isn't worth tiling.
+ */
+int tileCount( size_t aVertexCount )
+{
+    const int tileVertices = ADVANCED_CFG::GetCfg().m_PolygonTileVertices;
+
+    if( tileVertices <= 0 )
+        return 0;
+
+    // Not the thread count: the seams, and so the rounding of the result, would then depend on
+    // the machine
+    return (int) std::min( aVertexCount / tileVertices, MAX_TILES );
+}
+
+
+/**
+ * A vertex of a contour being clipped, and the edge of the original contour that the segment
+ * from it to the next vertex lies on.
+ *
+ * Crossings with the tile boundaries are always computed from the original edge, rather than
+ * from a segment already cut by another boundary.  Both tiles either side of a boundary then
+ * find the same crossing points, to the unit.
+ */
+struct CLIP_VERTEX
+{
+    Point64 m_Pt;
+    Point64 m_EdgeA;
+    Point64 m_EdgeB;
+    bool    m_OnBoundary;       ///< The segment runs along a tile boundary instead
+};
+
+
+/**
+ * Find where the segment from \a aVertex crosses x = aPos (if \a aVertical) or y = aPos.
+ */
+Point64 boundaryCrossing( const CLIP_VERTEX& aVertex, bool aVertical, int64_t aPos )
+{
+    Point64 a = aVertex.m_EdgeA;
+    Point64 b = aVertex.m_EdgeB;
+
+    // Segments along a boundary are horizontal or vertical, so their crossings are exact
+    if( aVertex.m_OnBoundary || ( aVertical ? a.x == b.x : a.y == b.y ) )
+        return aVertical ? Point64( aPos, aVertex.m_Pt.y ) : Point64( aVertex.m_Pt.x, aPos );
+
+    // Round the same way whichever way the edge runs
+    if( b.x < a.x || ( b.x == a.x && b.y < a.y ) )
+        std::swap( a, b );
+
+    if( aVertical )
+        return Point64( aPos, a.y + rescale<int64_t>( aPos - a.x, b.y - a.y, b.x - a.x ) );
+    else
+        return Point64( a.x + rescale<int64_t>( aPos - a.y, b.x - a.x, b.y - a.y ), aPos );
+}
+
+
+/**
+ * Clip \a aIn to the half plane on the \a aKeepGreater side of x = aPos (if \a aVertical) or
+ * y = aPos, boundary included.
+ */
+void clipHalfPlane( const std::vector<CLIP_VERTEX>& aIn, std::vector<CLIP_VERTEX>& aOut,
+                    bool aVertical, int64_t aPos, bool aKeepGreater )
+{
+    auto inside =
+            [&]( const Point64& aPt )
+            {
+                const int64_t coord = aVertical ? aPt.x : aPt.y;
+
+                return aKeepGreater ? coord >= aPos : coord <= aPos;
+            };
+
+    aOut.clear();
+
+    for( size_t ii = 0; ii < aIn.size(); ++ii )
+    {
+        const CLIP_VERTEX& curr = aIn[ii];
+        const CLIP_VERTEX& next = aIn[ii + 1 == aIn.size() ? 0 : ii + 1];
+        const bool         currInside = inside( curr.m_Pt );
+
+        if( currInside )
+            aOut.push_back( curr );
+
+        if( currInside != inside( next.m_Pt ) )
+        {
+            CLIP_VERTEX crossing = curr;
+
+            crossing.m_Pt = boundaryCrossing( curr, aVertical, aPos );
+            crossing.m_Pt.z = SEAM_Z;
+
+            // Leaving the half plane, the contour follows the boundary until it comes back in
+            if( currInside )
+                crossing.m_OnBoundary = true;
+
+            aOut.push_back( crossing );
+        }
+    }
+}
+
+
+/**
+ * Clip the closed contour \a aPath to \a aRect (Sutherland-Hodgman).
+ *
+ * Where the contour leaves the rectangle and comes back in, the result runs along the
+ * boundary, possibly back and forth over itself.  The boolean operations resolve these.
+ */
+Path64 clipToRect( const Path64& aPath, const Rect64& aRect )
+{
+    std::vector<CLIP_VERTEX> a;
+    std::vector<CLIP_VERTEX> b;
+
+    a.reserve( aPath.size() + 8 );
+
+    for( size_t ii = 0; ii < aPath.size(); ++ii )
+    {
+        const Point64& next = aPath[ii + 1 == aPath.size() ? 0 : ii + 1];
+
+        a.push_back( { aPath[ii], aPath[ii], next, false } );
+    }
+
+    clipHalfPlane( a, b, true, aRect.left, true );
+    clipHalfPlane( b, a, true, aRect.right, false );
+    clipHalfPlane( a, b, false, aRect.top, true );
+    clipHalfPlane( b, a, false, aRect.bottom, false );
+
+    Path64 result;
+
+    result.reserve( a.size() );
+
+    for( const CLIP_VERTEX& vertex : a )
+    {
+        if( result.empty() || result.back() != vertex.m_Pt )
+            result.push_back( vertex.m_Pt );
+    }
+
+    while( result.size() > 1 && result.back() == result.front() )
+        result.pop_back();
+
+    if( result.size() < 3 )
+        result.clear();
+
+    return result;
+}
+
+
+/**
+ * Find the contours within \a aMargin of each tile of \a aGrid.
+ */
+std::vector<std::vector<int>> binPaths( const Paths64& aPaths, const std::vector<Rect64>& aBounds,
+                                        const TILE_GRID& aGrid, int64_t aMargin )
+{
+    std::vector<std::vector<int>> bins( aGrid.Count() );
+
+    for( size_t ii = 0; ii < aPaths.size(); ++ii )
+    {
+        const Rect64& bounds = aBounds[ii];
+        int           firstCol, lastCol, firstRow, lastRow;
+
+        if( !TILE_GRID::Span( aGrid.m_Xs, bounds.left - aMargin, bounds.right + aMargin,
+                              firstCol, lastCol )
+            || !TILE_GRID::Span( aGrid.m_Ys, bounds.top - aMargin, bounds.bottom + aMargin,
+                                 firstRow, lastRow ) )
+        {
+            continue;
+        }
+
+        for( int row = firstRow; row <= lastRow; ++row )
+        {
+            for( int col = firstCol; col <= lastCol; ++col )
+                bins[row * aGrid.m_Cols + col].push_back( (int) ii );
+        }
+    }
+
+    return bins;
+}
+
+
+/**
+ * Clip the contours \a aIndices of \a aPaths to \a aRect.
+ */
+Paths64 clipPaths( const Paths64& aPaths, const std::vector<Rect64>& aBounds,
+                   const std::vector<int>& aIndices, const Rect64& aRect )
+{
+    Paths64 result;
+
+    result.reserve( aIndices.size() );
+
+    for( int idx : aIndices )
+    {
+        if( aRect.Contains( aBounds[idx] ) )
+        {
+            result.push_back( aPaths[idx] );
+        }
+        else
+        {
+            Path64 clipped = clipToRect( aPaths[idx], aRect );
+
+            if( !clipped.empty() )
+                result.push_back( std::move( clipped ) );
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * An outline of the result of a tile, and its holes.
+ */
+struct TILE_PIECE
+{
+    Path64  m_Outline;
+    Paths64 m_Holes;
+    int     m_Tile;
+};
+
+
+void collectPieces( const PolyPath64& aParent, int aTile, std::vector<TILE_PIECE>& aPieces )
+{
+    for( const std::unique_ptr<PolyPath64>& outline : aParent )
+    {
+        TILE_PIECE piece;
+
+        piece.m_Outline = outline->Polygon();
+        piece.m_Tile = aTile;
+
+        for( const std::unique_ptr<PolyPath64>& hole : *outline )
+        {
+            piece.m_Holes.push_back( hole->Polygon() );
+
+            // Islands within the hole
+            collectPieces( *hole, aTile, aPieces );
+        }
+
+        aPieces.push_back( std::move( piece ) );
+    }
+}
+
+
+/**
+ * A segment of a piece outline along a tile boundary.
+ */
+struct SEAM_EDGE
+{
+    int64_t m_Min;
+    int64_t m_Max;
+    int     m_Piece;
+};
+
+
+int findRoot( std::vector<int>& aParents, int aIdx )
+{
+    while( aParents[aIdx] != aIdx )
+    {
+        aParents[aIdx] = aParents[aParents[aIdx]];
+        aIdx = aParents[aIdx];
+    }
+
+    return aIdx;
+}
+
+
+/**
+ * Find the pieces which share part of a tile boundary, and so need merging.
+ *
+ * @return the index of the first piece of the group of each piece.
+ */
+std::vector<int> groupPieces( const TILE_GRID& aGrid, const std::vector<TILE_PIECE>& aPieces )
+{
+    // Edges along each internal column (then row) boundary, from the tiles before and after it
+    const int                   seamCount = aGrid.m_Cols + aGrid.m_Rows;
+    std::vector<std::vector<SEAM_EDGE>> before( seamCount );
+    std::vector<std::vector<SEAM_EDGE>> after( seamCount );
+
+    for( int ii = 0; ii < (int) aPieces.size(); ++ii )
+    {
+        const Path64& outline = aPieces[ii].m_Outline;
+        const int     col = aPieces[ii].m_Tile % aGrid.m_Cols;
+        const int     row = aPieces[ii].m_Tile / aGrid.m_Cols;
+
+        for( size_t jj = 0; jj < outline.size(); ++jj )
+        {
+            const Point64& a = outline[jj];
+            const Point64& b = outline[jj + 1 == outline.size() ? 0 : jj + 1];
+
+            if( a.x == b.x && a.y != b.y )
+            {
+                SEAM_EDGE edge{ std::min( a.y, b.y ), std::max( a.y, b.y ), ii };
+
+                if( col > 0 && a.x == aGrid.m_Xs[col] )
+                    after[col].push_back( edge );
+                else if( col + 1 < aGrid.m_Cols && a.x == aGrid.m_Xs[col + 1] )
+                    before[col + 1].push_back( edge );
+            }
+            else if( a.y == b.y && a.x != b.x )
+            {
+                SEAM_EDGE edge{ std::min( a.x, b.x ), std::max( a.x, b.x ), ii };
+
+                if( row > 0 && a.y == aGrid.m_Ys[row] )
+                    after[aGrid.m_Cols + row].push_back( edge );
+                else if( row + 1 < aGrid.m_Rows && a.y == aGrid.m_Ys[row + 1] )
+                    before[aGrid.m_Cols + row + 1].push_back( edge );
+            }
+        }
+    }
+
+    std::vector<int> parents( aPieces.size() );
+
+    std::iota( parents.begin(), parents.end(), 0 );
+
+    auto byMin =
+            []( const SEAM_EDGE& aLhs, const SEAM_EDGE& aRhs )
+            {
+                return aLhs.m_Min < aRhs.m_Min;
+            };
+
+    for( int seam = 0; seam < seamCount; ++seam )
+    {
+        std::vector<SEAM_EDGE>& lhs = before[seam];
+        std::vector<SEAM_EDGE>& rhs = after[seam];
+
+        std::sort( lhs.begin(), lhs.end(), byMin );
+        std::sort( rhs.begin(), rhs.end(), byMin );
+
+        // The pieces of a tile don't overlap, so neither do the edges on each side
+        for( size_t ii = 0, jj = 0; ii < lhs.size() && jj < rhs.size(); )
+        {
+            if( std::min( lhs[ii].m_Max, rhs[jj].m_Max ) > std::max( lhs[ii].m_Min,
+                                                                     rhs[jj].m_Min ) )
+            {
+                int lhsRoot = findRoot( parents, lhs[ii].m_Piece );
+                int rhsRoot = findRoot( parents, rhs[jj].m_Piece );
+
+                parents[std::max( lhsRoot, rhsRoot )] = std::min( lhsRoot, rhsRoot );
+            }
+
+            if( lhs[ii].m_Max < rhs[jj].m_Max )
+                ++ii;
+            else
+                ++jj;
+        }
+    }
+
+    for( int ii = 0; ii < (int) aPieces.size(); ++ii )
+        parents[ii] = findRoot( parents, ii );
+
+    return parents;
+}
+
+
+/**
+ * Merge the pieces of a group into polygons (each an outline followed by its holes).
+ */
+std::vector<Paths64> mergePieces( std::vector<TILE_PIECE*>& aPieces )
+{
+    Clipper64 clipper;
+    Paths64   outlines;
+    Paths64   holes;
+
+    for( TILE_PIECE* piece : aPieces )
+    {
+        outlines.push_back( std::move( piece->m_Outline ) );
+
+        for( Path64& hole : piece->m_Holes )
+            holes.push_back( std::move( hole ) );
+    }
+
+    keepVertexZ( clipper );
+    clipper.AddSubject( outlines );
+
+    PolyTree64 tree;
+
+    clipper.Execute( ClipType::Union, FillRule::NonZero, tree );
+
+    std::vector<TILE_PIECE> merged;
+
+    collectPieces( tree, 0, merged );
+
+    // The holes of the pieces are within the merged area.  Usually that's a single outline.
+    for( Path64& hole : holes )
+    {
+        size_t owner = 0;
+
+        for( size_t ii = 0; merged.size() > 1 && ii < merged.size(); ++ii )
+        {
+            const Point64& pt = hole.front();
+
+            if( PointInPolygon( pt, merged[ii].m_Outline ) == PointInPolygonResult::IsOutside )
+                continue;
+
+            auto inHole =
+                    [&]( const Path64& aMergedHole )
+                    {
+                        return PointInPolygon( pt, aMergedHole )
+                               == PointInPolygonResult::IsInside;
+                    };
+
+            if( std::none_of( merged[ii].m_Holes.begin(), merged[ii].m_Holes.end(), inHole ) )
+            {
+                owner = ii;
+                break;
+            }
+        }
+
+        if( !merged.empty() )
+            merged[owner].m_Holes.push_back( std::move( hole ) );
+    }
+
+    std::vector<Paths64> polygons;
+
+    for( TILE_PIECE& piece : merged )
+    {
+        polygons.emplace_back();
+        polygons.back().push_back( std::move( piece.m_Outline ) );
+
+        for( Path64& hole : piece.m_Holes )
+            polygons.back().push_back( std::move( hole ) );
+    }
+
+    return polygons;
+}
+
+
+/**
+ * Remove the vertices of \a aPath made by tile boundaries where the edge runs straight on.
+ *
+ * The crossing points are rounded to the unit, so they are within a unit of the line through
+ * the vertices either side.  Those left where the result turns along a tile boundary are kept,
+ * as new points.
+ */
+void dropSeamVertices( Path64& aPath )
+{
+    auto toVector =
+            []( const Point64& aPt )
+            {
+                return VECTOR2I( (int) aPt.x, (int) aPt.y );
+            };
+
+    auto first = std::find_if( aPath.begin(), aPath.end(),
+                               []( const Point64& aPt )
+                               {
+                                   return aPt.z != SEAM_Z;
+                               } );
+
+    if( first == aPath.end() )
+    {
+        for( Point64& pt : aPath )
+            pt.z = 0;
+
+        return;
+    }
+
+    // Start from a vertex which stays, so that the one before each vertex is settled
+    std::rotate( aPath.begin(), first, aPath.end() );
+
+    Path64 result;
+
+    result.reserve( aPath.size() );
+
+    for( size_t ii = 0; ii < aPath.size(); ++ii )
+    {
+        Point64 pt = aPath[ii];
+
+        if( pt.z == SEAM_Z )
+        {
+            const Point64& prev = result.back();
+            const Point64& next = aPath[ii + 1 == aPath.size() ? 0 : ii + 1];
+
+            if( prev != next && SEG( toVector( prev ), toVector( next ) )
+                                        .LineDistance( toVector( pt ) ) <= 1 )
+            {
+                continue;
+            }
+
+            pt.z = 0;
+        }
+
+        result.push_back( pt );
+    }
+
+    if( result.size() >= 3 )
+    {
+        aPath = std::move( result );
+        return;
+    }
+
+    for( Point64& pt : aPath )
+    {
+        if( pt.z == SEAM_Z )
+            pt.z = 0;
+    }
+}
+
+
+/**
+ * Run \a aTileOp on each tile of \a aGrid in parallel, then merge the results.
+ *
+ * @param aTileOp is called as aTileOp( tileIndex, tree ) to fill a PolyTree64 with the result
+ *                within a tile.
+ * @return the polygons of the result, each an outline followed by its holes.
+ */
+template <typename TILE_OP>
+std::vector<Paths64> runTiles( const TILE_GRID& aGrid, TILE_OP aTileOp )
+{
+    TASK_SCHEDULER&                      scheduler = GetKiCadTaskScheduler();
+    std::vector<std::vector<TILE_PIECE>> tilePieces( aGrid.Count() );
+
+    ParallelFor( scheduler, 0, aGrid.Count(),
+                 [&]( size_t aTile )
+                 {
+                     PolyTree64 tree;
+
+                     aTileOp( (int) aTile, tree );
+                     collectPieces( tree, (int) aTile, tilePieces[aTile] );
+                 },
+                 1 );
+
+    std::vector<TILE_PIECE> pieces;
+
+    for( std::vector<TILE_PIECE>& tile : tilePieces )
+    {
+        for( TILE_PIECE& piece : tile )
+            pieces.push_back( std::move( piece ) );
+    }
+
+    std::vector<int>                      groups = groupPieces( aGrid, pieces );
+    std::vector<std::vector<TILE_PIECE*>> members( pieces.size() );
+    std::vector<int>                      mergeList;
+
+    for( size_t ii = 0; ii < pieces.size(); ++ii )
+    {
+        members[groups[ii]].push_back( &pieces[ii] );
+
+        if( members[groups[ii]].size() == 2 )
+            mergeList.push_back( groups[ii] );
+    }
+
+    std::vector<std::vector<Paths64>> mergedGroups( pieces.size() );
+
+    ParallelFor( scheduler, 0, mergeList.size(),
+                 [&]( size_t aIdx )
+                 {
+                     int group = mergeList[aIdx];
+
+                     mergedGroups[group] = mergePieces( members[group] );
+                 },
+                 1 );
+
+    std::vector<Paths64> polygons;
+
+    for( size_t ii = 0; ii < pieces.size(); ++ii )
+    {
+        if( groups[ii] != (int) ii )
+            continue;
+
+        if( members[ii].size() > 1 )
+        {
+            for( Paths64& polygon : mergedGroups[ii] )
+                polygons.push_back( std::move( polygon ) );
+
+            continue;
+        }
+
+        polygons.emplace_back();
+        polygons.back().push_back( std::move( pieces[ii].m_Outline ) );
+
+        for( Path64& hole : pieces[ii].m_Holes )
+            polygons.back().push_back( std::move( hole ) );
+    }
+
+    ParallelFor( scheduler, 0, polygons.size(),
+                 [&]( size_t aIdx )
+                 {
+                     for( Path64& path : polygons[aIdx] )
+                         dropSeamVertices( path );
+                 } );
+
+    return polygons;
+}
+
+
+std::vector<Rect64> pathBounds( const Paths64& aPaths )
+{
+    std::vector<Rect64> bounds;
+
+    bounds.reserve( aPaths.size() );
+
+    for( const Path64& path : aPaths )
+        bounds.push_back( GetBounds( path ) );
+
+    return bounds;
+}
+
+
+std::vector<int> allIndices( size_t aCount )
+{
+    std::vector<int> indices( aCount );
+
+    std::iota( indices.begin(), indices.end(), 0 );
+
+    return indices;
+}
+
+
+Rect64 unionBounds( const std::vector<Rect64>& aBounds )
+{
+    const int64_t big = std::numeric_limits<int64_t>::max();
+    Rect64        result( big, big, -big, -big );
+
+    for( const Rect64& bounds : aBounds )
+    {
+        result.left = std::min( result.left, bounds.left );
+        result.top = std::min( result.top, bounds.top );
+        result.right = std::max( result.right, bounds.right );
+        result.bottom = std::max( result.bottom, bounds.bottom );
+    }
+
+    return result;
+}
+
+} // namespace
+
+
+bool SHAPE_POLY_SET::booleanOpTiled( Clipper2Lib::ClipType aType,
+                                     const SHAPE_POLY_SET& aOtherShape )
+{
+    int tiles = tileCount( FullPointCount() + aOtherShape.FullPointCount() );
+
+    if( tiles < 2 || ArcCount() > 0 || aOtherShape.ArcCount() > 0 )
+        return false;
+
+    std::vector<CLIPPER_Z_VALUE> zValues;
+    std::vector<SHAPE_ARC>       arcBuffer;
+    Paths64                      paths;
+    Paths64                      clips;
+
+    for( const POLYGON& poly : m_polys )
+    {
+        for( size_t i = 0; i < poly.size(); i++ )
+            paths.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
+    }
+
+    for( const POLYGON& poly : aOtherShape.m_polys )
+    {
+        for( size_t i = 0; i < poly.size(); i++ )
+            clips.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
+    }
+
+    // Without arcs, all Z values are plain points: the new points made by clipping (which
+    // have a Z of 0) can share the first one.
+    if( zValues.empty() )
+        return false;
+
+    std::vector<Rect64> pathBoxes = pathBounds( paths );
+    std::vector<Rect64> clipBoxes = pathBounds( clips );
+    Rect64              extents = unionBounds( pathBoxes );
+
+    if( aType == ClipType::Union )
+    {
+        Rect64 clipExtents = unionBounds( clipBoxes );
+
+        extents = unionBounds( { extents, clipExtents } );
+    }
+    else if( aType == ClipType::Intersection )
+    {
+        Rect64 clipExtents = unionBounds( clipBoxes );
+
+        extents = Rect64( std::max( extents.left, clipExtents.left ),
+                          std::max( extents.top, clipExtents.top ),
+                          std::min( extents.right, clipExtents.right ),
+                          std::min( extents.bottom, clipExtents.bottom ) );
+    }
+
+    if( paths.empty() || extents.IsEmpty() )
+    {
+        // Only a union with something (handled by the untiled operation) isn't empty
+        if( aType == ClipType::Union && !clips.empty() )
+            return false;
+
+        m_polys.clear();
+        return true;
+    }
+
+    TILE_GRID                     grid( extents, tiles );
+    std::vector<std::vector<int>> pathBins = binPaths( paths, pathBoxes, grid, 0 );
+    std::vector<std::vector<int>> clipBins = binPaths( clips, clipBoxes, grid, 0 );
+
+    std::vector<Paths64> polygons = runTiles( grid,
+            [&]( int aTile, PolyTree64& aTree )
+            {
+                const Rect64 tile = grid.Tile( aTile );
+                Clipper64    clipper;
+
+                keepVertexZ( clipper );
+                clipper.AddSubject( clipPaths( paths, pathBoxes, pathBins[aTile], tile ) );
+                clipper.AddClip( clipPaths( clips, clipBoxes, clipBins[aTile], tile ) );
+                clipper.Execute( aType, FillRule::NonZero, aTree );
+            } );
+
+    importTiles( polygons, zValues, arcBuffer );
+
+    return true;
+}
+
+
+bool SHAPE_POLY_SET::inflateTiled( int aAmount, int aCircleSegCount,
+                                   CORNER_STRATEGY aCornerStrategy )
+{
+    int tiles = tileCount( FullPointCount() );
+
+    if( tiles < 2 || ArcCount() > 0 )
+        return false;
+
+    // Same joins and tolerance as inflate2()
+    JoinType joinType = JoinType::Round;
+    double   miterLimit = 2.0;
+
+    switch( aCornerStrategy )
+    {
+    case CORNER_STRATEGY::ALLOW_ACUTE_CORNERS:
+        joinType = JoinType::Miter;
+        miterLimit = 10;
+        break;
+
+    case CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS:
+    case CORNER_STRATEGY::ROUND_ACUTE_CORNERS:
+        joinType = JoinType::Miter;
+        break;
+
+    case CORNER_STRATEGY::CHAMFER_ALL_CORNERS:
+        joinType = JoinType::Square;
+        break;
+
+    case CORNER_STRATEGY::ROUND_ALL_CORNERS:
+        joinType = JoinType::Round;
+        break;
+    }
+
+    aCircleSegCount = std::max( aCircleSegCount, 6 );
+
+    const double arcTolerance = std::abs( aAmount ) * ( 1.0 - cos( M_PI / aCircleSegCount ) );
+
+    std::vector<CLIPPER_Z_VALUE> zValues;
+    std::vector<SHAPE_ARC>       arcBuffer;
+    Paths64                      paths;
+
+    for( const POLYGON& poly : m_polys )
+    {
+        for( size_t i = 0; i < poly.size(); i++ )
+            paths.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
+    }
+
+    if( zValues.empty() )
+        return false;
+
+    // How far an edge can move, miters included (square joins reach sqrt(2) times the amount)
+    const int64_t       reach = (int64_t) std::ceil( std::abs( aAmount )
+                                                     * std::max( miterLimit, 2.0 ) ) + 1;
+    std::vector<Rect64> pathBoxes = pathBounds( paths );
+    Rect64              extents = unionBounds( pathBoxes );
+
+    if( aAmount > 0 )
+        extents = Rect64( extents.left - reach, extents.top - reach, extents.right + reach,
+                          extents.bottom + reach );
+
+    TILE_GRID grid( extents, tiles );
+
+    // Each tile is offset from the contours within twice the reach of it, so that the edges
+    // made by clipping them (which move too) stay out of the tile.  That's only worth it for
+    // tiles well above the reach.
+    const int64_t margin = 2 * reach;
+
+    if( grid.MinTileSize() < 2 * margin )
+        return false;
+
+    std::vector<std::vector<int>> pathBins = binPaths( paths, pathBoxes, grid, margin );
+
+    std::vector<Paths64> polygons = runTiles( grid,
+            [&]( int aTile, PolyTree64& aTree )
+            {
+                const Rect64 tile = grid.Tile( aTile );
+                const Rect64 reachRect( tile.left - margin, tile.top - margin,
+                                        tile.right + margin, tile.bottom + margin );
+
+                // Resolve the clipped contours running along the boundary before offsetting
+                Clipper64 merger;
+                Paths64   input;
+
+                merger.AddSubject( clipPaths( paths, pathBoxes, pathBins[aTile], reachRect ) );
+                merger.Execute( ClipType::Union, FillRule::NonZero, input );
+
+                if( input.empty() )
+                    return;
+
+                ClipperOffset offset;
+                Paths64       offsetPaths;
+
+                offset.ArcTolerance( arcTolerance );
+                offset.MiterLimit( miterLimit );
+                offset.AddPaths( input, joinType, EndType::Polygon );
+                offset.Execute( aAmount, offsetPaths );
+
+                // Keep the part within the tile
+                Clipper64 clipper;
+
+                keepVertexZ( clipper );
+                clipper.AddSubject( clipPaths( offsetPaths, pathBounds( offsetPaths ),
+                                               allIndices( offsetPaths.size() ), tile ) );
+                clipper.Execute( ClipType::Union, FillRule::NonZero, aTree );
+            } );
+
+    importTiles( polygons, zValues, arcBuffer );
+
+    return true;
+}
+
+
+void SHAPE_POLY_SET::importTiles( std::vector<Clipper2Lib::Paths64>&  aPolygons,
+                                  const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
+                                  const std::vector<SHAPE_ARC>&       aArcBuffer )
+{
+    m_polys.clear();
+    m_polys.reserve( aPolygons.size() );
+
+    for( const Paths64& polygon : aPolygons )
+    {
+        POLYGON paths;
+
+        paths.reserve( polygon.size() );
+
+        for( const Path64& path : polygon )
+            paths.emplace_back( path, aZValueBuffer, aArcBuffer );
+
+        m_polys.push_back( std::move( paths ) );
+    }
+}
@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -44,6 +45,28 @@ namespace IO
      * @return true if the process was successful
      */
     bool DuplicatePermissions( const wxString& aSrc, const wxString& aDest );
+
+    /**
+     * A read-only view of a whole file, see MapFile().
+     */
+    struct MAPPED_FILE
+    {
+        const char* m_Data = nullptr;
+        size_t      m_Size = 0;
+        void*       m_Handle = nullptr;     ///< Platform specific
+    };
+
+    /**
+     * Maps the whole of a file read-only into memory, hinting for sequential access.
+     *
+     * @return false if the file can't be mapped.  Empty files can't be mapped either.
+     */
+    bool MapFile( const wxString& aPath, MAPPED_FILE& aMapping );
+
+    /**
+     * Releases a mapping made by MapFile() and resets \a aMapping.
+     */
+    void UnmapFile( MAPPED_FILE& aMapping );
 } // namespace IO
 } // namespace KIPLATFORM
 
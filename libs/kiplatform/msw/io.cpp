@@ -114,3 +114,54 @@ bool KIPLATFORM::IO::DuplicatePermissions( const wxString &aSrc, const wxString
 
     return retval;
 }
+
+
+bool KIPLATFORM::IO::MapFile( const wxString& aPath, MAPPED_FILE& aMapping )
+{
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+
+    if( !GetFileSizeEx( hFile, &size ) || size.QuadPart <= 0 )
+    {
+        CloseHandle( hFile );
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    // The mapping object keeps its own reference to the file
+    CloseHandle( hFile );
+
+    if( !hMapping )
+        return false;
+
+    void* data = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+    if( !data )
+    {
+        CloseHandle( hMapping );
+        return false;
+    }
+
+    aMapping.m_Data = static_cast<const char*>( data );
+    aMapping.m_Size = static_cast<size_t>( size.QuadPart );
+    aMapping.m_Handle = hMapping;
+    return true;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( MAPPED_FILE& aMapping )
+{
+    if( aMapping.m_Data )
+    {
+        UnmapViewOfFile( aMapping.m_Data );
+        CloseHandle( static_cast<HANDLE>( aMapping.m_Handle ) );
+    }
+
+    aMapping = MAPPED_FILE();
+}
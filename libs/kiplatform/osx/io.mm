@@ -24,6 +24,11 @@
 #include <wx/crt.h>
 #include <wx/string.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 FILE* KIPLATFORM::IO::SeqFOpen( const wxString& aPath, const wxString& aMode )
 {
     return wxFopen( aPath, aMode );
@@ -62,4 +67,45 @@ bool KIPLATFORM::IO::DuplicatePermissions(const wxString& sourceFilePath, const
         NSLog(@"Error assigning permissions: %@", error);
         return false;
     }
-}
\ No newline at end of file
+}
+
+
+bool KIPLATFORM::IO::MapFile( const wxString& aPath, MAPPED_FILE& aMapping )
+{
+    int fd = open( aPath.fn_str(), O_RDONLY | O_CLOEXEC );
+
+    if( fd < 0 )
+        return false;
+
+    struct stat st;
+
+    if( fstat( fd, &st ) != 0 || st.st_size <= 0 )
+    {
+        close( fd );
+        return false;
+    }
+
+    void* data = mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping keeps its own reference to the file
+    close( fd );
+
+    if( data == MAP_FAILED )
+        return false;
+
+    posix_madvise( data, st.st_size, POSIX_MADV_SEQUENTIAL );
+
+    aMapping.m_Data = static_cast<const char*>( data );
+    aMapping.m_Size = st.st_size;
+    aMapping.m_Handle = nullptr;
+    return true;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( MAPPED_FILE& aMapping )
+{
+    if( aMapping.m_Data )
+        munmap( const_cast<char*>( aMapping.m_Data ), aMapping.m_Size );
+
+    aMapping = MAPPED_FILE();
+}
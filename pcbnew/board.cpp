@@ -49,6 +49,7 @@
 #include <pcb_textbox.h>
 #include <pcb_dimension.h>
 #include <pgm_base.h>
+#include <plot_geometry_cache.h>
 #include <pcbnew_settings.h>
 #include <progress_reporter.h>
 #include <project.h>
@@ -60,7 +61,7 @@
 #include <tool/tool_manager.h>
 #include <tool/selection_conditions.h>
 #include <string_utils.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <zone.h>
 
 // This is an odd place for this, but CvPcb won't link if it's in board_item.cpp like I first
@@ -253,25 +254,28 @@ void BOARD::IncrementTimeStamp()
 {
     m_timeStamp++;
 
-    if( !m_IntersectsAreaCache.empty()
-        || !m_EnclosedByAreaCache.empty()
-        || !m_IntersectsCourtyardCache.empty()
-        || !m_IntersectsFCourtyardCache.empty()
-        || !m_IntersectsBCourtyardCache.empty()
-        || !m_LayerExpressionCache.empty()
-        || !m_ZoneBBoxCache.empty()
+    if( m_PlotGeometryCache )
+        m_PlotGeometryCache->Clear();
+
+    if( !m_IntersectsAreaCache.Empty()
+        || !m_EnclosedByAreaCache.Empty()
+        || !m_IntersectsCourtyardCache.Empty()
+        || !m_IntersectsFCourtyardCache.Empty()
+        || !m_IntersectsBCourtyardCache.Empty()
+        || !m_LayerExpressionCache.Empty()
+        || !m_ZoneBBoxCache.Empty()
         || m_CopperItemRTreeCache )
     {
-        std::unique_lock<std::mutex> cacheLock( m_CachesMutex );
+        m_IntersectsAreaCache.Clear();
+        m_EnclosedByAreaCache.Clear();
+        m_IntersectsCourtyardCache.Clear();
+        m_IntersectsFCourtyardCache.Clear();
+        m_IntersectsBCourtyardCache.Clear();
+        m_LayerExpressionCache.Clear();
 
-        m_IntersectsAreaCache.clear();
-        m_EnclosedByAreaCache.clear();
-        m_IntersectsCourtyardCache.clear();
-        m_IntersectsFCourtyardCache.clear();
-        m_IntersectsBCourtyardCache.clear();
-        m_LayerExpressionCache.clear();
+        m_ZoneBBoxCache.Clear();
 
-        m_ZoneBBoxCache.clear();
+        std::unique_lock<std::mutex> cacheLock( m_CachesMutex );
 
         m_CopperItemRTreeCache = nullptr;
 
@@ -816,39 +820,31 @@ void BOARD::CacheTriangulation( PROGRESS_REPORTER* aReporter, const std::vector<
     if( aReporter )
         aReporter->Report( _( "Tessellating copper zones..." ) );
 
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<std::future<size_t>> returns;
-
-    returns.reserve( zones.size() );
-
-    auto cache_zones = [aReporter]( ZONE* aZone ) -> size_t
+    CANCELLATION_TOKEN cancelToken(
+            [aReporter]()
             {
-                if( aReporter && aReporter->IsCancelled() )
-                    return 0;
-
-                aZone->CacheTriangulation();
-
-                if( aReporter )
-                    aReporter->AdvanceProgress();
+                return aReporter && aReporter->IsCancelled();
+            } );
 
-                return 1;
-            };
+    TASK_GROUP triangulation( GetKiCadTaskScheduler(), &cancelToken );
 
     for( ZONE* zone : zones )
-        returns.emplace_back( tp.submit( cache_zones, zone ) );
-
-    // Finalize the triangulation threads
-    for( const std::future<size_t>& ret : returns )
     {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        triangulation.Run(
+                [zone, aReporter]()
+                {
+                    zone->CacheTriangulation();
 
-        while( status != std::future_status::ready )
-        {
-            if( aReporter )
-                aReporter->KeepRefreshing();
+                    if( aReporter )
+                        aReporter->AdvanceProgress();
+                } );
+    }
 
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
+    // Finalize the triangulation threads
+    while( !triangulation.WaitFor( std::chrono::milliseconds( 250 ) ) )
+    {
+        if( aReporter )
+            aReporter->KeepRefreshing();
     }
 }
 
@@ -2350,6 +2346,12 @@ void BOARD::OnRatsnestChanged()
 }
 
 
+void BOARD::OnNetsChanged( const std::vector<int>& aNetCodes )
+{
+    InvokeListeners( &BOARD_LISTENER::OnBoardNetsChanged, *this, aNetCodes );
+}
+
+
 void BOARD::ResetNetHighLight()
 {
     m_highLight.Clear();
@@ -27,6 +27,7 @@
 
 #include <board_item_container.h>
 #include <common.h> // Needed for stl hash extensions
+#include <core/sharded_cache.h>
 #include <convert_shape_list_to_polygon.h> // for OUTLINE_ERROR_HANDLER
 #include <hash.h>
 #include <layer_ids.h>
@@ -61,6 +62,7 @@ class CONNECTIVITY_DATA;
 class COMPONENT;
 class PROJECT;
 class PROGRESS_REPORTER;
+class PLOT_GEOMETRY_CACHE;
 struct ISOLATED_ISLANDS;
 
 // The default value for m_outlinesChainingEpsilon to convert a board outlines to polygons
@@ -252,6 +254,7 @@ public:
     virtual void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItem ) { }
     virtual void OnBoardHighlightNetChanged( BOARD& aBoard ) { }
     virtual void OnBoardRatsnestChanged( BOARD& aBoard ) { }
+    virtual void OnBoardNetsChanged( BOARD& aBoard, const std::vector<int>& aNetCodes ) { }
 };
 
 /**
@@ -1181,6 +1184,12 @@ public:
      */
     void OnRatsnestChanged();
 
+    /**
+     * Notify the board and its listeners of the nets whose connectivity was updated, so that
+     * they can refresh only what depends on those nets.
+     */
+    void OnNetsChanged( const std::vector<int>& aNetCodes );
+
     /**
      * Consistency check of internal m_groups structure.
      *
@@ -1226,16 +1235,22 @@ public:
     };
 
     // ------------ Run-time caches -------------
-    std::mutex                                            m_CachesMutex;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsFCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsBCourtyardCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_IntersectsAreaCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_EnclosedByAreaCache;
-    std::unordered_map< wxString, LSET >                  m_LayerExpressionCache;
+    // The expression function caches are read and written by all the DRC threads, so they are
+    // sharded rather than sharing one lock.  They are all cleared by IncrementTimeStamp().
+    SHARDED_CACHE<PTR_PTR_CACHE_KEY, bool>                m_IntersectsCourtyardCache;
+    SHARDED_CACHE<PTR_PTR_CACHE_KEY, bool>                m_IntersectsFCourtyardCache;
+    SHARDED_CACHE<PTR_PTR_CACHE_KEY, bool>                m_IntersectsBCourtyardCache;
+    SHARDED_CACHE<PTR_PTR_LAYER_CACHE_KEY, bool>          m_IntersectsAreaCache;
+    SHARDED_CACHE<PTR_PTR_LAYER_CACHE_KEY, bool>          m_EnclosedByAreaCache;
+    SHARDED_CACHE<wxString, LSET>                         m_LayerExpressionCache;
+    mutable SHARDED_CACHE<const ZONE*, BOX2I>             m_ZoneBBoxCache;
+
+    // Only set while a PLOT_GEOMETRY_CACHE_SCOPE is alive
+    std::shared_ptr<PLOT_GEOMETRY_CACHE>                  m_PlotGeometryCache;
+
+    std::mutex                                            m_CachesMutex;    // for the RTrees
     std::unordered_map<ZONE*, std::unique_ptr<DRC_RTREE>> m_CopperZoneRTreeCache;
     std::shared_ptr<DRC_RTREE>                            m_CopperItemRTreeCache;
-    mutable std::unordered_map<const ZONE*, BOX2I>        m_ZoneBBoxCache;
 
     // ------------ DRC caches -------------
     std::vector<ZONE*>    m_DRCZones;
@@ -130,6 +130,8 @@ void BOARD_COMMIT::dirtyIntersectingZones( BOARD_ITEM* item, int aChangeType )
 
     if( layers.any() )
     {
+        zoneFillerTool->DirtyArea( bbox, layers );
+
         for( ZONE* zone : board->Zones() )
         {
             if( zone->GetIsRuleArea() )
@@ -187,6 +189,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
         for( ZONE* zone : board->Zones() )
             zone->CacheBoundingBox();
     }
+    else if( m_isBoardEditor && !( aCommitFlags & ZONE_FILL_OP ) )
+    {
+        // Changes aren't being tracked for auto-fill, so cached zone knockouts go stale
+        if( ZONE_FILLER_TOOL* zoneFillerTool = m_toolMgr->GetTool<ZONE_FILLER_TOOL>() )
+            zoneFillerTool->ClearKnockoutCache();
+    }
 
     for( COMMIT_LINE& ent : m_changes )
     {
@@ -413,8 +421,25 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
         case CHT_MODIFY:
         {
             BOARD_ITEM* boardItemCopy = dynamic_cast<BOARD_ITEM*>( ent.m_copy );
+            bool        moved = false;
 
-            if( !( aCommitFlags & SKIP_UNDO ) )
+            // A footprint which was only moved is restored by moving it back, so the undo list
+            // doesn't need to keep a copy of it and of all its children.
+            if( !( aCommitFlags & SKIP_UNDO ) && ( aCommitFlags & MOVE_OP ) && boardItemCopy
+                    && boardItem->Type() == PCB_FOOTPRINT_T
+                    && boardItemCopy->Type() == PCB_FOOTPRINT_T )
+            {
+                moved = static_cast<FOOTPRINT*>( boardItem )->IsTranslationOf(
+                                *static_cast<FOOTPRINT*>( boardItemCopy ) );
+            }
+
+            if( moved )
+            {
+                ITEM_PICKER itemWrapper( nullptr, boardItem, UNDO_REDO::MOVED );
+                itemWrapper.SetPosition( boardItemCopy->GetPosition() );
+                undoList.PushItem( itemWrapper );
+            }
+            else if( !( aCommitFlags & SKIP_UNDO ) )
             {
                 ITEM_PICKER itemWrapper( nullptr, boardItem, UNDO_REDO::CHANGED );
                 wxASSERT( boardItemCopy );
@@ -442,7 +467,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             itemsChanged.push_back( boardItem );
 
             // if no undo entry is needed, the copy would create a memory leak
-            if( aCommitFlags & SKIP_UNDO )
+            if( ( aCommitFlags & SKIP_UNDO ) || moved )
                 delete ent.m_copy;
 
             break;
@@ -489,6 +514,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 frame->GetCanvas()->RedrawRatsnest();
 
             board->OnRatsnestChanged();
+
+            if( !connectivity->GetChangedNets().empty() )
+                board->OnNetsChanged( connectivity->GetChangedNets() );
         }
 
         if( solderMaskDirty )
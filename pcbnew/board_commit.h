@@ -42,6 +42,7 @@ class TOOL_BASE;
 #define SKIP_CONNECTIVITY  0x0008
 #define ZONE_FILL_OP       0x0010
 #define SKIP_TEARDROPS     0x0020
+#define MOVE_OP            0x0040    // the commit only moves items
 
 class BOARD_COMMIT : public COMMIT
 {
@@ -26,14 +26,14 @@
 
 
 #include <algorithm>
-#include <future>
 #include <mutex>
+#include <unordered_set>
 
 #include <connectivity/connectivity_algo.h>
 #include <progress_reporter.h>
 #include <geometry/geometry_utils.h>
 #include <board_commit.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <pcb_shape.h>
 
 #include <wx/log.h>
@@ -43,6 +43,33 @@
 #endif
 
 
+/**
+ * @return the Z-order (Morton) code of \a aPoint, which keeps nearby points mostly close
+ *         together when sorting.
+ */
+static uint64_t mortonCode( const VECTOR2I& aPoint )
+{
+    auto spread =
+            []( uint32_t aVal ) -> uint64_t
+            {
+                uint64_t v = aVal;
+
+                v = ( v | ( v << 16 ) ) & 0x0000FFFF0000FFFFULL;
+                v = ( v | ( v << 8 ) )  & 0x00FF00FF00FF00FFULL;
+                v = ( v | ( v << 4 ) )  & 0x0F0F0F0F0F0F0F0FULL;
+                v = ( v | ( v << 2 ) )  & 0x3333333333333333ULL;
+                v = ( v | ( v << 1 ) )  & 0x5555555555555555ULL;
+                return v;
+            };
+
+    // Offset to unsigned so that the order is continuous across zero
+    uint32_t x = static_cast<uint32_t>( aPoint.x ) ^ 0x80000000U;
+    uint32_t y = static_cast<uint32_t>( aPoint.y ) ^ 0x80000000U;
+
+    return spread( x ) | ( spread( y ) << 1 );
+}
+
+
 bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
 {
     markItemNetAsDirty( aItem );
@@ -235,6 +262,45 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     m_itemList.RemoveInvalidItems( garbage );
 
+    // The items which were connected to removed ones may now be in different clusters
+    for( CN_ITEM* item : garbage )
+    {
+        for( CN_ITEM* neighbour : item->ConnectedItems() )
+        {
+            if( neighbour->Valid() )
+                m_changedItems.push_back( neighbour );
+        }
+    }
+
+    if( !garbage.empty() )
+    {
+        alg::delete_if( m_changedItems,
+                        []( CN_ITEM* aItem )
+                        {
+                            return !aItem->Valid();
+                        } );
+
+        // The ratsnest clusters of clean nets are kept by incremental updates, so make sure
+        // none of them still refers to a deleted item (its parent may have changed net since
+        // it was clustered)
+        std::unordered_set<CN_ITEM*> deleted( garbage.begin(), garbage.end() );
+
+        for( const std::shared_ptr<CN_CLUSTER>& cluster : m_ratsnestClusters )
+        {
+            if( IsNetDirty( cluster->OriginNet() ) )
+                continue;
+
+            for( CN_ITEM* item : *cluster )
+            {
+                if( deleted.count( item ) )
+                {
+                    MarkNetAsDirty( cluster->OriginNet() );
+                    break;
+                }
+            }
+        }
+    }
+
     for( CN_ITEM* item : garbage )
         delete item;
 
@@ -243,7 +309,6 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     PROF_TIMER search_basic( "search-basic" );
 #endif
 
-    thread_pool& tp = GetKiCadThreadPool();
     std::vector<CN_ITEM*> dirtyItems;
     std::copy_if( m_itemList.begin(), m_itemList.end(), std::back_inserter( dirtyItems ),
                   [] ( CN_ITEM* aItem )
@@ -251,6 +316,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
                       return aItem->Dirty();
                   } );
 
+    m_changedItems.insert( m_changedItems.end(), dirtyItems.begin(), dirtyItems.end() );
+
     if( m_progressReporter )
     {
         m_progressReporter->SetMaxProgress( dirtyItems.size() );
@@ -261,39 +328,68 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     if( m_itemList.IsDirty() )
     {
+        // Query the items in Z-order of their centres so that the queries of a batch visit
+        // mostly the same R-tree nodes
+        std::vector<std::pair<uint64_t, CN_ITEM*>> ordered;
+        ordered.reserve( dirtyItems.size() );
 
-        std::vector<std::future<size_t>> returns( dirtyItems.size() );
+        for( CN_ITEM* item : dirtyItems )
+        {
+            VECTOR2I centre = item->BBox().Centre();
 
-        auto conn_lambda =
-                [&dirtyItems]( size_t aItem, CN_LIST* aItemList,
-                               PROGRESS_REPORTER* aReporter) -> size_t
-                {
-                    if( aReporter && aReporter->IsCancelled() )
-                        return 0;
+            ordered.emplace_back( mortonCode( centre ), item );
+        }
 
-                    CN_VISITOR visitor( dirtyItems[aItem] );
-                    aItemList->FindNearby( dirtyItems[aItem], visitor );
+        std::sort( ordered.begin(), ordered.end(),
+                   []( const std::pair<uint64_t, CN_ITEM*>& aA,
+                       const std::pair<uint64_t, CN_ITEM*>& aB )
+                   {
+                       return aA.first < aB.first;
+                   } );
+
+        // Each batch collects its connections in its own list, so the items are only modified
+        // (without locking) once all the searches are done
+        const size_t                          batchSize = 64;
+        size_t                                batchCount = ( ordered.size() + batchSize - 1 )
+                                                                    / batchSize;
+        std::vector<CN_VISITOR::CONNECTIONS>  connections( batchCount );
+        PROGRESS_REPORTER*                    reporter = m_progressReporter;
+        TASK_GROUP                            group( GetKiCadTaskScheduler() );
+
+        for( size_t batch = 0; batch < batchCount; ++batch )
+        {
+            group.Run(
+                    [&, batch]()
+                    {
+                        size_t last = std::min( ordered.size(), ( batch + 1 ) * batchSize );
 
-                    if( aReporter )
-                        aReporter->AdvanceProgress();
+                        for( size_t ii = batch * batchSize; ii < last; ++ii )
+                        {
+                            if( reporter && reporter->IsCancelled() )
+                                return;
 
-                    return 1;
-                };
+                            CN_VISITOR visitor( ordered[ii].second, connections[batch] );
+                            m_itemList.FindNearby( ordered[ii].second, visitor );
 
-        for( size_t ii = 0; ii < dirtyItems.size(); ++ii )
-            returns[ii] = tp.submit( conn_lambda, ii, &m_itemList, m_progressReporter );
+                            if( reporter )
+                                reporter->AdvanceProgress();
+                        }
+                    } );
+        }
 
-        for( const std::future<size_t>& ret : returns )
+        // Balance waiting with a 250ms timeout to allow UI updating
+        while( !group.WaitFor( std::chrono::milliseconds( 250 ) ) )
         {
-            // Here we balance returns with a 250ms timeout to allow UI updating
-            std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+            if( m_progressReporter )
+                m_progressReporter->KeepRefreshing();
+        }
 
-            while( status != std::future_status::ready )
+        for( const CN_VISITOR::CONNECTIONS& batch : connections )
+        {
+            for( const auto& [ itemA, itemB ] : batch )
             {
-                if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
-
-                status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+                itemA->Connect( itemB );
+                itemB->Connect( itemA );
             }
         }
 
@@ -331,7 +427,7 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 const CN_CONNECTIVITY_ALGO::CLUSTERS
 CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                       const std::initializer_list<KICAD_T>& aTypes,
-                                      int aSingleNet, CN_ITEM* rootItem )
+                                      int aSingleNet, CN_ITEM* rootItem, bool aDirtyNetsOnly )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
@@ -344,7 +440,7 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
         searchConnections();
 
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, &aTypes, rootItem ]( CN_ITEM *aItem )
+            [this, &item_set, withinAnyNet, aSingleNet, &aTypes, rootItem, aDirtyNetsOnly ]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -355,6 +451,9 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
                 if( aSingleNet >=0 && aItem->Net() != aSingleNet )
                     return;
 
+                if( aDirtyNetsOnly && !IsNetDirty( aItem->Net() ) )
+                    return;
+
                 bool found = false;
 
                 for( KICAD_T type : aTypes )
@@ -470,6 +569,9 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
     for( FOOTPRINT* footprint : aBoard->Footprints() )
         size += footprint->Pads().size();
 
+    // At most one entry per track, pad, drawing and zone layer
+    m_itemMap.reserve( m_itemMap.size() + (size_t) size - zitems.size() );
+
     size *= 1.5;                  // Our caller gets the other third of the progress bar
 
     progressDelta = std::max( progressDelta, (int) size / 4 );
@@ -486,38 +588,30 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     // Generate RTrees for CN_ZONE_LAYER items (in parallel)
     //
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<std::future<size_t>> returns( zitems.size() );
-
-    auto cache_zones =
-            [aReporter]( CN_ZONE_LAYER* aZoneLayer ) -> size_t
+    CANCELLATION_TOKEN cancelToken(
+            [aReporter]()
             {
-                if( aReporter && aReporter->IsCancelled() )
-                    return 0;
+                return aReporter && aReporter->IsCancelled();
+            } );
 
-                aZoneLayer->BuildRTree();
+    TASK_GROUP rtrees( GetKiCadTaskScheduler(), &cancelToken );
 
-                if( aReporter )
-                    aReporter->AdvanceProgress();
-
-                return 1;
-            };
-
-    for( size_t ii = 0; ii < zitems.size(); ++ii )
-        returns[ii] = tp.submit( cache_zones, zitems[ii] );
-
-    for( const std::future<size_t>& ret : returns )
+    for( CN_ZONE_LAYER* zitem : zitems )
     {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-
-        while( status != std::future_status::ready )
-        {
-            if( aReporter )
-                aReporter->KeepRefreshing();
+        rtrees.Run(
+                [zitem, aReporter]()
+                {
+                    zitem->BuildRTree();
 
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
+                    if( aReporter )
+                        aReporter->AdvanceProgress();
+                } );
+    }
 
+    while( !rtrees.WaitFor( std::chrono::milliseconds( 250 ) ) )
+    {
+        if( aReporter )
+            aReporter->KeepRefreshing();
     }
 
     // Add CN_ZONE_LAYERS, tracks, and pads to connectivity
@@ -646,9 +740,63 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 }
 
 
-void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
+const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::searchChangedClusters()
 {
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+    if( m_itemList.IsDirty() )
+        searchConnections();
+
+    // Connected components are the same whichever of their items the search starts from.
+    // Components without any of the CSM_PROPAGATE root types (zone islands) have nothing
+    // to propagate to, so it doesn't matter that they're included.
+    std::unordered_set<CN_ITEM*> visited;
+    std::deque<CN_ITEM*>         Q;
+    CLUSTERS                     clusters;
+
+    for( CN_ITEM* root : m_changedItems )
+    {
+        if( !root->Valid() || !visited.insert( root ).second )
+            continue;
+
+        std::shared_ptr<CN_CLUSTER> cluster = std::make_shared<CN_CLUSTER>();
+
+        Q.clear();
+        Q.push_back( root );
+
+        while( Q.size() )
+        {
+            CN_ITEM* current = Q.front();
+
+            Q.pop_front();
+            cluster->Add( current );
+
+            for( CN_ITEM* n : current->ConnectedItems() )
+            {
+                if( n->Valid() && visited.insert( n ).second )
+                    Q.push_back( n );
+            }
+        }
+
+        clusters.push_back( cluster );
+    }
+
+    std::sort( clusters.begin(), clusters.end(),
+               []( const std::shared_ptr<CN_CLUSTER>& a, const std::shared_ptr<CN_CLUSTER>& b )
+               {
+                   return a->OriginNet() < b->OriginNet();
+               } );
+
+    return clusters;
+}
+
+
+void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit, bool aIncremental )
+{
+    if( aIncremental )
+        m_connClusters = searchChangedClusters();
+    else
+        m_connClusters = SearchClusters( CSM_PROPAGATE );
+
+    m_changedItems.clear();
     propagateConnections( aCommit );
 }
 
@@ -710,9 +858,33 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap(
 }
 
 
-const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
+const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters( bool aDirtyNetsOnly )
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    if( !aDirtyNetsOnly )
+    {
+        m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+        return m_ratsnestClusters;
+    }
+
+    // Clusters never span nets, so those of clean nets are still valid
+    CLUSTERS clusters = SearchClusters( CSM_RATSNEST,
+                                        { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_T,
+                                          PCB_FOOTPRINT_T, PCB_SHAPE_T },
+                                        -1, nullptr, true );
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : m_ratsnestClusters )
+    {
+        if( !IsNetDirty( cluster->OriginNet() ) )
+            clusters.push_back( cluster );
+    }
+
+    std::sort( clusters.begin(), clusters.end(),
+               []( const std::shared_ptr<CN_CLUSTER>& a, const std::shared_ptr<CN_CLUSTER>& b )
+               {
+                   return a->OriginNet() < b->OriginNet();
+               } );
+
+    m_ratsnestClusters = std::move( clusters );
     return m_ratsnestClusters;
 }
 
@@ -750,8 +922,7 @@ void CN_VISITOR::checkZoneItemConnection( CN_ZONE_LAYER* aZoneLayer, CN_ITEM* aI
     auto connect =
             [&]()
             {
-                aZoneLayer->Connect( aItem );
-                aItem->Connect( aZoneLayer );
+                m_connections.emplace_back( aZoneLayer, aItem );
             };
 
     // Try quick checks first...
@@ -825,8 +996,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
 
         if( aZoneLayerB->ContainsPoint( outline.CPoint( i ) ) )
         {
-            aZoneLayerA->Connect( aZoneLayerB );
-            aZoneLayerB->Connect( aZoneLayerA );
+            m_connections.emplace_back( aZoneLayerA, aZoneLayerB );
             return;
         }
     }
@@ -841,8 +1011,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
 
         if( aZoneLayerA->ContainsPoint( outline2.CPoint( i ) ) )
         {
-            aZoneLayerA->Connect( aZoneLayerB );
-            aZoneLayerB->Connect( aZoneLayerA );
+            m_connections.emplace_back( aZoneLayerA, aZoneLayerB );
             return;
         }
     }
@@ -922,8 +1091,7 @@ bool CN_VISITOR::operator()( CN_ITEM* aCandidate )
         if( parentA->GetEffectiveShape( layer, flashingA )->Collide(
                 parentB->GetEffectiveShape( layer, flashingB ).get() ) )
         {
-            m_item->Connect( aCandidate );
-            aCandidate->Connect( m_item );
+            m_connections.emplace_back( m_item, aCandidate );
             return true;
         }
     }
@@ -936,6 +1104,7 @@ void CN_CONNECTIVITY_ALGO::Clear()
 {
     m_ratsnestClusters.clear();
     m_connClusters.clear();
+    m_changedItems.clear();
     m_itemMap.clear();
     m_itemList.Clear();
 
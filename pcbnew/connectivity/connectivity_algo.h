@@ -159,12 +159,12 @@ public:
             m_items.push_back( aItem );
         }
 
-        const std::list<CN_ITEM*>& GetItems() const
+        const std::vector<CN_ITEM*>& GetItems() const
         {
             return m_items;
         }
 
-        std::list<CN_ITEM*> m_items;
+        std::vector<CN_ITEM*> m_items;
     };
 
     CN_CONNECTIVITY_ALGO( CONNECTIVITY_DATA* aParentConnectivityData ) :
@@ -189,7 +189,7 @@ public:
 
     bool IsNetDirty( int aNet ) const
     {
-        if( aNet < 0 )
+        if( aNet < 0 || aNet >= (int) m_dirtyNets.size() )
             return false;
 
         return m_dirtyNets[ aNet ];
@@ -226,16 +226,22 @@ public:
     bool Remove( BOARD_ITEM* aItem );
     bool Add( BOARD_ITEM* aItem );
 
+    /**
+     * @param aDirtyNetsOnly restricts the search to the items of nets marked as dirty.
+     */
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                    const std::initializer_list<KICAD_T>& aTypes,
-                                   int aSingleNet, CN_ITEM* rootItem = nullptr );
+                                   int aSingleNet, CN_ITEM* rootItem = nullptr,
+                                   bool aDirtyNetsOnly = false );
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
     /**
      * Propagate nets from pads to other items in clusters.
      * @param aCommit is used to store undo information for items modified by the call.
+     * @param aIncremental restricts the propagation to the clusters of the items added,
+     *                     changed or disconnected by a removal since the last propagation.
      */
-    void PropagateNets( BOARD_COMMIT* aCommit = nullptr );
+    void PropagateNets( BOARD_COMMIT* aCommit = nullptr, bool aIncremental = false );
 
     /**
      * Fill in the isolated islands map with copper islands that are not connected to a net.
@@ -243,7 +249,13 @@ public:
     void FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>>& aMap,
                                  bool aConnectivityAlreadyRebuilt );
 
-    const CLUSTERS& GetClusters();
+    /**
+     * Search the ratsnest clusters.
+     *
+     * @param aDirtyNetsOnly only searches the nets marked as dirty, keeping the previous
+     *                       clusters of the other nets.
+     */
+    const CLUSTERS& GetClusters( bool aDirtyNetsOnly = false );
 
     const CN_LIST& ItemList() const
     {
@@ -277,6 +289,11 @@ private:
 
     void propagateConnections( BOARD_COMMIT* aCommit = nullptr );
 
+    /**
+     * Search the CSM_PROPAGATE clusters containing the changed items.
+     */
+    const CLUSTERS searchChangedClusters();
+
     template <class Container, class BItem>
     void add( Container& c, BItem brditem )
     {
@@ -296,6 +313,9 @@ private:
     std::vector<std::shared_ptr<CN_CLUSTER>>              m_ratsnestClusters;
     std::vector<bool>                                     m_dirtyNets;
 
+    ///< Items added, changed or connected to removed items since the last net propagation
+    std::vector<CN_ITEM*>                                 m_changedItems;
+
     bool                                                  m_isLocal;
     std::shared_ptr<CONNECTIVITY_DATA>                    m_globalConnectivityData;
 
@@ -306,8 +326,16 @@ private:
 class CN_VISITOR
 {
 public:
-    CN_VISITOR( CN_ITEM* aItem ) :
-        m_item( aItem )
+    using CONNECTIONS = std::vector<std::pair<CN_ITEM*, CN_ITEM*>>;
+
+    /**
+     * @param aConnections receives the pairs of touching items found, each pair once.  They
+     *                     are added to the items by the caller, so that visitors can run on
+     *                     several threads without locking the items.
+     */
+    CN_VISITOR( CN_ITEM* aItem, CONNECTIONS& aConnections ) :
+        m_item( aItem ),
+        m_connections( aConnections )
     {}
 
     bool operator()( CN_ITEM* aCandidate );
@@ -318,7 +346,8 @@ protected:
     void checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LAYER* aZoneLayerB );
 
 protected:
-    CN_ITEM* m_item;        ///< The item we are looking for connections to.
+    CN_ITEM*     m_item;        ///< The item we are looking for connections to.
+    CONNECTIONS& m_connections;
 };
 
 #endif
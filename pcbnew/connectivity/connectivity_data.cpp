@@ -28,9 +28,9 @@
 #endif
 
 #include <algorithm>
-#include <future>
 #include <initializer_list>
 
+#include <advanced_config.h>
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
 #include <connectivity/from_to_cache.h>
@@ -40,7 +40,7 @@
 #include <geometry/shape_circle.h>
 #include <ratsnest/ratsnest_data.h>
 #include <progress_reporter.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <trigo.h>
 #include <drc/drc_rtree.h>
 
@@ -183,23 +183,19 @@ void CONNECTIVITY_DATA::updateRatsnest()
                 return aNet->IsDirty() && aNet->GetNodeCount() > 0;
             } );
 
-    thread_pool& tp = GetKiCadThreadPool();
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
-            {
-                for( int ii = a; ii < b; ++ii )
-                    dirty_nets[ii]->UpdateNet();
-            } );
-    tp.wait_for_tasks();
+    ParallelFor( scheduler, 0, dirty_nets.size(),
+                 [&]( size_t ii )
+                 {
+                     dirty_nets[ii]->UpdateNet();
+                 } );
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
-            {
-                for( int ii = a; ii < b; ++ii )
-                    dirty_nets[ii]->OptimizeRNEdges();
-            } );
-    tp.wait_for_tasks();
+    ParallelFor( scheduler, 0, dirty_nets.size(),
+                 [&]( size_t ii )
+                 {
+                     dirty_nets[ii]->OptimizeRNEdges();
+                 } );
 
 #ifdef PROFILE
     rnUpdate.Show();
@@ -228,7 +224,11 @@ void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 
 void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
-    m_connAlgo->PropagateNets( aCommit );
+    // Edits only affect the clusters of the items they touch.  Full rebuilds (and loading)
+    // have no commit, so always search everything.
+    bool incremental = aCommit && ADVANCED_CFG::GetCfg().m_IncrementalConnectivity;
+
+    m_connAlgo->PropagateNets( aCommit, incremental );
 
     int lastNet = m_connAlgo->NetCount();
 
@@ -246,16 +246,16 @@ void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
             m_nets[ii]->Clear();
     }
 
-    const std::vector<std::shared_ptr<CN_CLUSTER>>& clusters = m_connAlgo->GetClusters();
+    const std::vector<std::shared_ptr<CN_CLUSTER>>& clusters = m_connAlgo->GetClusters( incremental );
 
-    int dirtyNets = 0;
+    m_changedNets.clear();
 
     for( int net = 0; net < lastNet; net++ )
     {
         if( m_connAlgo->IsNetDirty( net ) )
         {
             m_nets[net]->Clear();
-            dirtyNets++;
+            m_changedNets.push_back( net );
         }
     }
 
@@ -367,16 +367,9 @@ void CONNECTIVITY_DATA::ComputeLocalRatsnest( const std::vector<BOARD_ITEM*>& aI
         }
     };
 
-    thread_pool& tp = GetKiCadThreadPool();
     size_t num_nets = std::min( m_nets.size(), aDynamicData->m_nets.size() );
 
-    tp.push_loop( 1, num_nets,
-            [&]( const int a, const int b)
-            {
-                for( int ii = a; ii < b; ++ii )
-                    update_lambda( ii );
-            });
-    tp.wait_for_tasks();
+    ParallelFor( GetKiCadTaskScheduler(), 1, num_nets, update_lambda );
 
     // This gets the ratsnest for internal connections in the moving set
     const std::vector<CN_EDGE>& edges = GetRatsnestForItems( aItems );
@@ -455,7 +448,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
                     if( zone->IsFilled() )
                     {
-                        const SHAPE_POLY_SET*   zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
+                        PCB_LAYER_ID            layer = ToLAYER_ID( aLayer );
+                        const SHAPE_POLY_SET*   zoneFill = zone->GetFilledPolysList( layer ).get();
                         const SHAPE_LINE_CHAIN& padHull = pad->GetEffectivePolygon( ERROR_INSIDE )->Outline( 0 );
 
                         for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
@@ -479,7 +473,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
                     if( zone->IsFilled() )
                     {
-                        const SHAPE_POLY_SET* zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
+                        PCB_LAYER_ID          layer = ToLAYER_ID( aLayer );
+                        const SHAPE_POLY_SET* zoneFill = zone->GetFilledPolysList( layer ).get();
                         SHAPE_CIRCLE          viaHull( via->GetCenter(), via->GetWidth() / 2 );
 
                         for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
@@ -742,7 +737,7 @@ static int getMinDist( BOARD_CONNECTED_ITEM* aItem, const VECTOR2I& aPoint )
 bool CONNECTIVITY_DATA::TestTrackEndpointDangling( PCB_TRACK* aTrack, bool aIgnoreTracksInPads,
                                                    VECTOR2I* aPos ) const
 {
-    const std::list<CN_ITEM*>& items = GetConnectivityAlgo()->ItemEntry( aTrack ).GetItems();
+    const std::vector<CN_ITEM*>& items = GetConnectivityAlgo()->ItemEntry( aTrack ).GetItems();
 
     // Not in the connectivity system.  This is a bug!
     if( items.empty() )
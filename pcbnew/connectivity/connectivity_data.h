@@ -156,6 +156,11 @@ public:
      */
     RN_NET* GetRatsnestForNet( int aNet );
 
+    /**
+     * @return the codes of the nets whose ratsnest was recomputed by the last update.
+     */
+    const std::vector<int>& GetChangedNets() const { return m_changedNets; }
+
     /**
      * Propagates the net codes from the source pads to the tracks/vias.
      * @param aCommit is used to save the undo state of items modified by this call
@@ -303,6 +308,9 @@ private:
     std::vector<RN_DYNAMIC_LINE>    m_dynamicRatsnest;
     std::vector<RN_NET*>            m_nets;
 
+    /// Nets whose clusters were searched again by the last ratsnest update
+    std::vector<int>                m_changedNets;
+
     /// Used to suppress ratsnest calculations on dynamic ratsnests
     bool                            m_skipRatsnestUpdate;
 
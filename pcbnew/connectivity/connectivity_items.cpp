@@ -225,7 +225,7 @@ CN_ITEM* CN_LIST::Add( PCB_VIA* via )
 
 const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 {
-    const std::shared_ptr<SHAPE_POLY_SET>& polys = zone->GetFilledPolysList( aLayer );
+    std::shared_ptr<const SHAPE_POLY_SET> polys = zone->GetFilledPolysList( aLayer );
 
     std::vector<CN_ITEM*> rv;
 
@@ -235,7 +235,11 @@ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 
         zitem->BuildRTree();
 
-        for( const VECTOR2I& pt : zone->GetFilledPolysList( aLayer )->COutline( j ).CPoints() )
+        const std::vector<VECTOR2I>& pts = polys->COutline( j ).CPoints();
+
+        zitem->ReserveAnchors( (int) pts.size() );
+
+        for( const VECTOR2I& pt : pts )
             zitem->AddAnchor( pt );
 
         rv.push_back( Add( zitem ) );
@@ -256,10 +260,13 @@ CN_ITEM* CN_LIST::Add( CN_ZONE_LAYER* zitem )
 
 CN_ITEM* CN_LIST::Add( PCB_SHAPE* shape )
 {
-    CN_ITEM* item = new CN_ITEM( shape, true );
+    CN_ITEM*              item = new CN_ITEM( shape, true );
+    std::vector<VECTOR2I> points = shape->GetConnectionPoints();
+
     m_items.push_back( item );
+    item->ReserveAnchors( (int) points.size() );
 
-    for( const VECTOR2I& point : shape->GetConnectionPoints() )
+    for( const VECTOR2I& point : points )
         item->AddAnchor( point );
 
     item->SetLayer( shape->GetLayer() );
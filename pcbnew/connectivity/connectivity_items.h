@@ -141,7 +141,7 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
-        m_anchors.reserve( std::max( 6, aAnchorCount ) );
+        ReserveAnchors( aAnchorCount );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
         m_connected.reserve( 8 );
     }
@@ -152,10 +152,29 @@ public:
             anchor->SetItem( nullptr );
     };
 
+    /**
+     * Size the next block of anchors to hold \a aCount of them.
+     */
+    void ReserveAnchors( int aCount )
+    {
+        m_anchorBlockSize = std::max( 1, aCount );
+        m_anchors.reserve( m_anchors.size() + m_anchorBlockSize );
+    }
+
     std::shared_ptr<CN_ANCHOR> AddAnchor( const VECTOR2I& aPos )
     {
-        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
-        return m_anchors.at( m_anchors.size() - 1 );
+        // Anchors are stored in blocks owned jointly by the anchors they hold, so an item's
+        // anchors cost one allocation rather than one each.  A full block is never grown, as
+        // that would move its anchors; a new one is started instead.
+        if( !m_anchorBlock || m_anchorBlock->size() == m_anchorBlock->capacity() )
+        {
+            m_anchorBlock = std::make_shared<std::vector<CN_ANCHOR>>();
+            m_anchorBlock->reserve( std::max<size_t>( m_anchorBlockSize, m_anchors.size() ) );
+        }
+
+        m_anchorBlock->emplace_back( aPos, this );
+        m_anchors.emplace_back( m_anchorBlock, &m_anchorBlock->back() );
+        return m_anchors.back();
     }
 
     std::vector<std::shared_ptr<CN_ANCHOR>>& Anchors() { return m_anchors; }
@@ -207,10 +226,12 @@ public:
 
     bool CanChangeNet() const { return m_canChangeNet; }
 
+    /**
+     * Record that \a b touches this item.  Not thread-safe: the connection search collects
+     * the connections found by its worker threads and adds them afterwards.
+     */
     void Connect( CN_ITEM* b )
     {
-        std::lock_guard<std::mutex> lock( m_listLock );
-
         auto i = std::lower_bound( m_connected.begin(), m_connected.end(), b );
 
         if( i != m_connected.end() && *i == b )
@@ -241,12 +262,13 @@ private:
     std::vector<CN_ITEM*>                    m_connected;   ///< list of physically touching items
     std::vector<std::shared_ptr<CN_ANCHOR>>  m_anchors;
 
+    std::shared_ptr<std::vector<CN_ANCHOR>>  m_anchorBlock;     ///< block new anchors go to
+    int                                      m_anchorBlockSize;
+
     bool            m_canChangeNet;  ///< can the net propagator modify the netcode?
 
     bool            m_visited;       ///< visited flag for the BFS scan
     bool            m_valid;         ///< used to identify garbage items (we use lazy removal)
-
-    std::mutex      m_listLock;      ///< mutex protecting this item's connected_items set to
 };
 
 
@@ -360,11 +382,11 @@ public:
     bool HasSingleConnection();
 
 private:
-    ZONE*                               m_zone;
-    int                                 m_subpolyIndex;
-    PCB_LAYER_ID                        m_layer;
-    std::shared_ptr<SHAPE_POLY_SET>     m_fillPoly;
-    RTree<const SHAPE*, int, 2, double> m_rTree;
+    ZONE*                                 m_zone;
+    int                                   m_subpolyIndex;
+    PCB_LAYER_ID                          m_layer;
+    std::shared_ptr<const SHAPE_POLY_SET> m_fillPoly;
+    RTree<const SHAPE*, int, 2, double>   m_rTree;
 };
 
 
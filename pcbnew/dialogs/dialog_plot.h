@@ -24,6 +24,7 @@
 #include <board.h>
 #include <dialog_plot_base.h>
 #include <pcb_plot_params.h>
+#include <plot_geometry_cache.h>
 #include <widgets/unit_binder.h>
 
 // the plot dialog window name, used by wxWidgets
@@ -94,6 +95,10 @@ private:
     UNIT_BINDER         m_defaultPenSize;
     UNIT_BINDER         m_trackWidthCorrection;
 
+    /// Kept while the dialog is open so that plotting again, or in another format, reuses the
+    /// pads, solder mask and zone areas built by the previous plot.
+    PLOT_GEOMETRY_CACHE_SCOPE m_plotCache;
+
     wxString            m_DRCWarningTemplate;
 
     PCB_PLOT_PARAMS     m_plotOpts;
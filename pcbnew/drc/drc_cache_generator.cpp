@@ -24,7 +24,7 @@
 #include <common.h>
 #include <board_design_settings.h>
 #include <footprint.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <zone.h>
 #include <connectivity/connectivity_data.h>
 #include <drc/drc_engine.h>
@@ -35,11 +35,17 @@ bool DRC_CACHE_GENERATOR::Run()
 {
     m_board = m_drcEngine->GetBoard();
 
-    int&           largestClearance = m_board->m_DRCMaxClearance;
-    int&           largestPhysicalClearance = m_board->m_DRCMaxPhysicalClearance;
-    DRC_CONSTRAINT worstConstraint;
-    LSET           boardCopperLayers = LSET::AllCuMask( m_board->GetCopperLayerCount() );
-    thread_pool&   tp = GetKiCadThreadPool();
+    int&            largestClearance = m_board->m_DRCMaxClearance;
+    int&            largestPhysicalClearance = m_board->m_DRCMaxPhysicalClearance;
+    DRC_CONSTRAINT  worstConstraint;
+    LSET            boardCopperLayers = LSET::AllCuMask( m_board->GetCopperLayerCount() );
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+
+    CANCELLATION_TOKEN cancelToken(
+            [this]()
+            {
+                return m_drcEngine->IsCancelled();
+            } );
 
 
     largestClearance = std::max( largestClearance, m_board->GetMaxClearanceValue() );
@@ -133,7 +139,9 @@ bool DRC_CACHE_GENERATOR::Run()
 
     forEachGeometryItem( itemTypes, LSET::AllCuMask(), countItems );
 
-    std::future<void> retn = tp.submit(
+    TASK_GROUP copperTreeGroup( scheduler, &cancelToken );
+
+    copperTreeGroup.Run(
             [&]()
             {
                 std::unique_lock<std::mutex> cacheLock( m_board->m_CachesMutex );
@@ -144,13 +152,8 @@ bool DRC_CACHE_GENERATOR::Run()
                 forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
             } );
 
-    std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
-
-    while( status != std::future_status::ready )
-    {
+    while( !copperTreeGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
         reportProgress( done, count );
-        status = retn.wait_for( std::chrono::milliseconds( 250 ) );
-    }
 
     if( !reportPhase( _( "Tessellating copper zones..." ) ) )
         return false;   // DRC cancelled
@@ -161,16 +164,9 @@ bool DRC_CACHE_GENERATOR::Run()
     for( FOOTPRINT* footprint : m_board->Footprints() )
         footprint->BuildCourtyardCaches();
 
-    std::vector<std::future<size_t>> returns;
-
-    returns.reserve( allZones.size() );
-
     auto cache_zones =
-            [this, &done]( ZONE* aZone ) -> size_t
+            [this, &done]( ZONE* aZone )
             {
-                if( m_drcEngine->IsCancelled() )
-                    return 0;
-
                 aZone->CacheBoundingBox();
                 aZone->CacheTriangulation();
 
@@ -189,25 +185,19 @@ bool DRC_CACHE_GENERATOR::Run()
 
                    done.fetch_add( 1 );
                 }
-
-                return 1;
             };
 
-    for( ZONE* zone : allZones )
-        returns.emplace_back( tp.submit( cache_zones, zone ) );
-
     done.store( 1 );
 
-    for( const std::future<size_t>& ret : returns )
-    {
-        status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+    // One task per zone, so that idle workers pick up the remaining zones while a large one is
+    // still being tessellated.
+    TASK_GROUP zoneGroup( scheduler, &cancelToken );
 
-        while( status != std::future_status::ready )
-        {
-            reportProgress( done, allZones.size() );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
+    for( ZONE* zone : allZones )
+        zoneGroup.Run( [&cache_zones, zone]() { cache_zones( zone ); } );
+
+    while( !zoneGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( done, allZones.size() );
 
     m_board->m_ZoneIsolatedIslandsMap.clear();
 
@@ -37,9 +37,9 @@
 #include <drc/drc_item.h>
 #include <drc/drc_cache_generator.h>
 #include <footprint.h>
+#include <hash.h>
 #include <pad.h>
 #include <pcb_track.h>
-#include <core/thread_pool.h>
 #include <zone.h>
 
 
@@ -72,6 +72,7 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_rulesValid( false ),
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
+    m_conditionCacheTimeStamp( -1 ),
     m_reporter( nullptr ),
     m_progressReporter( nullptr )
 {
@@ -86,13 +87,7 @@ DRC_ENGINE::~DRC_ENGINE()
 {
     m_rules.clear();
 
-    for( std::pair<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> pair : m_constraintMap )
-    {
-        for( DRC_ENGINE_CONSTRAINT* constraint : *pair.second )
-            delete constraint;
-
-        delete pair.second;
-    }
+    clearConstraintMaps();
 }
 
 
@@ -514,6 +509,125 @@ void DRC_ENGINE::compileRules()
             m_constraintMap[ constraint.m_Type ]->push_back( engineConstraint );
         }
     }
+
+    // Most rules only apply to some layers; sort them out once rather than for every item pair
+    for( const auto& [ constraintType, ruleset ] : m_constraintMap )
+    {
+        std::vector<std::vector<DRC_ENGINE_CONSTRAINT*>>& layerRulesets =
+                m_layerConstraintMap[ constraintType ];
+
+        layerRulesets.resize( PCB_LAYER_ID_COUNT );
+
+        for( DRC_ENGINE_CONSTRAINT* c : *ruleset )
+        {
+            for( PCB_LAYER_ID layer : c->layerTest.Seq() )
+                layerRulesets[ layer ].push_back( c );
+        }
+    }
+}
+
+
+void DRC_ENGINE::clearConstraintMaps()
+{
+    for( std::pair<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> pair : m_constraintMap )
+    {
+        for( DRC_ENGINE_CONSTRAINT* constraint : *pair.second )
+            delete constraint;
+
+        delete pair.second;
+    }
+
+    m_constraintMap.clear();
+    m_layerConstraintMap.clear();
+
+    std::unique_lock<std::shared_mutex> writeLock( m_conditionCacheLock );
+    m_conditionCache.clear();
+}
+
+
+const std::vector<DRC_ENGINE::DRC_ENGINE_CONSTRAINT*>*
+DRC_ENGINE::getConstraints( DRC_CONSTRAINT_T aConstraintType, PCB_LAYER_ID aLayer,
+                            REPORTER* aReporter )
+{
+    auto it = m_constraintMap.find( aConstraintType );
+
+    if( it == m_constraintMap.end() )
+        return nullptr;
+
+    // When reporting, rules on other layers must still be visited to explain why they don't
+    // apply.  Otherwise skipping them makes no difference as they would be rejected by their
+    // layer test anyway.
+    if( aReporter || aLayer < 0 || aLayer >= PCB_LAYER_ID_COUNT )
+        return it->second;
+
+    return &m_layerConstraintMap.at( aConstraintType )[ aLayer ];
+}
+
+
+std::size_t
+DRC_ENGINE::CONDITION_CACHE_KEY_HASH::operator()( const CONDITION_CACHE_KEY& aKey ) const
+{
+    return hash_val( aKey.m_Condition, aKey.m_TypeA, aKey.m_NetA, aKey.m_TypeB, aKey.m_NetB );
+}
+
+
+bool DRC_ENGINE::evalCondition( DRC_RULE_CONDITION* aCondition, const BOARD_ITEM* a,
+                                const BOARD_ITEM* b, DRC_CONSTRAINT_T aConstraintType,
+                                PCB_LAYER_ID aLayer, REPORTER* aReporter )
+{
+    // Cached results can't explain themselves
+    if( aReporter || !aCondition->IsMemoizable() )
+        return aCondition->EvaluateFor( a, b, aConstraintType, aLayer, aReporter );
+
+    auto itemKey =
+            []( const BOARD_ITEM* aItem ) -> std::pair<int, const NETINFO_ITEM*>
+            {
+                if( !aItem )
+                    return { NOT_USED, nullptr };
+
+                auto cItem = dynamic_cast<const BOARD_CONNECTED_ITEM*>( aItem );
+
+                return { aItem->Type(), cItem ? cItem->GetNet() : nullptr };
+            };
+
+    std::pair<int, const NETINFO_ITEM*> keyA = itemKey( a );
+    std::pair<int, const NETINFO_ITEM*> keyB = itemKey( b );
+
+    // Conditions are commutative
+    if( keyB < keyA )
+        std::swap( keyA, keyB );
+
+    CONDITION_CACHE_KEY key = { aCondition, keyA.first, keyA.second, keyB.first, keyB.second };
+    int                 timeStamp = m_board->GetTimeStamp();
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_conditionCacheLock );
+
+        if( m_conditionCacheTimeStamp == timeStamp )
+        {
+            auto it = m_conditionCache.find( key );
+
+            if( it != m_conditionCache.end() )
+                return it->second;
+        }
+    }
+
+    bool result = aCondition->EvaluateFor( a, b, aConstraintType, aLayer, nullptr );
+
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_conditionCacheLock );
+
+        // Nets (and their netclasses) may have changed since the cache was filled
+        if( m_conditionCacheTimeStamp != timeStamp )
+        {
+            m_conditionCache.clear();
+            m_conditionCacheTimeStamp = timeStamp;
+        }
+
+        m_conditionCache[ key ] = result;
+    }
+
+    return result;
 }
 
 
@@ -530,15 +644,7 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
     m_rules.clear();
     m_rulesValid = false;
 
-    for( std::pair<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> pair : m_constraintMap )
-    {
-        for( DRC_ENGINE_CONSTRAINT* constraint : *pair.second )
-            delete constraint;
-
-        delete pair.second;
-    }
-
-    m_constraintMap.clear();
+    clearConstraintMaps();
 
     m_board->IncrementTimeStamp();  // Clear board-level caches
 
@@ -599,6 +705,13 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
     int timestamp = m_board->GetTimeStamp();
 
+    m_board->m_IntersectsCourtyardCache.ResetStats();
+    m_board->m_IntersectsFCourtyardCache.ResetStats();
+    m_board->m_IntersectsBCourtyardCache.ResetStats();
+    m_board->m_IntersectsAreaCache.ResetStats();
+    m_board->m_EnclosedByAreaCache.ResetStats();
+    m_board->m_LayerExpressionCache.ResetStats();
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
         ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
@@ -607,6 +720,26 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
             break;
     }
 
+    auto reportCacheStats =
+            [&]( const wxString& aName, const auto& aCache )
+            {
+                const auto stats = aCache.GetStats();
+
+                ReportAux( wxString::Format( wxT( "%s cache: %llu lookups, %llu hits, "
+                                                  "%llu contended" ),
+                                             aName,
+                                             (unsigned long long) stats.m_Lookups,
+                                             (unsigned long long) stats.m_Hits,
+                                             (unsigned long long) stats.m_Contended ) );
+            };
+
+    reportCacheStats( wxT( "intersectsCourtyard" ), m_board->m_IntersectsCourtyardCache );
+    reportCacheStats( wxT( "intersectsFrontCourtyard" ), m_board->m_IntersectsFCourtyardCache );
+    reportCacheStats( wxT( "intersectsBackCourtyard" ), m_board->m_IntersectsBCourtyardCache );
+    reportCacheStats( wxT( "intersectsArea" ), m_board->m_IntersectsAreaCache );
+    reportCacheStats( wxT( "enclosedByArea" ), m_board->m_EnclosedByAreaCache );
+    reportCacheStats( wxT( "Layer expression" ), m_board->m_LayerExpressionCache );
+
     // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
     // caches while DRC is running is problematic.
     wxASSERT( timestamp == m_board->GetTimeStamp() );
@@ -1255,7 +1388,8 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
                                                   EscapeHTML( c->condition->GetExpression() ) ) )
                     }
 
-                    if( c->condition->EvaluateFor( a, b, c->constraint.m_Type, aLayer, aReporter ) )
+                    if( evalCondition( c->condition, a, b, c->constraint.m_Type, aLayer,
+                                       aReporter ) )
                     {
                         if( aReporter )
                         {
@@ -1284,12 +1418,13 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
                 }
             };
 
-    if( m_constraintMap.count( aConstraintType ) )
-    {
-        std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = m_constraintMap[ aConstraintType ];
+    const std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = getConstraints( aConstraintType, aLayer,
+                                                                          aReporter );
 
-        for( int ii = 0; ii < (int) ruleset->size(); ++ii )
-            processConstraint( ruleset->at( ii ) );
+    if( ruleset )
+    {
+        for( const DRC_ENGINE_CONSTRAINT* c : *ruleset )
+            processConstraint( c );
     }
 
     if( constraint.GetParentRule() && !constraint.GetParentRule()->m_Implicit )
@@ -1308,12 +1443,10 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
         else
             b = parentFootprint;
 
-        if( m_constraintMap.count( aConstraintType ) )
+        if( ruleset )
         {
-            std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = m_constraintMap[ aConstraintType ];
-
-            for( int ii = 0; ii < (int) ruleset->size(); ++ii )
-                processConstraint( ruleset->at( ii ) );
+            for( const DRC_ENGINE_CONSTRAINT* c : *ruleset )
+                processConstraint( c );
 
             if( constraint.GetParentRule() && !constraint.GetParentRule()->m_Implicit )
                 return constraint;
@@ -1573,18 +1706,25 @@ bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
 }
 
 
+int DRC_ENGINE::GetErrorsRemaining( int aErrorCode ) const
+{
+    assert( aErrorCode >= 0 && aErrorCode <= DRCE_LAST );
+    return std::max( m_errorLimits[ aErrorCode ], 0 );
+}
+
+
 void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
                                   int aMarkerLayer )
 {
     static std::mutex globalLock;
 
+    // Providers may report from several threads at once
+    std::lock_guard<std::mutex> guard( globalLock );
+
     m_errorLimits[ aItem->GetErrorCode() ] -= 1;
 
     if( m_violationHandler )
-    {
-        std::lock_guard<std::mutex> guard( globalLock );
         m_violationHandler( aItem, aPos, aMarkerLayer );
-    }
 
     if( m_reporter )
     {
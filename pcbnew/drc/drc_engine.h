@@ -25,6 +25,7 @@
 #define DRC_ENGINE_H
 
 #include <memory>
+#include <shared_mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -146,6 +147,11 @@ public:
 
     bool IsErrorLimitExceeded( int error_code );
 
+    /**
+     * @return how many more violations of \a aErrorCode will be reported before its limit.
+     */
+    int GetErrorsRemaining( int aErrorCode ) const;
+
     DRC_CONSTRAINT EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
                               const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
                               REPORTER* aReporter = nullptr );
@@ -227,6 +233,46 @@ private:
     void loadImplicitRules();
     std::shared_ptr<DRC_RULE> createImplicitRule( const wxString& name );
 
+    /**
+     * @return the constraints of \a aConstraintType which need to be considered on \a aLayer,
+     *         in rule order, or nullptr if there are none.
+     */
+    const std::vector<DRC_ENGINE_CONSTRAINT*>* getConstraints( DRC_CONSTRAINT_T aConstraintType,
+                                                               PCB_LAYER_ID aLayer,
+                                                               REPORTER* aReporter );
+
+    /**
+     * Evaluate \a aCondition, looking up the result of memoizable conditions in
+     * m_conditionCache rather than running them for every pair of items.
+     */
+    bool evalCondition( DRC_RULE_CONDITION* aCondition, const BOARD_ITEM* a, const BOARD_ITEM* b,
+                        DRC_CONSTRAINT_T aConstraintType, PCB_LAYER_ID aLayer,
+                        REPORTER* aReporter );
+
+    void clearConstraintMaps();
+
+    /// What a memoizable condition depends on (see DRC_RULE_CONDITION::IsMemoizable())
+    struct CONDITION_CACHE_KEY
+    {
+        const DRC_RULE_CONDITION* m_Condition;
+        int                       m_TypeA;
+        const NETINFO_ITEM*       m_NetA;
+        int                       m_TypeB;
+        const NETINFO_ITEM*       m_NetB;
+
+        bool operator==( const CONDITION_CACHE_KEY& aOther ) const
+        {
+            return m_Condition == aOther.m_Condition
+                    && m_TypeA == aOther.m_TypeA && m_NetA == aOther.m_NetA
+                    && m_TypeB == aOther.m_TypeB && m_NetB == aOther.m_NetB;
+        }
+    };
+
+    struct CONDITION_CACHE_KEY_HASH
+    {
+        std::size_t operator()( const CONDITION_CACHE_KEY& aKey ) const;
+    };
+
 protected:
     BOARD_DESIGN_SETTINGS*     m_designSettings;
     BOARD*                     m_board;
@@ -244,6 +290,16 @@ protected:
     // constraint -> rule -> provider
     std::map<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> m_constraintMap;
 
+    // constraint -> layer -> rules of m_constraintMap whose layer condition includes the layer
+    std::map<DRC_CONSTRAINT_T,
+             std::vector<std::vector<DRC_ENGINE_CONSTRAINT*>>> m_layerConstraintMap;
+
+    // Results of memoizable rule conditions, valid for the board timestamp they were made at
+    std::unordered_map<CONDITION_CACHE_KEY, bool,
+                       CONDITION_CACHE_KEY_HASH>               m_conditionCache;
+    int                                                        m_conditionCacheTimeStamp;
+    std::shared_mutex                                          m_conditionCacheLock;
+
     DRC_VIOLATION_HANDLER      m_violationHandler;
     REPORTER*                  m_reporter;
     PROGRESS_REPORTER*         m_progressReporter;
@@ -509,6 +509,64 @@ public:
         return 0;
     }
 
+    /**
+     * Gather the candidate pairs of QueryCollidingPairs(), grouped by the pair of BOARD_ITEMs
+     * they belong to (in order of first occurrence).
+     *
+     * The groups are independent of each other, so they can be tested in parallel; within a
+     * group, pairs should be tested in order until the first collision.
+     */
+    std::vector<std::vector<PAIR_INFO>>
+    GetCollidingPairGroups( DRC_RTREE* aRefTree, const std::vector<LAYER_PAIR>& aLayerPairs,
+                            int aMaxClearance ) const
+    {
+        std::vector<std::vector<PAIR_INFO>>        groups;
+        std::unordered_map<PTR_PTR_CACHE_KEY, int> groupIndices;
+
+        for( const LAYER_PAIR& layerPair : aLayerPairs )
+        {
+            const PCB_LAYER_ID refLayer = layerPair.first;
+            const PCB_LAYER_ID targetLayer = layerPair.second;
+
+            for( ITEM_WITH_SHAPE* refItem : aRefTree->OnLayer( refLayer ) )
+            {
+                BOX2I box = refItem->shape->BBox();
+                box.Inflate( aMaxClearance );
+
+                int min[2] = { box.GetX(),     box.GetY() };
+                int max[2] = { box.GetRight(), box.GetBottom() };
+
+                auto visit =
+                        [&]( ITEM_WITH_SHAPE* aItemToTest ) -> bool
+                        {
+                            // don't collide items against themselves
+                            if( aItemToTest->parent == refItem->parent )
+                                return true;
+
+                            BOARD_ITEM* a = refItem->parent;
+                            BOARD_ITEM* b = aItemToTest->parent;
+
+                            // store canonical order so that a:b and b:a share a group
+                            if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+                                std::swap( a, b );
+
+                            auto [it, isNew] = groupIndices.emplace( PTR_PTR_CACHE_KEY{ a, b },
+                                                                     (int) groups.size() );
+
+                            if( isNew )
+                                groups.emplace_back();
+
+                            groups[it->second].emplace_back( layerPair, refItem, aItemToTest );
+                            return true;
+                        };
+
+                this->m_tree[targetLayer]->Search( min, max, visit );
+            }
+        }
+
+        return groups;
+    }
+
     /**
      * Return the number of items in the tree.
      *
@@ -30,7 +30,8 @@
 
 DRC_RULE_CONDITION::DRC_RULE_CONDITION( const wxString& aExpression ) :
     m_expression( aExpression ),
-    m_ucode ( nullptr )
+    m_ucode ( nullptr ),
+    m_memoizable( false )
 {
 }
 
@@ -112,6 +113,8 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
     PCBEXPR_CONTEXT preflightContext( 0, F_Cu );
 
     bool ok = compiler.Compile( GetExpression().ToUTF8().data(), m_ucode.get(), &preflightContext );
+
+    m_memoizable = ok && m_ucode->IsMemoizable();
     return ok;
 }
 
@@ -46,9 +46,17 @@ public:
     void SetExpression( const wxString& aExpression ) { m_expression = aExpression; }
     wxString GetExpression() const { return m_expression; }
 
+    /**
+     * @return true if the condition compiled and its result only depends on the types and nets
+     *         of the items it is evaluated for (ie: it only tests their Type, NetName and/or
+     *         NetClass).
+     */
+    bool IsMemoizable() const { return m_memoizable; }
+
 private:
     wxString                       m_expression;
     std::unique_ptr<PCBEXPR_UCODE> m_ucode;
+    bool                           m_memoizable;
 };
 
 
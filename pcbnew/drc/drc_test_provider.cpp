@@ -21,6 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <mutex>
+
+#include <core/task_scheduler.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <drc/drc_test_provider.h>
@@ -36,6 +40,90 @@ std::vector<KICAD_T> DRC_TEST_PROVIDER::s_allBasicItems;
 std::vector<KICAD_T> DRC_TEST_PROVIDER::s_allBasicItemsButZones;
 
 
+struct DEFERRED_VIOLATION
+{
+    std::shared_ptr<DRC_ITEM> m_Item;
+    VECTOR2I                  m_Pos;
+    int                       m_Layer;
+};
+
+/**
+ * The state of a runParallel() call.
+ *
+ * The violations of each index are held back, and only counted against the error limits once
+ * all the indexes before it have completed.  What that completed prefix leaves of a limit can
+ * only shrink as more indexes complete, and the violations beyond it would be dropped anyway
+ * when they are reported in index order, so skipping them doesn't depend on thread timing.
+ */
+struct PARALLEL_RUN
+{
+    PARALLEL_RUN( DRC_ENGINE* aEngine, size_t aCount ) :
+            m_Violations( aCount ),
+            m_Budgets( DRCE_LAST + 1 ),
+            m_completed( aCount, false ),
+            m_prefix( 0 )
+    {
+        for( int ii = 0; ii <= DRCE_LAST; ++ii )
+            m_Budgets[ii].store( aEngine->GetErrorsRemaining( ii ) );
+    }
+
+    /**
+     * @return how many more violations of \a aErrorCode index \a aIndex can report before
+     *         they would be dropped.
+     */
+    int Remaining( size_t aIndex, int aErrorCode ) const
+    {
+        const std::vector<DEFERRED_VIOLATION>& violations = m_Violations[aIndex];
+
+        return m_Budgets[aErrorCode].load()
+               - (int) std::count_if( violations.begin(), violations.end(),
+                                      [&]( const DEFERRED_VIOLATION& aViolation )
+                                      {
+                                          return aViolation.m_Item->GetErrorCode()
+                                                 == aErrorCode;
+                                      } );
+    }
+
+    /// Mark \a aIndex as completed, and count the violations of the completed prefix
+    void Complete( size_t aIndex )
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        m_completed[aIndex] = true;
+
+        while( m_prefix < m_completed.size() && m_completed[m_prefix] )
+        {
+            for( const DEFERRED_VIOLATION& violation : m_Violations[m_prefix] )
+                m_Budgets[violation.m_Item->GetErrorCode()].fetch_sub( 1 );
+
+            m_prefix++;
+        }
+    }
+
+    std::vector<std::vector<DEFERRED_VIOLATION>> m_Violations;  ///< Those of each index
+    std::vector<std::atomic<int>>                m_Budgets;     ///< What the prefix leaves
+
+private:
+    std::mutex        m_lock;
+    std::vector<bool> m_completed;
+    size_t            m_prefix;        ///< The indexes before it are completed and counted
+};
+
+
+/**
+ * The index of a runParallel() call running on the current thread.
+ */
+struct PARALLEL_INDEX
+{
+    PARALLEL_RUN* m_Run;
+    size_t        m_Index;
+};
+
+// Where reportViolation() collects the violations of the runParallel() call running on the
+// current thread (if any)
+static thread_local PARALLEL_INDEX* s_parallelIndex = nullptr;
+
+
 DRC_TEST_PROVIDER_REGISTRY::~DRC_TEST_PROVIDER_REGISTRY()
 {
     for( DRC_TEST_PROVIDER* provider : m_providers )
@@ -75,6 +163,17 @@ const wxString DRC_TEST_PROVIDER::GetDescription() const { return wxEmptyString;
 void DRC_TEST_PROVIDER::reportViolation( std::shared_ptr<DRC_ITEM>& item,
                                          const VECTOR2I& aMarkerPos, int aMarkerLayer )
 {
+    if( s_parallelIndex )
+    {
+        PARALLEL_RUN* run = s_parallelIndex->m_Run;
+        size_t        index = s_parallelIndex->m_Index;
+
+        if( run->Remaining( index, item->GetErrorCode() ) > 0 )
+            run->m_Violations[index].push_back( { item, aMarkerPos, aMarkerLayer } );
+
+        return;
+    }
+
     std::lock_guard<std::mutex> lock( m_statsMutex );
     if( item->GetViolatingRule() )
         accountCheck( item->GetViolatingRule() );
@@ -84,6 +183,79 @@ void DRC_TEST_PROVIDER::reportViolation( std::shared_ptr<DRC_ITEM>& item,
 }
 
 
+bool DRC_TEST_PROVIDER::runParallel( size_t aCount, const std::function<void( size_t )>& aFunc )
+{
+    PARALLEL_RUN        run( m_drcEngine, aCount );
+    std::atomic<size_t> done( 0 );
+
+    CANCELLATION_TOKEN cancelToken(
+            [this]()
+            {
+                return m_drcEngine->IsCancelled();
+            } );
+
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+    TASK_GROUP      group( scheduler, &cancelToken );
+
+    auto runOne =
+            [&]( size_t ii )
+            {
+                PARALLEL_INDEX  index = { &run, ii };
+                PARALLEL_INDEX* outer = s_parallelIndex;
+
+                s_parallelIndex = &index;
+
+                try
+                {
+                    aFunc( ii );
+                }
+                catch( ... )
+                {
+                    s_parallelIndex = outer;
+                    throw;
+                }
+
+                s_parallelIndex = outer;
+
+                run.Complete( ii );
+                done.fetch_add( 1 );
+            };
+
+    // The loop itself runs as a task so that this thread is free to keep the UI refreshed
+    group.Run(
+            [&]()
+            {
+                ParallelFor( scheduler, 0, aCount, runOne, 0, &cancelToken );
+            } );
+
+    while( !group.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( done, aCount );
+
+    if( m_drcEngine->IsCancelled() )
+        return false;
+
+    for( std::vector<DEFERRED_VIOLATION>& itemViolations : run.m_Violations )
+    {
+        for( DEFERRED_VIOLATION& violation : itemViolations )
+        {
+            if( !m_drcEngine->IsErrorLimitExceeded( violation.m_Item->GetErrorCode() ) )
+                reportViolation( violation.m_Item, violation.m_Pos, violation.m_Layer );
+        }
+    }
+
+    return true;
+}
+
+
+bool DRC_TEST_PROVIDER::isErrorLimitExceeded( int aErrorCode ) const
+{
+    if( s_parallelIndex )
+        return s_parallelIndex->m_Run->Remaining( s_parallelIndex->m_Index, aErrorCode ) <= 0;
+
+    return m_drcEngine->IsErrorLimitExceeded( aErrorCode );
+}
+
+
 bool DRC_TEST_PROVIDER::reportProgress( size_t aCount, size_t aSize, size_t aDelta )
 {
     if( ( aCount % aDelta ) == 0 || aCount == aSize -  1 )
@@ -103,6 +103,27 @@ protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
 
+    /**
+     * Call \a aFunc( ii ) for each \a ii in [0, aCount) on the task scheduler, reporting
+     * progress from the calling thread meanwhile.
+     *
+     * Violations reported by \a aFunc are held back and reported in index order once all the
+     * calls have completed.  They are counted against their error limit in index order too,
+     * as the calls before them complete, so the violations kept don't depend on thread timing.
+     * \a aFunc should use isErrorLimitExceeded() to skip tests whose violations would be
+     * dropped.  \a aFunc must not report progress or phases.
+     *
+     * @return false if DRC was cancelled.
+     */
+    bool runParallel( size_t aCount, const std::function<void( size_t )>& aFunc );
+
+    /**
+     * Like DRC_ENGINE::IsErrorLimitExceeded(), but within a runParallel() call on the calling
+     * thread, also counts the violations held back by the completed calls before it and by
+     * itself.
+     */
+    bool isErrorLimitExceeded( int aErrorCode ) const;
+
     // Do not use a wxString with a vararg list: it is a complex thing and can create issues.
     // So prefer using a wxChar* item in this case:
     void reportAux( const wxString& aMsg ) { reportAux( (const wxChar*) aMsg.wchar_str() ); }
@@ -44,7 +44,7 @@
 #include <math/vector2d.h>
 #include <pcb_shape.h>
 #include <progress_reporter.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <pcb_track.h>
 #include <pad.h>
 #include <zone.h>
@@ -822,51 +822,47 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
         }
     }
 
-    thread_pool&                     tp = GetKiCadThreadPool();
-    std::vector<std::future<size_t>> returns;
-    size_t                           total_effort = 0;
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+    size_t          total_effort = 0;
 
     for( const auto& [ netLayer, itemsPoly ] : dataset )
         total_effort += calc_effort( itemsPoly.Items, netLayer.Layer );
 
     total_effort += std::max( (size_t) 1, total_effort ) * distinctMinWidths.size();
 
-    returns.reserve( dataset.size() );
-
-    for( const auto& [ netLayer, itemsPoly ] : dataset )
-    {
-        returns.emplace_back( tp.submit( build_netlayer_polys, netLayer.Netcode, netLayer.Layer ) );
-    }
-
-    for( std::future<size_t>& ret : returns )
     {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        TASK_GROUP polyGroup( scheduler );
 
-        while( status != std::future_status::ready )
+        for( const auto& [ netLayer, itemsPoly ] : dataset )
         {
-            reportProgress( done, total_effort );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+            polyGroup.Run(
+                    [&build_netlayer_polys, netcode = netLayer.Netcode, layer = netLayer.Layer]()
+                    {
+                        build_netlayer_polys( netcode, layer );
+                    } );
         }
-    }
-
-    returns.clear();
-    returns.reserve( dataset.size() * distinctMinWidths.size() );
 
-    for( const auto& [ netLayer, itemsPoly ] : dataset )
-    {
-        for( int minWidth : distinctMinWidths )
-            returns.emplace_back( tp.submit( min_checker, itemsPoly, netLayer.Layer, minWidth ) );
+        while( !polyGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+            reportProgress( done, total_effort );
     }
 
-    for( std::future<size_t>& ret : returns )
     {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        TASK_GROUP checkGroup( scheduler );
 
-        while( status != std::future_status::ready )
+        for( const auto& [ netLayer, itemsPoly ] : dataset )
         {
-            reportProgress( done, total_effort );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+            for( int minWidth : distinctMinWidths )
+            {
+                checkGroup.Run(
+                        [&min_checker, &itemsPoly = itemsPoly, layer = netLayer.Layer, minWidth]()
+                        {
+                            min_checker( itemsPoly, layer, minWidth );
+                        } );
+            }
         }
+
+        while( !checkGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+            reportProgress( done, total_effort );
     }
 
     return true;
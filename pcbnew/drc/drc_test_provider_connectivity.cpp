@@ -124,7 +124,7 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_ISOLATED_COPPER ) )
                     break;
 
-                std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
+                std::shared_ptr<const SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
 
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_ISOLATED_COPPER );
                 drcItem->SetItems( zone );
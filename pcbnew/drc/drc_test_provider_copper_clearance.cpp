@@ -28,10 +28,11 @@
 #include <pcb_shape.h>
 #include <pad.h>
 #include <pcb_track.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <zone.h>
 
 #include <geometry/seg.h>
+#include <geometry/seg_batch.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
 
@@ -42,8 +43,6 @@
 #include <drc/drc_test_provider_clearance_base.h>
 #include <pcb_dimension.h>
 
-#include <future>
-
 /*
     Copper clearance test. Checks all copper items (pads, vias, tracks, drawings, zones) for their
     electrical clearance.
@@ -672,22 +671,29 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
         }
     };
 
-    thread_pool& tp = GetKiCadThreadPool();
+    CANCELLATION_TOKEN cancelToken(
+            [this]()
+            {
+                return m_drcEngine->IsCancelled();
+            } );
 
-    tp.push_loop( m_board->Tracks().size(), testTrack );
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+    TASK_GROUP      trackGroup( scheduler, &cancelToken );
 
-    while( done < count )
-    {
-        reportProgress( done, count );
-
-        if( m_drcEngine->IsCancelled() )
-        {
-            tp.wait_for_tasks();
-            break;
-        }
+    // The loop itself runs as a task so that this thread is free to keep the UI refreshed
+    trackGroup.Run(
+            [&]()
+            {
+                ParallelFor( scheduler, 0, count,
+                             [&]( size_t ii )
+                             {
+                                 testTrack( (int) ii, (int) ii + 1 );
+                             },
+                             0, &cancelToken );
+            } );
 
-        std::this_thread::sleep_for( std::chrono::milliseconds( 250 ) );
-    }
+    while( !trackGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( done, count );
 }
 
 
@@ -929,7 +935,6 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 {
-    thread_pool&        tp = GetKiCadThreadPool();
     size_t              count = 0;
     std::atomic<size_t> done( 1 );
 
@@ -942,7 +947,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 
     LSET boardCopperLayers = LSET::AllCuMask( m_board->GetCopperLayerCount() );
 
-    std::future<void> retn = tp.submit(
+    TASK_GROUP padGroup( GetKiCadTaskScheduler() );
+
+    padGroup.Run(
             [&]()
             {
                 for( FOOTPRINT* footprint : m_board->Footprints() )
@@ -1001,19 +1008,13 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
                 }
             } );
 
-    std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
-
-    while( status != std::future_status::ready )
-    {
+    while( !padGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
         reportProgress( done, count );
-        status = retn.wait_for( std::chrono::milliseconds( 250 ) );
-    }
 }
 
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
 {
-    thread_pool&        tp = GetKiCadThreadPool();
     size_t              count = m_board->Drawings().size();
     std::atomic<size_t> done( 1 );
 
@@ -1123,7 +1124,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
                             m_board->m_DRCMaxClearance );
             };
 
-    std::future<void> retn = tp.submit(
+    TASK_GROUP graphicGroup( GetKiCadTaskScheduler() );
+
+    graphicGroup.Run(
             [&]()
             {
                 for( BOARD_ITEM* item : m_board->Drawings() )
@@ -1153,13 +1156,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
                 }
         } );
 
-    std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
-
-    while( status != std::future_status::ready )
-    {
+    while( !graphicGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
         reportProgress( done, count );
-        status = retn.wait_for( std::chrono::milliseconds( 250 ) );
-    }
 }
 
 
@@ -1176,9 +1174,11 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
     // required clearance, and the layer
     using report_data = std::tuple<int, int, VECTOR2I, int, int, PCB_LAYER_ID>;
 
-    std::vector<std::future<report_data>> futures;
-    thread_pool&                          tp = GetKiCadThreadPool();
-    std::atomic<size_t>                   done( 1 );
+    // Contains the index for zoneA, zoneB, the required clearance, and the layer
+    using zone_job = std::tuple<int, int, int, PCB_LAYER_ID>;
+
+    std::vector<zone_job> jobs;
+    std::atomic<size_t>   done( 1 );
 
     auto checkZones =
             [this, testClearance, testIntersects, &poly_segments, &done]
@@ -1199,44 +1199,65 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     int ax2 = refSegment.B.x;
                     int ay2 = refSegment.B.y;
 
-                    // Iterate through all the segments in smoothed_polys[ia2]
-                    for( SEG& testSegment : testSegments )
+                    // We have ensured that the 'A' segment starts before the 'B' segment,
+                    // so once a 'B' segment starts after the 'A' segment ends, we can skip
+                    // to the next 'A'
+                    int testCount = 0;
+
+                    while( testCount < (int) testSegments.size()
+                           && testSegments[testCount].A.x <= ax2 )
                     {
-                        // Build test segment
-                        VECTOR2I pt;
-
-                        int bx1 = testSegment.A.x;
-                        int by1 = testSegment.A.y;
-                        int bx2 = testSegment.B.x;
-                        int by2 = testSegment.B.y;
-
-                        // We have ensured that the 'A' segment starts before the 'B' segment,
-                        // so if the 'A' segment ends before the 'B' segment starts, we can skip
-                        // to the next 'A'
-                        if( ax2 < bx1 )
-                            break;
+                        testCount++;
+                    }
 
-                        int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2, 0,
-                                                             ax1, ay1, ax2, ay2, 0,
-                                                             clearance, &pt.x, &pt.y );
+                    // Only the segments near the 'A' segment's box can be closer than the
+                    // clearance, so screen them a block at a time
+                    VECTOR2I boxMin, boxMax;
+                    report_data result = invalid_result;
 
-                        if( d < clearance )
-                        {
-                            if( d == 0 && testIntersects )
-                                reported = true;
-                            else if( testClearance )
-                                reported = true;
+                    SEG_BATCH::InflateBox( refSegment, clearance, boxMin, boxMax );
 
-                            if( reported )
+                    SEG_BATCH::Query( testSegments.data(), testCount, boxMin, boxMax,
+                            [&]( int aIndex )
                             {
-                                done.fetch_add( 1 );
-                                return std::make_tuple( zoneA, zoneB, pt, d, clearance, layer );
-                            }
-                        }
+                                const SEG& testSegment = testSegments[aIndex];
+                                VECTOR2I   pt;
 
-                        if( m_drcEngine->IsCancelled() )
-                            return invalid_result;
+                                int bx1 = testSegment.A.x;
+                                int by1 = testSegment.A.y;
+                                int bx2 = testSegment.B.x;
+                                int by2 = testSegment.B.y;
+
+                                int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2, 0,
+                                                                     ax1, ay1, ax2, ay2, 0,
+                                                                     clearance, &pt.x, &pt.y );
+
+                                if( d < clearance )
+                                {
+                                    if( d == 0 && testIntersects )
+                                        reported = true;
+                                    else if( testClearance )
+                                        reported = true;
+
+                                    if( reported )
+                                    {
+                                        result = std::make_tuple( zoneA, zoneB, pt, d, clearance,
+                                                                  layer );
+                                        return false;
+                                    }
+                                }
+
+                                return !m_drcEngine->IsCancelled();
+                            } );
+
+                    if( reported )
+                    {
+                        done.fetch_add( 1 );
+                        return result;
                     }
+
+                    if( m_drcEngine->IsCancelled() )
+                        return invalid_result;
                 }
 
                 done.fetch_add( 1 );
@@ -1302,8 +1323,10 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     continue;
 
                 // Examine a candidate zone: compare zoneB to zoneA
-                SHAPE_POLY_SET* polyA = m_board->m_DRCCopperZones[ia]->GetFill( layer );
-                SHAPE_POLY_SET* polyB = m_board->m_DRCCopperZones[ia2]->GetFill( layer );
+                const SHAPE_POLY_SET* polyA =
+                        m_board->m_DRCCopperZones[ia]->GetFilledPolysList( layer ).get();
+                const SHAPE_POLY_SET* polyB =
+                        m_board->m_DRCCopperZones[ia2]->GetFilledPolysList( layer ).get();
 
                 if( !polyA->BBoxFromCaches().Intersects( polyB->BBoxFromCaches() ) )
                     continue;
@@ -1315,73 +1338,75 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                 if( constraint.GetSeverity() == RPT_SEVERITY_IGNORE || zone2zoneClearance <= 0 )
                     continue;
 
-                futures.push_back( tp.submit( checkZones, ia, ia2, zone2zoneClearance, layer ) );
+                jobs.emplace_back( ia, ia2, zone2zoneClearance, layer );
             }
         }
     }
 
-    size_t count = futures.size();
+    size_t                   count = jobs.size();
+    std::vector<report_data> results( count,
+                                      std::make_tuple( -1, -1, VECTOR2I(), 0, 0, F_Cu ) );
 
-    for( auto& task : futures )
-    {
-        if( !task.valid() )
-            continue;
+    CANCELLATION_TOKEN cancelToken( [this]() { return m_drcEngine->IsCancelled(); } );
+    TASK_GROUP         zoneGroup( GetKiCadTaskScheduler(), &cancelToken );
 
-        std::future_status result;
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        zoneGroup.Run(
+                [&, ii]()
+                {
+                    const zone_job& job = jobs[ii];
 
-        while( true )
-        {
-            result = task.wait_for( std::chrono::milliseconds( 250 ) );
+                    results[ii] = checkZones( std::get<0>( job ), std::get<1>( job ),
+                                              std::get<2>( job ), std::get<3>( job ) );
+                } );
+    }
 
-            reportProgress( done, count );
+    while( !zoneGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( done, count );
 
-            if( m_drcEngine->IsCancelled() )
-                break;
+    if( m_drcEngine->IsCancelled() )
+        return;
 
-            if( result == std::future_status::ready )
-            {
-                report_data  data = task.get();
-                int          zoneA_idx = std::get<0>( data );
-                int          zoneB_idx = std::get<1>( data );
-                VECTOR2I     pt = std::get<2>( data );
-                int          actual = std::get<3>( data );
-                int          required = std::get<4>( data );
-                PCB_LAYER_ID layer = std::get<5>( data );
-
-                if( zoneA_idx >= 0 )
-                {
-                    ZONE* zoneA = m_board->m_DRCCopperZones[zoneA_idx];
-                    ZONE* zoneB = m_board->m_DRCCopperZones[zoneB_idx];
+    for( const report_data& data : results )
+    {
+        int          zoneA_idx = std::get<0>( data );
+        int          zoneB_idx = std::get<1>( data );
+        VECTOR2I     pt = std::get<2>( data );
+        int          actual = std::get<3>( data );
+        int          required = std::get<4>( data );
+        PCB_LAYER_ID layer = std::get<5>( data );
+
+        if( zoneA_idx < 0 )
+            continue;
 
-                    constraint = m_drcEngine->EvalRules( CLEARANCE_CONSTRAINT, zoneA, zoneB, layer );
-                    std::shared_ptr<DRC_ITEM> drce;
+        ZONE* zoneA = m_board->m_DRCCopperZones[zoneA_idx];
+        ZONE* zoneB = m_board->m_DRCCopperZones[zoneB_idx];
 
-                    if( actual <= 0 && testIntersects )
-                    {
-                        drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
-                    }
-                    else if( testClearance )
-                    {
-                        drce = DRC_ITEM::Create( DRCE_CLEARANCE );
-                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                  constraint.GetName(),
-                                                  required,
-                                                  std::max( actual, 0 ) );
+        constraint = m_drcEngine->EvalRules( CLEARANCE_CONSTRAINT, zoneA, zoneB, layer );
+        std::shared_ptr<DRC_ITEM> drce;
 
-                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                    }
+        if( actual <= 0 && testIntersects )
+        {
+            drce = DRC_ITEM::Create( DRCE_ZONES_INTERSECT );
+        }
+        else if( testClearance )
+        {
+            drce = DRC_ITEM::Create( DRCE_CLEARANCE );
+            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                      constraint.GetName(),
+                                      required,
+                                      std::max( actual, 0 ) );
 
-                    if( drce )
-                    {
-                        drce->SetItems( zoneA, zoneB );
-                        drce->SetViolatingRule( constraint.GetParentRule() );
+            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
+        }
 
-                        reportViolation( drce, pt, layer );
-                    }
-                }
+        if( drce )
+        {
+            drce->SetItems( zoneA, zoneB );
+            drce->SetViolatingRule( constraint.GetParentRule() );
 
-                break;
-            }
+            reportViolation( drce, pt, layer );
         }
     }
 }
@@ -71,6 +71,11 @@ private:
 
     bool testCourtyardClearances();
 
+    /**
+     * Test the footprint at \a aIndex against all the footprints which follow it.
+     */
+    void testCourtyardClearances( size_t aIndex );
+
 private:
     int  m_largestCourtyardClearance;
 };
@@ -150,196 +155,208 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
     if( !reportPhase( _( "Checking footprints for overlapping courtyards..." ) ) )
         return false;   // DRC cancelled
 
-    const int progressDelta = 100;
-    int       ii = 0;
+    const FOOTPRINTS& footprints = m_board->Footprints();
 
-    for( auto itA = m_board->Footprints().begin(); itA != m_board->Footprints().end(); itA++ )
+    // Build the courtyard and bounding box caches before going multi-threaded
+    for( FOOTPRINT* footprint : footprints )
     {
-        if( !reportProgress( ii++, m_board->Footprints().size(), progressDelta ) )
-            return false;   // DRC cancelled
+        footprint->GetCourtyard( F_CrtYd );
+        footprint->GetBoundingBox();
+    }
 
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
-        {
-            return true;   // continue with other tests
-        }
+    runParallel( footprints.size(),
+            [&]( size_t aIndex )
+            {
+                testCourtyardClearances( aIndex );
+            } );
 
-        FOOTPRINT*            fpA = *itA;
-        const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
-        const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
+    return !m_drcEngine->IsCancelled();
+}
 
-        if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
-             && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-             && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
-        {
-            // No courtyards defined and no hole testing against other footprint's courtyards
-            continue;
-        }
 
-        BOX2I frontA_worstCaseBBox = frontA.BBoxFromCaches();
-        BOX2I backA_worstCaseBBox = backA.BBoxFromCaches();
+void DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances( size_t aIndex )
+{
+    if( isErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
+        && isErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+        && isErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+    {
+        return;
+    }
+
+    const FOOTPRINTS&     footprints = m_board->Footprints();
+    auto                  itA = footprints.begin() + aIndex;
+    FOOTPRINT*            fpA = *itA;
+    const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
+
+    if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
+         && isErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+         && isErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+    {
+        // No courtyards defined and no hole testing against other footprint's courtyards
+        return;
+    }
+
+    BOX2I frontA_worstCaseBBox = frontA.BBoxFromCaches();
+    BOX2I backA_worstCaseBBox = backA.BBoxFromCaches();
 
-        frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-        backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+    frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+    backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
 
-        BOX2I fpA_bbox = fpA->GetBoundingBox();
+    BOX2I fpA_bbox = fpA->GetBoundingBox();
 
-        for( auto itB = itA + 1; itB != m_board->Footprints().end(); itB++ )
+    for( auto itB = itA + 1; itB != footprints.end(); itB++ )
+    {
+        FOOTPRINT*            fpB = *itB;
+        const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
+        const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
+
+        if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
+             && isErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+             && isErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
         {
-            FOOTPRINT*            fpB = *itB;
-            const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
-            const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
+            // No courtyards defined and no hole testing against other footprint's courtyards
+            continue;
+        }
 
-            if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
-            {
-                // No courtyards defined and no hole testing against other footprint's courtyards
-                continue;
-            }
+        BOX2I frontB_worstCaseBBox = frontB.BBoxFromCaches();
+        BOX2I backB_worstCaseBBox = backB.BBoxFromCaches();
 
-            BOX2I frontB_worstCaseBBox = frontB.BBoxFromCaches();
-            BOX2I backB_worstCaseBBox = backB.BBoxFromCaches();
+        frontB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+        backB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
 
-            frontB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-            backB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+        BOX2I          fpB_bbox = fpB->GetBoundingBox();
+        DRC_CONSTRAINT constraint;
+        int            clearance;
+        int            actual;
+        VECTOR2I       pos;
 
-            BOX2I          fpB_bbox = fpB->GetBoundingBox();
-            DRC_CONSTRAINT constraint;
-            int            clearance;
-            int            actual;
-            VECTOR2I       pos;
+        //
+        // Check courtyard-to-courtyard collisions on front of board.
+        //
 
-            //
-            // Check courtyard-to-courtyard collisions on front of board.
-            //
+        if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
+                && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() ) )
+        {
+            constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
+            clearance = constraint.GetValue().Min();
 
-            if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
-                    && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() ) )
+            if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
             {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
-                clearance = constraint.GetValue().Min();
-
-                if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+                if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
                 {
-                    if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
-
-                        if( clearance > 0 )
-                        {
-                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                      constraint.GetName(),
-                                                      clearance,
-                                                      actual );
+                    auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
 
-                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                        }
+                    if( clearance > 0 )
+                    {
+                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                                  constraint.GetName(),
+                                                  clearance,
+                                                  actual );
 
-                        drce->SetViolatingRule( constraint.GetParentRule() );
-                        drce->SetItems( fpA, fpB );
-                        reportViolation( drce, pos, F_CrtYd );
+                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
                     }
+
+                    drce->SetViolatingRule( constraint.GetParentRule() );
+                    drce->SetItems( fpA, fpB );
+                    reportViolation( drce, pos, F_CrtYd );
                 }
             }
+        }
 
-            //
-            // Check courtyard-to-courtyard collisions on back of board.
-            //
+        //
+        // Check courtyard-to-courtyard collisions on back of board.
+        //
 
-            if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
-                    && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() ) )
-            {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                clearance = constraint.GetValue().Min();
+        if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
+                && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() ) )
+        {
+            constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+            clearance = constraint.GetValue().Min();
 
-                if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+            if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+            {
+                if( backA.Collide( &backB, clearance, &actual, &pos ) )
                 {
-                    if( backA.Collide( &backB, clearance, &actual, &pos ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+                    auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
 
-                        if( clearance > 0 )
-                        {
-                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                      constraint.GetName(),
-                                                      clearance,
-                                                      actual );
-
-                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                        }
+                    if( clearance > 0 )
+                    {
+                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                                  constraint.GetName(),
+                                                  clearance,
+                                                  actual );
 
-                        drce->SetViolatingRule( constraint.GetParentRule() );
-                        drce->SetItems( fpA, fpB );
-                        reportViolation( drce, pos, B_CrtYd );
+                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
                     }
+
+                    drce->SetViolatingRule( constraint.GetParentRule() );
+                    drce->SetItems( fpA, fpB );
+                    reportViolation( drce, pos, B_CrtYd );
                 }
             }
+        }
 
-            //
-            // Check pad-hole-to-courtyard collisions on front and back of board.
-            //
-            // NB: via holes are not checked.  There is a presumption that a physical object goes
-            // through a pad hole, which is not the case for via holes.
-            //
+        //
+        // Check pad-hole-to-courtyard collisions on front and back of board.
+        //
+        // NB: via holes are not checked.  There is a presumption that a physical object goes
+        // through a pad hole, which is not the case for via holes.
+        //
 
-            auto testPadAgainstCourtyards =
-                    [&]( const PAD* pad, const FOOTPRINT* fp )
-                    {
-                        int errorCode = 0;
+        auto testPadAgainstCourtyards =
+                [&]( const PAD* pad, const FOOTPRINT* fp )
+                {
+                    int errorCode = 0;
 
-                        if( pad->GetAttribute() == PAD_ATTRIB::PTH )
-                            errorCode = DRCE_PTH_IN_COURTYARD;
-                        else if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
-                            errorCode = DRCE_NPTH_IN_COURTYARD;
-                        else
-                            return;
+                    if( pad->GetAttribute() == PAD_ATTRIB::PTH )
+                        errorCode = DRCE_PTH_IN_COURTYARD;
+                    else if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
+                        errorCode = DRCE_NPTH_IN_COURTYARD;
+                    else
+                        return;
 
-                        if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
-                            return;
+                    if( isErrorLimitExceeded( errorCode ) )
+                        return;
 
-                        if( pad->HasHole() )
+                    if( pad->HasHole() )
+                    {
+                        std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                        const SHAPE_POLY_SET&          front = fp->GetCourtyard( F_CrtYd );
+                        const SHAPE_POLY_SET&          back = fp->GetCourtyard( B_CrtYd );
+
+                        if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
                         {
-                            std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
-                            const SHAPE_POLY_SET&          front = fp->GetCourtyard( F_CrtYd );
-                            const SHAPE_POLY_SET&          back = fp->GetCourtyard( B_CrtYd );
-
-                            if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
-                            {
-                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
-                                drce->SetItems( pad, fp );
-                                reportViolation( drce, pad->GetPosition(), F_CrtYd );
-                            }
-                            else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
-                            {
-                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
-                                drce->SetItems( pad, fp );
-                                reportViolation( drce, pad->GetPosition(), B_CrtYd );
-                            }
+                            std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
+                            drce->SetItems( pad, fp );
+                            reportViolation( drce, pad->GetPosition(), F_CrtYd );
                         }
-                    };
-
-            if( ( frontA.OutlineCount() > 0 && frontA_worstCaseBBox.Intersects( fpB_bbox ) )
-                || ( backA.OutlineCount() > 0 && backA_worstCaseBBox.Intersects( fpB_bbox ) ) )
-            {
-                for( const PAD* padB : fpB->Pads() )
-                    testPadAgainstCourtyards( padB, fpA );
-            }
+                        else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
+                        {
+                            std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
+                            drce->SetItems( pad, fp );
+                            reportViolation( drce, pad->GetPosition(), B_CrtYd );
+                        }
+                    }
+                };
 
-            if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpA_bbox ) )
-                || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpA_bbox ) ) )
-            {
-                for( const PAD* padA : fpA->Pads() )
-                    testPadAgainstCourtyards( padA, fpB );
-            }
+        if( ( frontA.OutlineCount() > 0 && frontA_worstCaseBBox.Intersects( fpB_bbox ) )
+            || ( backA.OutlineCount() > 0 && backA_worstCaseBBox.Intersects( fpB_bbox ) ) )
+        {
+            for( const PAD* padB : fpB->Pads() )
+                testPadAgainstCourtyards( padB, fpA );
+        }
 
-            if( m_drcEngine->IsCancelled() )
-                return false;
+        if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpA_bbox ) )
+            || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpA_bbox ) ) )
+        {
+            for( const PAD* padA : fpA->Pads() )
+                testPadAgainstCourtyards( padA, fpB );
         }
-    }
 
-    return !m_drcEngine->IsCancelled();
+        if( m_drcEngine->IsCancelled() )
+            return;
+    }
 }
 
 
@@ -31,7 +31,7 @@
 #include <drc/drc_test_provider.h>
 #include <pad.h>
 #include <progress_reporter.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <zone.h>
 
 
@@ -152,34 +152,20 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
 
                 PTR_PTR_LAYER_CACHE_KEY key = { ruleArea, copperZone, UNDEFINED_LAYER };
 
-                {
-                    std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                    board->m_IntersectsAreaCache[ key ] = isInside;
-                }
+                board->m_IntersectsAreaCache.Insert( key, isInside );
 
                 done.fetch_add( 1 );
 
                 return 1;
             };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<std::future<size_t>> returns;
-
-    returns.reserve( toCache.size() );
+    TASK_GROUP areaGroup( GetKiCadTaskScheduler() );
 
     for( const std::pair<ZONE*, ZONE*>& areaZonePair : toCache )
-        returns.emplace_back( tp.submit( query_areas, areaZonePair ) );
-
-    for( const std::future<size_t>& ret : returns )
-    {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        areaGroup.Run( [&query_areas, areaZonePair]() { query_areas( areaZonePair ); } );
 
-        while( status != std::future_status::ready )
-        {
-            reportProgress( done, toCache.size() );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
+    while( !areaGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( done, toCache.size() );
 
     if( m_drcEngine->IsCancelled() )
         return false;
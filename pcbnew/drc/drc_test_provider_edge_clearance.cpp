@@ -273,31 +273,36 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
     /*
      * Test copper and silk items against the set of edges.
      */
-    const int progressDelta = 200;
-    int       count = 0;
-    int       ii = 0;
+    std::vector<BOARD_ITEM*> items;
 
     forEachGeometryItem( s_allBasicItemsButZones, LSET::AllLayersMask(),
             [&]( BOARD_ITEM *item ) -> bool
             {
-                count++;
+                items.push_back( item );
                 return true;
             } );
 
-    forEachGeometryItem( s_allBasicItemsButZones, LSET::AllLayersMask(),
-            [&]( BOARD_ITEM *item ) -> bool
-            {
-                bool testCopper = !m_drcEngine->IsErrorLimitExceeded( DRCE_EDGE_CLEARANCE );
-                bool testSilk = !m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE );
+    bool testCopper = !m_drcEngine->IsErrorLimitExceeded( DRCE_EDGE_CLEARANCE );
+    bool testSilk = !m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE );
 
-                if( !testCopper && !testSilk )
-                    return false;       // All limits exceeded; we're done
+    if( !testCopper && !testSilk )
+        return !m_drcEngine->IsCancelled();
 
-                if( !reportProgress( ii++, count, progressDelta ) )
-                    return false;       // DRC cancelled; we're done
+    // Each item is tested independently
+    runParallel( items.size(),
+            [&]( size_t ii )
+            {
+                BOARD_ITEM* item = items[ii];
+                bool        testItemCopper = testCopper
+                                             && !isErrorLimitExceeded( DRCE_EDGE_CLEARANCE );
+                bool        testItemSilk = testSilk
+                                           && !isErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE );
+
+                if( !testItemCopper && !testItemSilk )
+                    return;
 
                 if( isInvisibleText( item ) )
-                    return true;        // Continue with other items
+                    return;
 
                 if( item->Type() == PCB_PAD_T )
                 {
@@ -306,7 +311,7 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                     if( pad->GetProperty() == PAD_PROP::CASTELLATED
                         || pad->GetAttribute() == PAD_ATTRIB::CONN )
                     {
-                        return true;    // Continue with other items
+                        return;
                     }
                 }
 
@@ -314,7 +319,7 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
 
                 for( PCB_LAYER_ID testLayer : { Edge_Cuts, Margin } )
                 {
-                    if( testCopper && item->IsOnCopperLayer() )
+                    if( testItemCopper && item->IsOnCopperLayer() )
                     {
                         edgesTree.QueryColliding( item, UNDEFINED_LAYER, testLayer, nullptr,
                                 [&]( BOARD_ITEM* edge ) -> bool
@@ -326,7 +331,8 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                                 m_largestEdgeClearance );
                     }
 
-                    if( testSilk && ( item->IsOnLayer( F_SilkS ) || item->IsOnLayer( B_SilkS ) ) )
+                    if( testItemSilk
+                            && ( item->IsOnLayer( F_SilkS ) || item->IsOnLayer( B_SilkS ) ) )
                     {
                         if( edgesTree.QueryColliding( item, UNDEFINED_LAYER, testLayer, nullptr,
                                 [&]( BOARD_ITEM* edge ) -> bool
@@ -345,8 +351,6 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                         }
                     }
                 }
-
-                return true;
             } );
 
     reportRuleStatistics();
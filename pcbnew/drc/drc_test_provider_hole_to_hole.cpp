@@ -133,8 +133,6 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
                 return true;
             } );
 
-    count *= 2;  // One for adding to the rtree; one for checking
-
     forEachGeometryItem( { PCB_PAD_T, PCB_VIA_T }, LSET::AllLayersMask(),
             [&]( BOARD_ITEM* item ) -> bool
             {
@@ -159,7 +157,10 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
                 return true;
             } );
 
-    std::unordered_map<PTR_PTR_CACHE_KEY, int> checkedPairs;
+    // Each pair of holes is tested by whichever of its two items comes first in a loop, which
+    // is the one which tested it when the loops were run serially.
+    std::vector<PCB_VIA*>                   vias;
+    std::unordered_map<BOARD_ITEM*, size_t> viaIndices;
 
     for( PCB_TRACK* track : m_board->Tracks() )
     {
@@ -168,82 +169,68 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
 
         PCB_VIA* via = static_cast<PCB_VIA*>( track );
 
-        if( !reportProgress( ii++, count, progressDelta ) )
-            return false;   // DRC cancelled
-
         // We only care about mechanically drilled (ie: non-laser) holes.  These include both
         // blind/buried via holes (drilled prior to lamination) and through-via and drilled pad
         // holes (which are generally drilled post laminataion).
         if( via->GetViaType() != VIATYPE::MICROVIA )
         {
-            std::shared_ptr<SHAPE_CIRCLE> holeShape = getDrilledHoleShape( via );
-
-            m_holeTree.QueryColliding( via, Edge_Cuts, Edge_Cuts,
-                    // Filter:
-                    [&]( BOARD_ITEM* other ) -> bool
-                    {
-                        BOARD_ITEM* a = via;
-                        BOARD_ITEM* b = other;
+            viaIndices[ via ] = vias.size();
+            vias.push_back( via );
+        }
+    }
 
-                        // store canonical order so we don't collide in both directions
-                        // (a:b and b:a)
-                        if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                            std::swap( a, b );
+    bool ok = runParallel( vias.size(),
+            [&]( size_t aIndex )
+            {
+                PCB_VIA*                      via = vias[aIndex];
+                std::shared_ptr<SHAPE_CIRCLE> holeShape = getDrilledHoleShape( via );
 
-                        if( checkedPairs.find( { a, b } ) != checkedPairs.end() )
+                m_holeTree.QueryColliding( via, Edge_Cuts, Edge_Cuts,
+                        // Filter:
+                        [&]( BOARD_ITEM* other ) -> bool
                         {
-                            return false;
-                        }
-                        else
+                            auto it = viaIndices.find( other );
+                            return it == viaIndices.end() || it->second > aIndex;
+                        },
+                        // Visitor:
+                        [&]( BOARD_ITEM* other ) -> bool
                         {
-                            checkedPairs[ { a, b } ] = 1;
-                            return true;
-                        }
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* other ) -> bool
-                    {
-                        return testHoleAgainstHole( via, holeShape.get(), other );
-                    },
-                    m_largestHoleToHoleClearance );
-        }
-    }
+                            return testHoleAgainstHole( via, holeShape.get(), other );
+                        },
+                        m_largestHoleToHoleClearance );
+            } );
+
+    if( !ok )
+        return false;   // DRC cancelled
 
-    checkedPairs.clear();
+    std::vector<PAD*>                       pads;
+    std::unordered_map<BOARD_ITEM*, size_t> padIndices;
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
         for( PAD* pad : footprint->Pads() )
         {
-            if( !reportProgress( ii++, count, progressDelta ) )
-                return false;   // DRC cancelled
-
             // We only care about drilled (ie: round) holes
             if( pad->GetDrillSize().x && pad->GetDrillSize().x == pad->GetDrillSize().y )
             {
+                padIndices[ pad ] = pads.size();
+                pads.push_back( pad );
+            }
+        }
+    }
+
+    ok = runParallel( pads.size(),
+            [&]( size_t aIndex )
+            {
+                PAD*                          pad = pads[aIndex];
                 std::shared_ptr<SHAPE_CIRCLE> holeShape = getDrilledHoleShape( pad );
 
                 m_holeTree.QueryColliding( pad, Edge_Cuts, Edge_Cuts,
                         // Filter:
                         [&]( BOARD_ITEM* other ) -> bool
                         {
-                            BOARD_ITEM* a = pad;
-                            BOARD_ITEM* b = other;
-
-                            // store canonical order so we don't collide in both directions
-                            // (a:b and b:a)
-                            if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                                std::swap( a, b );
-
-                            if( checkedPairs.find( { a, b } ) != checkedPairs.end() )
-                            {
-                                return false;
-                            }
-                            else
-                            {
-                                checkedPairs[ { a, b } ] = 1;
-                                return true;
-                            }
+                            auto it = padIndices.find( other );
+                            return it == padIndices.end() || it->second > aIndex;
                         },
                         // Visitor:
                         [&]( BOARD_ITEM* other ) -> bool
@@ -251,12 +238,10 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
                             return testHoleAgainstHole( pad, holeShape.get(), other );
                         },
                         m_largestHoleToHoleClearance );
-            }
-        }
+            } );
 
-        if( m_drcEngine->IsCancelled() )
-            return false;
-    }
+    if( !ok )
+        return false;   // DRC cancelled
 
     reportRuleStatistics();
 
@@ -267,8 +252,8 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
 bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::testHoleAgainstHole( BOARD_ITEM* aItem, SHAPE_CIRCLE* aHole,
                                                           BOARD_ITEM* aOther )
 {
-    bool reportCoLocation = !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_COLOCATED );
-    bool reportHole2Hole = !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE );
+    bool reportCoLocation = !isErrorLimitExceeded( DRCE_DRILLED_HOLES_COLOCATED );
+    bool reportHole2Hole = !isErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE );
 
     if( !reportCoLocation && !reportHole2Hole )
         return false;
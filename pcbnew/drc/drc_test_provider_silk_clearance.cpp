@@ -173,87 +173,88 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
         DRC_RTREE::LAYER_PAIR( B_SilkS, Margin )
     };
 
-    targetTree.QueryCollidingPairs( &silkTree, layerPairs,
-            [&]( const DRC_RTREE::LAYER_PAIR& aLayers, DRC_RTREE::ITEM_WITH_SHAPE* aRefItemShape,
-                 DRC_RTREE::ITEM_WITH_SHAPE* aTestItemShape, bool* aCollisionDetected ) -> bool
+    std::vector<std::vector<DRC_RTREE::PAIR_INFO>> pairGroups =
+            targetTree.GetCollidingPairGroups( &silkTree, layerPairs, m_largestClearance );
+
+    // Each group holds the candidate shape pairs of a single pair of items; only the first
+    // colliding shape pair is reported (items may be compound or triangulated shapes).
+    runParallel( pairGroups.size(),
+            [&]( size_t aGroup )
             {
-                BOARD_ITEM*  refItem = aRefItemShape->parent;
-                const SHAPE* refShape = aRefItemShape->shape;
-                BOARD_ITEM*  testItem = aTestItemShape->parent;
-                const SHAPE* testShape = aTestItemShape->shape;
+                for( const DRC_RTREE::PAIR_INFO& pair : pairGroups[aGroup] )
+                {
+                    const DRC_RTREE::LAYER_PAIR& layers = pair.layerPair;
+                    BOARD_ITEM*                  refItem = pair.refItem->parent;
+                    const SHAPE*                 refShape = pair.refItem->shape;
+                    BOARD_ITEM*                  testItem = pair.testItem->parent;
+                    const SHAPE*                 testShape = pair.testItem->shape;
 
-                std::shared_ptr<SHAPE> hole;
+                    std::shared_ptr<SHAPE> hole;
 
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
-                    return false;
+                    if( isErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+                        return;
 
-                if( isInvisibleText( refItem ) || isInvisibleText( testItem ) )
-                    return true;
+                    if( isInvisibleText( refItem ) || isInvisibleText( testItem ) )
+                        continue;
 
-                if( testItem->IsTented() )
-                {
-                    if( testItem->HasHole() )
+                    if( testItem->IsTented() )
                     {
-                        hole = testItem->GetEffectiveHoleShape();
-                        testShape = hole.get();
+                        if( testItem->HasHole() )
+                        {
+                            hole = testItem->GetEffectiveHoleShape();
+                            testShape = hole.get();
+                        }
+                        else
+                        {
+                            continue;
+                        }
                     }
-                    else
-                    {
-                        return true;
-                    }
-                }
 
-                DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( SILK_CLEARANCE_CONSTRAINT,
-                                                                    refItem, testItem,
-                                                                    aLayers.second );
+                    DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( SILK_CLEARANCE_CONSTRAINT,
+                                                                        refItem, testItem,
+                                                                        layers.second );
 
-                if( constraint.IsNull() || constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
-                    return true;
+                    if( constraint.IsNull() || constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
+                        continue;
 
-                int minClearance = constraint.GetValue().Min();
+                    int minClearance = constraint.GetValue().Min();
 
-                if( minClearance < 0 )
-                    return true;
+                    if( minClearance < 0 )
+                        continue;
 
-                int      actual;
-                VECTOR2I pos;
-
-                // Graphics are often compound shapes so ignore collisions between shapes in a
-                // single footprint or on the board (both parent footprints will be nullptr).
-                if( refItem->Type() == PCB_SHAPE_T && testItem->Type() == PCB_SHAPE_T
-                         && refItem->GetParentFootprint() == testItem->GetParentFootprint() )
-                {
-                    return true;
-                }
+                    int      actual;
+                    VECTOR2I pos;
 
-                if( refShape->Collide( testShape, minClearance, &actual, &pos ) )
-                {
-                    std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_OVERLAPPING_SILK );
+                    // Graphics are often compound shapes so ignore collisions between shapes in
+                    // a single footprint or on the board (both parent footprints will be nullptr).
+                    if( refItem->Type() == PCB_SHAPE_T && testItem->Type() == PCB_SHAPE_T
+                             && refItem->GetParentFootprint() == testItem->GetParentFootprint() )
+                    {
+                        continue;
+                    }
 
-                    if( minClearance > 0 )
+                    if( refShape->Collide( testShape, minClearance, &actual, &pos ) )
                     {
-                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                  constraint.GetParentRule()->m_Name,
-                                                  minClearance,
-                                                  actual );
+                        std::shared_ptr<DRC_ITEM> drcItem =
+                                DRC_ITEM::Create( DRCE_OVERLAPPING_SILK );
 
-                        drcItem->SetErrorMessage( drcItem->GetErrorText() + wxS( " " ) + msg );
-                    }
+                        if( minClearance > 0 )
+                        {
+                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                                      constraint.GetParentRule()->m_Name,
+                                                      minClearance,
+                                                      actual );
 
-                    drcItem->SetItems( refItem, testItem );
-                    drcItem->SetViolatingRule( constraint.GetParentRule() );
+                            drcItem->SetErrorMessage( drcItem->GetErrorText() + wxS( " " ) + msg );
+                        }
 
-                    reportViolation( drcItem, pos, aLayers.second );
+                        drcItem->SetItems( refItem, testItem );
+                        drcItem->SetViolatingRule( constraint.GetParentRule() );
 
-                    *aCollisionDetected = true;
+                        reportViolation( drcItem, pos, layers.second );
+                        return;
+                    }
                 }
-
-                return true;
-            },
-            m_largestClearance,
-            [&]( int aCount, int aSize ) -> bool
-            {
-                return reportProgress( aCount, aSize, progressDelta );
             } );
 
     reportRuleStatistics();
@@ -33,7 +33,7 @@
 #include <drc/drc_test_provider.h>
 #include <advanced_config.h>
 #include <progress_reporter.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 
 /*
     Checks for slivers in copper layers
@@ -131,7 +131,8 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
                             {
                                 if( !zone->GetIsRuleArea() )
                                 {
-                                    fill = zone->GetFill( layer )->CloneDropTriangulation();
+                                    fill = zone->GetFilledPolysList( layer )
+                                                   ->CloneDropTriangulation();
                                     poly.Append( fill );
 
                                     // Report progress on board zones only.  Everything else is
@@ -160,24 +161,13 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
                 return 1;
             };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<std::future<size_t>> returns;
-
-    returns.reserve( copperLayers.size() );
+    TASK_GROUP layerGroup( GetKiCadTaskScheduler() );
 
     for( size_t ii = 0; ii < copperLayers.size(); ++ii )
-        returns.emplace_back( tp.submit( build_layer_polys, ii ) );
-
-    for( const std::future<size_t>& ret : returns )
-    {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        layerGroup.Run( [&build_layer_polys, ii]() { build_layer_polys( ii ); } );
 
-        while( status != std::future_status::ready )
-        {
-            reportProgress( zoneLayerCount, done );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
+    while( !layerGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( zoneLayerCount, done );
 
     for( int ii = 0; ii < layerCount; ++ii )
     {
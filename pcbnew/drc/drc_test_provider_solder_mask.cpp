@@ -77,13 +77,40 @@ private:
     void addItemToRTrees( BOARD_ITEM* aItem );
     void buildRTrees();
 
+    /**
+     * A collision candidate of a mask bridge test.  Candidates passing the cheap filters are
+     * collected in parallel, then each pair is claimed (serially, in board order) by the first
+     * item to reach it as in a serial run (see m_checkedPairs).  Only claimed pairs are collided,
+     * again in parallel, and whether the collisions constitute bridges is finally decided
+     * serially as it depends on the order in which items are visited (see m_maskApertureNetMap).
+     */
+    struct BRIDGE_CANDIDATE
+    {
+        BOARD_ITEM* m_Other;
+        bool        m_Claimed;
+        bool        m_Collides;
+        VECTOR2I    m_Pos;
+    };
+
+    struct BRIDGE_TEST
+    {
+        BOARD_ITEM*                   m_Item;
+        PCB_LAYER_ID                  m_RefLayer;
+        PCB_LAYER_ID                  m_TargetLayer;
+        bool                          m_AgainstZones;
+        std::vector<BRIDGE_CANDIDATE> m_Candidates;
+    };
+
     void testSilkToMaskClearance();
     void testMaskBridges();
 
-    void testItemAgainstItems( BOARD_ITEM* aItem, const BOX2I& aItemBBox,
-                               PCB_LAYER_ID aRefLayer, PCB_LAYER_ID aTargetLayer );
-    void testMaskItemAgainstZones( BOARD_ITEM* item, const BOX2I& itemBBox,
-                                   PCB_LAYER_ID refLayer, PCB_LAYER_ID targetLayer );
+    void collectItemCandidates( BRIDGE_TEST& aTest );
+    void claimItemCandidates( BRIDGE_TEST& aTest );
+    void collideItemCandidates( BRIDGE_TEST& aTest );
+    void collectZoneCandidates( BRIDGE_TEST& aTest );
+
+    void testItemAgainstItems( const BRIDGE_TEST& aTest );
+    void testMaskItemAgainstZones( const BRIDGE_TEST& aTest );
 
     bool checkMaskAperture( BOARD_ITEM* aMaskItem, BOARD_ITEM* aTestItem, PCB_LAYER_ID aTestLayer,
                             int aTestNet, BOARD_ITEM** aCollidingItem );
@@ -222,13 +249,15 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::buildRTrees()
                 return true;
             } );
 
-    solderMask->GetFill( F_Mask )->Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-    solderMask->GetFill( B_Mask )->Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    solderMask->GetFill( F_Mask )->SimplifyTiled( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    solderMask->GetFill( B_Mask )->SimplifyTiled( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-    solderMask->GetFill( F_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
-                                            m_maxError );
-    solderMask->GetFill( B_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
-                                            m_maxError );
+    solderMask->GetFill( F_Mask )->DeflateTiled( m_webWidth / 2,
+                                                 CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
+                                                 m_maxError );
+    solderMask->GetFill( B_Mask )->DeflateTiled( m_webWidth / 2,
+                                                 CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
+                                                 m_maxError );
 
     solderMask->SetFillFlag( F_Mask, true );
     solderMask->SetFillFlag( B_Mask, true );
@@ -245,30 +274,29 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::buildRTrees()
 
 void DRC_TEST_PROVIDER_SOLDER_MASK::testSilkToMaskClearance()
 {
-    LSET   silkLayers = { 2, F_SilkS, B_SilkS };
+    LSET                     silkLayers = { 2, F_SilkS, B_SilkS };
+    std::vector<BOARD_ITEM*> items;
 
-    const size_t progressDelta = 250;
-    int          count = 0;
-    int          ii = 0;
+    if( m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_CLEARANCE ) )
+        return;
 
     forEachGeometryItem( s_allBasicItems, silkLayers,
             [&]( BOARD_ITEM* item ) -> bool
             {
-                ++count;
+                items.push_back( item );
                 return true;
             } );
 
-    forEachGeometryItem( s_allBasicItems, silkLayers,
-            [&]( BOARD_ITEM* item ) -> bool
+    runParallel( items.size(),
+            [&]( size_t ii )
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_CLEARANCE ) )
-                    return false;
+                BOARD_ITEM* item = items[ii];
 
-                if( !reportProgress( ii++, count, progressDelta ) )
-                    return false;
+                if( isErrorLimitExceeded( DRCE_SILK_CLEARANCE ) )
+                    return;
 
                 if( isInvisibleText( item ) )
-                    return true;
+                    return;
 
                 for( PCB_LAYER_ID layer : silkLayers.Seq() )
                 {
@@ -284,7 +312,7 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testSilkToMaskClearance()
                     VECTOR2I       pos;
 
                     if( constraint.GetSeverity() == RPT_SEVERITY_IGNORE || clearance < 0 )
-                        return true;
+                        return;
 
                     std::shared_ptr<SHAPE> itemShape = item->GetEffectiveShape( layer );
 
@@ -309,8 +337,6 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testSilkToMaskClearance()
                         reportViolation( drce, pos, layer );
                     }
                 }
-
-                return true;
             } );
 }
 
@@ -430,21 +456,19 @@ bool DRC_TEST_PROVIDER_SOLDER_MASK::checkItemMask( BOARD_ITEM* aMaskItem, int aT
 }
 
 
-void DRC_TEST_PROVIDER_SOLDER_MASK::testItemAgainstItems( BOARD_ITEM* aItem, const BOX2I& aItemBBox,
-                                                          PCB_LAYER_ID aRefLayer,
-                                                          PCB_LAYER_ID aTargetLayer )
+void DRC_TEST_PROVIDER_SOLDER_MASK::collectItemCandidates( BRIDGE_TEST& aTest )
 {
-    int itemNet = -1;
+    BOARD_ITEM* aItem = aTest.m_Item;
+    int         itemNet = -1;
 
     if( aItem->IsConnected() )
         itemNet = static_cast<BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode();
 
     BOARD_DESIGN_SETTINGS& bds = aItem->GetBoard()->GetDesignSettings();
     PAD*                   pad = dynamic_cast<PAD*>( aItem );
-    PCB_VIA*               via = dynamic_cast<PCB_VIA*>( aItem );
-    std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( aRefLayer );
 
-    m_itemTree->QueryColliding( aItem, aRefLayer, aTargetLayer,
+    // Only the filter is run here: collisions are tested once the pairs have been claimed
+    m_itemTree->QueryColliding( aItem, aTest.m_RefLayer, aTest.m_TargetLayer,
             // Filter:
             [&]( BOARD_ITEM* other ) -> bool
             {
@@ -478,120 +502,163 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testItemAgainstItems( BOARD_ITEM* aItem, con
                     return false;
                 }
 
-                BOARD_ITEM* a = aItem;
-                BOARD_ITEM* b = other;
+                aTest.m_Candidates.push_back( { other, false, false, VECTOR2I() } );
+                return false;
+            },
+            nullptr, m_largestClearance );
+}
+
 
-                // store canonical order so we don't collide in both directions (a:b and b:a)
-                if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                    std::swap( a, b );
+void DRC_TEST_PROVIDER_SOLDER_MASK::claimItemCandidates( BRIDGE_TEST& aTest )
+{
+    for( BRIDGE_CANDIDATE& candidate : aTest.m_Candidates )
+    {
+        BOARD_ITEM* a = aTest.m_Item;
+        BOARD_ITEM* b = candidate.m_Other;
 
-                auto it = m_checkedPairs.find( { a, b } );
+        // store canonical order so we don't collide in both directions (a:b and b:a)
+        if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+            std::swap( a, b );
 
-                if( it != m_checkedPairs.end() && it->second.test( aTargetLayer ) )
-                {
-                    return false;
-                }
-                else
-                {
-                    m_checkedPairs[ { a, b } ].set( aTargetLayer );
-                    return true;
-                }
-            },
-            // Visitor:
-            [&]( BOARD_ITEM* other ) -> bool
-            {
-                PAD*     otherPad = dynamic_cast<PAD*>( other );
-                PCB_VIA* otherVia = dynamic_cast<PCB_VIA*>( other );
-                auto     otherShape = other->GetEffectiveShape( aTargetLayer );
-                int      otherNet = -1;
+        LSET& checkedLayers = m_checkedPairs[ { a, b } ];
 
-                if( other->IsConnected() )
-                    otherNet = static_cast<BOARD_CONNECTED_ITEM*>( other )->GetNetCode();
+        candidate.m_Claimed = !checkedLayers.test( aTest.m_TargetLayer );
+        checkedLayers.set( aTest.m_TargetLayer );
+    }
+}
 
-                int      actual;
-                VECTOR2I pos;
-                int      clearance = 0;
 
-                if( aRefLayer == F_Mask || aRefLayer == B_Mask )
-                {
-                    // Aperture-to-aperture must enforce web-min-width
-                    clearance = m_webWidth;
-                }
-                else // ( aRefLayer == F_Cu || aRefLayer == B_Cu )
-                {
-                    // Copper-to-aperture uses the solder-mask-to-copper-clearance
-                    clearance = m_board->GetDesignSettings().m_SolderMaskToCopperClearance;
-                }
+void DRC_TEST_PROVIDER_SOLDER_MASK::collideItemCandidates( BRIDGE_TEST& aTest )
+{
+    BOARD_ITEM*            aItem = aTest.m_Item;
+    PCB_LAYER_ID           aRefLayer = aTest.m_RefLayer;
+    PAD*                   pad = dynamic_cast<PAD*>( aItem );
+    PCB_VIA*               via = dynamic_cast<PCB_VIA*>( aItem );
+    std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( aRefLayer );
 
-                if( pad )
-                    clearance += pad->GetSolderMaskExpansion();
-                else if( via && !via->IsTented() )
-                    clearance += via->GetSolderMaskExpansion();
+    for( BRIDGE_CANDIDATE& candidate : aTest.m_Candidates )
+    {
+        if( !candidate.m_Claimed )
+            continue;
 
-                if( otherPad )
-                    clearance += otherPad->GetSolderMaskExpansion();
-                else if( otherVia && !otherVia->IsTented() )
-                    clearance += otherVia->GetSolderMaskExpansion();
+        BOARD_ITEM* other = candidate.m_Other;
+        PAD*        otherPad = dynamic_cast<PAD*>( other );
+        PCB_VIA*    otherVia = dynamic_cast<PCB_VIA*>( other );
+        auto        otherShape = other->GetEffectiveShape( aTest.m_TargetLayer );
+        int         actual;
+        int         clearance = 0;
 
-                if( itemShape->Collide( otherShape.get(), clearance, &actual, &pos ) )
-                {
-                    wxString    msg;
-                    BOARD_ITEM* colliding = nullptr;
+        // The broad phase of DRC_RTREE::QueryColliding()
+        if( !itemShape->Collide( otherShape.get(), m_largestClearance ) )
+            continue;
 
-                    if( aTargetLayer == F_Mask )
-                        msg = _( "Front solder mask aperture bridges items with different nets" );
-                    else
-                        msg = _( "Rear solder mask aperture bridges items with different nets" );
+        if( aRefLayer == F_Mask || aRefLayer == B_Mask )
+        {
+            // Aperture-to-aperture must enforce web-min-width
+            clearance = m_webWidth;
+        }
+        else // ( aRefLayer == F_Cu || aRefLayer == B_Cu )
+        {
+            // Copper-to-aperture uses the solder-mask-to-copper-clearance
+            clearance = m_board->GetDesignSettings().m_SolderMaskToCopperClearance;
+        }
 
-                    // Simple mask apertures aren't associated with copper items, so they only
-                    // constitute a bridge when they expose other copper items having at least
-                    // two distinct nets.
-                    if( isMaskAperture( aItem ) )
-                    {
-                        if( checkMaskAperture( aItem, other, aRefLayer, otherNet, &colliding ) )
-                        {
-                            auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
+        if( pad )
+            clearance += pad->GetSolderMaskExpansion();
+        else if( via && !via->IsTented() )
+            clearance += via->GetSolderMaskExpansion();
 
-                            drce->SetErrorMessage( msg );
-                            drce->SetItems( aItem, colliding, other );
-                            drce->SetViolatingRule( &m_bridgeRule );
-                            reportViolation( drce, pos, aTargetLayer );
-                        }
-                    }
-                    else if( isMaskAperture( other ) )
-                    {
-                        if( checkMaskAperture( other, aItem, aRefLayer, itemNet, &colliding ) )
-                        {
-                            auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
+        if( otherPad )
+            clearance += otherPad->GetSolderMaskExpansion();
+        else if( otherVia && !otherVia->IsTented() )
+            clearance += otherVia->GetSolderMaskExpansion();
 
-                            drce->SetErrorMessage( msg );
-                            drce->SetItems( other, colliding, aItem );
-                            drce->SetViolatingRule( &m_bridgeRule );
-                            reportViolation( drce, pos, aTargetLayer );
-                        }
-                    }
-                    else if( checkItemMask( other, itemNet ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
+        candidate.m_Collides = itemShape->Collide( otherShape.get(), clearance, &actual,
+                                                   &candidate.m_Pos );
 
-                        drce->SetErrorMessage( msg );
-                        drce->SetItems( aItem, other );
-                        drce->SetViolatingRule( &m_bridgeRule );
-                        reportViolation( drce, pos, aTargetLayer );
-                    }
-                }
+        if( m_drcEngine->IsCancelled() )
+            return;
+    }
+}
 
-                return !m_drcEngine->IsCancelled();
-            },
-            m_largestClearance );
+
+void DRC_TEST_PROVIDER_SOLDER_MASK::testItemAgainstItems( const BRIDGE_TEST& aTest )
+{
+    BOARD_ITEM*  aItem = aTest.m_Item;
+    PCB_LAYER_ID aRefLayer = aTest.m_RefLayer;
+    PCB_LAYER_ID aTargetLayer = aTest.m_TargetLayer;
+    int          itemNet = -1;
+
+    if( aItem->IsConnected() )
+        itemNet = static_cast<BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode();
+
+    for( const BRIDGE_CANDIDATE& candidate : aTest.m_Candidates )
+    {
+        BOARD_ITEM* other = candidate.m_Other;
+
+        if( !candidate.m_Claimed || !candidate.m_Collides )
+            continue;
+
+        int otherNet = -1;
+
+        if( other->IsConnected() )
+            otherNet = static_cast<BOARD_CONNECTED_ITEM*>( other )->GetNetCode();
+
+        wxString    msg;
+        BOARD_ITEM* colliding = nullptr;
+        VECTOR2I    pos = candidate.m_Pos;
+
+        if( aTargetLayer == F_Mask )
+            msg = _( "Front solder mask aperture bridges items with different nets" );
+        else
+            msg = _( "Rear solder mask aperture bridges items with different nets" );
+
+        // Simple mask apertures aren't associated with copper items, so they only constitute a
+        // bridge when they expose other copper items having at least two distinct nets.
+        if( isMaskAperture( aItem ) )
+        {
+            if( checkMaskAperture( aItem, other, aRefLayer, otherNet, &colliding ) )
+            {
+                auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
+
+                drce->SetErrorMessage( msg );
+                drce->SetItems( aItem, colliding, other );
+                drce->SetViolatingRule( &m_bridgeRule );
+                reportViolation( drce, pos, aTargetLayer );
+            }
+        }
+        else if( isMaskAperture( other ) )
+        {
+            if( checkMaskAperture( other, aItem, aRefLayer, itemNet, &colliding ) )
+            {
+                auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
+
+                drce->SetErrorMessage( msg );
+                drce->SetItems( other, colliding, aItem );
+                drce->SetViolatingRule( &m_bridgeRule );
+                reportViolation( drce, pos, aTargetLayer );
+            }
+        }
+        else if( checkItemMask( other, itemNet ) )
+        {
+            auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
+
+            drce->SetErrorMessage( msg );
+            drce->SetItems( aItem, other );
+            drce->SetViolatingRule( &m_bridgeRule );
+            reportViolation( drce, pos, aTargetLayer );
+        }
+    }
 }
 
 
-void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskItemAgainstZones( BOARD_ITEM* aItem,
-                                                              const BOX2I& aItemBBox,
-                                                              PCB_LAYER_ID aMaskLayer,
-                                                              PCB_LAYER_ID aTargetLayer )
+void DRC_TEST_PROVIDER_SOLDER_MASK::collectZoneCandidates( BRIDGE_TEST& aTest )
 {
+    BOARD_ITEM*  aItem = aTest.m_Item;
+    PCB_LAYER_ID aMaskLayer = aTest.m_RefLayer;
+    PCB_LAYER_ID aTargetLayer = aTest.m_TargetLayer;
+    BOX2I        itemBBox = aItem->GetBoundingBox();
+
     for( ZONE* zone : m_board->m_DRCCopperZones )
     {
         if( !zone->GetLayerSet().test( aTargetLayer ) )
@@ -607,7 +674,7 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskItemAgainstZones( BOARD_ITEM* aItem,
                 continue;
         }
 
-        BOX2I inflatedBBox( aItemBBox );
+        BOX2I inflatedBBox( itemBBox );
         int   clearance = m_board->GetDesignSettings().m_SolderMaskToCopperClearance;
 
         if( aItem->Type() == PCB_PAD_T )
@@ -626,104 +693,165 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskItemAgainstZones( BOARD_ITEM* aItem,
 
         std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( aMaskLayer );
 
-        if( zoneTree && zoneTree->QueryColliding( aItemBBox, itemShape.get(), aTargetLayer,
+        if( zoneTree && zoneTree->QueryColliding( itemBBox, itemShape.get(), aTargetLayer,
                                                   clearance, &actual, &pos ) )
         {
-            wxString    msg;
-            BOARD_ITEM* colliding = nullptr;
+            aTest.m_Candidates.push_back( { zone, true, true, pos } );
+        }
 
-            if( aMaskLayer == F_Mask )
-                msg = _( "Front solder mask aperture bridges items with different nets" );
-            else
-                msg = _( "Rear solder mask aperture bridges items with different nets" );
+        if( m_drcEngine->IsCancelled() )
+            return;
+    }
+}
 
-            // Simple mask apertures aren't associated with copper items, so they only constitute
-            // a bridge when they expose other copper items having at least two distinct nets.
-            if( isMaskAperture( aItem ) && zoneNet >= 0 )
-            {
-                if( checkMaskAperture( aItem, zone, aTargetLayer, zoneNet, &colliding ) )
-                {
-                    auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
 
-                    drce->SetErrorMessage( msg );
-                    drce->SetItems( aItem, colliding, zone );
-                    drce->SetViolatingRule( &m_bridgeRule );
-                    reportViolation( drce, pos, aTargetLayer );
-                }
-            }
-            else
+void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskItemAgainstZones( const BRIDGE_TEST& aTest )
+{
+    BOARD_ITEM*  aItem = aTest.m_Item;
+    PCB_LAYER_ID aMaskLayer = aTest.m_RefLayer;
+    PCB_LAYER_ID aTargetLayer = aTest.m_TargetLayer;
+
+    for( const BRIDGE_CANDIDATE& candidate : aTest.m_Candidates )
+    {
+        ZONE*       zone = static_cast<ZONE*>( candidate.m_Other );
+        int         zoneNet = zone->GetNetCode();
+        wxString    msg;
+        BOARD_ITEM* colliding = nullptr;
+
+        if( aMaskLayer == F_Mask )
+            msg = _( "Front solder mask aperture bridges items with different nets" );
+        else
+            msg = _( "Rear solder mask aperture bridges items with different nets" );
+
+        // Simple mask apertures aren't associated with copper items, so they only constitute
+        // a bridge when they expose other copper items having at least two distinct nets.
+        if( isMaskAperture( aItem ) && zoneNet >= 0 )
+        {
+            if( checkMaskAperture( aItem, zone, aTargetLayer, zoneNet, &colliding ) )
             {
                 auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
 
                 drce->SetErrorMessage( msg );
-                drce->SetItems( aItem, zone );
+                drce->SetItems( aItem, colliding, zone );
                 drce->SetViolatingRule( &m_bridgeRule );
-                reportViolation( drce, pos, aTargetLayer );
+                reportViolation( drce, candidate.m_Pos, aTargetLayer );
             }
         }
+        else
+        {
+            auto drce = DRC_ITEM::Create( DRCE_SOLDERMASK_BRIDGE );
 
-        if( m_drcEngine->IsCancelled() )
-            return;
+            drce->SetErrorMessage( msg );
+            drce->SetItems( aItem, zone );
+            drce->SetViolatingRule( &m_bridgeRule );
+            reportViolation( drce, candidate.m_Pos, aTargetLayer );
+        }
     }
 }
 
 
 void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskBridges()
 {
-    LSET   copperAndMaskLayers = { 4, F_Mask, B_Mask, F_Cu, B_Cu };
+    LSET                     copperAndMaskLayers = { 4, F_Mask, B_Mask, F_Cu, B_Cu };
+    std::vector<BOARD_ITEM*> items;
 
-    const size_t progressDelta = 250;
-    int          count = 0;
-    int          ii = 0;
+    if( m_drcEngine->IsErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
+        return;
 
     forEachGeometryItem( s_allBasicItemsButZones, copperAndMaskLayers,
             [&]( BOARD_ITEM* item ) -> bool
             {
-                ++count;
+                items.push_back( item );
                 return true;
             } );
 
-    forEachGeometryItem( s_allBasicItemsButZones, copperAndMaskLayers,
-            [&]( BOARD_ITEM* item ) -> bool
-            {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
-                    return false;
-
-                if( !reportProgress( ii++, count, progressDelta ) )
-                    return false;
+    std::vector<std::vector<BRIDGE_TEST>> tests( items.size() );
 
-                BOX2I itemBBox = item->GetBoundingBox();
+    // Collect the candidates passing the cheap filters in parallel...
+    bool ok = runParallel( items.size(),
+            [&]( size_t ii )
+            {
+                BOARD_ITEM*               item = items[ii];
+                std::vector<BRIDGE_TEST>& itemTests = tests[ii];
 
                 if( item->IsOnLayer( F_Mask ) && !isNullAperture( item ) )
                 {
                     // Test for aperture-to-aperture collisions
-                    testItemAgainstItems( item, itemBBox, F_Mask, F_Mask );
+                    itemTests.push_back( { item, F_Mask, F_Mask, false, {} } );
 
                     // Test for aperture-to-zone collisions
-                    testMaskItemAgainstZones( item, itemBBox, F_Mask, F_Cu );
+                    itemTests.push_back( { item, F_Mask, F_Cu, true, {} } );
                 }
                 else if( item->IsOnLayer( F_Cu ) )
                 {
                     // Test for copper-item-to-aperture collisions
-                    testItemAgainstItems( item, itemBBox, F_Cu, F_Mask );
+                    itemTests.push_back( { item, F_Cu, F_Mask, false, {} } );
                 }
 
                 if( item->IsOnLayer( B_Mask ) && !isNullAperture( item ) )
                 {
                     // Test for aperture-to-aperture collisions
-                    testItemAgainstItems( item, itemBBox, B_Mask, B_Mask );
+                    itemTests.push_back( { item, B_Mask, B_Mask, false, {} } );
 
                     // Test for aperture-to-zone collisions
-                    testMaskItemAgainstZones( item, itemBBox, B_Mask, B_Cu );
+                    itemTests.push_back( { item, B_Mask, B_Cu, true, {} } );
                 }
                 else if( item->IsOnLayer( B_Cu ) )
                 {
                     // Test for copper-item-to-aperture collisions
-                    testItemAgainstItems( item, itemBBox, B_Cu, B_Mask );
+                    itemTests.push_back( { item, B_Cu, B_Mask, false, {} } );
                 }
 
-                return true;
+                for( BRIDGE_TEST& test : itemTests )
+                {
+                    if( !test.m_AgainstZones )
+                        collectItemCandidates( test );
+                }
             } );
+
+    if( !ok )
+        return;
+
+    // ... give each pair to the first item reaching it in board order...
+    for( std::vector<BRIDGE_TEST>& itemTests : tests )
+    {
+        for( BRIDGE_TEST& test : itemTests )
+        {
+            if( !test.m_AgainstZones )
+                claimItemCandidates( test );
+        }
+    }
+
+    // ... collide the claimed pairs in parallel...
+    ok = runParallel( items.size(),
+            [&]( size_t ii )
+            {
+                for( BRIDGE_TEST& test : tests[ii] )
+                {
+                    if( test.m_AgainstZones )
+                        collectZoneCandidates( test );
+                    else
+                        collideItemCandidates( test );
+                }
+            } );
+
+    if( !ok )
+        return;
+
+    // ... then decide which collisions are bridges in board order.
+    for( const std::vector<BRIDGE_TEST>& itemTests : tests )
+    {
+        if( m_drcEngine->IsErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
+            break;
+
+        for( const BRIDGE_TEST& test : itemTests )
+        {
+            if( test.m_AgainstZones )
+                testMaskItemAgainstZones( test );
+            else
+                testItemAgainstItems( test );
+        }
+    }
 }
 
 
@@ -28,7 +28,7 @@
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
@@ -81,8 +81,8 @@ void DRC_TEST_PROVIDER_ZONE_CONNECTIONS::testZoneLayer( ZONE* aZone, PCB_LAYER_I
     DRC_CONSTRAINT                     constraint;
     wxString                           msg;
 
-    const std::shared_ptr<SHAPE_POLY_SET>& zoneFill = aZone->GetFilledPolysList( aLayer );
-    ISOLATED_ISLANDS                       isolatedIslands;
+    std::shared_ptr<const SHAPE_POLY_SET> zoneFill = aZone->GetFilledPolysList( aLayer );
+    ISOLATED_ISLANDS                      isolatedIslands;
 
     auto zoneIter = board->m_ZoneIsolatedIslandsMap.find( aZone );
 
@@ -260,37 +260,26 @@ bool DRC_TEST_PROVIDER_ZONE_CONNECTIONS::Run()
 
     total_effort = std::max( (size_t) 1, total_effort );
 
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<std::future<int>> returns;
+    CANCELLATION_TOKEN cancelToken(
+            [this]()
+            {
+                return m_drcEngine->IsCancelled();
+            } );
 
-    returns.reserve( zoneLayers.size() );
+    TASK_GROUP zoneGroup( GetKiCadTaskScheduler(), &cancelToken );
 
-    for( const std::pair<ZONE*, PCB_LAYER_ID>& zonelayer : zoneLayers )
+    for( const auto& [ zone, layer ] : zoneLayers )
     {
-        returns.emplace_back( tp.submit(
-                [&]( ZONE* aZone, PCB_LAYER_ID aLayer ) -> int
+        zoneGroup.Run(
+                [this, &done, zone = zone, layer = layer]()
                 {
-                    if( !m_drcEngine->IsCancelled() )
-                    {
-                        testZoneLayer( aZone, aLayer );
-                        done.fetch_add( aZone->GetFilledPolysList( aLayer )->FullPointCount() );
-                    }
-
-                    return 0;
-                },
-                zonelayer.first, zonelayer.second ) );
+                    testZoneLayer( zone, layer );
+                    done.fetch_add( zone->GetFilledPolysList( layer )->FullPointCount() );
+                } );
     }
 
-    for( const std::future<int>& ret : returns )
-    {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-
-        while( status != std::future_status::ready )
-        {
-            reportProgress( done, total_effort );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
+    while( !zoneGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+        reportProgress( done, total_effort );
 
     return !m_drcEngine->IsCancelled();
 }
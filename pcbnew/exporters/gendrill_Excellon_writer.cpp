@@ -39,6 +39,7 @@
 #include <string_utils.h>
 #include <locale_io.h>
 #include <macros.h>
+#include <core/task_scheduler.h>
 #include <pcb_edit_frame.h>
 #include <build_version.h>
 #include <math/util.h>      // for KiROUND
@@ -77,8 +78,6 @@ bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenMap, REPORTER * aReporter )
 {
     bool        success = true;
-    wxFileName  fn;
-    wxString    msg;
 
     std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
@@ -86,66 +85,68 @@ bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     if( !m_merge_PTH_NPTH )
         hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    if( aGenDrill )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file to be
-        // sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole
-        // drill file is created (do not create any PTH drill file can be seen as not working
-        // drill generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-        {
-            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
-            fn.SetPath( aPlotDirectory );
-
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
+        std::vector<DRILL_FILE_STATUS> status( hole_sets.size(), DRILL_FILE_STATUS::SKIPPED );
+        std::vector<wxString>          fileNames( hole_sets.size() );
+        CANCELLATION_TOKEN             failed;
 
-                FILE* file = wxFopen( fullFilename, wxT( "w" ) );
+        // Each hole set is written by its own copy of the writer, so the files can be written
+        // concurrently.  The locale must be switched before starting the threads.
+        LOCALE_IO toggle;
 
-                if( file == nullptr )
+        ParallelForLimited( GetKiCadTaskScheduler(), 0, hole_sets.size(), m_parallelJobs,
+                [&]( size_t ii )
                 {
-                    if( aReporter )
+                    DRILL_LAYER_PAIR pair = hole_sets[ii];
+                    // For separate drill files, the last layer pair is the NPTH drill file.
+                    bool doing_npth = m_merge_PTH_NPTH ? false : ( ii == hole_sets.size() - 1 );
+                    EXCELLON_WRITER  writer( *this );
+
+                    writer.buildHolesList( pair, doing_npth );
+
+                    // The file is created if it has holes, or if it is the non plated drill
+                    // file to be sure the NPTH file is up to date in separate files mode.
+                    // Also a PTH drill/map file is always created, to be sure at least one
+                    // plated hole drill file is created (do not create any PTH drill file can
+                    // be seen as not working drill generator).
+                    if( writer.getHolesCount() == 0 && !doing_npth
+                            && pair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
                     {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
+                        return;
                     }
 
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
+                    wxFileName fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
+                    fn.SetPath( aPlotDirectory );
+                    fileNames[ii] = fn.GetFullPath();
+
+                    FILE* file = wxFopen( fileNames[ii], wxT( "w" ) );
+
+                    if( file == nullptr )
                     {
-                        msg.Printf( _( "Created file '%s'" ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
+                        status[ii] = DRILL_FILE_STATUS::FAILED;
+                        failed.Cancel();
+                        return;
                     }
-                }
 
-                TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
+                    TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
 
-                // Only external layer pair can have non plated hole
-                // internal layers have only plated via holes
-                if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-                {
-                    if( m_merge_PTH_NPTH )
-                        file_type = TYPE_FILE::MIXED_FILE;
-                    else if( doing_npth )
-                        file_type = TYPE_FILE::NPTH_FILE;
-                }
+                    // Only external layer pair can have non plated hole
+                    // internal layers have only plated via holes
+                    if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                    {
+                        if( m_merge_PTH_NPTH )
+                            file_type = TYPE_FILE::MIXED_FILE;
+                        else if( doing_npth )
+                            file_type = TYPE_FILE::NPTH_FILE;
+                    }
 
-                createDrillFile( file, pair, file_type );
-            }
-        }
+                    writer.createDrillFile( file, pair, file_type );
+                    status[ii] = DRILL_FILE_STATUS::CREATED;
+                },
+                &failed );
+
+        success = reportDrillFiles( status, fileNames, aReporter );
     }
 
     if( aGenMap )
@@ -297,6 +297,38 @@ const wxString GENDRILL_WRITER_BASE::getDrillFileName( DRILL_LAYER_PAIR aPair, b
     return ret;
 }
 
+bool GENDRILL_WRITER_BASE::reportDrillFiles( const std::vector<DRILL_FILE_STATUS>& aStatus,
+                                             const std::vector<wxString>& aFileNames,
+                                             REPORTER* aReporter ) const
+{
+    wxString msg;
+
+    for( size_t ii = 0; ii < aStatus.size(); ++ii )
+    {
+        if( aStatus[ii] == DRILL_FILE_STATUS::FAILED )
+        {
+            if( aReporter )
+            {
+                msg.Printf( _( "Failed to create file '%s'." ), aFileNames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ERROR );
+            }
+
+            return false;
+        }
+        else if( aStatus[ii] == DRILL_FILE_STATUS::CREATED )
+        {
+            if( aReporter )
+            {
+                msg.Printf( _( "Created file '%s'." ), aFileNames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ACTION );
+            }
+        }
+    }
+
+    return true;
+}
+
+
 bool GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
                                               REPORTER * aReporter )
 {
@@ -177,6 +177,13 @@ public:
      */
     void SetMergeOption( bool aMerge ) { m_merge_PTH_NPTH = aMerge; }
 
+    /**
+     * Set the number of drill files written concurrently.
+     *
+     * @param aJobs is the maximum number of files written at a time, 0 for one per CPU.
+     */
+    void SetParallelJobs( unsigned aJobs ) { m_parallelJobs = aJobs; }
+
     /**
      * Return the plot offset (usually the position of the drill/place origin).
      */
@@ -374,8 +381,26 @@ protected:
         m_pageInfo        = nullptr;
         m_merge_PTH_NPTH  = false;
         m_zeroFormat      = DECIMAL_FORMAT;
+        m_parallelJobs    = 1;
     }
 
+    /// The outcome of writing the drill file of a hole set
+    enum class DRILL_FILE_STATUS
+    {
+        SKIPPED,                // No holes, so no file needed
+        CREATED,
+        FAILED
+    };
+
+    /**
+     * Report the outcome of writing the drill files, in hole set order, up to the first one
+     * which failed.
+     *
+     * @return false if a file failed.
+     */
+    bool reportDrillFiles( const std::vector<DRILL_FILE_STATUS>& aStatus,
+                           const std::vector<wxString>& aFileNames, REPORTER* aReporter ) const;
+
     BOARD*                   m_pcb;
     wxString                 m_drillFileExtension;      // .drl or .gbr, depending on format
     bool                     m_unitsMetric;             // true = mm, false = inches
@@ -394,6 +419,7 @@ protected:
                                                         // if this map is needed
     const PAGE_INFO*         m_pageInfo;                // the page info used to plot drill maps
                                                         // If NULL, use a A4 page format
+    unsigned                 m_parallelJobs;            // Drill files written concurrently
 };
 
 #endif      // #define GENDRILL_FILE_WRITER_BASE_H
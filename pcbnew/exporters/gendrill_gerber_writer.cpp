@@ -30,6 +30,7 @@
 #include <plotters/plotter_gerber.h>
 #include <string_utils.h>
 #include <locale_io.h>
+#include <core/task_scheduler.h>
 #include <board.h>
 #include <footprint.h>
 #include <pcb_track.h>
@@ -61,62 +62,60 @@ bool GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory, b
     // Note: In Gerber drill files, NPTH and PTH are always separate files
     m_merge_PTH_NPTH = false;
 
-    wxFileName  fn;
-    wxString    msg;
-
     std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
     // append a pair representing the NPTH set of holes, for separate drill files.
     // (Gerber drill files are separate files for PTH and NPTH)
     hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    if( aGenDrill )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole drill
-        // file is created (do not create any PTH drill file can be seen as not working drill
-        // generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-        {
-            fn = getDrillFileName( pair, doing_npth, false );
-            fn.SetPath( aPlotDirectory );
-
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
+        std::vector<DRILL_FILE_STATUS> status( hole_sets.size(), DRILL_FILE_STATUS::SKIPPED );
+        std::vector<wxString>          fileNames( hole_sets.size() );
+        CANCELLATION_TOKEN             failed;
 
-                int result = createDrillFile( fullFilename, doing_npth, pair );
+        // Each hole set is plotted by its own copy of the writer, so the files can be written
+        // concurrently.  The locale must be switched before starting the threads.
+        LOCALE_IO toggle;
 
-                if( result < 0 )
+        ParallelForLimited( GetKiCadTaskScheduler(), 0, hole_sets.size(), m_parallelJobs,
+                [&]( size_t ii )
                 {
-                    if( aReporter )
+                    DRILL_LAYER_PAIR pair = hole_sets[ii];
+                    // For separate drill files, the last layer pair is the NPTH drill file.
+                    bool             doing_npth = ( ii == hole_sets.size() - 1 );
+                    GERBER_WRITER    writer( *this );
+
+                    writer.buildHolesList( pair, doing_npth );
+
+                    // The file is created if it has holes, or if it is the non plated drill
+                    // file to be sure the NPTH file is up to date in separate files mode.
+                    // Also a PTH drill/map file is always created, to be sure at least one
+                    // plated hole drill file is created (do not create any PTH drill file can
+                    // be seen as not working drill generator).
+                    if( writer.getHolesCount() == 0 && !doing_npth
+                            && pair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
                     {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
+                        return;
                     }
 
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
+                    wxFileName fn = getDrillFileName( pair, doing_npth, false );
+                    fn.SetPath( aPlotDirectory );
+                    fileNames[ii] = fn.GetFullPath();
+
+                    if( writer.createDrillFile( fileNames[ii], doing_npth, pair ) < 0 )
+                    {
+                        status[ii] = DRILL_FILE_STATUS::FAILED;
+                        failed.Cancel();
+                    }
+                    else
                     {
-                        msg.Printf( _( "Created file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
+                        status[ii] = DRILL_FILE_STATUS::CREATED;
                     }
-                }
+                },
+                &failed );
 
-            }
-        }
+        success = reportDrillFiles( status, fileNames, aReporter );
     }
 
     if( aGenMap )
@@ -24,7 +24,9 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -42,6 +44,8 @@
 #include <kiplatform/io.h>
 #include <string_utils.h>
 #include <build_version.h>
+#include <core/profile.h>
+#include <core/task_scheduler.h>
 #include <geometry/shape_segment.h>
 
 #include "step_pcb_model.h"
@@ -936,46 +940,68 @@ bool STEP_PCB_MODEL::CreatePCB( SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin )
 
         auto subtractShapes = [&]( const wxString& aWhat, std::vector<TopoDS_Shape>& aShapesList )
         {
-            // Remove holes for each item (board body or bodies, one can have more than one board)
-            int cnt = 0;
-            for( TopoDS_Shape& shape : aShapesList )
+            if( aShapesList.empty() )
+                return;
+
+            ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
+
+            PROF_TIMER timer;
+
+            // Bnd_BoundSortBox::Compare() isn't reentrant, so find the holes of each item
+            // (board body or bodies, one can have more than one board) first
+            std::vector<TopTools_ListOfShape> holelists( aShapesList.size() );
+
+            for( size_t ii = 0; ii < aShapesList.size(); ++ii )
             {
                 Bnd_Box shapeBbox;
-                BRepBndLib::Add( shape, shapeBbox );
+                BRepBndLib::Add( aShapesList[ii], shapeBbox );
 
-                const TColStd_ListOfInteger& indices = bsbHoles.Compare( shapeBbox );
-
-                TopTools_ListOfShape holelist;
+                for( const Standard_Integer& index : bsbHoles.Compare( shapeBbox ) )
+                    holelists[ii].Append( m_cutouts[index] );
+            }
 
-                for( const Standard_Integer& index : indices )
-                    holelist.Append( m_cutouts[index] );
+            // The items are cut concurrently; a hole can be a tool of several cuts at once, so
+            // the cuts must not modify their inputs.  OCC also splits the big cuts (typically
+            // the board bodies) between threads.
+            std::atomic<int> cnt( 0 );
+            std::mutex       reportLock;
 
-                if( cnt == 0 )
-                    ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
+            ParallelFor( GetKiCadTaskScheduler(), 0, aShapesList.size(),
+                    [&]( size_t ii )
+                    {
+                        if( !holelists[ii].IsEmpty() )
+                        {
+                            TopTools_ListOfShape cutArgs;
+                            cutArgs.Append( aShapesList[ii] );
 
-                cnt++;
+                            BRepAlgoAPI_Cut cut;
 
-                if( cnt % 10 == 0 )
-                    ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), cnt,
-                                                     (int) aShapesList.size(), aWhat ) );
+                            // This helps cutting circular holes in zones where a hole is already
+                            // cut in Clipper
+                            cut.SetFuzzyValue( 0.0005 );
+                            cut.SetNonDestructive( Standard_True );
+                            cut.SetRunParallel( Standard_True );
+                            cut.SetArguments( cutArgs );
 
-                if( holelist.IsEmpty() )
-                    continue;
+                            cut.SetTools( holelists[ii] );
+                            cut.Build();
 
-                TopTools_ListOfShape cutArgs;
-                cutArgs.Append( shape );
+                            aShapesList[ii] = cut.Shape();
+                        }
 
-                BRepAlgoAPI_Cut cut;
+                        int done = ++cnt;
 
-                // This helps cutting circular holes in zones where a hole is already cut in Clipper
-                cut.SetFuzzyValue( 0.0005 );
-                cut.SetArguments( cutArgs );
+                        if( done % 10 == 0 )
+                        {
+                            std::lock_guard<std::mutex> lock( reportLock );
 
-                cut.SetTools( holelist );
-                cut.Build();
+                            ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), done,
+                                                             (int) aShapesList.size(), aWhat ) );
+                        }
+                    } );
 
-                shape = cut.Shape();
-            }
+            ReportMessage( wxString::Format( _( "Cut %d %s in %.1f ms\n" ),
+                                             (int) aShapesList.size(), aWhat, timer.msecs() ) );
         };
 
         subtractShapes( _( "pads" ), m_board_copper_pads );
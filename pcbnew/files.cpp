@@ -28,7 +28,7 @@
 
 #include <confirm.h>
 #include <core/arraydim.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <gestfich.h>
 #include <pcb_edit_frame.h>
 #include <board_design_settings.h>
@@ -1291,21 +1291,21 @@ void PCB_EDIT_FRAME::GenIPC2581File( wxCommandEvent& event )
         }
     };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    auto ret = tp.submit( saveFile );
+    TASK_GROUP saveGroup( GetKiCadTaskScheduler() );
+    bool       saved = false;
 
-
-    std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-
-    while( status != std::future_status::ready )
-    {
-        reporter.KeepRefreshing();
-        status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-    }
+    saveGroup.Run(
+            [&]()
+            {
+                saved = saveFile();
+            } );
 
     try
     {
-        if( !ret.get() )
+        while( !saveGroup.WaitFor( std::chrono::milliseconds( 250 ) ) )
+            reporter.KeepRefreshing();
+
+        if( !saved )
             return;
     }
     catch(const std::exception& e)
@@ -3040,6 +3040,43 @@ bool FOOTPRINT::operator==( const BOARD_ITEM& aOther ) const
 }
 
 
+bool FOOTPRINT::IsTranslationOf( const FOOTPRINT& aOther ) const
+{
+    VECTOR2I delta = GetPosition() - aOther.GetPosition();
+
+    if( GetOrientation() != aOther.GetOrientation() || GetLayer() != aOther.GetLayer() )
+        return false;
+
+    std::vector<BOARD_ITEM*> children;
+    std::vector<BOARD_ITEM*> otherChildren;
+
+    RunOnChildren( [&]( BOARD_ITEM* aChild ) { children.push_back( aChild ); } );
+    aOther.RunOnChildren( [&]( BOARD_ITEM* aChild ) { otherChildren.push_back( aChild ); } );
+
+    if( children.size() != otherChildren.size() )
+        return false;
+
+    for( size_t ii = 0; ii < children.size(); ++ii )
+    {
+        const BOARD_ITEM* child = children[ii];
+        const BOARD_ITEM* otherChild = otherChildren[ii];
+        BOX2I             otherBBox = otherChild->GetBoundingBox();
+
+        otherBBox.Move( delta );
+
+        if( child->m_Uuid != otherChild->m_Uuid
+                || child->GetLayerSet() != otherChild->GetLayerSet()
+                || child->GetPosition() != otherChild->GetPosition() + delta
+                || child->GetBoundingBox() != otherBBox )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 double FOOTPRINT::Similarity( const BOARD_ITEM& aOther ) const
 {
     if( aOther.Type() != PCB_FOOTPRINT_T )
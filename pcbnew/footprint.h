@@ -920,6 +920,14 @@ public:
 
     bool operator==( const BOARD_ITEM& aOther ) const override;
 
+    /**
+     * Check if this footprint is \a aOther moved by a translation: same orientation and side,
+     * and the same children at the same places relative to the footprint.
+     *
+     * @note Only the placement is compared.  The caller must know that nothing else changed.
+     */
+    bool IsTranslationOf( const FOOTPRINT& aOther ) const;
+
 #if defined(DEBUG)
     virtual void Show( int nestLevel, std::ostream& os ) const override { ShowDummy( os ); }
 #endif
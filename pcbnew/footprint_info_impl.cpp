@@ -31,7 +31,7 @@
 #include <lib_id.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <wildcards_and_files_ext.h>
 
 #include <kiplatform/io.h>
@@ -172,15 +172,13 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
 
 void FOOTPRINT_LIST_IMPL::loadLibs()
 {
-    thread_pool& tp = GetKiCadThreadPool();
-    size_t num_returns = m_queue_in.size();
-    std::vector<std::future<size_t>> returns( num_returns );
+    TASK_GROUP loaders( GetKiCadTaskScheduler() );
+    size_t     num_jobs = m_queue_in.size();
 
     auto loader_job =
-            [this]() -> size_t
+            [this]()
             {
                 wxString nickname;
-                size_t retval = 0;
 
                 if( !m_cancelled && m_queue_in.pop( nickname ) )
                 {
@@ -192,27 +190,16 @@ void FOOTPRINT_LIST_IMPL::loadLibs()
                     {
                         m_progress_reporter->AdvanceProgress();
                     }
-
-                    ++retval;
                 }
-
-                return retval;
             };
 
-    for( size_t ii = 0; ii < num_returns; ++ii )
-        returns[ii] = tp.submit( loader_job );
+    for( size_t ii = 0; ii < num_jobs; ++ii )
+        loaders.Run( loader_job );
 
-    for( const std::future<size_t>& ret : returns )
+    while( !loaders.WaitFor( std::chrono::milliseconds( 250 ) ) )
     {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-
-        while( status != std::future_status::ready )
-        {
-            if( m_progress_reporter && !m_progress_reporter->KeepRefreshing() )
-                m_cancelled = true;
-
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
+        if( m_progress_reporter && !m_progress_reporter->KeepRefreshing() )
+            m_cancelled = true;
     }
 }
 
@@ -229,17 +216,16 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
     // TODO: blast LOCALE_IO into the sun
 
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
-    thread_pool&                                tp = GetKiCadThreadPool();
+    TASK_GROUP                                  parsers( GetKiCadTaskScheduler() );
     size_t                                      num_elements = m_queue_out.size();
-    std::vector<std::future<size_t>>            returns( num_elements );
 
     auto fp_thread =
-            [ this, &queue_parsed ]() -> size_t
+            [ this, &queue_parsed ]()
             {
                 wxString nickname;
 
                 if( m_cancelled || !m_queue_out.pop( nickname ) )
-                    return 0;
+                    return;
 
                 wxArrayString fpnames;
 
@@ -259,29 +245,20 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
                             } );
 
                     if( m_cancelled )
-                        return 0;
+                        return;
                 }
 
                 if( m_progress_reporter )
                     m_progress_reporter->AdvanceProgress();
-
-                return 1;
             };
 
     for( size_t ii = 0; ii < num_elements; ++ii )
-        returns[ii] = tp.submit( fp_thread );
+        parsers.Run( fp_thread );
 
-    for( const std::future<size_t>& ret : returns )
+    while( !parsers.WaitFor( std::chrono::milliseconds( 250 ) ) )
     {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-
-        while( status != std::future_status::ready )
-        {
-            if( m_progress_reporter )
-                m_progress_reporter->KeepRefreshing();
-
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
+        if( m_progress_reporter )
+            m_progress_reporter->KeepRefreshing();
     }
 
     std::unique_ptr<FOOTPRINT_INFO> fpi;
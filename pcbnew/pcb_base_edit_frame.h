@@ -209,6 +209,14 @@ public:
 
     void ClearListAndDeleteItems( PICKED_ITEMS_LIST* aList );
 
+    /**
+     * Estimate the memory held by the undo and redo lists: the copies of changed items and the
+     * deleted items.  Zone fills shared with the board or between copies are counted once.
+     *
+     * @return the approximate size in bytes.
+     */
+    size_t GetUndoRedoMemoryUsage() const;
+
     /**
      * Return the absolute path to the design rules file for the currently-loaded board.
      *
@@ -0,0 +1,166 @@
+/**
+* This program source code file is part of KiCad, a free EDA CAD application.
+*
+* Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ipc2581_xml_writer.h"
+
+#include <cstdio>
+#include <string_view>
+
+#include <ki_exception.h>
+#include <richio.h>
+
+#include <wx/ffile.h>
+#include <wx/translation.h>
+#include <wx/xml/xml.h>
+
+
+IPC2581_XML_WRITER::IPC2581_XML_WRITER( OUTPUTFORMATTER& aOut, int aDepth ) :
+        m_out( aOut ),
+        m_depth( aDepth )
+{
+}
+
+
+void IPC2581_XML_WRITER::WriteDeclaration()
+{
+    m_out.Append( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+}
+
+
+void IPC2581_XML_WRITER::StartElement( const wxXmlNode* aNode )
+{
+    writeStartTag( aNode, false );
+    m_open.push_back( aNode->GetName() );
+    m_depth++;
+}
+
+
+void IPC2581_XML_WRITER::EndElement()
+{
+    wxCHECK( !m_open.empty(), /* void */ );
+
+    m_depth--;
+    m_out.AppendIndent( m_depth );
+    m_out.Append( "</" );
+    m_out.Append( (const char*) m_open.back().utf8_str() );
+    m_out.Append( ">\n" );
+    m_open.pop_back();
+}
+
+
+void IPC2581_XML_WRITER::WriteNode( const wxXmlNode* aNode )
+{
+    if( aNode->GetType() == wxXML_TEXT_NODE )
+    {
+        m_out.AppendIndent( m_depth );
+        writeEscaped( aNode->GetContent() );
+        m_out.Append( "\n" );
+        return;
+    }
+
+    if( aNode->GetType() != wxXML_ELEMENT_NODE )
+        return;
+
+    if( !aNode->GetChildren() )
+    {
+        writeStartTag( aNode, true );
+        return;
+    }
+
+    writeStartTag( aNode, false );
+    m_depth++;
+
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+        WriteNode( child );
+
+    m_depth--;
+    m_out.AppendIndent( m_depth );
+    m_out.Append( "</" );
+    m_out.Append( (const char*) aNode->GetName().utf8_str() );
+    m_out.Append( ">\n" );
+}
+
+
+void IPC2581_XML_WRITER::WriteFile( const wxString& aFileName )
+{
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        THROW_IO_ERROR( wxString::Format( _( "Cannot open file '%s'." ), aFileName ) );
+
+    char   buffer[65536];
+    size_t count;
+
+    while( ( count = file.Read( buffer, sizeof( buffer ) ) ) > 0 )
+        m_out.Append( std::string_view( buffer, count ) );
+
+    if( file.Error() )
+        THROW_IO_ERROR( wxString::Format( _( "Error reading file '%s'." ), aFileName ) );
+}
+
+
+void IPC2581_XML_WRITER::writeStartTag( const wxXmlNode* aNode, bool aEmpty )
+{
+    m_out.AppendIndent( m_depth );
+    m_out.Append( "<" );
+    m_out.Append( (const char*) aNode->GetName().utf8_str() );
+
+    for( const wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        m_out.Append( " " );
+        m_out.Append( (const char*) attr->GetName().utf8_str() );
+        m_out.Append( "=\"" );
+        writeEscaped( attr->GetValue() );
+        m_out.Append( "\"" );
+    }
+
+    m_out.Append( aEmpty ? "/>\n" : ">\n" );
+}
+
+
+void IPC2581_XML_WRITER::writeEscaped( const wxString& aText )
+{
+    wxScopedCharBuffer utf8 = aText.utf8_str();
+    const char*        text = utf8.data();
+    size_t             length = utf8.length();
+    size_t             run = 0;
+
+    for( size_t ii = 0; ii < length; ++ii )
+    {
+        const char* entity;
+
+        switch( text[ii] )
+        {
+        case '&':  entity = "&amp;";  break;
+        case '<':  entity = "&lt;";   break;
+        case '>':  entity = "&gt;";   break;
+        case '"':  entity = "&quot;"; break;
+        case '\t': entity = "&#x9;";  break;
+        case '\n': entity = "&#xA;";  break;
+        case '\r': entity = "&#xD;";  break;
+        default:   continue;
+        }
+
+        m_out.Append( std::string_view( text + run, ii - run ) );
+        m_out.Append( entity );
+        run = ii + 1;
+    }
+
+    m_out.Append( std::string_view( text + run, length - run ) );
+}
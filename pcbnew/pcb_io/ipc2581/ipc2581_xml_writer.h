@@ -0,0 +1,83 @@
+/**
+* This program source code file is part of KiCad, a free EDA CAD application.
+*
+* Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation, either version 3 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef IPC2581_XML_WRITER_H_
+#define IPC2581_XML_WRITER_H_
+
+#include <vector>
+
+#include <wx/string.h>
+
+class OUTPUTFORMATTER;
+class wxXmlNode;
+
+
+/**
+ * Writes XML to an OUTPUTFORMATTER as it is produced, rather than holding the whole document
+ * in a wxXmlDocument.
+ *
+ * Elements are either opened and closed explicitly, or written in one go from a finished
+ * wxXmlNode subtree which the caller can then free.  Each element goes on its own line,
+ * indented by two spaces per level.
+ */
+class IPC2581_XML_WRITER
+{
+public:
+    /**
+     * @param aDepth is the nesting level of the first element written.  Use it to write a
+     *               fragment which will later be copied into a document with WriteFile().
+     */
+    IPC2581_XML_WRITER( OUTPUTFORMATTER& aOut, int aDepth = 0 );
+
+    void WriteDeclaration();
+
+    /**
+     * Open the element \a aNode with its attributes, but not its children.
+     */
+    void StartElement( const wxXmlNode* aNode );
+
+    /**
+     * Close the last element opened by StartElement().
+     */
+    void EndElement();
+
+    /**
+     * Write \a aNode and all its children.
+     */
+    void WriteNode( const wxXmlNode* aNode );
+
+    /**
+     * Copy the content of \a aFileName, a fragment written with the current depth, verbatim.
+     *
+     * @throw IO_ERROR if the file can't be read.
+     */
+    void WriteFile( const wxString& aFileName );
+
+private:
+    void writeStartTag( const wxXmlNode* aNode, bool aEmpty );
+
+    void writeEscaped( const wxString& aText );
+
+private:
+    OUTPUTFORMATTER&      m_out;
+    int                   m_depth;
+    std::vector<wxString> m_open;      ///< Names of the elements opened by StartElement()
+};
+
+#endif // IPC2581_XML_WRITER_H_
@@ -42,14 +42,19 @@
 #include <pgm_base.h>
 #include <progress_reporter.h>
 #include <settings/settings_manager.h>
+#include <richio.h>
 #include <string_utf8_map.h>
-#include <wx_fstream_progress.h>
+
+#include "ipc2581_xml_writer.h"
 
 #include <geometry/shape_circle.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
 
+#include <fmt/format.h>
+#include <functional>
+
 #include <wx/log.h>
 #include <wx/numformatter.h>
 #include <wx/mstream.h>
@@ -111,8 +116,6 @@ void PCB_IO_IPC2581::insertNodeAfter( wxXmlNode* aPrev, wxXmlNode* aNode )
 
 wxXmlNode* PCB_IO_IPC2581::insertNode( wxXmlNode* aParent, const wxString& aName )
 {
-    // Opening tag, closing tag, brackets and the closing slash
-    m_total_bytes += 2 * aName.size() + 5;
     wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, aName );
     insertNode( aParent, node );
     return node;
@@ -125,23 +128,20 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
     wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, aName );
 
-    if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
+    if( m_last_appended && m_last_appended->GetParent() == aParent
+            && m_last_appended->GetNext() == nullptr )
     {
         node->SetParent( aParent );
-        lastNode->SetNext( node );
+        m_last_appended->SetNext( node );
     }
     else
     {
         aParent->AddChild( node );
     }
 
-    lastNode = node;
-
-    // Opening tag, closing tag, brackets and the closing slash
-    m_total_bytes += 2 * aName.size() + 5;
+    m_last_appended = node;
 
     return node;
 }
@@ -244,17 +244,19 @@ wxString PCB_IO_IPC2581::componentName( FOOTPRINT* aFootprint )
 
 wxString PCB_IO_IPC2581::floatVal( double aVal )
 {
-    wxString str = wxString::FromCDouble( aVal, m_sigfig );
+    // fmt is locale independent, like wxString::FromCDouble(), but doesn't go through a
+    // wide string for each of the millions of coordinates of a large board
+    std::string str = fmt::format( "{:.{}f}", aVal, m_sigfig );
 
     // Remove all but the last trailing zeros from str
-    while( str.EndsWith( wxT( "00" ) ) )
-        str.RemoveLast();
+    while( str.size() > 2 && str.compare( str.size() - 2, 2, "00" ) == 0 )
+        str.pop_back();
 
     // We don't want to output -0.0 as this value is just 0 for fabs
-    if( str == wxT( "-0.0" ) )
+    if( str == "-0.0" )
         return wxT( "0.0" );
 
-    return str;
+    return wxString::FromAscii( str.c_str() );
 }
 
 
@@ -275,7 +277,6 @@ void PCB_IO_IPC2581::addXY( wxXmlNode* aNode, const VECTOR2I& aVec, const char*
 
 void PCB_IO_IPC2581::addAttribute( wxXmlNode* aNode, const wxString& aName, const wxString& aValue )
 {
-    m_total_bytes += aName.size() + aValue.size() + 4;
     aNode->AddAttribute( aName, aValue );
 }
 
@@ -1550,6 +1551,7 @@ void PCB_IO_IPC2581::generateStepSection( wxXmlNode* aCadNode )
 {
     wxXmlNode* stepNode = appendNode( aCadNode, "Step" );
     wxFileName fn( m_board->GetFileName() );
+    m_step_node = stepNode;
     addAttribute( stepNode,  "name", genString( fn.GetName(), "BOARD" ) );
 
     if( m_version > 'B' )
@@ -1567,8 +1569,24 @@ void PCB_IO_IPC2581::generateStepSection( wxXmlNode* aCadNode )
     addAttribute( m_last_padstack,  "type", "INTEGER" );
     addAttribute( m_last_padstack,  "value", wxString::Format( "%zu", m_board->Footprints().size() ) );
 
+    // Nesting level of the Step's children in the final document
+    int depth = 1;
+
+    for( wxXmlNode* parent = stepNode->GetParent(); parent; parent = parent->GetParent() )
+    {
+        if( parent->GetType() == wxXML_ELEMENT_NODE )
+            depth++;
+    }
+
+    FILE_OUTPUTFORMATTER featuresOut( m_features_file, wxT( "wb" ) );
+    IPC2581_XML_WRITER   featuresWriter( featuresOut, depth );
+
+    m_features_writer = &featuresWriter;
+
     generateLayerFeatures( stepNode );
     generateLayerSetDrill( stepNode );
+
+    m_features_writer = nullptr;
 }
 
 
@@ -2342,8 +2360,9 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
         if( m_progressReporter )
             m_progressReporter->SetMaxProgress( nets.GetNetCount() * layers.size() );
 
-        wxXmlNode* layerNode = appendNode( aStepNode, "LayerFeature" );
-        addAttribute( layerNode,  "layerRef", m_layer_name_map[layer] );
+        std::unique_ptr<wxXmlNode> layerNode = std::make_unique<wxXmlNode>( wxXML_ELEMENT_NODE,
+                                                                            "LayerFeature" );
+        addAttribute( layerNode.get(), "layerRef", m_layer_name_map[layer] );
 
         for( const NETINFO_ITEM* net : nets )
         {
@@ -2369,14 +2388,13 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
             if( vec.empty() )
                 continue;
 
-            generateLayerSetNet( layerNode, layer, vec );
+            generateLayerSetNet( layerNode.get(), layer, vec );
         }
 
-        if( layerNode->GetChildren() == nullptr )
-        {
-            aStepNode->RemoveChild( layerNode );
-            delete layerNode;
-        }
+        if( layerNode->GetChildren() )
+            m_features_writer->WriteNode( layerNode.get() );
+
+        m_last_appended = nullptr;
     }
 }
 
@@ -2386,7 +2404,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
     int hole_count = 1;
     for( const auto& [layer_pair, vec] : m_drill_layers )
     {
-        wxXmlNode* layerNode = appendNode( aLayerNode, "LayerFeature" );
+        std::unique_ptr<wxXmlNode> layerNode = std::make_unique<wxXmlNode>( wxXML_ELEMENT_NODE,
+                                                                            "LayerFeature" );
         layerNode->AddAttribute( "layerRef", genString(
                                                 wxString::Format( "%s_%s",
                                                     m_board->GetLayerName( layer_pair.first ),
@@ -2406,7 +2425,7 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
                     continue;
                 }
 
-                wxXmlNode* padNode = appendNode( layerNode, "Set" );
+                wxXmlNode* padNode = appendNode( layerNode.get(), "Set" );
                 addAttribute( padNode,  "geometry", it->second );
 
                 if( via->GetNetCode() > 0 )
@@ -2432,7 +2451,7 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
                     continue;
                 }
 
-                wxXmlNode* padNode = appendNode( layerNode, "Set" );
+                wxXmlNode* padNode = appendNode( layerNode.get(), "Set" );
                 addAttribute( padNode,  "geometry", it->second );
 
                 if( pad->GetNetCode() > 0 )
@@ -2447,12 +2466,16 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
                 addXY( holeNode, pad->GetPosition() );
             }
         }
+
+        m_features_writer->WriteNode( layerNode.get() );
+        m_last_appended = nullptr;
     }
 
     hole_count = 1;
     for( const auto& [layer_pair, vec] : m_slot_holes )
     {
-        wxXmlNode* layerNode = appendNode( aLayerNode, "LayerFeature" );
+        std::unique_ptr<wxXmlNode> layerNode = std::make_unique<wxXmlNode>( wxXML_ELEMENT_NODE,
+                                                                            "LayerFeature" );
         layerNode->AddAttribute( "layerRef", genString(
                                                 wxString::Format( "%s_%s",
                                                     m_board->GetLayerName( layer_pair.first ),
@@ -2461,13 +2484,16 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
 
         for( PAD* pad : vec )
         {
-            wxXmlNode* padNode = appendNode( layerNode, "Set" );
+            wxXmlNode* padNode = appendNode( layerNode.get(), "Set" );
 
             if( pad->GetNetCode() > 0 )
                 addAttribute( padNode,  "net", genString( pad->GetNetname(), "NET" ) );
 
             addSlotCavity( padNode, *pad, wxString::Format( "SLOT%d", hole_count++ )  );
         }
+
+        m_features_writer->WriteNode( layerNode.get() );
+        m_last_appended = nullptr;
     }
 }
 
@@ -2571,7 +2597,7 @@ void PCB_IO_IPC2581::generateLayerSetNet( wxXmlNode* aLayerNode, PCB_LAYER_ID aL
             }
         }
 
-        SHAPE_POLY_SET& zone_shape = *zone->GetFilledPolysList( aLayer );
+        const SHAPE_POLY_SET& zone_shape = *zone->GetFilledPolysList( aLayer );
 
         for( int ii = 0; ii < zone_shape.OutlineCount(); ++ii )
             addContourNode( zoneFeatureNode, zone_shape, ii );
@@ -2882,63 +2908,71 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
             m_acceptable_chars.insert( c );
     }
 
-    m_xml_doc = new wxXmlDocument();
+    m_xml_doc = std::make_unique<wxXmlDocument>();
     m_xml_root = generateXmlHeader();
+    m_last_appended = nullptr;
+    m_step_node = nullptr;
+    m_features_file = wxFileName::CreateTempFileName( wxS( "kicad_ipc2581" ) );
 
-    generateContentSection();
-
-    if( m_progressReporter )
+    try
     {
-        m_progressReporter->SetNumPhases( 7 );
-        m_progressReporter->BeginPhase( 1 );
-        m_progressReporter->Report( _( "Generating logistic section" ) );
-    }
+        generateContentSection();
 
-    generateLogisticSection();
-    generateHistorySection();
+        if( m_progressReporter )
+        {
+            m_progressReporter->SetNumPhases( 7 );
+            m_progressReporter->BeginPhase( 1 );
+            m_progressReporter->Report( _( "Generating logistic section" ) );
+        }
 
-    wxXmlNode* ecad_node = generateEcadSection();
-    generateBOMSection( ecad_node );
-    generateAvlSection();
+        generateLogisticSection();
+        generateHistorySection();
 
-    if( m_progressReporter )
-    {
-        m_progressReporter->AdvancePhase( _( "Saving file" ) );
-    }
+        wxXmlNode* ecad_node = generateEcadSection();
+        generateBOMSection( ecad_node );
+        generateAvlSection();
 
-    wxFileOutputStreamWithProgress out_stream( aFileName );
-    double written_bytes = 0.0;
-    double last_yield = 0.0;
+        if( m_progressReporter )
+            m_progressReporter->AdvancePhase( _( "Saving file" ) );
 
-    // This is a rough estimation of the size of the spaces in the file
-    // We just need to total to be slightly larger than the value of the
-    // progress bar, so accurately counting spaces is not terribly important
-    m_total_bytes += m_total_bytes / 10;
+        FILE_OUTPUTFORMATTER out( aFileName, wxT( "wb" ) );
+        IPC2581_XML_WRITER   writer( out );
 
-    auto update_progress = [&]( size_t aBytes )
-    {
-        written_bytes += aBytes;
-        double percent = written_bytes / static_cast<double>( m_total_bytes );
+        // The Step and its ancestors are written element by element so that the layer
+        // features can be copied in after the Step's other children
+        std::function<void( const wxXmlNode* )> writeNode =
+                [&]( const wxXmlNode* aNode )
+                {
+                    const wxXmlNode* ancestor = m_step_node;
 
-        if( m_progressReporter )
-        {
-            // Only update every percent
-            if( last_yield + 0.01 < percent )
-            {
-                last_yield = percent;
-                m_progressReporter->SetCurrentProgress( percent );
-            }
-        }
-    };
+                    while( ancestor && ancestor != aNode )
+                        ancestor = ancestor->GetParent();
+
+                    if( !ancestor )
+                    {
+                        writer.WriteNode( aNode );
+                        return;
+                    }
+
+                    writer.StartElement( aNode );
 
-    out_stream.SetProgressCallback( update_progress );
+                    for( wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+                        writeNode( child );
 
-    if( !m_xml_doc->Save( out_stream ) )
+                    if( aNode == m_step_node )
+                        writer.WriteFile( m_features_file );
+
+                    writer.EndElement();
+                };
+
+        writer.WriteDeclaration();
+        writeNode( m_xml_root );
+    }
+    catch( ... )
     {
-        wxLogError( _( "Failed to save file to buffer" ) );
-        return;
+        wxRemoveFile( m_features_file );
+        throw;
     }
 
-    size_t size = out_stream.GetSize();
-
+    wxRemoveFile( m_features_file );
 }
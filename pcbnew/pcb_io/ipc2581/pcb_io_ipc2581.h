@@ -37,6 +37,7 @@ class BOARD;
 class BOARD_ITEM;
 class EDA_TEXT;
 class FOOTPRINT;
+class IPC2581_XML_WRITER;
 class PROGRESS_REPORTER;
 class NETINFO_ITEM;
 class PAD;
@@ -56,7 +57,6 @@ public:
     PCB_IO_IPC2581() : PCB_IO( wxS( "IPC-2581" ) )
     {
         m_show_layer_mapping_warnings = false;
-        m_total_bytes = 0;
         m_scale = 1.0;
         m_sigfig = 3;
         m_version = 'B';
@@ -68,8 +68,10 @@ public:
         m_line_node = nullptr;
         m_last_padstack = nullptr;
         m_progress_reporter = nullptr;
-        m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_step_node = nullptr;
+        m_features_writer = nullptr;
+        m_last_appended = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -286,8 +288,6 @@ private:
     LAYER_MAPPING_HANDLER   m_layerMappingHandler;
     bool                    m_show_layer_mapping_warnings;
 
-    size_t                  m_total_bytes;  //<! Total number of bytes to be written
-
     wxString                m_units_str;    //<! Output string for units
     double                  m_scale;        //<! Scale factor from IU to IPC2581 units (mm, micron, in)
     int                     m_sigfig;       //<! Max number of digits past the decimal point
@@ -347,8 +347,15 @@ private:
 
     std::set<wxUniChar>     m_acceptable_chars;     //<! IPC2581B and C have differing sets of allowed characters in names
 
-    wxXmlDocument*          m_xml_doc;
+    std::unique_ptr<wxXmlDocument> m_xml_doc;
     wxXmlNode*              m_xml_root;
+    wxXmlNode*              m_last_appended;    //<! Last node added by appendNode()
+
+    // The layer features are most of the file, so they are written out layer by layer to
+    // m_features_file rather than kept in m_xml_doc, and copied in after the rest of the Step
+    wxXmlNode*              m_step_node;
+    wxString                m_features_file;
+    IPC2581_XML_WRITER*     m_features_writer;
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
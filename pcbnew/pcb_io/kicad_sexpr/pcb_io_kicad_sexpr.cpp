@@ -26,6 +26,7 @@
 #include <board.h>
 #include <board_design_settings.h>
 #include <confirm.h>
+#include <core/task_scheduler.h>
 #include <convert_basic_shapes_to_polygon.h> // for enum RECT_CHAMFER_POSITIONS definition
 #include <string_utils.h>
 #include <kiface_base.h>
@@ -101,51 +102,63 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
                                           m_lib_raw_path ) );
     }
 
+    std::vector<FP_CACHE_ITEM*> toSave;
+
     for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        if( aFootprint && aFootprint != it->second->GetFootprint() )
-            continue;
+        if( !aFootprint || aFootprint == it->second->GetFootprint() )
+            toSave.push_back( it->second );
+    }
 
-        WX_FILENAME fn = it->second->GetFileName();
+    // Each footprint has its own file, so a whole library is written on the thread pool
+    ParallelFor( GetKiCadTaskScheduler(), 0, toSave.size(),
+            [&]( size_t aIndex )
+            {
+                WX_FILENAME fn = toSave[aIndex]->GetFileName();
 
-        wxString tempFileName =
+                wxString tempFileName =
 #ifdef USE_TMP_FILE
-        wxFileName::CreateTempFileName( fn.GetPath() );
+                wxFileName::CreateTempFileName( fn.GetPath() );
 #else
-        fn.GetFullPath();
+                fn.GetFullPath();
 #endif
-        // Allow file output stream to go out of scope to close the file stream before
-        // renaming the file.
-        {
-            wxLogTrace( traceKicadPcbPlugin, wxT( "Creating temporary library file '%s'." ),
-                    tempFileName );
+                // Allow file output stream to go out of scope to close the file stream before
+                // renaming the file.
+                {
+                    wxLogTrace( traceKicadPcbPlugin, wxT( "Creating temporary library file '%s'." ),
+                                tempFileName );
 
-            PRETTIFIED_FILE_OUTPUTFORMATTER formatter( tempFileName );
+                    PRETTIFIED_FILE_OUTPUTFORMATTER formatter( tempFileName );
+                    PCB_IO_KICAD_SEXPR              writer( m_owner->m_ctl );
 
-            m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( (BOARD_ITEM*) it->second->GetFootprint() );
-        }
+                    m_owner->initWorker( writer );
+                    writer.SetOutputFormatter( &formatter );
+                    writer.Format( (BOARD_ITEM*) toSave[aIndex]->GetFootprint() );
+                }
 
 #ifdef USE_TMP_FILE
-        wxRemove( fn.GetFullPath() );     // it is not an error if this does not exist
+                wxRemove( fn.GetFullPath() );     // it is not an error if this does not exist
 
-        // Even on Linux you can see an _intermittent_ error when calling wxRename(),
-        // and it is fully inexplicable.  See if this dodges the error.
-        wxMilliSleep( 250L );
+                // Even on Linux you can see an _intermittent_ error when calling wxRename(),
+                // and it is fully inexplicable.  See if this dodges the error.
+                wxMilliSleep( 250L );
 
-        // Preserve the permissions of the current file
-        KIPLATFORM::IO::DuplicatePermissions( fn.GetFullPath(), tempFileName );
+                // Preserve the permissions of the current file
+                KIPLATFORM::IO::DuplicatePermissions( fn.GetFullPath(), tempFileName );
 
-        if( !wxRenameFile( tempFileName, fn.GetFullPath() ) )
-        {
-            wxString msg = wxString::Format( _( "Cannot rename temporary file '%s' to '%s'" ),
-                                             tempFileName,
-                                             fn.GetFullPath() );
-            THROW_IO_ERROR( msg );
-        }
+                if( !wxRenameFile( tempFileName, fn.GetFullPath() ) )
+                {
+                    wxString msg = wxString::Format( _( "Cannot rename temporary file '%s' to '%s'" ),
+                                                     tempFileName,
+                                                     fn.GetFullPath() );
+                    THROW_IO_ERROR( msg );
+                }
 #endif
-        m_cache_timestamp += fn.GetTimestamp();
-    }
+            },
+            1 );
+
+    for( FP_CACHE_ITEM* item : toSave )
+        m_cache_timestamp += WX_FILENAME( item->GetFileName() ).GetTimestamp();
 
     m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
 
@@ -455,11 +468,29 @@ std::string formatInternalUnits( const VECTOR2I& aCoord, const FOOTPRINT* aParen
 }
 
 
+/**
+ * Write \a aCoord like formatInternalUnits() does, but straight to \a aOut.
+ */
+static void appendCoord( OUTPUTFORMATTER* aOut, const VECTOR2I& aCoord,
+                         const FOOTPRINT* aParentFP = nullptr )
+{
+    if( aParentFP )
+    {
+        VECTOR2I coord = aCoord - aParentFP->GetPosition();
+        RotatePoint( coord, -aParentFP->GetOrientation() );
+        aOut->AppendIU( pcbIUScale, coord );
+        return;
+    }
+
+    aOut->AppendIU( pcbIUScale, aCoord );
+}
+
+
 void PCB_IO_KICAD_SEXPR::formatLayer( PCB_LAYER_ID aLayer, bool aIsKnockout ) const
 {
-    m_out->Print( 0, " (layer %s%s)",
-                  m_out->Quotew( LSET::Name( aLayer ) ).c_str(),
-                  aIsKnockout ? " knockout" : "" );
+    m_out->Append( " (layer " );
+    m_out->AppendQuoted( LSET::Name( aLayer ) );
+    m_out->Append( aIsKnockout ? " knockout)" : ")" );
 }
 
 
@@ -476,19 +507,27 @@ void PCB_IO_KICAD_SEXPR::formatPolyPts( const SHAPE_LINE_CHAIN& outline, int aNe
     {
         int ind = outline.ArcIndex( ii );
 
+        // Zone fills can have millions of points, so these don't go through Print()
+        m_out->AppendIndent( nestLevel );
+
         if( ind < 0 )
         {
-            m_out->Print( nestLevel, "(xy %s)",
-                          formatInternalUnits( outline.CPoint( ii ), aParentFP ).c_str() );
+            m_out->Append( "(xy " );
+            appendCoord( m_out, outline.CPoint( ii ), aParentFP );
+            m_out->Append( ")" );
             needNewline = true;
         }
         else
         {
             const SHAPE_ARC& arc = outline.Arc( ind );
-            m_out->Print( nestLevel, "(arc (start %s) (mid %s) (end %s))",
-                          formatInternalUnits( arc.GetP0(), aParentFP ).c_str(),
-                          formatInternalUnits( arc.GetArcMid(), aParentFP ).c_str(),
-                          formatInternalUnits( arc.GetP1(), aParentFP ).c_str() );
+
+            m_out->Append( "(arc (start " );
+            appendCoord( m_out, arc.GetP0(), aParentFP );
+            m_out->Append( ") (mid " );
+            appendCoord( m_out, arc.GetArcMid(), aParentFP );
+            m_out->Append( ") (end " );
+            appendCoord( m_out, arc.GetP1(), aParentFP );
+            m_out->Append( "))" );
             needNewline = true;
 
             do
@@ -504,7 +543,7 @@ void PCB_IO_KICAD_SEXPR::formatPolyPts( const SHAPE_LINE_CHAIN& outline, int aNe
         if( !( shapesAdded % 4 ) || !aCompact )
         {
             // newline every 4 shapes if compact save
-            m_out->Print( 0, "\n" );
+            m_out->Append( "\n" );
             needNewline = false;
         }
     }
@@ -794,11 +833,7 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard, int aNestLevel ) const
     formatHeader( aBoard, aNestLevel );
 
     // Save the footprints.
-    for( BOARD_ITEM* footprint : sorted_footprints )
-    {
-        Format( footprint, aNestLevel );
-        m_out->Print( 0, "\n" );
-    }
+    formatItems( { sorted_footprints.begin(), sorted_footprints.end() }, aNestLevel, "\n" );
 
     // Save the graphical items on the board (not owned by a footprint)
     for( BOARD_ITEM* item : sorted_drawings )
@@ -810,15 +845,13 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard, int aNestLevel ) const
     // Do not save PCB_MARKERs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( PCB_TRACK* track : sorted_tracks )
-        Format( track, aNestLevel );
+    formatItems( { sorted_tracks.begin(), sorted_tracks.end() }, aNestLevel );
 
     if( sorted_tracks.size() )
         m_out->Print( 0, "\n" );
 
     // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone, aNestLevel );
+    formatItems( { sorted_zones.begin(), sorted_zones.end() }, aNestLevel );
 
     // Save the groups
     for( BOARD_ITEM* group : sorted_groups )
@@ -830,6 +863,58 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard, int aNestLevel ) const
 }
 
 
+void PCB_IO_KICAD_SEXPR::formatItems( const std::vector<const BOARD_ITEM*>& aItems,
+                                      int aNestLevel, const char* aSuffix ) const
+{
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+    size_t          chunkCount = std::min<size_t>( aItems.size(),
+                                                   8 * (size_t) scheduler.GetThreadCount() );
+
+    if( chunkCount < 2 || !ADVANCED_CFG::GetCfg().m_ParallelBoardSave )
+    {
+        for( const BOARD_ITEM* item : aItems )
+        {
+            Format( item, aNestLevel );
+            m_out->Append( aSuffix );
+        }
+
+        return;
+    }
+
+    std::vector<std::string> chunks( chunkCount );
+
+    ParallelFor( scheduler, 0, chunkCount,
+                 [&]( size_t aChunk )
+                 {
+                     PCB_IO_KICAD_SEXPR worker( m_ctl );
+                     size_t             first = aItems.size() * aChunk / chunkCount;
+                     size_t             last = aItems.size() * ( aChunk + 1 ) / chunkCount;
+
+                     initWorker( worker );
+
+                     for( size_t ii = first; ii < last; ++ii )
+                     {
+                         worker.Format( aItems[ii], aNestLevel );
+                         worker.m_out->Append( aSuffix );
+                     }
+
+                     chunks[aChunk] = worker.GetStringOutput( true );
+                 },
+                 1 );
+
+    for( const std::string& chunk : chunks )
+        m_out->Append( chunk );
+}
+
+
+void PCB_IO_KICAD_SEXPR::initWorker( PCB_IO_KICAD_SEXPR& aWorker ) const
+{
+    aWorker.m_board = m_board;
+    aWorker.m_props = m_props;
+    *aWorker.m_mapping = *m_mapping;
+}
+
+
 void PCB_IO_KICAD_SEXPR::format( const PCB_DIMENSION_BASE* aDimension, int aNestLevel ) const
 {
     const PCB_DIM_ALIGNED*    aligned = dynamic_cast<const PCB_DIM_ALIGNED*>( aDimension );
@@ -942,10 +1027,12 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_SHAPE* aShape, int aNestLevel ) const
     switch( aShape->GetShape() )
     {
     case SHAPE_T::SEGMENT:
-        m_out->Print( aNestLevel, "(%s_line (start %s) (end %s)\n",
-                      prefix.c_str(),
-                      formatInternalUnits( aShape->GetStart(), parentFP ).c_str(),
-                      formatInternalUnits( aShape->GetEnd(), parentFP ).c_str() );
+        m_out->AppendIndent( aNestLevel );
+        m_out->Append( parentFP ? "(fp_line (start " : "(gr_line (start " );
+        appendCoord( m_out, aShape->GetStart(), parentFP );
+        m_out->Append( ") (end " );
+        appendCoord( m_out, aShape->GetEnd(), parentFP );
+        m_out->Append( ")\n" );
         break;
 
     case SHAPE_T::RECTANGLE:
@@ -2096,9 +2183,11 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_TRACK* aTrack, int aNestLevel ) const
             THROW_IO_ERROR( wxString::Format( _( "unknown via type %d"  ), via->GetViaType() ) );
         }
 
-        m_out->Print( 0, " (at %s) (size %s)",
-                      formatInternalUnits( aTrack->GetStart() ).c_str(),
-                      formatInternalUnits( aTrack->GetWidth() ).c_str() );
+        m_out->Append( " (at " );
+        appendCoord( m_out, aTrack->GetStart() );
+        m_out->Append( ") (size " );
+        m_out->AppendIU( pcbIUScale, aTrack->GetWidth() );
+        m_out->Append( ")" );
 
         // Old boards were using UNDEFINED_DRILL_DIAMETER value in file for via drill when
         // via drill was the netclass value.
@@ -2151,31 +2240,42 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_TRACK* aTrack, int aNestLevel ) const
     {
         const PCB_ARC* arc = static_cast<const PCB_ARC*>( aTrack );
 
-        m_out->Print( aNestLevel, "(arc (start %s) (mid %s) (end %s) (width %s)",
-                      formatInternalUnits( arc->GetStart() ).c_str(),
-                      formatInternalUnits( arc->GetMid() ).c_str(),
-                      formatInternalUnits( arc->GetEnd() ).c_str(),
-                      formatInternalUnits( arc->GetWidth() ).c_str() );
+        m_out->AppendIndent( aNestLevel );
+        m_out->Append( "(arc (start " );
+        appendCoord( m_out, arc->GetStart() );
+        m_out->Append( ") (mid " );
+        appendCoord( m_out, arc->GetMid() );
+        m_out->Append( ") (end " );
+        appendCoord( m_out, arc->GetEnd() );
+        m_out->Append( ") (width " );
+        m_out->AppendIU( pcbIUScale, arc->GetWidth() );
+        m_out->Append( ")" );
 
         if( arc->IsLocked() )
             KICAD_FORMAT::FormatBool( m_out, 0, "locked", arc->IsLocked() );
 
-        m_out->Print( 0, " (layer %s)", m_out->Quotew( LSET::Name( arc->GetLayer() ) ).c_str() );
+        formatLayer( arc->GetLayer() );
     }
     else
     {
-        m_out->Print( aNestLevel, "(segment (start %s) (end %s) (width %s)",
-                      formatInternalUnits( aTrack->GetStart() ).c_str(),
-                      formatInternalUnits( aTrack->GetEnd() ).c_str(),
-                      formatInternalUnits( aTrack->GetWidth() ).c_str() );
+        m_out->AppendIndent( aNestLevel );
+        m_out->Append( "(segment (start " );
+        appendCoord( m_out, aTrack->GetStart() );
+        m_out->Append( ") (end " );
+        appendCoord( m_out, aTrack->GetEnd() );
+        m_out->Append( ") (width " );
+        m_out->AppendIU( pcbIUScale, aTrack->GetWidth() );
+        m_out->Append( ")" );
 
         if( aTrack->IsLocked() )
             KICAD_FORMAT::FormatBool( m_out, 0, "locked", aTrack->IsLocked() );
 
-        m_out->Print( 0, " (layer %s)", m_out->Quotew( LSET::Name( aTrack->GetLayer() ) ).c_str() );
+        formatLayer( aTrack->GetLayer() );
     }
 
-    m_out->Print( 0, " (net %d)", m_mapping->Translate( aTrack->GetNetCode() ) );
+    m_out->Append( " (net " );
+    m_out->AppendInt( m_mapping->Translate( aTrack->GetNetCode() ) );
+    m_out->Append( ")" );
 
     KICAD_FORMAT::FormatUuid( m_out, aTrack->m_Uuid );
 
@@ -2376,7 +2476,7 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone, int aNestLevel ) const
     // Save the PolysList (filled areas)
     for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
     {
-        const std::shared_ptr<SHAPE_POLY_SET>& fv = aZone->GetFilledPolysList( layer );
+        std::shared_ptr<const SHAPE_POLY_SET> fv = aZone->GetFilledPolysList( layer );
 
         for( int ii = 0; ii < fv->OutlineCount(); ++ii )
         {
@@ -2418,7 +2518,7 @@ PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                               const STRING_UTF8_MAP* aProperties, PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
     unsigned lineCount = 0;
 
@@ -2429,7 +2529,9 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
+        std::string_view line;
+
+        while( reader.ReadLineView( line ) && !line.empty() )
             lineCount++;
 
         reader.Rewind();
@@ -405,6 +405,20 @@ protected:
 private:
     void format( const BOARD* aBoard, int aNestLevel = 0 ) const;
 
+    /**
+     * Format \a aItems in order, each followed by \a aSuffix.
+     *
+     * The items are split into chunks formatted to separate buffers on the thread pool, which
+     * are then output in order, so the result is the same as formatting them one by one.
+     */
+    void formatItems( const std::vector<const BOARD_ITEM*>& aItems, int aNestLevel,
+                      const char* aSuffix = "" ) const;
+
+    /**
+     * Set up \a aWorker to format items as this plugin would, to its own string.
+     */
+    void initWorker( PCB_IO_KICAD_SEXPR& aWorker ) const;
+
     void format( const PCB_DIMENSION_BASE* aDimension, int aNestLevel = 0 ) const;
 
     void format( const PCB_REFERENCE_IMAGE* aBitmap, int aNestLevel = 0 ) const;
@@ -35,6 +35,7 @@
 #include <title_block.h>
 #include <trigo.h>
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <pcb_dimension.h>
@@ -52,6 +53,7 @@
 #include <geometry/shape_line_chain.h>
 #include <font/font.h>
 #include <core/ignore.h>
+#include <core/task_scheduler.h>
 #include <netclass.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcb_plot_params_parser.h>
@@ -897,6 +899,39 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
     std::vector<BOARD_ITEM*> bulkAddedItems;
     BOARD_ITEM* item = nullptr;
 
+    // When the file is in memory, footprints and zones are parsed by worker threads while
+    // this one parses everything else.  The items are then added in file order.
+    VIEW_LINE_READER*      viewReader = dynamic_cast<VIEW_LINE_READER*>( reader );
+    bool                   scanned = false;
+    std::vector<ITEM_SPAN> spans;
+    size_t                 nextSpan = 0;
+
+    std::vector<std::unique_ptr<BOARD_ITEM>> items;
+
+    // Don't bother finishing the workers' jobs if we throw
+    auto cancelWorkers =
+            []( TASK_GROUP* aWorkers )
+            {
+                aWorkers->Cancel();
+                delete aWorkers;
+            };
+
+    std::unique_ptr<TASK_GROUP, decltype( cancelWorkers )> workers( nullptr, cancelWorkers );
+
+    auto addItem =
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( spans.empty() )
+                {
+                    m_board->Add( aItem, ADD_MODE::BULK_APPEND, true );
+                    bulkAddedItems.push_back( aItem );
+                }
+                else
+                {
+                    items.emplace_back( aItem );
+                }
+            };
+
     for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
     {
         checkpoint();
@@ -904,6 +939,58 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         if( token != T_LEFT )
             Expecting( T_LEFT );
 
+        if( !scanned )
+        {
+            scanned = true;
+
+            if( viewReader && curTokenView() && !m_appendToExisting
+                    && ADVANCED_CFG::GetCfg().m_ParallelBoardLoad
+                    && GetKiCadTaskScheduler().GetThreadCount() > 1 )
+            {
+                std::string_view text = viewReader->GetText();
+
+                if( !findItemSpans( text, curTokenView() - text.data(), CurLineNumber(), spans ) )
+                    spans.clear();
+            }
+        }
+
+        if( nextSpan < spans.size()
+                && curTokenView() == viewReader->GetText().data() + spans[nextSpan].m_Open )
+        {
+            // The setup sections all come before the first footprint or zone, so the workers
+            // can start now
+            if( !workers )
+            {
+                TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+                size_t          chunks = 4 * (size_t) scheduler.GetThreadCount();
+                size_t          chunkSize = std::max<size_t>( 1, spans.size() / chunks );
+
+                workers.reset( new TASK_GROUP( scheduler ) );
+
+                for( size_t first = 0; first < spans.size(); first += chunkSize )
+                {
+                    size_t last = std::min( spans.size(), first + chunkSize );
+
+                    workers->Run(
+                            [this, viewReader, &spans, first, last]()
+                            {
+                                parseItemSpans( *viewReader, spans, first, last );
+                            } );
+                }
+            }
+
+            ITEM_SPAN& span = spans[nextSpan++];
+
+            span.m_Slot = items.size();
+            span.m_GroupPos = m_groupInfos.size();
+            items.emplace_back( nullptr );
+
+            // Carry on after the item
+            viewReader->Seek( span.m_End, span.m_LastLine );
+            discardLine();
+            continue;
+        }
+
         token = NextTok();
 
         if( token == T_page && m_requiredVersion <= 20200119 )
@@ -983,52 +1070,36 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         case T_gr_poly:
         case T_gr_circle:
         case T_gr_rect:
-            item = parsePCB_SHAPE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_SHAPE( m_board ) );
             break;
 
         case T_image:
-            item = parsePCB_REFERENCE_IMAGE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_REFERENCE_IMAGE( m_board ) );
             break;
 
         case T_gr_text:
-            item = parsePCB_TEXT( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_TEXT( m_board ) );
             break;
 
         case T_gr_text_box:
-            item = parsePCB_TEXTBOX( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_TEXTBOX( m_board ) );
             break;
 
         case T_dimension:
-            item = parseDIMENSION( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parseDIMENSION( m_board ) );
             break;
 
         case T_module:      // legacy token
         case T_footprint:
-            item = parseFOOTPRINT();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parseFOOTPRINT() );
             break;
 
         case T_segment:
-            item = parsePCB_TRACK();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_TRACK() );
             break;
 
         case T_arc:
-            item = parseARC();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parseARC() );
             break;
 
         case T_group:
@@ -1040,21 +1111,15 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
             break;
 
         case T_via:
-            item = parsePCB_VIA();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_VIA() );
             break;
 
         case T_zone:
-            item = parseZONE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parseZONE( m_board ) );
             break;
 
         case T_target:
-            item = parsePCB_TARGET();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            addItem( parsePCB_TARGET() );
             break;
 
         default:
@@ -1064,6 +1129,69 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( workers )
+    {
+        if( m_progressReporter )
+        {
+            while( !workers->WaitFor( std::chrono::milliseconds( 100 ) ) )
+            {
+                if( !m_progressReporter->KeepRefreshing() )
+                {
+                    workers->Cancel();
+                    workers->Wait();
+                    THROW_IO_ERROR( _( "Open cancelled by user." ) );
+                }
+            }
+        }
+        else
+        {
+            workers->Wait();
+        }
+
+        std::vector<GROUP_INFO> groupInfos;
+        size_t                  groupPos = 0;
+
+        // Can't happen unless the pre-scan and the lexer disagree
+        if( nextSpan != spans.size() )
+            THROW_IO_ERROR( wxT( "Board items were not where the pre-scan found them." ) );
+
+        for( ITEM_SPAN& span : spans )
+        {
+            // Items the workers couldn't handle
+            if( !span.m_Item )
+                parseItemSpan( *viewReader, span );
+
+            m_undefinedLayers.insert( span.m_UndefinedLayers.begin(),
+                                      span.m_UndefinedLayers.end() );
+
+            if( span.m_RequiredVersion > m_requiredVersion )
+            {
+                m_requiredVersion = span.m_RequiredVersion;
+                m_tooRecent = ( m_requiredVersion > SEXPR_BOARD_FILE_VERSION );
+            }
+
+            while( groupPos < span.m_GroupPos )
+                groupInfos.push_back( std::move( m_groupInfos[groupPos++] ) );
+
+            for( GROUP_INFO& groupInfo : span.m_GroupInfos )
+                groupInfos.push_back( std::move( groupInfo ) );
+
+            items[span.m_Slot] = std::move( span.m_Item );
+        }
+
+        while( groupPos < m_groupInfos.size() )
+            groupInfos.push_back( std::move( m_groupInfos[groupPos++] ) );
+
+        m_groupInfos = std::move( groupInfos );
+    }
+
+    for( std::unique_ptr<BOARD_ITEM>& parsed : items )
+    {
+        item = parsed.release();
+        m_board->Add( item, ADD_MODE::BULK_APPEND, true );
+        bulkAddedItems.push_back( item );
+    }
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1160,6 +1288,240 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+bool PCB_IO_KICAD_SEXPR_PARSER::findItemSpans( std::string_view aText, size_t aPos,
+                                               unsigned aLine, std::vector<ITEM_SPAN>& aSpans )
+{
+    // Sections setting up the board or this parser for the items
+    static const std::string_view setupSections[] = { "general", "paper", "page", "title_block",
+                                                      "layers", "setup", "property", "net",
+                                                      "net_class", "host", "generator",
+                                                      "generator_version" };
+
+    auto isBlank =
+            []( char c )
+            {
+                return c == ' ' || c == '\t' || c == '\r' || c == '\0';
+            };
+
+    auto isSep =
+            [&]( char c )
+            {
+                return isBlank( c ) || c == '\n' || c == '(' || c == ')' || c == '"';
+            };
+
+    const char* text = aText.data();
+    size_t      size = aText.size();
+    size_t      lineStart = aText.rfind( '\n', aPos );
+    int         depth = 0;
+    bool        tokenStart = true;  // as opposed to within an unquoted token
+    bool        itemAlone = false;  // the item's '(' is the first thing on its line
+    ITEM_SPAN   item;
+
+    std::string_view keyword;
+
+    lineStart = ( lineStart == std::string_view::npos ) ? 0 : lineStart + 1;
+
+    bool blankSoFar = std::all_of( text + lineStart, text + aPos, isBlank );
+
+    for( size_t pos = aPos; pos < size; ++pos )
+    {
+        char c = text[pos];
+
+        if( c == '\n' )
+        {
+            ++aLine;
+            lineStart = pos + 1;
+            blankSoFar = true;
+            tokenStart = true;
+            continue;
+        }
+
+        if( isBlank( c ) )
+        {
+            tokenStart = true;
+            continue;
+        }
+
+        bool firstOnLine = blankSoFar;
+
+        blankSoFar = false;
+
+        if( c == '#' && firstOnLine )
+        {
+            // A comment line
+            while( pos + 1 < size && text[pos + 1] != '\n' )
+                ++pos;
+
+            continue;
+        }
+
+        if( c == '"' && tokenStart )
+        {
+            // Quoted strings can't span lines
+            for( ++pos; pos < size && text[pos] != '"'; ++pos )
+            {
+                if( text[pos] == '\\' )
+                    ++pos;
+
+                if( pos >= size || text[pos] == '\n' )
+                    return false;
+            }
+
+            if( pos >= size )
+                return false;
+
+            continue;
+        }
+
+        if( c == '(' )
+        {
+            if( depth == 0 )
+            {
+                size_t kwBegin = pos + 1;
+
+                while( kwBegin < size && isBlank( text[kwBegin] ) )
+                    ++kwBegin;
+
+                size_t kwEnd = kwBegin;
+
+                while( kwEnd < size && !isSep( text[kwEnd] ) )
+                    ++kwEnd;
+
+                keyword = std::string_view( text + kwBegin, kwEnd - kwBegin );
+                itemAlone = firstOnLine;
+                item.m_Begin = lineStart;
+                item.m_Open = pos;
+                item.m_FirstLine = aLine;
+            }
+
+            ++depth;
+            tokenStart = true;
+            continue;
+        }
+
+        if( c == ')' )
+        {
+            if( depth == 0 )
+                break;      // the end of the board
+
+            tokenStart = true;
+
+            if( --depth > 0 )
+                continue;
+
+            if( keyword == "footprint" || keyword == "module" || keyword == "zone" )
+            {
+                size_t end = pos + 1;
+
+                while( end < size && isBlank( text[end] ) )
+                    ++end;
+
+                // Unusual layouts are best left to the serial parser
+                if( !itemAlone || ( end < size && text[end] != '\n' ) )
+                    return false;
+
+                item.m_End = std::min( end + 1, size );
+                item.m_LastLine = aLine;
+                aSpans.push_back( std::move( item ) );
+                item = ITEM_SPAN();
+
+                // Carry on from the end of line
+                pos = end - 1;
+            }
+            else if( !aSpans.empty()
+                        && std::find( std::begin( setupSections ), std::end( setupSections ),
+                                      keyword ) != std::end( setupSections ) )
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        tokenStart = false;
+    }
+
+    return !aSpans.empty();
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseItemSpan( const VIEW_LINE_READER& aReader,
+                                               ITEM_SPAN& aSpan )
+{
+    std::string_view text = aReader.GetText().substr( aSpan.m_Begin, aSpan.m_End - aSpan.m_Begin );
+    VIEW_LINE_READER spanReader( text, aReader.GetSource(), aSpan.m_FirstLine - 1 );
+
+    // The span's groups are kept apart from those of the items parsed so far
+    std::vector<GROUP_INFO> groupInfos;
+
+    std::swap( m_groupInfos, groupInfos );
+    PushReader( &spanReader );
+
+    try
+    {
+        NeedLEFT();
+
+        if( NextTok() == T_zone )
+            aSpan.m_Item.reset( parseZONE( m_board ) );
+        else
+            aSpan.m_Item.reset( parseFOOTPRINT() );
+    }
+    catch( ... )
+    {
+        PopReader();
+        std::swap( m_groupInfos, groupInfos );
+        throw;
+    }
+
+    PopReader();
+    std::swap( m_groupInfos, groupInfos );
+    aSpan.m_GroupInfos = std::move( groupInfos );
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseItemSpans( const VIEW_LINE_READER& aReader,
+                                                std::vector<ITEM_SPAN>& aSpans, size_t aFirst,
+                                                size_t aLast )
+{
+    PCB_IO_KICAD_SEXPR_PARSER worker( nullptr, nullptr, nullptr );
+
+    worker.m_board = m_board;
+    worker.m_layerIndices = m_layerIndices;
+    worker.m_layerMasks = m_layerMasks;
+    worker.m_netCodes = m_netCodes;
+    worker.m_tooRecent = m_tooRecent;
+    worker.m_requiredVersion = m_requiredVersion;
+    worker.m_generatorVersion = m_generatorVersion;
+    worker.m_isWorker = true;
+
+    for( size_t ii = aFirst; ii < aLast; ++ii )
+    {
+        ITEM_SPAN& span = aSpans[ii];
+
+        try
+        {
+            worker.parseItemSpan( aReader, span );
+            span.m_UndefinedLayers = std::move( worker.m_undefinedLayers );
+            span.m_RequiredVersion = worker.m_requiredVersion;
+        }
+        catch( const DEFERRED_ITEM& )
+        {
+            // Left for the main thread
+            span.m_Item.reset();
+            worker.InitParserState();
+        }
+        catch( const IO_ERROR& )
+        {
+            // Left for the main thread too, so that errors are reported in file order
+            span.m_Item.reset();
+            worker.InitParserState();
+        }
+
+        worker.m_undefinedLayers.clear();
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem = [&]( const KIID& aId )
@@ -2983,6 +3345,7 @@ PCB_SHAPE* PCB_IO_KICAD_SEXPR_PARSER::parsePCB_SHAPE( BOARD_ITEM* aParent )
         case T_net:
             if( !shape->SetNetCode( getNetCode( parseInt( "net number" ) ), /* aNoAssert */ true ) )
             {
+                deferToMainThread();
                 wxLogError( _( "Invalid net ID in\nfile: '%s'\nline: %d\noffset: %d." ),
                             CurSource(), CurLineNumber(), CurOffset() );
             }
@@ -4591,6 +4954,7 @@ PAD* PCB_IO_KICAD_SEXPR_PARSER::parsePAD( FOOTPRINT* aParent )
 
             if( ! pad->SetNetCode( getNetCode( parseInt( "net number" ) ), /* aNoAssert */ true ) )
             {
+                deferToMainThread();
                 wxLogError( _( "Invalid net ID in\nfile: %s\nline: %d offset: %d" ),
                             CurSource(), CurLineNumber(), CurOffset() );
             }
@@ -4609,6 +4973,7 @@ PAD* PCB_IO_KICAD_SEXPR_PARSER::parsePAD( FOOTPRINT* aParent )
 
                 if( netName != m_board->FindNet( pad->GetNetCode() )->GetNetname() )
                 {
+                    deferToMainThread();
                     pad->SetNetCode( NETINFO_LIST::ORPHANED, /* aNoAssert */ true );
                     wxLogError( _( "Net name doesn't match ID in\nfile: %s\nline: %d offset: %d" ),
                                 CurSource(), CurLineNumber(), CurOffset() );
@@ -4909,6 +5274,7 @@ PAD* PCB_IO_KICAD_SEXPR_PARSER::parsePAD( FOOTPRINT* aParent )
     // Zero-sized pads are likely algorithmically unsafe.
     if( pad->GetSizeX() <= 0 || pad->GetSizeY() <= 0 )
     {
+        deferToMainThread();
         pad->SetSize( VECTOR2I( pcbIUScale.mmToIU( 0.001 ), pcbIUScale.mmToIU( 0.001 ) ) );
 
         wxLogWarning( _( "Invalid zero-sized pad pinned to %s in\nfile: %s\nline: %d\noffset: %d" ),
@@ -5578,6 +5944,7 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 
             if( !zone->SetNetCode( tmp, /* aNoAssert */ true ) )
             {
+                deferToMainThread();
                 wxLogError( _( "Invalid net ID in\nfile: %s;\nline: %d\noffset: %d." ),
                             CurSource(), CurLineNumber(), CurOffset() );
             }
@@ -6088,6 +6455,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     {
         if( isStrokedFill && !zone->GetIsRuleArea() )
         {
+            deferToMainThread();
+
             if( m_showLegacy5ZoneWarning )
             {
                 wxLogWarning(
@@ -6120,6 +6489,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         // Note RFB: This code might be removed if turns out this never existed for sexpr file
         // format or otherwise we should add a test case to the qa folder
 
+        deferToMainThread();
+
         if( m_showLegacySegmentZoneWarning )
         {
             wxLogWarning( _( "The legacy segment zone fill mode is no longer supported.\n"
@@ -6175,6 +6546,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         }
         else    // Not existing net: add a new net to keep trace of the zone netname
         {
+            deferToMainThread();
+
             int newnetcode = m_board->GetNetCount();
             net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
             m_board->Add( net, ADD_MODE::INSERT, true );
@@ -6188,7 +6561,10 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     }
 
     if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
+    {
+        deferToMainThread();
         m_board->SetLegacyTeardrops( true );
+    }
 
     // Clear flags used in zone edition:
     zone->SetNeedRefill( false );
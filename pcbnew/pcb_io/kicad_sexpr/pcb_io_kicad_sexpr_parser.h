@@ -39,6 +39,9 @@
 #include <string_any_map.h>
 
 #include <chrono>
+#include <memory>
+#include <set>
+#include <string_view>
 #include <unordered_map>
 
 
@@ -83,6 +86,7 @@ public:
         m_progressReporter( aProgressReporter ),
         m_lastProgressTime( std::chrono::steady_clock::now() ),
         m_lineCount( aLineCount ),
+        m_isWorker( false ),
         m_queryUserCallback( std::move( aQueryUserCallback ) )
     {
         init();
@@ -144,6 +148,30 @@ private:
         STRING_ANY_MAP properties;
     };
 
+    /**
+     * A top-level footprint or zone of a board which can be parsed by a worker thread.  Its
+     * lines hold nothing else.
+     */
+    struct ITEM_SPAN
+    {
+        size_t   m_Begin;       ///< offset of the start of the line holding the item's '('
+        size_t   m_Open;        ///< offset of the item's '('
+        size_t   m_End;         ///< offset of the start of the line after the item's ')'
+        unsigned m_FirstLine;   ///< line number of the line holding the item's '('
+        unsigned m_LastLine;    ///< line number of the line holding the item's ')'
+
+        size_t   m_Slot = 0;        ///< position of the item among the board's items
+        size_t   m_GroupPos = 0;    ///< position of its groups among m_groupInfos
+
+        std::unique_ptr<BOARD_ITEM> m_Item;         ///< nullptr if not (yet) parsed
+        std::vector<GROUP_INFO>     m_GroupInfos;   ///< the footprint's groups
+        std::set<wxString>          m_UndefinedLayers;
+        int                         m_RequiredVersion = 0;
+    };
+
+    ///< Thrown by deferToMainThread()
+    struct DEFERRED_ITEM {};
+
     ///< Convert net code using the mapping table if available,
     ///< otherwise returns unchanged net code if < 0 or if it's out of range
     inline int getNetCode( int aNetCode )
@@ -235,6 +263,43 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    /**
+     * Find the footprints and zones of a board file which can be parsed by worker threads.
+     *
+     * @param aText is the board file.
+     * @param aPos is the position of the '(' of the first item of the board.
+     * @param aLine is the line number of @a aPos.
+     * @param aSpans receives the footprints and zones.
+     * @return false if the board must be parsed serially, e.g. because setup sections such as
+     *         the net list follow its first footprint.
+     */
+    static bool findItemSpans( std::string_view aText, size_t aPos, unsigned aLine,
+                               std::vector<ITEM_SPAN>& aSpans );
+
+    /**
+     * Parse [\a aFirst, \a aLast) of \a aSpans of \a aReader's text in a worker parser which
+     * shares our board, layer map and net codes.  Items which the worker can't handle are left
+     * for parseItemSpan() on the main thread.
+     */
+    void parseItemSpans( const VIEW_LINE_READER& aReader, std::vector<ITEM_SPAN>& aSpans,
+                         size_t aFirst, size_t aLast );
+
+    /**
+     * Parse the footprint or zone of \a aSpan of \a aReader's text with this parser.
+     */
+    void parseItemSpan( const VIEW_LINE_READER& aReader, ITEM_SPAN& aSpan );
+
+    /**
+     * When parsing in a worker thread (see parseItemSpans()), give up on the current item so
+     * that it is parsed again on the main thread.  Used for the rare paths which change the
+     * board or report a message; they must happen in file order.
+     */
+    void deferToMainThread()
+    {
+        if( m_isWorker )
+            throw DEFERRED_ITEM();
+    }
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -326,7 +391,7 @@ private:
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        return (int) parseLong( 10 );
     }
 
     inline int parseInt( const char* aExpected )
@@ -338,7 +403,7 @@ private:
     inline long parseHex()
     {
         NextTok();
-        return strtol( CurText(), nullptr, 16 );
+        return parseLong( 16 );
     }
 
     bool parseBool();
@@ -402,6 +467,8 @@ private:
     std::vector<GROUP_INFO>     m_groupInfos;
     std::vector<GENERATOR_INFO> m_generatorInfos;
 
+    bool                m_isWorker;          ///< parsing item spans for another parser
+
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
 };
 
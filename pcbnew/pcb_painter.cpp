@@ -2465,7 +2465,7 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_FRACTURE_BORDERS
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION ) )
     {
-        const std::shared_ptr<SHAPE_POLY_SET>& polySet = aZone->GetFilledPolysList( layer );
+        std::shared_ptr<const SHAPE_POLY_SET> polySet = aZone->GetFilledPolysList( layer );
 
         if( polySet->OutlineCount() == 0 )  // Nothing to draw
             return;
@@ -2489,8 +2489,13 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
         // as primitives. CacheTriangulation() can create basic triangle primitives to
         // draw the polygon solid shape on Opengl.  GLU tessellation is much slower,
         // so currently we are using our tessellation.
+        // The triangulation is only a cache of the fill, so building it here doesn't change
+        // the zone.
         if( m_gal->IsOpenGlEngine() && !polySet->IsTriangulationUpToDate() )
-            polySet->CacheTriangulation( true, true );
+        {
+            const_cast<ZONE*>( aZone )->GetFill( layer )->CacheTriangulation( true, true );
+            polySet = aZone->GetFilledPolysList( layer );
+        }
 
         m_gal->DrawPolygon( *polySet, displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION );
     }
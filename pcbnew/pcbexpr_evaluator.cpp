@@ -57,14 +57,12 @@ public:
         // in the ENUM_MAP: one for the canonical layer name and one for the user layer name.
         // We need to check against both.
 
-        wxPGChoices&                 layerMap = ENUM_MAP<PCB_LAYER_ID>::Instance().Choices();
-        const wxString&              layerName = b->AsString();
-        BOARD*                       board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
-        std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-        auto                         i = board->m_LayerExpressionCache.find( layerName );
-        LSET                         mask;
-
-        if( i == board->m_LayerExpressionCache.end() )
+        wxPGChoices&    layerMap = ENUM_MAP<PCB_LAYER_ID>::Instance().Choices();
+        const wxString& layerName = b->AsString();
+        BOARD*          board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
+        LSET            mask;
+
+        if( !board->m_LayerExpressionCache.Find( layerName, mask ) )
         {
             for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
             {
@@ -74,11 +72,7 @@ public:
                     mask.set( ToLAYER_ID( entry.GetValue() ) );
             }
 
-            board->m_LayerExpressionCache[ layerName ] = mask;
-        }
-        else
-        {
-            mask = i->second;
+            board->m_LayerExpressionCache.Insert( layerName, mask );
         }
 
         return mask.Contains( m_layer );
@@ -132,7 +126,8 @@ public:
 
     const wxString& AsString() const override
     {
-        const_cast<PCBEXPR_NETCLASS_VALUE*>( this )->Set( m_item->GetEffectiveNetClass()->GetName() );
+        const_cast<PCBEXPR_NETCLASS_VALUE*>( this )->SetStringRef(
+                &m_item->GetEffectiveNetClass()->GetName() );
         return LIBEVAL::VALUE::AsString();
     }
 
@@ -167,7 +162,11 @@ public:
 
     const wxString& AsString() const override
     {
-        const_cast<PCBEXPR_NET_VALUE*>( this )->Set( m_item->GetNetname() );
+        if( m_item->GetNet() )
+            const_cast<PCBEXPR_NET_VALUE*>( this )->SetStringRef( &m_item->GetNet()->GetNetname() );
+        else
+            const_cast<PCBEXPR_NET_VALUE*>( this )->Set( wxEmptyString );
+
         return LIBEVAL::VALUE::AsString();
     }
 
@@ -197,12 +196,12 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     PCBEXPR_CONTEXT* context = static_cast<PCBEXPR_CONTEXT*>( aCtx );
 
     if( m_itemIndex == 2 )
-        return new PCBEXPR_LAYER_VALUE( context->GetLayer() );
+        return aCtx->AllocValue<PCBEXPR_LAYER_VALUE>( context->GetLayer() );
 
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
     auto it = m_matchingTypes.find( TYPE_HASH( *item ) );
 
@@ -212,13 +211,13 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
         // simpler "A.Via_Type == 'buried'" is perfectly clear.  Instead, return an undefined
         // value when the property doesn't appear on a particular object.
 
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
     }
     else
     {
         if( m_type == LIBEVAL::VT_NUMERIC )
         {
-            return new LIBEVAL::VALUE( (double) item->Get<int>( it->second ) );
+            return aCtx->AllocValue( (double) item->Get<int>( it->second ) );
         }
         else
         {
@@ -229,9 +228,9 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
                 str = item->Get<wxString>( it->second );
 
                 if( it->second->Name() == wxT( "Pin Type" ) )
-                    return new PCBEXPR_PINTYPE_VALUE( str );
+                    return aCtx->AllocValue<PCBEXPR_PINTYPE_VALUE>( str );
                 else
-                    return new LIBEVAL::VALUE( str );
+                    return aCtx->AllocValue( str );
             }
             else
             {
@@ -243,18 +242,19 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
                         || it->second->Name() == wxT( "Layer Bottom" ) )
                 {
                     if( any.GetAs<PCB_LAYER_ID>( &layer ) )
-                        return new PCBEXPR_LAYER_VALUE( layer );
+                        return aCtx->AllocValue<PCBEXPR_LAYER_VALUE>( layer );
                     else if( any.GetAs<wxString>( &str ) )
-                        return new PCBEXPR_LAYER_VALUE( context->GetBoard()->GetLayerID( str ) );
+                        return aCtx->AllocValue<PCBEXPR_LAYER_VALUE>(
+                                context->GetBoard()->GetLayerID( str ) );
                 }
                 else
                 {
                     if( any.GetAs<wxString>( &str ) )
-                        return new LIBEVAL::VALUE( str );
+                        return aCtx->AllocValue( str );
                 }
             }
 
-            return new LIBEVAL::VALUE();
+            return aCtx->AllocValue();
         }
     }
 }
@@ -265,9 +265,9 @@ LIBEVAL::VALUE* PCBEXPR_NETCLASS_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NETCLASS_VALUE( item );
+    return aCtx->AllocValue<PCBEXPR_NETCLASS_VALUE>( item );
 }
 
 
@@ -276,9 +276,9 @@ LIBEVAL::VALUE* PCBEXPR_NETNAME_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NET_VALUE( item );
+    return aCtx->AllocValue<PCBEXPR_NET_VALUE>( item );
 }
 
 
@@ -287,9 +287,11 @@ LIBEVAL::VALUE* PCBEXPR_TYPE_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new LIBEVAL::VALUE( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    LIBEVAL::VALUE* value = aCtx->AllocValue();
+    value->SetStringRef( &ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    return value;
 }
 
 
@@ -297,6 +299,9 @@ LIBEVAL::FUNC_CALL_REF PCBEXPR_UCODE::CreateFuncCall( const wxString& aName )
 {
     PCBEXPR_BUILTIN_FUNCTIONS& registry = PCBEXPR_BUILTIN_FUNCTIONS::Instance();
 
+    // Functions may look at anything (geometry, layers, other items...)
+    m_memoizable = false;
+
     return registry.Get( aName.Lower() );
 }
 
@@ -337,6 +342,8 @@ std::unique_ptr<LIBEVAL::VAR_REF> PCBEXPR_UCODE::CreateVarRef( const wxString& a
             return nullptr;
     }
 
+    m_memoizable = false;
+
     if( aVar == wxT( "A" ) || aVar == wxT( "AB" ) )
         vref = std::make_unique<PCBEXPR_VAR_REF>( 0 );
     else if( aVar == wxT( "B" ) )
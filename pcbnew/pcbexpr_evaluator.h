@@ -40,12 +40,24 @@ class PCBEXPR_VAR_REF;
 class PCBEXPR_UCODE final : public LIBEVAL::UCODE
 {
 public:
-    PCBEXPR_UCODE() {};
+    PCBEXPR_UCODE() :
+            m_memoizable( true )
+    {};
+
     virtual ~PCBEXPR_UCODE() {};
 
     virtual std::unique_ptr<LIBEVAL::VAR_REF> CreateVarRef( const wxString& aVar,
                                                             const wxString& aField ) override;
     virtual LIBEVAL::FUNC_CALL_REF CreateFuncCall( const wxString& aName ) override;
+
+    /**
+     * @return true if the compiled expression refers to nothing but the Type, NetName and
+     *         NetClass of items A and B, so that its result only depends on their types and nets.
+     */
+    bool IsMemoizable() const { return m_memoizable; }
+
+private:
+    bool m_memoizable;
 };
 
 
@@ -135,11 +135,9 @@ static void existsOnLayerFunc( LIBEVAL::CONTEXT* aCtx, void *self )
                      */
 
                     BOARD* board = item->GetBoard();
-                    std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                    auto i = board->m_LayerExpressionCache.find( layerName );
-                    LSET mask;
+                    LSET   mask;
 
-                    if( i == board->m_LayerExpressionCache.end() )
+                    if( !board->m_LayerExpressionCache.Find( layerName, mask ) )
                     {
                         for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
                         {
@@ -149,11 +147,7 @@ static void existsOnLayerFunc( LIBEVAL::CONTEXT* aCtx, void *self )
                                 mask.set( ToLAYER_ID( entry.GetValue() ) );
                         }
 
-                        board->m_LayerExpressionCache[ layerName ] = mask;
-                    }
-                    else
-                    {
-                        mask = i->second;
+                        board->m_LayerExpressionCache.Insert( layerName, mask );
                     }
 
                     if( ( item->GetLayerSet() & mask ).any() )
@@ -271,22 +265,20 @@ static void intersectsCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+                            PTR_PTR_CACHE_KEY key = { fp, item };
+                            bool              res;
 
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
+                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0
+                                    && board->m_IntersectsCourtyardCache.Find( key, res ) )
                             {
-                                auto i = board->m_IntersectsCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsCourtyardCache.end() )
-                                    return i->second;
+                                return res;
                             }
 
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
+                            res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
                                     || collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsCourtyardCache[ key ] = res;
+                                board->m_IntersectsCourtyardCache.Insert( key, res );
 
                             return res;
                         } ) )
@@ -331,21 +323,19 @@ static void intersectsFrontCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+                            PTR_PTR_CACHE_KEY key = { fp, item };
+                            bool              res;
 
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
+                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0
+                                    && board->m_IntersectsFCourtyardCache.Find( key, res ) )
                             {
-                                auto i = board->m_IntersectsFCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsFCourtyardCache.end() )
-                                    return i->second;
+                                return res;
                             }
 
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu );
+                            res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsFCourtyardCache[ key ] = res;
+                                board->m_IntersectsFCourtyardCache.Insert( key, res );
 
                             return res;
                         } ) )
@@ -390,21 +380,19 @@ static void intersectsBackCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+                            PTR_PTR_CACHE_KEY key = { fp, item };
+                            bool              res;
 
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
+                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0
+                                    && board->m_IntersectsBCourtyardCache.Find( key, res ) )
                             {
-                                auto i = board->m_IntersectsBCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsBCourtyardCache.end() )
-                                    return i->second;
+                                return res;
                             }
 
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
+                            res = collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsBCourtyardCache[ key ] = res;
+                                board->m_IntersectsBCourtyardCache.Insert( key, res );
 
                             return res;
                         } ) )
@@ -504,7 +492,15 @@ bool collidesWithArea( BOARD_ITEM* aItem, PCBEXPR_CONTEXT* aCtx, ZONE* aArea )
         if( !zone->IsFilled() )
             return false;
 
-        DRC_RTREE* zoneRTree = board->m_CopperZoneRTreeCache[ zone ].get();
+        DRC_RTREE* zoneRTree = nullptr;
+
+        {
+            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+            auto                         it = board->m_CopperZoneRTreeCache.find( zone );
+
+            if( it != board->m_CopperZoneRTreeCache.end() )
+                zoneRTree = it->second.get();
+        }
 
         if( zoneRTree )
         {
@@ -648,9 +644,8 @@ static void intersectsAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             if( !aArea->GetBoundingBox().Intersects( itemBBox ) )
                                 return false;
 
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                            LSET                         testLayers;
-                            PTR_PTR_LAYER_CACHE_KEY      key;
+                            LSET                    testLayers;
+                            PTR_PTR_LAYER_CACHE_KEY key;
 
                             if( aLayer != UNDEFINED_LAYER )
                                 testLayers.set( aLayer );
@@ -661,18 +656,18 @@ static void intersectsAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             {
                                 if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                                 {
-                                    key = { aArea, item, layer };
+                                    bool cached = false;
 
-                                    auto i = board->m_IntersectsAreaCache.find( key );
+                                    key = { aArea, item, layer };
 
-                                    if( i != board->m_IntersectsAreaCache.end() && i->second )
+                                    if( board->m_IntersectsAreaCache.Find( key, cached ) && cached )
                                         return true;
                                 }
 
                                 bool collides = collidesWithArea( item, context, aArea );
 
                                 if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                    board->m_IntersectsAreaCache[ key ] = collides;
+                                    board->m_IntersectsAreaCache.Insert( key, collides );
 
                                 if( collides )
                                     return true;
@@ -732,19 +727,16 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             if( !aArea->GetBoundingBox().Intersects( itemBBox ) )
                                 return false;
 
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                            PTR_PTR_LAYER_CACHE_KEY      key = { aArea, item, layer };
+                            PTR_PTR_LAYER_CACHE_KEY key = { aArea, item, layer };
+                            bool                    enclosedByArea;
 
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
+                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0
+                                    && board->m_EnclosedByAreaCache.Find( key, enclosedByArea ) )
                             {
-                                auto i = board->m_EnclosedByAreaCache.find( key );
-
-                                if( i != board->m_EnclosedByAreaCache.end() )
-                                    return i->second;
+                                return enclosedByArea;
                             }
 
                             SHAPE_POLY_SET itemShape;
-                            bool           enclosedByArea;
 
                             item->TransformShapeToPolygon( itemShape, layer, 0, maxError,
                                                            ERROR_OUTSIDE );
@@ -763,7 +755,7 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             }
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_EnclosedByAreaCache[ key ] = enclosedByArea;
+                                board->m_EnclosedByAreaCache.Insert( key, enclosedByArea );
 
                             return enclosedByArea;
                         } ) )
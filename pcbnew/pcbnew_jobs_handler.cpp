@@ -38,6 +38,7 @@
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_drc.h>
 #include <cli/exit_codes.h>
+#include <core/task_scheduler.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
 #include <plotters/plotter_dxf.h>
@@ -50,9 +51,11 @@
 #include <gendrill_Excellon_writer.h>
 #include <gendrill_gerber_writer.h>
 #include <kiface_base.h>
+#include <locale_io.h>
 #include <macros.h>
 #include <pad.h>
 #include <pcb_marker.h>
+#include <plot_geometry_cache.h>
 #include <project/project_file.h>
 #include <exporters/export_svg.h>
 #include <pcbnew_settings.h>
@@ -205,6 +208,9 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     loadOverrideDrawingSheet( brd, aSvgJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
+    // The layers plotted share the offset pads, solder mask and zone areas
+    PLOT_GEOMETRY_CACHE_SCOPE plotCache( brd );
+
     if( aJob->IsCli() )
     {
         if( EXPORT_SVG::Plot( brd, svgPlotOptions ) )
@@ -259,6 +265,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
     plotOpts.SetPlotReference( aDxfJob->m_plotRefDes );
     plotOpts.SetLayerSelection( aDxfJob->m_printMaskLayer );
 
+    PLOT_GEOMETRY_CACHE_SCOPE plotCache( brd );
+
     DXF_PLOTTER* plotter = (DXF_PLOTTER*) StartPlotBoard(
             brd, &plotOpts, UNDEFINED_LAYER, aDxfJob->m_outputFile, wxEmptyString, wxEmptyString );
 
@@ -328,6 +336,8 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
             break;
     }
 
+    PLOT_GEOMETRY_CACHE_SCOPE plotCache( brd );
+
     PDF_PLOTTER* plotter = (PDF_PLOTTER*) StartPlotBoard(
             brd, &plotOpts, UNDEFINED_LAYER, aPdfJob->m_outputFile, wxEmptyString, wxEmptyString );
 
@@ -385,9 +395,27 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             aGerberJob->m_layersIncludeOnAll = plotOnAllLayersSelection;
     }
 
+    // Each layer is plotted to its own file, so the layers can be plotted concurrently once their
+    // options and file names are known.  This relies on PlotBoardLayers() leaving the board alone:
+    // pads are plotted from offset copies (see PLOT_GEOMETRY_CACHE) rather than being resized
+    // and restored, and DISABLE_ARC_RADIUS_CORRECTION only affects the calling thread.  Keep it
+    // that way, or plot serially.
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID    m_Layer;
+        LSEQ            m_PlotSequence;
+        PCB_PLOT_PARAMS m_PlotOpts;
+        wxString        m_FullPath;
+        bool            m_Success = false;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+    bool                    plotFrameRef = false;
+
     for( LSEQ seq = LSET( aGerberJob->m_printMaskLayer ).UIOrder(); seq; ++seq )
     {
-        LSEQ plotSequence;
+        LAYER_PLOT& layerPlot = layerPlots.emplace_back();
+        LSEQ&       plotSequence = layerPlot.m_PlotSequence;
 
         // Base layer always gets plotted first.
         plotSequence.push_back( *seq );
@@ -405,7 +433,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
         // Pick the basename from the board file
         wxFileName fn( brd->GetFileName() );
         PCB_LAYER_ID layer = *seq;
-        PCB_PLOT_PARAMS plotOpts;
+        PCB_PLOT_PARAMS& plotOpts = layerPlot.m_PlotOpts;
 
         if( aGerberJob->m_useBoardPlotParams )
             plotOpts = boardPlotOptions;
@@ -422,26 +450,51 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
 
         jobfile_writer.AddGbrFile( layer, fullname );
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard(
-                brd, &plotOpts, layer, fn.GetFullPath(), wxEmptyString, wxEmptyString );
+        layerPlot.m_Layer = layer;
+        layerPlot.m_FullPath = fn.GetFullPath();
+        plotFrameRef |= plotOpts.GetPlotFrameRef();
+    }
+
+    // The drawing sheet items are built in the shared drawing sheet model
+    int                       jobs = plotFrameRef ? 1 : aGerberJob->m_jobs;
+    LOCALE_IO                 toggle;
+    PLOT_GEOMETRY_CACHE_SCOPE plotCache( brd );
+
+    ParallelForLimited( GetKiCadTaskScheduler(), 0, layerPlots.size(), std::max( jobs, 0 ),
+            [&]( size_t ii )
+            {
+                LAYER_PLOT& layerPlot = layerPlots[ii];
+
+                // We are feeding it one layer at the start here to silence a logic check
+                GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard(
+                        brd, &layerPlot.m_PlotOpts, layerPlot.m_Layer, layerPlot.m_FullPath,
+                        wxEmptyString, wxEmptyString );
+
+                if( plotter )
+                {
+                    PlotBoardLayers( brd, plotter, layerPlot.m_PlotSequence,
+                                     layerPlot.m_PlotOpts );
+                    plotter->EndPlot();
+                    layerPlot.m_Success = true;
+                }
+
+                delete plotter;
+            } );
 
-        if( plotter )
+    for( const LAYER_PLOT& layerPlot : layerPlots )
+    {
+        if( layerPlot.m_Success )
         {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), layerPlot.m_FullPath ),
                                 RPT_SEVERITY_ACTION );
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
             m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
-                                                  fn.GetFullPath() ),
+                                                  layerPlot.m_FullPath ),
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
-
-        delete plotter;
     }
 
     wxFileName fn( aGerberJob->m_filename );
@@ -505,6 +558,8 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
     populateGerberPlotOptionsFromJob( plotOpts, aGerberJob );
     plotOpts.SetLayerSelection( aGerberJob->m_printMaskLayer );
 
+    PLOT_GEOMETRY_CACHE_SCOPE plotCache( brd );
+
     // We are feeding it one layer at the start here to silence a logic check
     GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard(
             brd, &plotOpts, aGerberJob->m_printMaskLayer.front(), aGerberJob->m_outputFile,
@@ -563,6 +618,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
         drillWriter = std::make_unique<GERBER_WRITER>( brd );
     }
 
+    drillWriter->SetParallelJobs( std::max( aDrillJob->m_jobs, 0 ) );
+
     VECTOR2I offset;
 
     if( aDrillJob->m_drillOrigin == JOB_EXPORT_PCB_DRILL::DRILL_ORIGIN::ABS )
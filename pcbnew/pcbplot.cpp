@@ -390,7 +390,8 @@ void BuildPlotFileName( wxFileName* aFilename, const wxString& aOutputDir,
 }
 
 
-PLOT_CONTROLLER::PLOT_CONTROLLER( BOARD* aBoard )
+PLOT_CONTROLLER::PLOT_CONTROLLER( BOARD* aBoard ) :
+        m_plotCache( aBoard )
 {
     m_plotter = nullptr;
     m_board = aBoard;
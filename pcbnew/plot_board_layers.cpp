@@ -44,6 +44,7 @@
 #include <pcb_target.h>
 #include <pcb_dimension.h>
 #include <pcbplot.h>
+#include <plot_geometry_cache.h>
 #include <plotters/plotter_dxf.h>
 #include <plotters/plotter_hpgl.h>
 #include <plotters/plotter_gerber.h>
@@ -272,6 +273,151 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
 }
 
 
+/**
+ * Build a copy of \a aPad offset by \a aMargin (mask or paste margin) and \a aWidthAdj (fine
+ * width adjustment of PS plotters), as it must be plotted.
+ *
+ * Not all shapes can have a different margin for the x and y axis: only oval and rect shapes
+ * can.  Other shapes use margin.x.
+ */
+static std::shared_ptr<const PAD> buildPlotPad( const PAD* aPad, const VECTOR2I& aMargin,
+                                                int aWidthAdj, int aMaxError )
+{
+    std::shared_ptr<PAD> plotPad = std::make_shared<PAD>( *aPad );
+    int                  mask_clearance = aMargin.x;
+    VECTOR2I padPlotsSize = aPad->GetSize() + aMargin * 2 + VECTOR2I( aWidthAdj, aWidthAdj );
+
+    switch( aPad->GetShape() )
+    {
+    case PAD_SHAPE::CIRCLE:
+    case PAD_SHAPE::OVAL:
+        plotPad->SetSize( padPlotsSize );
+        break;
+
+    case PAD_SHAPE::RECTANGLE:
+        plotPad->SetSize( padPlotsSize );
+
+        if( mask_clearance > 0 )
+        {
+            plotPad->SetShape( PAD_SHAPE::ROUNDRECT );
+            plotPad->SetRoundRectCornerRadius( mask_clearance );
+        }
+
+        break;
+
+    case PAD_SHAPE::TRAPEZOID:
+        // inflate/deflate a trapezoid is a bit complex.
+        // so if the margin is not null, build a similar polygonal pad shape,
+        // and inflate/deflate the polygonal shape
+        // because inflating/deflating using different values for y and y
+        // we are using only margin.x as inflate/deflate value
+        if( mask_clearance != 0 )
+        {
+            plotPad->SetAnchorPadShape( PAD_SHAPE::CIRCLE );
+            plotPad->SetShape( PAD_SHAPE::CUSTOM );
+            SHAPE_POLY_SET outline;
+            outline.NewOutline();
+            int dx = aPad->GetSize().x / 2;
+            int dy = aPad->GetSize().y / 2;
+            int ddx = aPad->GetDelta().x / 2;
+            int ddy = aPad->GetDelta().y / 2;
+
+            outline.Append( -dx - ddy,  dy + ddx );
+            outline.Append(  dx + ddy,  dy - ddx );
+            outline.Append(  dx - ddy, -dy + ddx );
+            outline.Append( -dx + ddy, -dy - ddx );
+
+            // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
+            // which can create bad shapes if margin.x is < 0
+            outline.InflateWithLinkedHoles( mask_clearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                            aMaxError, SHAPE_POLY_SET::PM_FAST );
+            plotPad->DeletePrimitivesList();
+            plotPad->AddPrimitivePoly( outline, 0, true );
+
+            // Be sure the anchor pad is not bigger than the deflated shape because this
+            // anchor will be added to the pad shape when plotting the pad. So now the
+            // polygonal shape is built, we can clamp the anchor size
+            plotPad->SetSize( VECTOR2I( 0, 0 ) );
+        }
+
+        break;
+
+    case PAD_SHAPE::ROUNDRECT:
+    {
+        // rounding is stored as a percent, but we have to update this ratio
+        // to force recalculation of other values after size changing (we do not
+        // really change the rounding percent value)
+        double radius_ratio = aPad->GetRoundRectRadiusRatio();
+        plotPad->SetSize( padPlotsSize );
+        plotPad->SetRoundRectRadiusRatio( radius_ratio );
+        break;
+    }
+
+    case PAD_SHAPE::CHAMFERED_RECT:
+        if( mask_clearance == 0 )
+        {
+            // the size can be slightly inflated by width_adj (PS/PDF only)
+            plotPad->SetSize( padPlotsSize );
+        }
+        else
+        {
+            // Due to the polygonal shape of a CHAMFERED_RECT pad, the best way is to
+            // convert the pad shape to a full polygon, inflate/deflate the polygon
+            // and use a dummy CUSTOM pad to plot the final shape.
+            // Build the outline with coordinates relative to the pad position and
+            // orientation 0. The actual pos and rotation will be taken in account
+            // later by the plot function
+            plotPad->SetPosition( VECTOR2I( 0, 0 ) );
+            plotPad->SetOrientation( ANGLE_0 );
+            SHAPE_POLY_SET outline;
+            plotPad->TransformShapeToPolygon( outline, UNDEFINED_LAYER, 0, aMaxError,
+                                              ERROR_INSIDE );
+            outline.InflateWithLinkedHoles( mask_clearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                            aMaxError, SHAPE_POLY_SET::PM_FAST );
+
+            plotPad->SetAnchorPadShape( PAD_SHAPE::CIRCLE );
+            plotPad->SetShape( PAD_SHAPE::CUSTOM );
+            plotPad->DeletePrimitivesList();
+            plotPad->AddPrimitivePoly( outline, 0, true );
+
+            // Be sure the anchor pad is not bigger than the deflated shape because this
+            // anchor will be added to the pad shape when plotting the pad.
+            // So we set the anchor size to 0
+            plotPad->SetSize( VECTOR2I( 0, 0 ) );
+            plotPad->SetPosition( aPad->GetPosition() );
+            plotPad->SetOrientation( aPad->GetOrientation() );
+        }
+
+        break;
+
+    case PAD_SHAPE::CUSTOM:
+    {
+        // inflate/deflate a custom shape is a bit complex.
+        // so build a similar pad shape, and inflate/deflate the polygonal shape
+        SHAPE_POLY_SET shape;
+        aPad->MergePrimitivesAsPolygon( &shape );
+
+        // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
+        // which can create bad shapes if margin.x is < 0
+        shape.InflateWithLinkedHoles( mask_clearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                      aMaxError, SHAPE_POLY_SET::PM_FAST );
+        plotPad->DeletePrimitivesList();
+        plotPad->AddPrimitivePoly( shape, 0, true );
+
+        // Be sure the anchor pad is not bigger than the deflated shape because this
+        // anchor will be added to the pad shape when plotting the pad. So now the
+        // polygonal shape is built, we can clamp the anchor size
+        if( mask_clearance < 0 )  // we expect margin.x = margin.y for custom pads
+            plotPad->SetSize( padPlotsSize );
+
+        break;
+    }
+    }
+
+    return plotPad;
+}
+
+
 /**
  * Plot a copper layer or mask.
  *
@@ -306,11 +452,11 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         itemplotter.PlotFootprintGraphicItems( footprint );
 
     // Plot footprint pads
-    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
     {
         aPlotter->StartBlock( nullptr );
 
-        for( PAD* pad : footprint->Pads() )
+        for( const PAD* pad : footprint->Pads() )
         {
             OUTLINE_MODE padPlotMode = plotMode;
 
@@ -368,21 +514,9 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             if( onSolderPasteLayer )
                 margin = pad->GetSolderPasteMargin();
 
-            // not all shapes can have a different margin for x and y axis
-            // in fact only oval and rect shapes can have different values.
-            // Round shape have always the same x,y margin
-            // so define a unique value for other shapes that do not support different values
-            int mask_clearance = margin.x;
-
             // Now offset the pad size by margin + width_adj
             VECTOR2I padPlotsSize = pad->GetSize() + margin * 2 + VECTOR2I( width_adj, width_adj );
 
-            // Store these parameters that can be modified to plot inflated/deflated pads shape
-            PAD_SHAPE padShape = pad->GetShape();
-            VECTOR2I  padSize = pad->GetSize();
-            VECTOR2I  padDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
-            double    padCornerRadius = pad->GetRoundRectCornerRadius();
-
             // Don't draw a 0 sized pad.
             // Note: a custom pad can have its pad anchor with size = 0
             if( pad->GetShape() != PAD_SHAPE::CUSTOM
@@ -391,168 +525,39 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 continue;
             }
 
-            switch( pad->GetShape() )
+            if( ( pad->GetShape() == PAD_SHAPE::CIRCLE || pad->GetShape() == PAD_SHAPE::OVAL )
+                && aPlotOpt.GetSkipPlotNPTH_Pads()
+                && aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE
+                && padPlotsSize == pad->GetDrillSize()
+                && pad->GetAttribute() == PAD_ATTRIB::NPTH )
             {
-            case PAD_SHAPE::CIRCLE:
-            case PAD_SHAPE::OVAL:
-                pad->SetSize( padPlotsSize );
-
-                if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
-                    ( aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
-                    ( pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
-                {
-                    break;
-                }
-
-                itemplotter.PlotPad( pad, color, padPlotMode );
-                break;
-
-            case PAD_SHAPE::RECTANGLE:
-                pad->SetSize( padPlotsSize );
-
-                if( mask_clearance > 0 )
-                {
-                    pad->SetShape( PAD_SHAPE::ROUNDRECT );
-                    pad->SetRoundRectCornerRadius( mask_clearance );
-                }
-
-                itemplotter.PlotPad( pad, color, padPlotMode );
-                break;
-
-            case PAD_SHAPE::TRAPEZOID:
-                // inflate/deflate a trapezoid is a bit complex.
-                // so if the margin is not null, build a similar polygonal pad shape,
-                // and inflate/deflate the polygonal shape
-                // because inflating/deflating using different values for y and y
-                // we are using only margin.x as inflate/deflate value
-                if( mask_clearance == 0 )
-                {
-                    itemplotter.PlotPad( pad, color, padPlotMode );
-                }
-                else
-                {
-                    PAD dummy( *pad );
-                    dummy.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
-                    dummy.SetShape( PAD_SHAPE::CUSTOM );
-                    SHAPE_POLY_SET outline;
-                    outline.NewOutline();
-                    int dx = padSize.x / 2;
-                    int dy = padSize.y / 2;
-                    int ddx = padDelta.x / 2;
-                    int ddy = padDelta.y / 2;
-
-                    outline.Append( -dx - ddy,  dy + ddx );
-                    outline.Append(  dx + ddy,  dy - ddx );
-                    outline.Append(  dx - ddy, -dy + ddx );
-                    outline.Append( -dx + ddy, -dy - ddx );
-
-                    // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
-                    // which can create bad shapes if margin.x is < 0
-                    outline.InflateWithLinkedHoles( mask_clearance,
-                                                    CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError,
-                                                    SHAPE_POLY_SET::PM_FAST );
-                    dummy.DeletePrimitivesList();
-                    dummy.AddPrimitivePoly( outline, 0, true );
-
-                    // Be sure the anchor pad is not bigger than the deflated shape because this
-                    // anchor will be added to the pad shape when plotting the pad. So now the
-                    // polygonal shape is built, we can clamp the anchor size
-                    dummy.SetSize( VECTOR2I( 0, 0 ) );
-
-                    itemplotter.PlotPad( &dummy, color, padPlotMode );
-                }
-
-                break;
+                continue;
+            }
 
-            case PAD_SHAPE::ROUNDRECT:
+            if( margin.x == 0 && margin.y == 0 && width_adj == 0
+                && pad->GetShape() != PAD_SHAPE::CUSTOM )
             {
-                // rounding is stored as a percent, but we have to update this ratio
-                // to force recalculation of other values after size changing (we do not
-                // really change the rounding percent value)
-                double radius_ratio = pad->GetRoundRectRadiusRatio();
-                pad->SetSize( padPlotsSize );
-                pad->SetRoundRectRadiusRatio( radius_ratio );
-
                 itemplotter.PlotPad( pad, color, padPlotMode );
-                break;
+                continue;
             }
 
-            case PAD_SHAPE::CHAMFERED_RECT:
-                if( mask_clearance == 0 )
-                {
-                    // the size can be slightly inflated by width_adj (PS/PDF only)
-                    pad->SetSize( padPlotsSize );
-                    itemplotter.PlotPad( pad, color, padPlotMode );
-                }
-                else
-                {
-                    // Due to the polygonal shape of a CHAMFERED_RECT pad, the best way is to
-                    // convert the pad shape to a full polygon, inflate/deflate the polygon
-                    // and use a dummy  CUSTOM pad to plot the final shape.
-                    PAD dummy( *pad );
-                    // Build the dummy pad outline with coordinates relative to the pad position
-                    // and orientation 0. The actual pos and rotation will be taken in account
-                    // later by the plot function
-                    dummy.SetPosition( VECTOR2I( 0, 0 ) );
-                    dummy.SetOrientation( ANGLE_0 );
-                    SHAPE_POLY_SET outline;
-                    dummy.TransformShapeToPolygon( outline, UNDEFINED_LAYER, 0, maxError,
-                                                   ERROR_INSIDE );
-                    outline.InflateWithLinkedHoles( mask_clearance,
-                                                    CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError,
-                                                    SHAPE_POLY_SET::PM_FAST );
-
-                    // Initialize the dummy pad shape:
-                    dummy.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
-                    dummy.SetShape( PAD_SHAPE::CUSTOM );
-                    dummy.DeletePrimitivesList();
-                    dummy.AddPrimitivePoly( outline, 0, true );
-
-                    // Be sure the anchor pad is not bigger than the deflated shape because this
-                    // anchor will be added to the pad shape when plotting the pad.
-                    // So we set the anchor size to 0
-                    dummy.SetSize( VECTOR2I( 0, 0 ) );
-                    dummy.SetPosition( pad->GetPosition() );
-                    dummy.SetOrientation( pad->GetOrientation() );
-
-                    itemplotter.PlotPad( &dummy, color, padPlotMode );
-                }
-
-                break;
+            std::shared_ptr<const PAD> plotPad;
 
-            case PAD_SHAPE::CUSTOM:
+            if( aBoard->m_PlotGeometryCache )
             {
-                // inflate/deflate a custom shape is a bit complex.
-                // so build a similar pad shape, and inflate/deflate the polygonal shape
-                PAD dummy( *pad );
-                SHAPE_POLY_SET shape;
-                pad->MergePrimitivesAsPolygon( &shape );
-
-                // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
-                // which can create bad shapes if margin.x is < 0
-                shape.InflateWithLinkedHoles( mask_clearance,
-                                              CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError,
-                                              SHAPE_POLY_SET::PM_FAST );
-                dummy.DeletePrimitivesList();
-                dummy.AddPrimitivePoly( shape, 0, true );
-
-                // Be sure the anchor pad is not bigger than the deflated shape because this
-                // anchor will be added to the pad shape when plotting the pad. So now the
-                // polygonal shape is built, we can clamp the anchor size
-                if( mask_clearance < 0 )  // we expect margin.x = margin.y for custom pads
-                    dummy.SetSize( padPlotsSize );
-
-                itemplotter.PlotPad( &dummy, color, padPlotMode );
-                break;
+                plotPad = aBoard->m_PlotGeometryCache->m_Pads.FindOrInsert(
+                        { pad, margin, width_adj },
+                        [&]()
+                        {
+                            return buildPlotPad( pad, margin, width_adj, maxError );
+                        } );
             }
+            else
+            {
+                plotPad = buildPlotPad( pad, margin, width_adj, maxError );
             }
 
-            // Restore the pad parameters modified by the plot code
-            pad->SetSize( padSize );
-            pad->SetDelta( padDelta );
-            pad->SetShape( padShape );
-            pad->SetRoundRectCornerRadius( padCornerRadius );
+            itemplotter.PlotPad( plotPad.get(), color, padPlotMode );
         }
 
         aPlotter->EndBlock( nullptr );
@@ -680,25 +685,44 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             if( !aLayerMask[layer] )
                 continue;
 
-            SHAPE_POLY_SET mainArea = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
-            SHAPE_POLY_SET islands;
+            auto splitIslands =
+                    [&]()
+                    {
+                        auto mainArea = std::make_shared<SHAPE_POLY_SET>(
+                                zone->GetFilledPolysList( layer )->CloneDropTriangulation() );
+                        auto islands = std::make_shared<SHAPE_POLY_SET>();
+
+                        for( int i = mainArea->OutlineCount() - 1; i >= 0; i-- )
+                        {
+                            if( zone->IsIsland( layer, i ) )
+                            {
+                                islands->AddOutline( mainArea->CPolygon( i )[0] );
+                                mainArea->DeletePolygon( i );
+                            }
+                        }
+
+                        return PLOT_GEOMETRY_CACHE::ZONE_AREAS{ mainArea, islands };
+                    };
 
-            for( int i = mainArea.OutlineCount() - 1; i >= 0; i-- )
+            PLOT_GEOMETRY_CACHE::ZONE_AREAS areas;
+
+            if( aBoard->m_PlotGeometryCache )
             {
-                if( zone->IsIsland( layer, i ) )
-                {
-                    islands.AddOutline( mainArea.CPolygon( i )[0] );
-                    mainArea.DeletePolygon( i );
-                }
+                areas = aBoard->m_PlotGeometryCache->m_ZoneAreas.FindOrInsert( { zone, layer },
+                                                                             splitIslands );
+            }
+            else
+            {
+                areas = splitIslands();
             }
 
-            itemplotter.PlotZone( zone, layer, mainArea );
+            itemplotter.PlotZone( zone, layer, *areas.m_MainArea );
 
-            if( !islands.IsEmpty() )
+            if( !areas.m_Islands->IsEmpty() )
             {
                 ZONE dummy( *zone );
                 dummy.SetNet( &nonet );
-                itemplotter.PlotZone( &dummy, layer, islands );
+                itemplotter.PlotZone( &dummy, layer, *areas.m_Islands );
             }
         }
     }
@@ -818,6 +842,31 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
 
+    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
+    itemplotter.SetLayerSet( aLayerMask );
+
+    // To avoid a lot of code, use a ZONE to handle and plot polygons, because our polygons look
+    // exactly like filled areas in zones.
+    ZONE zone( aBoard );
+    zone.SetMinThickness( 0 );      // trace polygons only
+    zone.SetLayer( layer );
+
+    // The merged areas only depend on the footprint texts plotted, not on the plotter
+    PLOT_GEOMETRY_CACHE*                  cache = aBoard->m_PlotGeometryCache.get();
+    PLOT_GEOMETRY_CACHE::SOLDER_MASK_KEY  cacheKey{ layer, aMinThickness, 0 };
+    std::shared_ptr<const SHAPE_POLY_SET> cachedAreas;
+
+    cacheKey.m_TextOptions = ( itemplotter.GetPlotFPText() ? 1 : 0 )
+                             | ( itemplotter.GetPlotInvisibleText() ? 2 : 0 )
+                             | ( itemplotter.GetPlotReference() ? 4 : 0 )
+                             | ( itemplotter.GetPlotValue() ? 8 : 0 );
+
+    if( cache && cache->m_SolderMasks.Find( cacheKey, cachedAreas ) )
+    {
+        itemplotter.PlotZone( &zone, layer, *cachedAreas );
+        return;
+    }
+
     if( aBoard->GetBoardPolygonOutlines( buffer ) )
         boardOutline = &buffer;
 
@@ -825,9 +874,6 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     // than or equal comparison in the shape separation (boolean add)
     int inflate = aMinThickness / 2 - 1;
 
-    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
-    itemplotter.SetLayerSet( aLayerMask );
-
     // Build polygons for each pad shape.  The size of the shape on solder mask should be size
     // of pad + clearance around the pad, where clearance = solder mask clearance + extra margin.
     // Extra margin is half the min width for solder mask, which is used to merge too-close shapes
@@ -981,24 +1027,24 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
     // Merge all polygons: After deflating, not merged (not overlapping) polygons will have the
     // initial shape (with perhaps small changes due to deflating transform)
-    areas.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-    areas.Deflate( inflate, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
-
-    // To avoid a lot of code, use a ZONE to handle and plot polygons, because our polygons look
-    // exactly like filled areas in zones.
-    // Note, also this code is not optimized: it creates a lot of copy/duplicate data.
-    // However it is not complex, and fast enough for plot purposes (copy/convert data is only a
-    // very small calculation time for these calculations).
-    ZONE zone( aBoard );
-    zone.SetMinThickness( 0 );      // trace polygons only
-    zone.SetLayer( layer );
+    areas.SimplifyTiled( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    areas.DeflateTiled( inflate, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
 
     // Combine the current areas to initial areas. This is mandatory because inflate/deflate
     // transform is not perfect, and we want the initial areas perfectly kept
-    areas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
+    areas.BooleanAddTiled( initialPolys, SHAPE_POLY_SET::PM_FAST );
     areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
-    itemplotter.PlotZone( &zone, layer, areas );
+    if( cache )
+    {
+        cachedAreas = std::make_shared<const SHAPE_POLY_SET>( areas );
+        cache->m_SolderMasks.Insert( cacheKey, cachedAreas );
+        itemplotter.PlotZone( &zone, layer, *cachedAreas );
+    }
+    else
+    {
+        itemplotter.PlotZone( &zone, layer, areas );
+    }
 }
 
 
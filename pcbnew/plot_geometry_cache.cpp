@@ -0,0 +1,41 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <plot_geometry_cache.h>
+
+#include <board.h>
+
+
+PLOT_GEOMETRY_CACHE_SCOPE::PLOT_GEOMETRY_CACHE_SCOPE( BOARD* aBoard ) :
+        m_board( aBoard ),
+        m_owner( false )
+{
+    if( m_board && !m_board->m_PlotGeometryCache )
+    {
+        m_board->m_PlotGeometryCache = std::make_shared<PLOT_GEOMETRY_CACHE>();
+        m_owner = true;
+    }
+}
+
+
+PLOT_GEOMETRY_CACHE_SCOPE::~PLOT_GEOMETRY_CACHE_SCOPE()
+{
+    if( m_owner )
+        m_board->m_PlotGeometryCache = nullptr;
+}
@@ -0,0 +1,149 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLOT_GEOMETRY_CACHE_H
+#define PLOT_GEOMETRY_CACHE_H
+
+#include <memory>
+
+#include <core/sharded_cache.h>
+#include <hash.h>
+#include <layer_ids.h>
+#include <math/vector2d.h>
+
+class BOARD;
+class PAD;
+class SHAPE_POLY_SET;
+class ZONE;
+
+
+/**
+ * Geometry built when plotting board layers which depends on the board and a few plot options,
+ * but not on the plotter: pads offset by their mask or paste margin, the merged solder mask
+ * areas and the zone fills split into main areas and islands.
+ *
+ * It is shared by all the layers and output formats plotted while a PLOT_GEOMETRY_CACHE_SCOPE
+ * is alive, so that a Gerber, PDF and SVG set of the same board only does the polygon work
+ * once.  Layers may be plotted concurrently.  BOARD::IncrementTimeStamp() clears it.
+ */
+class PLOT_GEOMETRY_CACHE
+{
+public:
+    struct PAD_KEY
+    {
+        const PAD* m_Pad;
+        VECTOR2I   m_Margin;
+        int        m_WidthAdj;
+
+        bool operator==( const PAD_KEY& aOther ) const
+        {
+            return m_Pad == aOther.m_Pad && m_Margin == aOther.m_Margin
+                    && m_WidthAdj == aOther.m_WidthAdj;
+        }
+    };
+
+    struct SOLDER_MASK_KEY
+    {
+        PCB_LAYER_ID m_Layer;
+        int          m_MinThickness;
+        unsigned     m_TextOptions;     ///< Which footprint texts are included, see the plotter
+
+        bool operator==( const SOLDER_MASK_KEY& aOther ) const
+        {
+            return m_Layer == aOther.m_Layer && m_MinThickness == aOther.m_MinThickness
+                    && m_TextOptions == aOther.m_TextOptions;
+        }
+    };
+
+    struct ZONE_KEY
+    {
+        const ZONE*  m_Zone;
+        PCB_LAYER_ID m_Layer;
+
+        bool operator==( const ZONE_KEY& aOther ) const
+        {
+            return m_Zone == aOther.m_Zone && m_Layer == aOther.m_Layer;
+        }
+    };
+
+    struct ZONE_AREAS
+    {
+        std::shared_ptr<const SHAPE_POLY_SET> m_MainArea;
+        std::shared_ptr<const SHAPE_POLY_SET> m_Islands;
+    };
+
+    struct PAD_KEY_HASH
+    {
+        size_t operator()( const PAD_KEY& aKey ) const
+        {
+            return hash_val( aKey.m_Pad, aKey.m_Margin.x, aKey.m_Margin.y, aKey.m_WidthAdj );
+        }
+    };
+
+    struct SOLDER_MASK_KEY_HASH
+    {
+        size_t operator()( const SOLDER_MASK_KEY& aKey ) const
+        {
+            return hash_val( (int) aKey.m_Layer, aKey.m_MinThickness, aKey.m_TextOptions );
+        }
+    };
+
+    struct ZONE_KEY_HASH
+    {
+        size_t operator()( const ZONE_KEY& aKey ) const
+        {
+            return hash_val( aKey.m_Zone, (int) aKey.m_Layer );
+        }
+    };
+
+    void Clear()
+    {
+        m_Pads.Clear();
+        m_SolderMasks.Clear();
+        m_ZoneAreas.Clear();
+    }
+
+    SHARDED_CACHE<PAD_KEY, std::shared_ptr<const PAD>, PAD_KEY_HASH>               m_Pads;
+    SHARDED_CACHE<SOLDER_MASK_KEY, std::shared_ptr<const SHAPE_POLY_SET>,
+                  SOLDER_MASK_KEY_HASH>                                            m_SolderMasks;
+    SHARDED_CACHE<ZONE_KEY, ZONE_AREAS, ZONE_KEY_HASH>                             m_ZoneAreas;
+};
+
+
+/**
+ * Enable the plot geometry cache of a board for the lifetime of the scope, typically a plot
+ * job covering several layers or output formats.  Nested scopes share the outermost cache.
+ *
+ * Must be created and destroyed on the main thread, outside of any concurrent plotting.
+ */
+class PLOT_GEOMETRY_CACHE_SCOPE
+{
+public:
+    PLOT_GEOMETRY_CACHE_SCOPE( BOARD* aBoard );
+    ~PLOT_GEOMETRY_CACHE_SCOPE();
+
+    PLOT_GEOMETRY_CACHE_SCOPE( const PLOT_GEOMETRY_CACHE_SCOPE& ) = delete;
+    PLOT_GEOMETRY_CACHE_SCOPE& operator=( const PLOT_GEOMETRY_CACHE_SCOPE& ) = delete;
+
+private:
+    BOARD* m_board;
+    bool   m_owner;
+};
+
+#endif // PLOT_GEOMETRY_CACHE_H
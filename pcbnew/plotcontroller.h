@@ -32,6 +32,7 @@
 
 #include <pcb_plot_params.h>
 #include <layer_ids.h>
+#include <plot_geometry_cache.h>
 
 class PLOTTER;
 class BOARD;
@@ -132,6 +133,10 @@ private:
 
     BOARD*          m_board;
     wxFileName      m_plotFile;
+
+    /// Shares the pad, zone and solder mask geometry between all the layers and formats
+    /// plotted by the controller
+    PLOT_GEOMETRY_CACHE_SCOPE m_plotCache;
 };
 
 #endif
@@ -40,7 +40,11 @@ using namespace std::placeholders;
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
+#include <map>
+
+#include <core/kicad_algo.h>
 
 #include <delaunator.hpp>
 
@@ -139,20 +143,39 @@ class RN_NET::TRIANGULATOR_STATE
 private:
     std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> m_allNodes;
 
-
-    // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
-    // have unique coordinates!
-    bool areNodesColinear( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes ) const
+    // Orders positions the same way as CN_PTR_CMP orders anchors
+    struct POS_CMP
+    {
+        bool operator()( const VECTOR2I& aA, const VECTOR2I& aB ) const
+        {
+            return aA.x < aB.x || ( aA.x == aB.x && aA.y < aB.y );
+        }
+    };
+
+    // The triangulation of the previous update, kept so that moving a few anchors of a large
+    // net doesn't retriangulate all of them.  Each distinct anchor position is a vertex, and
+    // m_neighbours holds a superset of its Delaunay neighbours: edges which an insertion makes
+    // non-Delaunay aren't looked for, and stay until the next full rebuild.  A superset of the
+    // Delaunay triangulation still contains the minimum spanning tree.
+    std::map<VECTOR2I, int, POS_CMP> m_vertexIds;
+    std::vector<VECTOR2I>            m_vertexPos;
+    std::vector<std::vector<int>>    m_neighbours;
+    size_t                           m_edgeCount = 0;
+    bool                             m_valid = false;
+
+    // Checks if all points in aPoints lie on a single line. Requires the points to
+    // be unique!
+    static bool arePointsColinear( const std::vector<VECTOR2I>& aPoints )
     {
-        if ( aNodes.size() <= 2 )
+        if ( aPoints.size() <= 2 )
             return true;
 
-        const VECTOR2I p0( aNodes[0]->Pos() );
-        const VECTOR2I v0( aNodes[1]->Pos() - p0 );
+        const VECTOR2I p0( aPoints[0] );
+        const VECTOR2I v0( aPoints[1] - p0 );
 
-        for( unsigned i = 2; i < aNodes.size(); i++ )
+        for( unsigned i = 2; i < aPoints.size(); i++ )
         {
-            const VECTOR2I v1 = aNodes[i]->Pos() - p0;
+            const VECTOR2I v1 = aPoints[i] - p0;
 
             if( v0.Cross( v1 ) != 0 )
                 return false;
@@ -161,98 +184,426 @@ private:
         return true;
     }
 
-public:
+    int addVertex( const VECTOR2I& aPos )
+    {
+        int id = (int) m_vertexPos.size();
 
-    void Clear()
+        m_vertexPos.push_back( aPos );
+        m_neighbours.emplace_back();
+        m_vertexIds[aPos] = id;
+        return id;
+    }
+
+    void connect( int aA, int aB )
     {
-        m_allNodes.clear();
+        if( aA == aB || alg::contains( m_neighbours[aA], aB ) )
+            return;
+
+        m_neighbours[aA].push_back( aB );
+        m_neighbours[aB].push_back( aA );
+        m_edgeCount++;
     }
 
-    void AddNode( const std::shared_ptr<CN_ANCHOR>& aNode )
+    /**
+     * Connect the vertices \a aIds as in the Delaunay triangulation of their positions.
+     */
+    void triangulate( std::vector<int>& aIds )
     {
-        m_allNodes.insert( aNode );
+        std::sort( aIds.begin(), aIds.end(),
+                   [&]( int aA, int aB )
+                   {
+                       return POS_CMP()( m_vertexPos[aA], m_vertexPos[aB] );
+                   } );
+
+        std::vector<VECTOR2I> pts;
+
+        for( int id : aIds )
+            pts.push_back( m_vertexPos[id] );
+
+        if( arePointsColinear( pts ) )
+        {
+            // special case: all points are on the same line - there's no
+            // triangulation for such set. In this case, we sort along any coordinate
+            // and chain the points together.
+            for( size_t i = 1; i < aIds.size(); i++ )
+                connect( aIds[i - 1], aIds[i] );
+
+            return;
+        }
+
+        std::vector<double> coords;
+        coords.reserve( 2 * pts.size() );
+
+        for( const VECTOR2I& pt : pts )
+        {
+            coords.push_back( pt.x );
+            coords.push_back( pt.y );
+        }
+
+        delaunator::Delaunator delaunator( coords );
+        const std::vector<size_t>& triangles = delaunator.triangles;
+
+        for( size_t i = 0; i < triangles.size(); i += 3 )
+        {
+            connect( aIds[triangles[i]],     aIds[triangles[i + 1]] );
+            connect( aIds[triangles[i + 1]], aIds[triangles[i + 2]] );
+            connect( aIds[triangles[i + 2]], aIds[triangles[i]]     );
+        }
     }
 
-    void Triangulate( std::vector<CN_EDGE>& mstEdges )
+    void rebuild( const std::vector<std::shared_ptr<CN_ANCHOR>>& aAnchors, std::vector<int>& aIds )
+    {
+        m_vertexIds.clear();
+        m_vertexPos.clear();
+        m_neighbours.clear();
+        m_edgeCount = 0;
+
+        aIds.clear();
+
+        for( const std::shared_ptr<CN_ANCHOR>& anchor : aAnchors )
+            aIds.push_back( addVertex( anchor->Pos() ) );
+
+        std::vector<int> all( aIds );
+        triangulate( all );
+
+        m_valid = true;
+    }
+
+    /**
+     * Remove vertex \a aId.  The Delaunay edges replacing the removed ones join its former
+     * neighbours, and are Delaunay edges of any subset of the vertices containing their ends,
+     * so triangulating the former neighbours finds them.
+     */
+    void removeVertex( int aId )
+    {
+        std::vector<int> neighbours;
+
+        std::swap( neighbours, m_neighbours[aId] );
+
+        for( int neighbour : neighbours )
+            alg::delete_matching( m_neighbours[neighbour], aId );
+
+        m_edgeCount -= neighbours.size();
+        m_vertexIds.erase( m_vertexPos[aId] );
+
+        triangulate( neighbours );
+    }
+
+    /**
+     * Insert vertex \a aId, whose Delaunay neighbours are found by triangulating the vertices
+     * around it within a radius growing until all its triangles are known to be Delaunay.
+     *
+     * @param aAnchors are all the anchors, with \a aIds the vertex ids of those already
+     *                 inserted (and -1 for the others).
+     * @return false if too many vertices had to be triangulated, in which case a full rebuild
+     *         is cheaper.
+     */
+    bool insertVertex( int aId, const std::vector<std::shared_ptr<CN_ANCHOR>>& aAnchors,
+                       const std::vector<int>& aIds )
     {
-        std::vector<double>                                    node_pts;
-        std::vector<std::shared_ptr<CN_ANCHOR>>                anchors;
-        std::vector< std::vector<std::shared_ptr<CN_ANCHOR>> > anchorChains( m_allNodes.size() );
+        const VECTOR2I p = m_vertexPos[aId];
+        const size_t   maxVertices = std::max<size_t>( 64, m_vertexIds.size() / 4 );
 
-        node_pts.reserve( 2 * m_allNodes.size() );
-        anchors.reserve( m_allNodes.size() );
+        auto firstAtX =
+                [&]( int64_t aX ) -> size_t
+                {
+                    return std::lower_bound( aAnchors.begin(), aAnchors.end(), aX,
+                                             []( const std::shared_ptr<CN_ANCHOR>& aAnchor,
+                                                 int64_t aVal )
+                                             {
+                                                 return aAnchor->Pos().x < aVal;
+                                             } )
+                           - aAnchors.begin();
+                };
 
-        auto addEdge =
-                [&]( const std::shared_ptr<CN_ANCHOR>& src, const std::shared_ptr<CN_ANCHOR>& dst )
+        // Start from twice the distance to the nearest vertex, which is always a neighbour
+        size_t      start = firstAtX( p.x );
+        SEG::ecoord nearest_sq = VECTOR2I::ECOORD_MAX;
+
+        // Returns false once the x distance alone is larger than the nearest distance
+        auto visit =
+                [&]( size_t ii ) -> bool
                 {
-                    mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
+                    SEG::ecoord dx_sq = SEG::Square( (SEG::ecoord) aAnchors[ii]->Pos().x - p.x );
+
+                    if( dx_sq > nearest_sq )
+                        return false;
+
+                    if( aIds[ii] >= 0 && aIds[ii] != aId )
+                    {
+                        nearest_sq = std::min( nearest_sq,
+                                               ( aAnchors[ii]->Pos() - p ).SquaredEuclideanNorm() );
+                    }
+
+                    return true;
                 };
 
-        std::shared_ptr<CN_ANCHOR> prev = nullptr;
+        for( size_t ii = start; ii < aAnchors.size(); ++ii )
+        {
+            if( !visit( ii ) )
+                break;
+        }
+
+        for( size_t ii = start; ii > 0; --ii )
+        {
+            if( !visit( ii - 1 ) )
+                break;
+        }
+
+        if( nearest_sq == VECTOR2I::ECOORD_MAX )
+            return false;
+
+        double radius = 2.0 * std::sqrt( (double) nearest_sq ) + 1.0;
 
-        for( const std::shared_ptr<CN_ANCHOR>& n : m_allNodes )
+        while( true )
         {
-            if( !prev || prev->Pos() != n->Pos() )
+            std::vector<int> ids;
+
+            for( size_t ii = firstAtX( (int64_t) std::floor( p.x - radius ) );
+                 ii < aAnchors.size() && aAnchors[ii]->Pos().x <= p.x + radius; ++ii )
+            {
+                if( aIds[ii] >= 0 && aIds[ii] != aId
+                        && std::abs( (double) aAnchors[ii]->Pos().y - p.y ) <= radius )
+                {
+                    ids.push_back( aIds[ii] );
+                }
+            }
+
+            if( ids.size() > maxVertices )
+                return false;
+
+            // Nothing left to search if the new vertex is on the hull of all of them
+            bool complete = ids.size() + 1 >= m_vertexIds.size();
+
+            ids.push_back( aId );
+
+            std::vector<VECTOR2I> pts;
+
+            for( int id : ids )
+                pts.push_back( m_vertexPos[id] );
+
+            if( ids.size() >= 3 && !arePointsColinear( pts ) )
             {
-                node_pts.push_back( n->Pos().x );
-                node_pts.push_back( n->Pos().y );
-                anchors.push_back( n );
-                prev = n;
+                std::vector<double> coords;
+
+                for( const VECTOR2I& pt : pts )
+                {
+                    coords.push_back( pt.x );
+                    coords.push_back( pt.y );
+                }
+
+                delaunator::Delaunator     delaunator( coords );
+                const std::vector<size_t>& triangles = delaunator.triangles;
+                const size_t               self = ids.size() - 1;
+                std::vector<int>           neighbours;
+                bool                       verified = true;
+
+                for( size_t e = 0; e < triangles.size() && verified; e++ )
+                {
+                    if( triangles[e] != self )
+                        continue;
+
+                    // An outer edge: the new vertex is on the hull of the local vertices
+                    if( delaunator.halfedges[e] == delaunator::INVALID_INDEX )
+                    {
+                        verified = false;
+                        break;
+                    }
+
+                    size_t   t = e - e % 3;
+                    VECTOR2D a( coords[2 * triangles[t]],     coords[2 * triangles[t] + 1] );
+                    VECTOR2D b( coords[2 * triangles[t + 1]], coords[2 * triangles[t + 1] + 1] );
+                    VECTOR2D c( coords[2 * triangles[t + 2]], coords[2 * triangles[t + 2] + 1] );
+
+                    // The triangle is Delaunay if its circumcircle lies within the searched
+                    // area, as no vertex outside the area can be in it
+                    VECTOR2D ab = b - a;
+                    VECTOR2D ac = c - a;
+                    double   d = 2.0 * ( ab.x * ac.y - ab.y * ac.x );
+
+                    if( d == 0.0 )
+                    {
+                        verified = false;
+                        break;
+                    }
+
+                    VECTOR2D centre( a.x + ( ac.y * ab.SquaredEuclideanNorm()
+                                             - ab.y * ac.SquaredEuclideanNorm() ) / d,
+                                     a.y + ( ab.x * ac.SquaredEuclideanNorm()
+                                             - ac.x * ab.SquaredEuclideanNorm() ) / d );
+                    double   r = ( centre - a ).EuclideanNorm();
+
+                    if( ( centre - VECTOR2D( p ) ).EuclideanNorm() + r > radius )
+                    {
+                        verified = false;
+                        break;
+                    }
+
+                    neighbours.push_back( ids[triangles[t + ( e + 1 ) % 3]] );
+                    neighbours.push_back( ids[triangles[t + ( e + 2 ) % 3]] );
+                }
+
+                if( verified )
+                {
+                    for( int neighbour : neighbours )
+                        connect( aId, neighbour );
+
+                    return true;
+                }
             }
 
-            anchorChains[anchors.size() - 1].push_back( n );
+            if( complete )
+                return false;
+
+            radius *= 2.0;
         }
+    }
 
-        if( anchors.size() < 2 )
+    /**
+     * Bring the triangulation up to date with \a aAnchors by removing and inserting the
+     * vertices which have changed since the previous update.
+     *
+     * @param aIds receives the vertex id of each anchor.
+     * @return false if the triangulation must be rebuilt instead.
+     */
+    bool update( const std::vector<std::shared_ptr<CN_ANCHOR>>& aAnchors, std::vector<int>& aIds )
+    {
+        if( !m_valid )
+            return false;
+
+        std::vector<int>    removed;
+        std::vector<size_t> added;
+        auto                it = m_vertexIds.begin();
+
+        aIds.assign( aAnchors.size(), -1 );
+
+        // Both are sorted by position
+        for( size_t ii = 0; ii < aAnchors.size(); ++ii )
         {
-            return;
+            const VECTOR2I& pos = aAnchors[ii]->Pos();
+
+            while( it != m_vertexIds.end() && POS_CMP()( it->first, pos ) )
+                removed.push_back( ( it++ )->second );
+
+            if( it != m_vertexIds.end() && it->first == pos )
+                aIds[ii] = ( it++ )->second;
+            else
+                added.push_back( ii );
         }
-        else if( areNodesColinear( anchors ) )
+
+        for( ; it != m_vertexIds.end(); ++it )
+            removed.push_back( it->second );
+
+        if( removed.size() + added.size() > std::max<size_t>( 16, aAnchors.size() / 8 ) )
+            return false;
+
+        for( int id : removed )
+            removeVertex( id );
+
+        for( size_t ii : added )
         {
-            // special case: all nodes are on the same line - there's no
-            // triangulation for such set. In this case, we sort along any coordinate
-            // and chain the nodes together.
-            for( size_t i = 0; i < anchors.size() - 1; i++ )
-                addEdge( anchors[i], anchors[i + 1] );
+            aIds[ii] = addVertex( aAnchors[ii]->Pos() );
+
+            if( !insertVertex( aIds[ii], aAnchors, aIds ) )
+                return false;
         }
-        else
-        {
-            delaunator::Delaunator delaunator( node_pts );
-            auto& triangles = delaunator.triangles;
 
-            for( size_t i = 0; i < triangles.size(); i += 3 )
-            {
-                addEdge( anchors[triangles[i]],     anchors[triangles[i + 1]] );
-                addEdge( anchors[triangles[i + 1]], anchors[triangles[i + 2]] );
-                addEdge( anchors[triangles[i + 2]], anchors[triangles[i]]     );
-            }
+        // Too many stale edges (a triangulation has fewer than 3 per vertex)
+        return m_edgeCount <= 4 * m_vertexIds.size() + 16;
+    }
+
+    /**
+     * Add an edge for each pair of neighbouring vertices of the triangulation of \a aAnchors
+     * (which must be at distinct positions) to \a aEdges.
+     */
+    void addTriangulationEdges( const std::vector<std::shared_ptr<CN_ANCHOR>>& aAnchors,
+                                std::vector<CN_EDGE>& aEdges )
+    {
+        std::vector<int> ids;
+
+        if( !update( aAnchors, ids ) )
+            rebuild( aAnchors, ids );
+
+        std::vector<int> anchorIndex( m_vertexPos.size(), -1 );
 
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
+        for( size_t i = 0; i < ids.size(); i++ )
+            anchorIndex[ids[i]] = (int) i;
+
+        for( size_t i = 0; i < ids.size(); i++ )
+        {
+            for( int neighbour : m_neighbours[ids[i]] )
             {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
+                if( ids[i] > neighbour )
                     continue;
 
-                addEdge( anchors[triangles[i]], anchors[triangles[delaunator.halfedges[i]]] );
+                const std::shared_ptr<CN_ANCHOR>& src = aAnchors[i];
+                const std::shared_ptr<CN_ANCHOR>& dst = aAnchors[anchorIndex[neighbour]];
+
+                aEdges.emplace_back( src, dst, src->Dist( *dst ) );
+            }
+        }
+    }
+
+public:
+
+    void Clear()
+    {
+        m_allNodes.clear();
+    }
+
+    void AddNode( const std::shared_ptr<CN_ANCHOR>& aNode )
+    {
+        m_allNodes.insert( aNode );
+    }
+
+    void Triangulate( std::vector<CN_EDGE>& mstEdges )
+    {
+        // Nodes at the same position are adjacent; the first of each is the anchor used for
+        // the triangulation and the others are chained to it.
+        std::vector<std::shared_ptr<CN_ANCHOR>> nodes( m_allNodes.begin(), m_allNodes.end() );
+        std::vector<std::shared_ptr<CN_ANCHOR>> anchors;
+        std::vector<size_t>                     chainStarts;
+
+        anchors.reserve( nodes.size() );
+        chainStarts.reserve( nodes.size() + 1 );
+
+        for( size_t i = 0; i < nodes.size(); i++ )
+        {
+            if( i == 0 || nodes[i - 1]->Pos() != nodes[i]->Pos() )
+            {
+                anchors.push_back( nodes[i] );
+                chainStarts.push_back( i );
             }
         }
 
-        for( size_t i = 0; i < anchorChains.size(); i++ )
+        chainStarts.push_back( nodes.size() );
+
+        if( anchors.size() < 2 )
+        {
+            m_valid = false;
+            return;
+        }
+
+        addTriangulationEdges( anchors, mstEdges );
+
+        for( size_t i = 0; i + 1 < chainStarts.size(); i++ )
         {
-            std::vector<std::shared_ptr<CN_ANCHOR>>& chain = anchorChains[i];
+            auto chainBegin = nodes.begin() + chainStarts[i];
+            auto chainEnd = nodes.begin() + chainStarts[i + 1];
 
-            if( chain.size() < 2 )
+            if( chainEnd - chainBegin < 2 )
                 continue;
 
-            std::sort( chain.begin(), chain.end(),
+            std::sort( chainBegin, chainEnd,
                     [] ( const std::shared_ptr<CN_ANCHOR>& a, const std::shared_ptr<CN_ANCHOR>& b )
                     {
                         return a->GetCluster().get() < b->GetCluster().get();
                     } );
 
-            for( unsigned int j = 1; j < chain.size(); j++ )
+            for( auto it = chainBegin + 1; it != chainEnd; ++it )
             {
-                const std::shared_ptr<CN_ANCHOR>& prevNode = chain[j - 1];
-                const std::shared_ptr<CN_ANCHOR>& curNode  = chain[j];
+                const std::shared_ptr<CN_ANCHOR>& prevNode = *( it - 1 );
+                const std::shared_ptr<CN_ANCHOR>& curNode  = *it;
                 int weight = prevNode->GetCluster() != curNode->GetCluster() ? 1 : 0;
                 mstEdges.emplace_back( prevNode, curNode, weight );
             }
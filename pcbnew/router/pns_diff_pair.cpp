@@ -24,6 +24,7 @@
 #include <cmath>
 #include <limits>
 
+#include <geometry/seg_batch.h>
 #include <geometry/shape_rect.h>
 
 #include "pns_diff_pair.h"
@@ -183,13 +184,20 @@ static bool checkGap( const SHAPE_LINE_CHAIN &p, const SHAPE_LINE_CHAIN &n, int
 
     for( int i = 0; i < p.SegmentCount(); i++ )
     {
-        for( int j = 0; j < n.SegmentCount() ; j++ )
-        {
-            SEG::ecoord dist_sq = p.CSegment( i ).SquaredDistance( n.CSegment( j ) );
+        const SEG pSeg = p.CSegment( i );
+        VECTOR2I  boxMin, boxMax;
 
-            if( dist_sq < gap_sq )
-                return false;
-        }
+        // Only the segments of n near the box of pSeg can be closer than the gap
+        SEG_BATCH::InflateBox( pSeg, gap - 100, boxMin, boxMax );
+
+        bool clear = SEG_BATCH::Query( n.CPoints(), n.IsClosed(), boxMin, boxMax,
+                [&]( int j )
+                {
+                    return pSeg.SquaredDistance( n.CSegment( j ) ) >= gap_sq;
+                } );
+
+        if( !clear )
+            return false;
     }
 
     return true;
@@ -19,6 +19,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_rect.h>
 #include <geometry/shape_simple.h>
@@ -229,31 +230,28 @@ bool PRESERVE_VERTEX_CONSTRAINT::Check( int aVertex1, int aVertex2, const LINE*
                                         const SHAPE_LINE_CHAIN& aCurrentPath,
                                         const SHAPE_LINE_CHAIN& aReplacement )
 {
-    bool cv = false;
+    VECTOR2I boxMin, boxMax;
 
-    for( int i = aVertex1; i < aVertex2; i++ )
-    {
-        SEG::ecoord dist = aCurrentPath.CSegment(i).SquaredDistance( m_v );
+    // Only the segments near the vertex can pass through it
+    SEG_BATCH::InflateBox( m_v, m_v, 1, boxMin, boxMax );
 
-        if ( dist <= 1 )
-        {
-            cv = true;
-            break;
-        }
-    }
-
-    if( !cv )
-        return true;
+    auto passesVertex =
+            [&]( const SHAPE_LINE_CHAIN& aPath, int aFirst, int aLast )
+            {
+                return !SEG_BATCH::Query( aPath.CPoints(), aPath.IsClosed(), boxMin, boxMax,
+                        [&]( int i )
+                        {
+                            if( i < aFirst || i >= aLast )
+                                return true;
 
-    for( int i = 0; i < aReplacement.SegmentCount(); i++ )
-    {
-        SEG::ecoord dist = aReplacement.CSegment(i).SquaredDistance( m_v );
+                            return aPath.CSegment( i ).SquaredDistance( m_v ) > 1;
+                        } );
+            };
 
-        if ( dist <= 1 )
-            return true;
-    }
+    if( !passesVertex( aCurrentPath, aVertex1, aVertex2 ) )
+        return true;
 
-    return false;
+    return passesVertex( aReplacement, 0, aReplacement.SegmentCount() );
 }
 
 
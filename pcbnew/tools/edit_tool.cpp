@@ -2377,7 +2377,7 @@ int EDIT_TOOL::MoveExact( const TOOL_EVENT& aEvent )
                 getView()->Update( boardItem );
         }
 
-        commit.Push( _( "Move exact" ) );
+        commit.Push( _( "Move exact" ), MOVE_OP );
 
         if( selection.IsHover() )
             m_toolMgr->RunAction( PCB_ACTIONS::selectionClear );
@@ -198,7 +198,7 @@ int EDIT_TOOL::PackAndMoveFootprints( const TOOL_EVENT& aEvent )
     SpreadFootprints( &footprintsToPack, footprintsBbox.Normalize().GetOrigin(), false );
 
     if( doMoveSelection( aEvent, &commit ) )
-        commit.Push( _( "Pack footprints" ) );
+        commit.Push( _( "Pack footprints" ), MOVE_OP );
     else
         commit.Revert();
 
@@ -229,7 +229,7 @@ int EDIT_TOOL::Move( const TOOL_EVENT& aEvent )
         BOARD_COMMIT localCommit( this );
 
         if( doMoveSelection( aEvent, &localCommit ) )
-            localCommit.Push( _( "Move" ) );
+            localCommit.Push( _( "Move" ), MOVE_OP );
         else
             localCommit.Revert();
     }
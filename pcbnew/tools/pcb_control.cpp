@@ -65,6 +65,7 @@
 #include <widgets/wx_progress_reporters.h>
 #include <widgets/wx_infobar.h>
 #include <wx/hyperlink.h>
+#include <wx/filename.h>
 
 using namespace std::placeholders;
 
@@ -1453,7 +1454,11 @@ int PCB_CONTROL::UpdateMessagePanel( const TOOL_EVENT& aEvent )
         }
         else
         {
-            m_frame->SetMsgPanel( m_frame->GetBoard() );
+            wxULongLong undoMemory( pcbFrame->GetUndoRedoMemoryUsage() );
+
+            m_frame->GetBoard()->GetMsgPanelInfo( m_frame, msgItems );
+            msgItems.emplace_back( _( "Undo Memory" ),
+                                   wxFileName::GetHumanReadableSize( undoMemory ) );
         }
     }
     else if( selection.GetSize() == 1 )
@@ -228,7 +228,7 @@ int ALIGN_DISTRIBUTE_TOOL::AlignTop( const TOOL_EVENT& aEvent )
         item->Move( VECTOR2I( 0, difference ) );
     }
 
-    commit.Push( _( "Align to Top" ) );
+    commit.Push( _( "Align to Top" ), MOVE_OP );
     return 0;
 }
 
@@ -272,7 +272,7 @@ int ALIGN_DISTRIBUTE_TOOL::AlignBottom( const TOOL_EVENT& aEvent )
         item->Move( VECTOR2I( 0, difference ) );
     }
 
-    commit.Push( _( "Align to Bottom" ) );
+    commit.Push( _( "Align to Bottom" ), MOVE_OP );
     return 0;
 }
 
@@ -327,7 +327,7 @@ int ALIGN_DISTRIBUTE_TOOL::doAlignLeft()
         item->Move( VECTOR2I( difference, 0 ) );
     }
 
-    commit.Push( _( "Align to Left" ) );
+    commit.Push( _( "Align to Left" ), MOVE_OP );
     return 0;
 }
 
@@ -382,7 +382,7 @@ int ALIGN_DISTRIBUTE_TOOL::doAlignRight()
         item->Move( VECTOR2I( difference, 0 ) );
     }
 
-    commit.Push( _( "Align to Right" ) );
+    commit.Push( _( "Align to Right" ), MOVE_OP );
     return 0;
 }
 
@@ -426,7 +426,7 @@ int ALIGN_DISTRIBUTE_TOOL::AlignCenterX( const TOOL_EVENT& aEvent )
         item->Move( VECTOR2I( difference, 0 ) );
     }
 
-    commit.Push( _( "Align to Middle" ) );
+    commit.Push( _( "Align to Middle" ), MOVE_OP );
     return 0;
 }
 
@@ -470,7 +470,7 @@ int ALIGN_DISTRIBUTE_TOOL::AlignCenterY( const TOOL_EVENT& aEvent )
         item->Move( VECTOR2I( 0, difference ) );
     }
 
-    commit.Push( _( "Align to Center" ) );
+    commit.Push( _( "Align to Center" ), MOVE_OP );
     return 0;
 }
 
@@ -532,7 +532,7 @@ int ALIGN_DISTRIBUTE_TOOL::DistributeHorizontally( const TOOL_EVENT& aEvent )
         doDistributeGapsHorizontally( itemsToDistribute, commit, lastItem, totalGap );
     }
 
-    commit.Push( _( "Distribute Horizontally" ) );
+    commit.Push( _( "Distribute Horizontally" ), MOVE_OP );
     return 0;
 }
 
@@ -657,7 +657,7 @@ int ALIGN_DISTRIBUTE_TOOL::DistributeVertically( const TOOL_EVENT& aEvent )
         doDistributeGapsVertically( itemsToDistribute, commit, lastItem, totalGap );
     }
 
-    commit.Push( _( "Distribute Vertically" ) );
+    commit.Push( _( "Distribute Vertically" ), MOVE_OP );
     return 0;
 }
 
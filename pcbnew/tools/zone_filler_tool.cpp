@@ -45,6 +45,7 @@
 #include "zone_filler.h"
 #include "teardrop/teardrop.h"
 #include <core/profile.h>
+#include <advanced_config.h>
 
 ZONE_FILLER_TOOL::ZONE_FILLER_TOOL() :
     PCB_TOOL_BASE( "pcbnew.ZoneFiller" ),
@@ -60,6 +61,7 @@ ZONE_FILLER_TOOL::~ZONE_FILLER_TOOL()
 
 void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 {
+    ClearKnockoutCache();
 }
 
 
@@ -80,6 +82,12 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRep
 
     m_filler = std::make_unique<ZONE_FILLER>( frame()->GetBoard(), &commit );
 
+    // A full fill; just (re)populate the knockout cache
+    ClearKnockoutCache();
+
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetKnockoutCache( &m_knockoutCache, m_dirtyAreas );
+
     if( aReporter )
     {
         m_filler->SetProgressReporter( aReporter );
@@ -137,6 +145,12 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    // A full fill; just (re)populate the knockout cache
+    ClearKnockoutCache();
+
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetKnockoutCache( &m_knockoutCache, m_dirtyAreas );
+
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
         WX_INFOBAR* infobar = frame->GetInfoBar();
@@ -224,6 +238,14 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    // Digesting the whole board costs more than refilling the few zones touched by an edit
+    m_filler->SetUseFillCache( false );
+
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetKnockoutCache( &m_knockoutCache, m_dirtyAreas );
+
+    m_dirtyAreas.clear();
+
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
         WX_INFOBAR* infobar = frame->GetInfoBar();
@@ -344,6 +366,9 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    // An explicit refill must not trust anything cached
+    ClearKnockoutCache();
+
     reporter = std::make_unique<WX_PROGRESS_REPORTER>( frame(), _( "Fill Zone" ), 5 );
     m_filler->SetProgressReporter( reporter.get() );
 
@@ -405,6 +430,7 @@ int ZONE_FILLER_TOOL::ZoneUnfill( const TOOL_EVENT& aEvent )
     }
 
     commit.Push( _( "Unfill Zone" ), ZONE_FILL_OP );
+    ClearKnockoutCache();
 
     refresh();
 
@@ -424,6 +450,7 @@ int ZONE_FILLER_TOOL::ZoneUnfillAll( const TOOL_EVENT& aEvent )
     }
 
     commit.Push( _( "Unfill All Zones" ), ZONE_FILL_OP );
+    ClearKnockoutCache();
 
     refresh();
 
@@ -29,6 +29,7 @@
 
 #include <tools/pcb_tool_base.h>
 #include <zone.h>
+#include <zone_filler.h>
 
 
 class PCB_EDIT_FRAME;
@@ -67,6 +68,26 @@ public:
         m_dirtyZoneIDs.insert( aZone->m_Uuid );
     }
 
+    /**
+     * Record an area touched by a commit so that the next auto-fill only has to rebuild the
+     * zone knockouts there.
+     */
+    void DirtyArea( const BOX2I& aArea, const LSET& aLayers )
+    {
+        for( PCB_LAYER_ID layer : aLayers.Seq() )
+            m_dirtyAreas[ layer ].push_back( aArea );
+    }
+
+    /**
+     * Forget the cached zone knockouts.  Must be called whenever the board changes without
+     * the changes being recorded with DirtyArea().
+     */
+    void ClearKnockoutCache()
+    {
+        m_knockoutCache.clear();
+        m_dirtyAreas.clear();
+    }
+
     static bool IsZoneFillAction( const TOOL_EVENT* aEvent );
 
 private:
@@ -84,6 +105,9 @@ private:
     bool                         m_fillInProgress;
 
     std::set<KIID>               m_dirtyZoneIDs;
+
+    std::map<PCB_LAYER_ID, std::vector<BOX2I>> m_dirtyAreas;
+    ZONE_KNOCKOUT_CACHE                        m_knockoutCache;
 };
 
 #endif
@@ -215,7 +215,7 @@ bool TRACKS_CLEANER::testTrackEndpointIsNode( PCB_TRACK* aTrack, bool aTstStart
 {
     // A node is a point where more than 2 items are connected.
 
-    const std::list<CN_ITEM*>& items =
+    const std::vector<CN_ITEM*>& items =
                 m_brd->GetConnectivity()->GetConnectivityAlgo()->ItemEntry( aTrack ).GetItems();
 
     if( items.empty() )
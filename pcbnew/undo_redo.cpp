@@ -35,6 +35,8 @@ using namespace std::placeholders;
 #include <pcb_target.h>
 #include <footprint.h>
 #include <pad.h>
+#include <pcb_shape.h>
+#include <zone.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
 #include <tool/tool_manager.h>
@@ -42,8 +44,10 @@ using namespace std::placeholders;
 #include <tools/pcb_selection_tool.h>
 #include <tools/pcb_control.h>
 #include <tools/board_editor_control.h>
+#include <tools/zone_filler_tool.h>
 #include <drawing_sheet/ds_proxy_undo_item.h>
 #include <wx/msgdlg.h>
+#include <set>
 
 /* Functions to undo and redo edit commands.
  *  commands to undo are stored in CurrentScreen->m_UndoList
@@ -143,6 +147,7 @@ void PCB_BASE_EDIT_FRAME::saveCopyInUndoList( PICKED_ITEMS_LIST* commandToUndo,
         case UNDO_REDO::PAGESETTINGS:
         case UNDO_REDO::REGROUP:
         case UNDO_REDO::UNGROUP:
+        case UNDO_REDO::MOVED:
             break;
 
         default:
@@ -396,6 +401,24 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
             break;
         }
 
+        case UNDO_REDO::MOVED:      /* Move the item back, and keep where it was for redo */
+        {
+            BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
+            VECTOR2I    position = item->GetPosition();
+
+            view->Remove( item );
+            connectivity->Remove( item );
+
+            item->Move( aList->GetPickedItemPosition( ii ) - position );
+            aList->SetPickedItemPosition( position, ii );
+
+            view->Add( item );
+            view->Hide( item, false );
+            connectivity->Add( item );
+            item->GetBoard()->OnItemChanged( item );
+            break;
+        }
+
         case UNDO_REDO::NEWITEM:        /* new items are deleted */
             aList->SetPickedItemStatus( UNDO_REDO::DELETED, ii );
             GetModel()->Remove( (BOARD_ITEM*) eda_item );
@@ -487,6 +510,10 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
 
     if( IsType( FRAME_PCB_EDITOR ) )
     {
+        // Undo/redo doesn't record dirty areas for incremental zone refills
+        if( ZONE_FILLER_TOOL* zoneFillerTool = m_toolManager->GetTool<ZONE_FILLER_TOOL>() )
+            zoneFillerTool->ClearKnockoutCache();
+
         if( reBuild_ratsnest || deep_reBuild_ratsnest )
             Compile_Ratsnest( false );
 
@@ -538,6 +565,107 @@ void PCB_BASE_EDIT_FRAME::ClearListAndDeleteItems( PICKED_ITEMS_LIST* aList )
 }
 
 
+static size_t polyMemoryUsage( const SHAPE_POLY_SET& aPoly )
+{
+    // Each vertex is held with the index of the arc it belongs to (if any)
+    return aPoly.TotalVertices() * ( sizeof( VECTOR2I ) + sizeof( std::pair<ssize_t, ssize_t> ) );
+}
+
+
+static size_t itemMemoryUsage( const BOARD_ITEM* aItem, std::set<const void*>& aSeenFills )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_FOOTPRINT_T:
+    {
+        size_t size = sizeof( FOOTPRINT );
+
+        static_cast<const FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* child )
+                {
+                    size += itemMemoryUsage( child, aSeenFills );
+                } );
+
+        return size;
+    }
+
+    case PCB_PAD_T:   return sizeof( PAD );
+    case PCB_TRACE_T: return sizeof( PCB_TRACK );
+    case PCB_ARC_T:   return sizeof( PCB_ARC );
+    case PCB_VIA_T:   return sizeof( PCB_VIA );
+    case PCB_TEXT_T:  return sizeof( PCB_TEXT );
+    case PCB_FIELD_T: return sizeof( PCB_FIELD );
+
+    case PCB_SHAPE_T:
+        return sizeof( PCB_SHAPE )
+                + polyMemoryUsage( static_cast<const PCB_SHAPE*>( aItem )->GetPolyShape() );
+
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+        size_t      size = sizeof( ZONE ) + polyMemoryUsage( *zone->Outline() );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            std::shared_ptr<const SHAPE_POLY_SET> fill = zone->GetFilledPolysList( layer );
+
+            if( aSeenFills.insert( fill.get() ).second )
+                size += polyMemoryUsage( *fill );
+        }
+
+        return size;
+    }
+
+    default:
+        return sizeof( BOARD_ITEM );
+    }
+}
+
+
+size_t PCB_BASE_EDIT_FRAME::GetUndoRedoMemoryUsage() const
+{
+    std::set<const void*> seenFills;
+    size_t                size = 0;
+
+    // Fills still shared with the board cost nothing more to the undo list
+    for( const ZONE* zone : GetBoard()->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( zone->HasFilledPolysForLayer( layer ) )
+                seenFills.insert( zone->GetFilledPolysList( layer ).get() );
+        }
+    }
+
+    for( const UNDO_REDO_CONTAINER* list : { &m_undoList, &m_redoList } )
+    {
+        for( const PICKED_ITEMS_LIST* command : list->m_CommandsList )
+        {
+            for( unsigned ii = 0; ii < command->GetCount(); ++ii )
+            {
+                EDA_ITEM* link = command->GetPickedItemLink( ii );
+                EDA_ITEM* item = command->GetPickedItem( ii );
+
+                if( BOARD_ITEM* boardLink = dynamic_cast<BOARD_ITEM*>( link ) )
+                    size += itemMemoryUsage( boardLink, seenFills );
+
+                // Deleted items are owned by the undo list
+                if( command->GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+                {
+                    if( BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( item ) )
+                        size += itemMemoryUsage( boardItem, seenFills );
+                }
+            }
+        }
+    }
+
+    return size;
+}
+
+
 void PCB_BASE_EDIT_FRAME::RollbackFromUndo()
 {
     PICKED_ITEMS_LIST* undo = PopCommandFromUndoList();
@@ -165,8 +165,10 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
     {
         std::shared_ptr<SHAPE_POLY_SET> fill = aZone.m_FilledPolysList.at( layer );
 
+        // Share the fill rather than copying it: most copies (undo list entries, commit
+        // images) never modify it, and the ones that do get their own copy then.
         if( fill )
-            m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>( *fill );
+            m_FilledPolysList[layer] = fill;
         else
             m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>();
 
@@ -223,7 +225,11 @@ bool ZONE::UnFill()
     {
         change |= !pair.second->IsEmpty();
         m_insulatedIslands[pair.first].clear();
-        pair.second->RemoveAllContours();
+
+        if( pair.second.use_count() > 1 )
+            pair.second = std::make_shared<SHAPE_POLY_SET>();
+        else
+            pair.second->RemoveAllContours();
     }
 
     m_isFilled = false;
@@ -355,16 +361,13 @@ const BOX2I ZONE::GetBoundingBox() const
 {
     if( const BOARD* board = GetBoard() )
     {
-        std::unordered_map<const ZONE*, BOX2I>& cache = board->m_ZoneBBoxCache;
-        auto                                    cacheIter = cache.find( this );
-
-        if( cacheIter != cache.end() )
-            return cacheIter->second;
+        BOX2I bbox;
 
-        BOX2I bbox = m_Poly->BBox();
+        if( board->m_ZoneBBoxCache.Find( this, bbox ) )
+            return bbox;
 
-        std::unique_lock<std::mutex> cacheLock( const_cast<BOARD*>( board )->m_CachesMutex );
-        cache[ this ] = bbox;
+        bbox = m_Poly->BBox();
+        board->m_ZoneBBoxCache.Insert( this, bbox );
 
         return bbox;
     }
@@ -375,16 +378,11 @@ const BOX2I ZONE::GetBoundingBox() const
 
 void ZONE::CacheBoundingBox()
 {
-    BOARD*                                  board = GetBoard();
-    std::unordered_map<const ZONE*, BOX2I>& cache = board->m_ZoneBBoxCache;
+    BOARD* board = GetBoard();
+    BOX2I  bbox;
 
-    auto cacheIter = cache.find( this );
-
-    if( cacheIter == cache.end() )
-    {
-        std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-        cache[ this ] = m_Poly->BBox();
-    }
+    if( !board->m_ZoneBBoxCache.Find( this, bbox ) )
+        board->m_ZoneBBoxCache.Insert( this, m_Poly->BBox() );
 }
 
 
@@ -679,6 +677,8 @@ void ZONE::Move( const VECTOR2I& offset )
     HatchBorder();
 
     /* move fills */
+    unshareFills();
+
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Move( offset );
 
@@ -688,12 +688,15 @@ void ZONE::Move( const VECTOR2I& offset )
      * While the cache will get nuked at the conclusion of the operation, we use it for some
      * things (such as drawing the parent group) during the move.
      */
-    if( GetBoard() )
+    if( BOARD* board = GetBoard() )
     {
-        auto it = GetBoard()->m_ZoneBBoxCache.find( this );
+        BOX2I bbox;
 
-        if( it != GetBoard()->m_ZoneBBoxCache.end() )
-            it->second.Move( offset );
+        if( board->m_ZoneBBoxCache.Find( this, bbox ) )
+        {
+            bbox.Move( offset );
+            board->m_ZoneBBoxCache.Insert( this, bbox );
+        }
     }
 }
 
@@ -732,6 +735,8 @@ void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
     HatchBorder();
 
     /* rotate filled areas: */
+    unshareFills();
+
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Rotate( aAngle, aCentre );
 }
@@ -763,6 +768,7 @@ void ZONE::Mirror( const VECTOR2I& aMirrorRef, bool aMirrorLeftRight )
     m_Poly->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
 
     HatchBorder();
+    unshareFills();
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
@@ -1085,19 +1091,38 @@ void ZONE::swapData( BOARD_ITEM* aImage )
 }
 
 
+void ZONE::unshareFills()
+{
+    for( auto& [ layer, poly ] : m_FilledPolysList )
+    {
+        if( poly.use_count() > 1 )
+            poly = std::make_shared<SHAPE_POLY_SET>( *poly );
+    }
+}
+
+
 void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
 {
+    // Fills shared with copies of this zone are only copied when they actually need a new
+    // triangulation.
+    auto cacheFill =
+            [&]( PCB_LAYER_ID layer )
+            {
+                if( !m_FilledPolysList.at( layer )->IsTriangulationUpToDate() )
+                    GetFill( layer )->CacheTriangulation();
+            };
+
     if( aLayer == UNDEFINED_LAYER )
     {
         for( auto& [ layer, poly ] : m_FilledPolysList )
-            poly->CacheTriangulation();
+            cacheFill( layer );
 
         m_Poly->CacheTriangulation( false );
     }
     else
     {
         if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ]->CacheTriangulation();
+            cacheFill( aLayer );
     }
 }
 
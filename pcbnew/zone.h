@@ -610,18 +610,30 @@ public:
     }
 
     /**
-     * @return a reference to the list of filled polygons.
+     * @return the list of filled polygons.
+     *
+     * @note The filled polygons may be shared with copies of this zone.  Use GetFill() to
+     *       modify them.
      */
-    const std::shared_ptr<SHAPE_POLY_SET>& GetFilledPolysList( PCB_LAYER_ID aLayer ) const
+    std::shared_ptr<const SHAPE_POLY_SET> GetFilledPolysList( PCB_LAYER_ID aLayer ) const
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
         return m_FilledPolysList.at( aLayer );
     }
 
+    /**
+     * @return the filled polygons of \a aLayer, to be modified.  If they are shared with copies
+     *         of this zone (such as the ones in the undo list), they are copied first.
+     */
     SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer )
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
-        return m_FilledPolysList.at( aLayer ).get();
+        std::shared_ptr<SHAPE_POLY_SET>& fill = m_FilledPolysList.at( aLayer );
+
+        if( fill.use_count() > 1 )
+            fill = std::make_shared<SHAPE_POLY_SET>( *fill );
+
+        return fill.get();
     }
 
     /**
@@ -802,6 +814,11 @@ public:
 protected:
     virtual void swapData( BOARD_ITEM* aImage ) override;
 
+    /**
+     * Copy the filled polygons shared with copies of this zone, before modifying them in place.
+     */
+    void unshareFills();
+
 protected:
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
@@ -890,6 +907,7 @@ protected:
     int              m_localFlgs;               // Variable used in polygon calculations.
 
     /* set of filled polygons used to draw a zone as a filled area.
+     * Copies of the zone share them until either side modifies them (see GetFill()).
      * from outlines (m_Poly) but unlike m_Poly these filled polygons have no hole
      * (they are all in one piece)  In very simple cases m_FilledPolysList is same
      * as m_Poly.  In less simple cases (when m_Poly has holes) m_FilledPolysList is
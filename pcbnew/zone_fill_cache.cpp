@@ -0,0 +1,526 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <wx/datetime.h>
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 106800
+#include <boost/uuid/detail/sha1.hpp>
+#else
+#include <boost/uuid/sha1.hpp>
+#endif
+
+#include <advanced_config.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <build_version.h>
+#include <core/task_scheduler.h>
+#include <footprint.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <project.h>
+#include <project/net_settings.h>
+#include <project/project_file.h>
+#include <geometry/shape_poly_set.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <wildcards_and_files_ext.h>
+#include "zone_fill_cache.h"
+
+
+#define MASK_ZONE_FILL_CACHE "ZONE_FILL_CACHE"
+
+// Bump whenever the file format or the filling algorithm changes in a way which isn't
+// reflected in the build version.
+static const char     CACHE_FORMAT_TAG[] = "kicad-zone-fill-cache-1";
+static const uint32_t CACHE_FILE_MAGIC = 0x4346'5a4b;     // "KZFC"
+static const uint32_t CACHE_FILE_VERSION = 1;
+
+// Far more than the fill of any real zone layer; anything bigger is a corrupt file
+static const wxFileOffset CACHE_FILE_MAX_SIZE = 1024LL * 1024 * 1024;
+
+
+namespace
+{
+
+/**
+ * Accumulates a SHA1 digest.  Every field is followed by a separator so that adjacent fields
+ * can't run into each other.
+ */
+class SHA1_DIGEST
+{
+public:
+    void Add( const void* aData, size_t aLength )
+    {
+        m_sha1.process_bytes( aData, aLength );
+        m_sha1.process_byte( 0 );
+    }
+
+    void Add( const std::string& aString ) { Add( aString.data(), aString.size() ); }
+
+    void Add( const wxString& aString ) { Add( std::string( aString.ToUTF8() ) ); }
+
+    void Add( long long aValue ) { Add( &aValue, sizeof( aValue ) ); }
+
+    void Add( int aValue ) { Add( (long long) aValue ); }
+
+    void Add( double aValue ) { Add( &aValue, sizeof( aValue ) ); }
+
+    void Add( const SHAPE_POLY_SET& aPoly )
+    {
+        for( int ii = 0; ii < aPoly.OutlineCount(); ++ii )
+        {
+            for( const SHAPE_LINE_CHAIN& chain : aPoly.CPolygon( ii ) )
+            {
+                for( const VECTOR2I& pt : chain.CPoints() )
+                {
+                    Add( pt.x );
+                    Add( pt.y );
+                }
+
+                Add( chain.IsClosed() ? 1 : 0 );
+            }
+
+            Add( -1 );
+        }
+    }
+
+    /// @return the digest as 40 hex digits (MSB first, as for the 3D model cache).
+    std::string Finish()
+    {
+        unsigned int digest[5];
+        m_sha1.get_digest( digest );
+
+        char buf[41];
+
+        for( int ii = 0; ii < 5; ++ii )
+            snprintf( buf + 8 * ii, 9, "%08x", digest[ii] );
+
+        return std::string( buf, 40 );
+    }
+
+private:
+    boost::uuids::detail::sha1 m_sha1;
+};
+
+
+void writeUint( wxFFile& aFile, uint32_t aValue )
+{
+    uint8_t buf[4] = { uint8_t( aValue ), uint8_t( aValue >> 8 ), uint8_t( aValue >> 16 ),
+                       uint8_t( aValue >> 24 ) };
+
+    aFile.Write( buf, sizeof( buf ) );
+}
+
+
+bool readUint( const std::vector<uint8_t>& aBuffer, size_t& aPos, uint32_t& aValue )
+{
+    if( aPos + 4 > aBuffer.size() )
+        return false;
+
+    aValue = uint32_t( aBuffer[aPos] ) | uint32_t( aBuffer[aPos + 1] ) << 8
+             | uint32_t( aBuffer[aPos + 2] ) << 16 | uint32_t( aBuffer[aPos + 3] ) << 24;
+
+    aPos += 4;
+    return true;
+}
+
+} // namespace
+
+
+ZONE_FILL_CACHE::ZONE_FILL_CACHE( const wxString& aCacheDir )
+{
+    if( aCacheDir.IsEmpty() )
+        return;
+
+    wxFileName cacheDir;
+    cacheDir.AssignDir( aCacheDir );
+
+    if( !cacheDir.DirExists() )
+    {
+        cacheDir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+        if( !cacheDir.DirExists() )
+        {
+            wxLogTrace( MASK_ZONE_FILL_CACHE,
+                        wxT( "%s:%s:%d\n * failed to create zone fill cache directory '%s'" ),
+                        __FILE__, __FUNCTION__, __LINE__, cacheDir.GetPath() );
+
+            return;
+        }
+    }
+
+    m_cacheDir = cacheDir.GetPathWithSep();
+}
+
+
+wxString ZONE_FILL_CACHE::GetDefaultCacheDir( const BOARD* aBoard )
+{
+    if( !aBoard || aBoard->GetFileName().IsEmpty() )
+        return wxEmptyString;
+
+    wxFileName fn( aBoard->GetFileName() );
+    fn.AppendDir( fn.GetName() + wxT( "-zone-fill-cache" ) );
+
+    return fn.GetPath();
+}
+
+
+void ZONE_FILL_CACHE::BuildItemDigests( BOARD* aBoard, const SHAPE_POLY_SET* aBoardOutline )
+{
+    m_itemDigests.clear();
+    m_zoneDigests.clear();
+
+    // Everything which can change any fill on the board
+    SHA1_DIGEST rules;
+
+    rules.Add( std::string( CACHE_FORMAT_TAG ) );
+    rules.Add( GetBuildVersion() );
+    rules.Add( aBoard->GetDesignSettings().FormatAsString() );
+    rules.Add( (long long) ADVANCED_CFG::GetCfg().m_UseClipper2 );
+    rules.Add( (long long) ADVANCED_CFG::GetCfg().m_PolygonTileVertices );
+    rules.Add( (long long) pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance ) );
+    rules.Add( (long long) aBoard->GetCopperLayerCount() );
+
+    if( PROJECT* project = aBoard->GetProject() )
+        rules.Add( project->GetProjectFile().NetSettings()->FormatAsString() );
+
+    if( !aBoard->GetFileName().IsEmpty() )
+    {
+        wxFileName rulesFile( aBoard->GetFileName() );
+        rulesFile.SetExt( FILEEXT::DesignRulesFileExtension );
+
+        wxFFile  file;
+        wxString rulesText;
+
+        if( rulesFile.FileExists() && file.Open( rulesFile.GetFullPath() )
+                && file.ReadAll( &rulesText ) )
+        {
+            rules.Add( rulesText );
+        }
+    }
+
+    if( aBoardOutline )
+        rules.Add( *aBoardOutline );
+
+    m_rulesDigest = rules.Finish();
+
+    for( ZONE* zone : aBoard->Zones() )
+        m_zoneDigests[ zone ] = zoneDigest( zone );
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+        m_itemDigests.push_back( { footprint, footprint->GetBoundingBox(), std::string() } );
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+        m_itemDigests.push_back( { track, track->GetBoundingBox(), std::string() } );
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+        m_itemDigests.push_back( { item, item->GetBoundingBox(), std::string() } );
+
+    // Digest the s-expression of each item; the formatter covers every property which can
+    // affect the item's knockouts, including ones added after this was written.
+    auto digest_lambda =
+            [&]( size_t aStart, size_t aEnd )
+            {
+                PCB_IO_KICAD_SEXPR formatter( CTL_FOR_BOARD );
+
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    ITEM_DIGEST& entry = m_itemDigests[ii];
+                    SHA1_DIGEST  digest;
+
+                    formatter.Format( entry.m_Item );
+                    digest.Add( formatter.GetStringOutput( true ) );
+
+                    if( auto cItem = dynamic_cast<const BOARD_CONNECTED_ITEM*>( entry.m_Item ) )
+                        digest.Add( cItem->GetNetname() );
+
+                    entry.m_Digest = digest.Finish();
+                }
+            };
+
+    // One block per thread, as each needs its own formatter
+    TASK_SCHEDULER& scheduler = GetKiCadTaskScheduler();
+    size_t          count = m_itemDigests.size();
+    size_t          blocks = scheduler.GetThreadCount();
+
+    ParallelFor( scheduler, 0, blocks,
+                 [&]( size_t aBlock )
+                 {
+                     digest_lambda( count * aBlock / blocks, count * ( aBlock + 1 ) / blocks );
+                 },
+                 1 );
+}
+
+
+std::string ZONE_FILL_CACHE::zoneDigest( const ZONE* aZone ) const
+{
+    SHA1_DIGEST digest;
+
+    digest.Add( aZone->GetZoneName() );
+    digest.Add( aZone->GetNetname() );
+    digest.Add( (long long) aZone->GetNetCode() );
+    digest.Add( aZone->GetLayerSet().FmtHex() );
+    digest.Add( (long long) aZone->GetAssignedPriority() );
+    digest.Add( (long long) aZone->GetLocalClearance() );
+    digest.Add( (long long) aZone->GetMinThickness() );
+    digest.Add( (long long) aZone->GetPadConnection() );
+    digest.Add( (long long) aZone->GetThermalReliefGap() );
+    digest.Add( (long long) aZone->GetThermalReliefSpokeWidth() );
+    digest.Add( (long long) aZone->GetFillMode() );
+    digest.Add( (long long) aZone->GetHatchThickness() );
+    digest.Add( (long long) aZone->GetHatchGap() );
+    digest.Add( aZone->GetHatchOrientation().AsDegrees() );
+    digest.Add( (long long) aZone->GetHatchSmoothingLevel() );
+    digest.Add( aZone->GetHatchSmoothingValue() );
+    digest.Add( aZone->GetHatchHoleMinArea() );
+    digest.Add( (long long) aZone->GetHatchBorderAlgorithm() );
+    digest.Add( (long long) aZone->GetCornerSmoothingType() );
+    digest.Add( (long long) aZone->GetCornerRadius() );
+    digest.Add( (long long) aZone->GetIslandRemovalMode() );
+    digest.Add( aZone->GetMinIslandArea() );
+    digest.Add( (long long) aZone->GetTeardropAreaType() );
+    digest.Add( (long long) aZone->GetIsRuleArea() );
+    digest.Add( (long long) aZone->GetDoNotAllowCopperPour() );
+    digest.Add( *aZone->Outline() );
+
+    return digest.Finish();
+}
+
+
+std::string ZONE_FILL_CACHE::MakeKey( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aReach,
+                                      const std::vector<const ZONE*>& aDependencies ) const
+{
+    SHA1_DIGEST key;
+
+    key.Add( m_rulesDigest );
+    key.Add( (long long) aLayer );
+
+    auto it = m_zoneDigests.find( aZone );
+
+    if( it != m_zoneDigests.end() )
+        key.Add( it->second );
+    else
+        key.Add( zoneDigest( aZone ) );
+
+    for( const ITEM_DIGEST& entry : m_itemDigests )
+    {
+        if( entry.m_BBox.Intersects( aReach ) )
+            key.Add( entry.m_Digest );
+    }
+
+    for( const auto& [ zone, digest ] : m_zoneDigests )
+    {
+        if( zone != aZone && zone->GetBoundingBox().Intersects( aReach ) )
+            key.Add( digest );
+    }
+
+    // Higher-priority zones are knocked out using their fills
+    for( const ZONE* dependency : aDependencies )
+    {
+        key.Add( m_zoneDigests.count( dependency ) ? m_zoneDigests.at( dependency )
+                                                   : zoneDigest( dependency ) );
+
+        if( dependency->HasFilledPolysForLayer( aLayer ) )
+            key.Add( *dependency->GetFilledPolysList( aLayer ) );
+    }
+
+    return key.Finish();
+}
+
+
+wxString ZONE_FILL_CACHE::cacheFileName( const std::string& aKey ) const
+{
+    return m_cacheDir + wxString::FromUTF8( aKey ) + wxT( ".zfc" );
+}
+
+
+bool ZONE_FILL_CACHE::Load( const std::string& aKey, SHAPE_POLY_SET& aFill ) const
+{
+    if( !IsValid() || aKey.empty() )
+        return false;
+
+    wxString fname = cacheFileName( aKey );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    wxFFile file( fname, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 || length > CACHE_FILE_MAX_SIZE )
+    {
+        wxLogTrace( MASK_ZONE_FILL_CACHE, wxT( " * [zone fill] bad cache file '%s'" ), fname );
+        return false;
+    }
+
+    std::vector<uint8_t> buffer( (size_t) length );
+
+    if( file.Read( buffer.data(), buffer.size() ) != buffer.size() )
+        return false;
+
+    size_t   pos = 0;
+    uint32_t magic, version, polyCount;
+
+    if( !readUint( buffer, pos, magic ) || magic != CACHE_FILE_MAGIC
+            || !readUint( buffer, pos, version ) || version != CACHE_FILE_VERSION
+            || !readUint( buffer, pos, polyCount ) )
+    {
+        wxLogTrace( MASK_ZONE_FILL_CACHE, wxT( " * [zone fill] bad cache file '%s'" ), fname );
+        return false;
+    }
+
+    SHAPE_POLY_SET fill;
+
+    for( uint32_t ii = 0; ii < polyCount; ++ii )
+    {
+        uint32_t contourCount;
+
+        if( !readUint( buffer, pos, contourCount ) )
+            return false;
+
+        for( uint32_t jj = 0; jj < contourCount; ++jj )
+        {
+            uint32_t         pointCount;
+            SHAPE_LINE_CHAIN chain;
+
+            if( !readUint( buffer, pos, pointCount ) )
+                return false;
+
+            for( uint32_t kk = 0; kk < pointCount; ++kk )
+            {
+                uint32_t x, y;
+
+                if( !readUint( buffer, pos, x ) || !readUint( buffer, pos, y ) )
+                    return false;
+
+                chain.Append( (int32_t) x, (int32_t) y, true );
+            }
+
+            chain.SetClosed( true );
+
+            if( jj == 0 )
+                fill.AddOutline( chain );
+            else
+                fill.AddHole( chain );
+        }
+    }
+
+    if( pos != buffer.size() )
+        return false;
+
+    aFill = std::move( fill );
+
+    wxLogTrace( MASK_ZONE_FILL_CACHE, wxT( " * [zone fill] loaded '%s'" ), fname );
+    return true;
+}
+
+
+bool ZONE_FILL_CACHE::Save( const std::string& aKey, const SHAPE_POLY_SET& aFill ) const
+{
+    if( !IsValid() || aKey.empty() )
+        return false;
+
+    // Write to a temporary file and rename it into place so that concurrent readers (other
+    // threads or processes sharing the cache) never see a partial file.
+    wxString tmpName = wxFileName::CreateTempFileName( m_cacheDir + wxT( "zfc" ) );
+
+    if( tmpName.IsEmpty() )
+        return false;
+
+    {
+        wxFFile file( tmpName, wxT( "wb" ) );
+
+        if( !file.IsOpened() )
+            return false;
+
+        writeUint( file, CACHE_FILE_MAGIC );
+        writeUint( file, CACHE_FILE_VERSION );
+        writeUint( file, aFill.OutlineCount() );
+
+        for( int ii = 0; ii < aFill.OutlineCount(); ++ii )
+        {
+            const SHAPE_POLY_SET::POLYGON& poly = aFill.CPolygon( ii );
+
+            writeUint( file, poly.size() );
+
+            for( const SHAPE_LINE_CHAIN& chain : poly )
+            {
+                writeUint( file, chain.PointCount() );
+
+                for( const VECTOR2I& pt : chain.CPoints() )
+                {
+                    writeUint( file, (uint32_t) pt.x );
+                    writeUint( file, (uint32_t) pt.y );
+                }
+            }
+        }
+
+        if( file.Error() || !file.Close() )
+        {
+            wxRemoveFile( tmpName );
+            return false;
+        }
+    }
+
+    if( !wxRenameFile( tmpName, cacheFileName( aKey ), true ) )
+    {
+        wxRemoveFile( tmpName );
+        return false;
+    }
+
+    return true;
+}
+
+
+void ZONE_FILL_CACHE::CleanCacheDir( int aNumDaysOld )
+{
+    wxDir         dir;
+    wxArrayString fileList;
+    wxDateTime    lastAccess;
+    wxDateSpan    durationInDays;
+
+    if( !IsValid() || !dir.Open( m_cacheDir ) )
+        return;
+
+    durationInDays.SetDays( aNumDaysOld );
+    wxDateTime thresholdDate = wxDateTime::Now() - durationInDays;
+
+    size_t numFilesFound = wxDir::GetAllFiles( m_cacheDir, &fileList, wxT( "*.zfc" ),
+                                               wxDIR_FILES );
+
+    for( size_t ii = 0; ii < numFilesFound; ii++ )
+    {
+        wxFileName thisFile( fileList[ii] );
+
+        if( thisFile.GetTimes( &lastAccess, nullptr, nullptr )
+                && lastAccess.IsEarlierThan( thresholdDate ) )
+        {
+            wxRemoveFile( thisFile.GetFullPath() );
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZONE_FILL_CACHE_H
+#define ZONE_FILL_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <wx/string.h>
+
+#include <layer_ids.h>
+#include <math/box2.h>
+
+class BOARD;
+class BOARD_ITEM;
+class SHAPE_POLY_SET;
+class ZONE;
+
+
+/**
+ * A persistent, content-addressed cache of zone fills.
+ *
+ * Each fill is stored in its own file whose name is the SHA1 digest of everything the fill of
+ * that zone layer depends on: the zone itself, the design rules, the board outline and every
+ * item (including other zones) whose knockouts could reach the zone.  An identical board filled
+ * a second time, in another process or on another machine sharing the cache directory, can then
+ * load its fills without running any polygon operations.
+ *
+ * The key is built before filling from s-expression digests of the board items, so it only
+ * needs BuildItemDigests() on the main thread; MakeKey(), Load() and Save() are thread-safe.
+ */
+class ZONE_FILL_CACHE
+{
+public:
+    /**
+     * @param aCacheDir is the directory holding the cache files.  It is created if needed.
+     */
+    ZONE_FILL_CACHE( const wxString& aCacheDir );
+
+    /**
+     * @return the default cache directory for \a aBoard (next to the board file), or an empty
+     *         string if the board has never been saved.
+     */
+    static wxString GetDefaultCacheDir( const BOARD* aBoard );
+
+    bool IsValid() const { return !m_cacheDir.IsEmpty(); }
+
+    /**
+     * Digest the design rules and all board items.  Must be called (from the main thread)
+     * before any keys are made.
+     *
+     * @param aBoardOutline is the outline fills are clipped to (or nullptr).
+     */
+    void BuildItemDigests( BOARD* aBoard, const SHAPE_POLY_SET* aBoardOutline );
+
+    /**
+     * Build the cache key of \a aZone's fill on \a aLayer.
+     *
+     * @param aReach is the zone's bounding box inflated by the worst clearance; only items
+     *               intersecting it are included.
+     * @param aDependencies are the other zones whose (already completed) fills on \a aLayer
+     *                      are knocked out of this one.
+     */
+    std::string MakeKey( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aReach,
+                         const std::vector<const ZONE*>& aDependencies ) const;
+
+    bool Load( const std::string& aKey, SHAPE_POLY_SET& aFill ) const;
+
+    bool Save( const std::string& aKey, const SHAPE_POLY_SET& aFill ) const;
+
+    /**
+     * Delete cache files which haven't been accessed for \a aNumDaysOld days.
+     */
+    void CleanCacheDir( int aNumDaysOld );
+
+private:
+    struct ITEM_DIGEST
+    {
+        const BOARD_ITEM* m_Item;
+        BOX2I             m_BBox;
+        std::string       m_Digest;
+    };
+
+    std::string zoneDigest( const ZONE* aZone ) const;
+
+    wxString cacheFileName( const std::string& aKey ) const;
+
+private:
+    wxString                 m_cacheDir;
+    std::string              m_rulesDigest;
+    std::vector<ITEM_DIGEST> m_itemDigests;
+    std::map<const ZONE*, std::string> m_zoneDigests;
+};
+
+#endif // ZONE_FILL_CACHE_H
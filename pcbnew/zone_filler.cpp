@@ -23,7 +23,6 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
-#include <future>
 #include <core/kicad_algo.h>
 #include <advanced_config.h>
 #include <board.h>
@@ -43,8 +42,9 @@
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
 #include <confirm.h>
-#include <core/thread_pool.h>
+#include <core/task_scheduler.h>
 #include <math/util.h>      // for KiROUND
+#include "zone_fill_cache.h"
 #include "zone_filler.h"
 
 
@@ -54,10 +54,13 @@ ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
         m_maxError( ARC_HIGH_DEF ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_knockoutCache( nullptr )
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
+
+    m_useFillCache = ADVANCED_CFG::GetCfg().m_ZoneFillDiskCache;
 }
 
 
@@ -74,6 +77,172 @@ void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
 }
 
 
+void ZONE_FILLER::SetKnockoutCache( ZONE_KNOCKOUT_CACHE* aCache,
+                                    const std::map<PCB_LAYER_ID, std::vector<BOX2I>>& aDirtyAreas )
+{
+    m_knockoutCache = aCache;
+    m_dirtyAreas = aDirtyAreas;
+}
+
+
+/**
+ * The furthest an item's clearance knockout can extend outside its bounding box.
+ */
+int ZONE_FILLER::worstKnockoutGap() const
+{
+    int extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+
+    return m_worstClearance + extra_margin + m_board->GetDesignSettings().m_MaxError;
+}
+
+
+/**
+ * The dirty areas are only handed to the filler once, so the cached knockouts of the zones not
+ * filled now which they reach are stale from now on.
+ */
+void ZONE_FILLER::invalidateUnfilledKnockouts( const std::vector<ZONE*>& aZones )
+{
+    if( !m_knockoutCache || m_dirtyAreas.empty() )
+        return;
+
+    int gap = worstKnockoutGap();
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( alg::contains( aZones, zone ) )
+            continue;
+
+        BOX2I zoneReach = zone->GetBoundingBox();
+        zoneReach.Inflate( gap );
+
+        for( const auto& [ layer, dirtyAreas ] : m_dirtyAreas )
+        {
+            auto it = m_knockoutCache->find( { zone->m_Uuid, layer } );
+
+            if( it == m_knockoutCache->end() || !it->second.m_Valid )
+                continue;
+
+            for( const BOX2I& dirtyArea : dirtyAreas )
+            {
+                if( dirtyArea.Intersects( zoneReach ) )
+                {
+                    it->second.m_Valid = false;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Decide for each copper zone layer to be filled whether its cached knockouts can be reused,
+ * and collect the dirty areas which must be rebuilt.  Must be called from the main thread as
+ * it may insert new entries in the cache.
+ */
+void ZONE_FILLER::prepareKnockoutRefills(
+        const std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& aToFill,
+        std::map<std::pair<ZONE*, PCB_LAYER_ID>, MD5_HASH>& aOldHashes )
+{
+    m_knockoutRefills.clear();
+
+    // The debug filler fills internal layers on F_Cu; keep it away from the cache
+    if( !m_knockoutCache || m_debugZoneFiller )
+        return;
+
+    // Past this many dirty areas a single enclosing area is cheaper to handle
+    const size_t MAX_DIRTY_AREAS = 64;
+    int          gap = worstKnockoutGap();
+
+    for( const auto& [ zone, layer ] : aToFill )
+    {
+        if( !zone->IsOnCopperLayer() )
+            continue;
+
+        ZONE_KNOCKOUT_CACHE_ENTRY& entry = ( *m_knockoutCache )[ { zone->m_Uuid, layer } ];
+        KNOCKOUT_REFILL&           refill = m_knockoutRefills[ { zone, layer } ];
+
+        refill.m_Entry = &entry;
+        refill.m_Incremental = entry.m_Valid
+                                && entry.m_OutlineHash == zone->Outline()->GetHash()
+                                && entry.m_FillHash == aOldHashes[ { zone, layer } ]
+                                && entry.m_WorstClearance == m_worstClearance;
+
+        // Not trustworthy again until this fill completes
+        entry.m_Valid = false;
+
+        if( !refill.m_Incremental || !m_dirtyAreas.count( layer ) )
+            continue;
+
+        BOX2I zoneReach = zone->GetBoundingBox();
+        zoneReach.Inflate( gap );
+
+        for( const BOX2I& dirtyArea : m_dirtyAreas.at( layer ) )
+        {
+            if( !dirtyArea.Intersects( zoneReach ) )
+                continue;
+
+            // Any knockout which changed lies within 'gap' of the item's old or new bbox
+            BOX2I area = dirtyArea;
+            area.Inflate( gap );
+
+            if( area.Contains( zoneReach ) )
+            {
+                refill.m_Incremental = false;
+                break;
+            }
+
+            refill.m_Areas.push_back( area );
+        }
+
+        if( refill.m_Areas.size() > MAX_DIRTY_AREAS )
+        {
+            BOX2I area = refill.m_Areas.front();
+
+            for( const BOX2I& other : refill.m_Areas )
+                area.Merge( other );
+
+            refill.m_Areas = { area };
+        }
+
+        if( !refill.m_Incremental )
+            refill.m_Areas.clear();
+    }
+}
+
+
+std::string ZONE_FILLER::fillCacheKey( const ZONE* aZone, PCB_LAYER_ID aLayer ) const
+{
+    // Same reach as buildCopperItemClearances() and knockoutThermalReliefs()
+    BOX2I reach = aZone->GetBoundingBox();
+    reach.Inflate( worstKnockoutGap() );
+
+    // Higher- or equal-priority zones on other nets are knocked out using their fills (see
+    // check_fill_dependency() in Fill())
+    std::vector<const ZONE*> dependencies;
+
+    for( ZONE* otherZone : m_board->Zones() )
+    {
+        if( otherZone == aZone || otherZone->GetIsRuleArea() || otherZone->GetNumCorners() <= 2 )
+            continue;
+
+        if( !otherZone->GetLayerSet().test( aLayer ) || aZone->HigherPriority( otherZone )
+                || otherZone->SameNet( aZone ) )
+        {
+            continue;
+        }
+
+        if( otherZone->GetBoundingBox().Intersects( reach )
+                && aZone->Outline()->Collide( otherZone->Outline(), m_worstClearance ) )
+        {
+            dependencies.push_back( otherZone );
+        }
+    }
+
+    return m_fillCache->MakeKey( aZone, aLayer, reach, dependencies );
+}
+
+
 /**
  * Fills the given list of zones.
  *
@@ -136,6 +305,29 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         footprint->BuildCourtyardCaches();
     }
 
+    invalidateUnfilledKnockouts( aZones );
+
+    m_fillCache.reset();
+
+    if( m_useFillCache && !m_debugZoneFiller )
+    {
+        wxString cacheDir = ZONE_FILL_CACHE::GetDefaultCacheDir( m_board );
+
+        if( !cacheDir.IsEmpty() )
+            m_fillCache = std::make_unique<ZONE_FILL_CACHE>( cacheDir );
+
+        if( m_fillCache && m_fillCache->IsValid() )
+        {
+            m_fillCache->CleanCacheDir( 30 );
+            m_fillCache->BuildItemDigests( m_board, m_brdOutlinesValid ? &m_boardOutline
+                                                                       : nullptr );
+        }
+        else
+        {
+            m_fillCache.reset();
+        }
+    }
+
     LSET boardCuMask = m_board->GetEnabledLayers() & LSET::AllCuMask();
 
     auto findHighestPriorityZone = [&]( const BOX2I& aBBox, const PCB_LAYER_ID aItemLayer,
@@ -324,6 +516,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         zone->UnFill();
     }
 
+    prepareKnockoutRefills( toFill, oldFillHashes );
+
     auto check_fill_dependency =
             [&]( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone ) -> bool
             {
@@ -366,44 +560,55 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                 return aZone->Outline()->Collide( aOtherZone->Outline(), m_worstClearance );
             };
 
+    auto has_pending_dependency =
+            [&]( ZONE* aZone, PCB_LAYER_ID aLayer ) -> bool
+            {
+                // If our zone needs to be clipped by another zone then we can't fill until that
+                // zone is filled.
+                for( ZONE* otherZone : aZones )
+                {
+                    if( otherZone != aZone && check_fill_dependency( aZone, aLayer, otherZone ) )
+                        return true;
+                }
+
+                return false;
+            };
+
     auto fill_lambda =
             [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
             {
                 PCB_LAYER_ID layer = aFillItem.second;
                 ZONE*        zone = aFillItem.first;
-                bool         canFill = true;
-
-                // Check for any fill dependencies.  If our zone needs to be clipped by
-                // another zone then we can't fill until that zone is filled.
-                for( ZONE* otherZone : aZones )
-                {
-                    if( otherZone == zone )
-                        continue;
-
-                    if( check_fill_dependency( zone, layer, otherZone ) )
-                    {
-                        canFill = false;
-                        break;
-                    }
-                }
 
                 if( m_progressReporter && m_progressReporter->IsCancelled() )
                     return 0;
 
-                if( !canFill )
-                    return 0;
-
                 // Now we're ready to fill.
                 {
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
-
-                    if( !zoneLock.owns_lock() )
-                        return 0;
+                    std::unique_lock<std::mutex> zoneLock( zone->GetLock() );
 
                     SHAPE_POLY_SET fillPolys;
+                    std::string    cacheKey;
 
-                    if( !fillSingleZone( zone, layer, fillPolys ) )
-                        return 0;
+                    if( m_fillCache )
+                        cacheKey = fillCacheKey( zone, layer );
+
+                    if( !cacheKey.empty() && m_fillCache->Load( cacheKey, fillPolys ) )
+                    {
+                        zone->SetNeedRefill( false );
+                    }
+                    else
+                    {
+                        if( !fillSingleZone( zone, layer, fillPolys ) )
+                            return 0;
+
+                        // Don't cache fills which were cut short
+                        if( !cacheKey.empty()
+                                && !( m_progressReporter && m_progressReporter->IsCancelled() ) )
+                        {
+                            m_fillCache->Save( cacheKey, fillPolys );
+                        }
+                    }
 
                     zone->SetFilledPolysList( layer, fillPolys );
                 }
@@ -424,10 +629,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                 ZONE*        zone = aFillItem.first;
 
                 {
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
-
-                    if( !zoneLock.owns_lock() )
-                        return 0;
+                    std::unique_lock<std::mutex> zoneLock( zone->GetLock() );
 
                     zone->CacheTriangulation( layer );
                     zone->SetFillFlag( layer, true );
@@ -438,74 +640,59 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
     // Calculate the copper fills (NB: this is multi-threaded)
     //
-    std::vector<std::pair<std::future<int>, int>> returns;
-    returns.reserve( toFill.size() );
-    size_t finished = 0;
-    bool cancelled = false;
+    // Zone layers which have to wait for the fill of a higher-priority zone are parked, and
+    // requeued whenever a fill completes, so that workers only ever pick up fillable work.
+    CANCELLATION_TOKEN cancelToken(
+            [&]()
+            {
+                return m_progressReporter && m_progressReporter->IsCancelled();
+            } );
 
-    thread_pool& tp = GetKiCadThreadPool();
+    TASK_GROUP                    fillGroup( GetKiCadTaskScheduler(), &cancelToken );
+    std::mutex                    parkedLock;
+    std::vector<size_t>           parked;
+    std::function<void( size_t )> fill_task;
 
-    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
-        returns.emplace_back( std::make_pair( tp.submit( fill_lambda, fillItem ), 0 ) );
+    fill_task =
+            [&]( size_t aIndex )
+            {
+                const std::pair<ZONE*, PCB_LAYER_ID>& fillItem = toFill[aIndex];
 
-    while( !cancelled && finished != 2 * toFill.size() )
-    {
-        for( size_t ii = 0; ii < returns.size(); ++ii )
-        {
-            auto& ret = returns[ii];
+                // Fill flags are only ever set, so once a zone layer has no pending dependency
+                // it never will again.  A pending one must be re-checked under the lock to be
+                // sure it won't complete between the check and our parking.
+                if( has_pending_dependency( fillItem.first, fillItem.second ) )
+                {
+                    std::lock_guard<std::mutex> lock( parkedLock );
 
-            if( ret.second > 1 )
-                continue;
+                    if( has_pending_dependency( fillItem.first, fillItem.second ) )
+                    {
+                        parked.push_back( aIndex );
+                        return;
+                    }
+                }
 
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
+                if( !fill_lambda( fillItem ) || !tesselate_lambda( fillItem ) )
+                    return;
 
-            if( status == std::future_status::ready )
-            {
-                if( ret.first.get() )   // lambda completed
-                {
-                    ++finished;
-                    ret.second++;       // go to next step
-                }
+                std::vector<size_t> ready;
 
-                if( !cancelled )
                 {
-                    // Queue the next step (will re-queue the existing step if it didn't complete)
-                    if( ret.second == 0 )
-                        returns[ii].first = tp.submit( fill_lambda, toFill[ii] );
-                    else if( ret.second == 1 )
-                        returns[ii].first = tp.submit( tesselate_lambda, toFill[ii] );
+                    std::lock_guard<std::mutex> lock( parkedLock );
+                    ready.swap( parked );
                 }
-            }
-        }
 
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                for( size_t ii : ready )
+                    fillGroup.Run( [&fill_task, ii]() { fill_task( ii ); } );
+            };
 
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+        fillGroup.Run( [&fill_task, ii]() { fill_task( ii ); } );
 
+    while( !fillGroup.WaitFor( std::chrono::milliseconds( 100 ) ) )
+    {
         if( m_progressReporter )
-        {
             m_progressReporter->KeepRefreshing();
-
-            if( m_progressReporter->IsCancelled() )
-                cancelled = true;
-        }
-    }
-
-    // Make sure that all futures have finished.
-    // This can happen when the user cancels the above operation
-    for( auto& ret : returns )
-    {
-        if( ret.first.valid() )
-        {
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
-
-            while( status != std::future_status::ready )
-            {
-                if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
-
-                status = ret.first.wait_for( std::chrono::milliseconds( 100 ) );
-            }
-        }
     }
 
     // Now update the connectivity to check for isolated copper islands
@@ -572,7 +759,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             // to allow deleting a polygon from list without breaking the remaining of the list
             std::sort( islands.begin(), islands.end(), std::greater<int>() );
 
-            std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
+            SHAPE_POLY_SET*                 poly = zone->GetFill( layer );
             long long int                   minArea = zone->GetMinIslandArea();
             ISLAND_REMOVAL_MODE             mode = zone->GetIslandRemovalMode();
 
@@ -598,9 +785,9 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
     // Now remove islands which are either outside the board edge or fail to meet the minimum
     // area requirements
-    using island_check_return = std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, int>>;
+    using island_check_return = std::vector<int>;
 
-    std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, double>> polys_to_check;
+    std::vector<std::tuple<ZONE*, PCB_LAYER_ID, double>> polys_to_check;
 
     // rough estimate to save re-allocation time
     polys_to_check.reserve( m_board->GetCopperLayerCount() * aZones.size() );
@@ -619,91 +806,89 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
                 continue;
 
-            polys_to_check.emplace_back( zone->GetFilledPolysList( layer ), minArea );
+            polys_to_check.emplace_back( zone, layer, minArea );
         }
     }
 
+    std::vector<island_check_return> island_results( polys_to_check.size() );
+
     auto island_lambda =
-            [&]( int aStart, int aEnd ) -> island_check_return
+            [&]( size_t aIndex )
             {
-                island_check_return retval;
+                auto [zone, layer, minArea] = polys_to_check[aIndex];
+                std::shared_ptr<const SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
+                island_check_return& retval = island_results[aIndex];
 
-                for( int ii = aStart; ii < aEnd && !cancelled; ++ii )
+                for( int jj = poly->OutlineCount() - 1; jj >= 0; jj-- )
                 {
-                    auto [poly, minArea] = polys_to_check[ii];
+                    SHAPE_POLY_SET island;
+                    SHAPE_POLY_SET intersection;
+                    const SHAPE_LINE_CHAIN& test_poly = poly->Polygon( jj ).front();
+                    double island_area = test_poly.Area();
 
-                    for( int jj = poly->OutlineCount() - 1; jj >= 0; jj-- )
-                    {
-                        SHAPE_POLY_SET island;
-                        SHAPE_POLY_SET intersection;
-                        const SHAPE_LINE_CHAIN& test_poly = poly->Polygon( jj ).front();
-                        double island_area = test_poly.Area();
-
-                        if( island_area < minArea )
-                            continue;
-
-
-                        island.AddOutline( test_poly );
-                        intersection.BooleanIntersection( m_boardOutline, island,
-                                                          SHAPE_POLY_SET::POLYGON_MODE::PM_FAST );
-
-                        // Nominally, all of these areas should be either inside or outside the
-                        // board outline.  So this test should be able to just compare areas (if
-                        // they are equal, you are inside).  But in practice, we sometimes have
-                        // slight overlap at the edges, so testing against half-size area acts as
-                        // a fail-safe.
-                        if( intersection.Area() < island_area / 2.0 )
-                            retval.emplace_back( poly, jj );
-                    }
-                }
-
-                return retval;
-            };
+                    if( island_area < minArea )
+                        continue;
 
-    auto island_returns = tp.parallelize_loop( 0, polys_to_check.size(), island_lambda );
-    cancelled = false;
 
-    // Allow island removal threads to finish
-    for( size_t ii = 0; ii < island_returns.size(); ++ii )
-    {
-        std::future<island_check_return>& ret = island_returns[ii];
+                    island.AddOutline( test_poly );
+                    intersection.BooleanIntersection( m_boardOutline, island,
+                                                      SHAPE_POLY_SET::POLYGON_MODE::PM_FAST );
 
-        if( ret.valid() )
-        {
-            std::future_status status = ret.wait_for( std::chrono::seconds( 0 ) );
+                    // Nominally, all of these areas should be either inside or outside the
+                    // board outline.  So this test should be able to just compare areas (if
+                    // they are equal, you are inside).  But in practice, we sometimes have
+                    // slight overlap at the edges, so testing against half-size area acts as
+                    // a fail-safe.
+                    if( intersection.Area() < island_area / 2.0 )
+                        retval.push_back( jj );
+                }
+            };
 
-            while( status != std::future_status::ready )
-            {
-                if( m_progressReporter )
-                {
-                    m_progressReporter->KeepRefreshing();
+    TASK_GROUP islandGroup( GetKiCadTaskScheduler(), &cancelToken );
 
-                    if( m_progressReporter->IsCancelled() )
-                        cancelled = true;
-                }
+    for( size_t ii = 0; ii < polys_to_check.size(); ++ii )
+        islandGroup.Run( [&island_lambda, ii]() { island_lambda( ii ); } );
 
-                status = ret.wait_for( std::chrono::milliseconds( 100 ) );
-            }
-        }
+    // Allow island removal threads to finish
+    while( !islandGroup.WaitFor( std::chrono::milliseconds( 100 ) ) )
+    {
+        if( m_progressReporter )
+            m_progressReporter->KeepRefreshing();
     }
 
-    if( cancelled )
+    if( cancelToken.IsCancelled() )
         return false;
 
-    for( size_t ii = 0; ii < island_returns.size(); ++ii )
+    for( size_t ii = 0; ii < polys_to_check.size(); ++ii )
     {
-        std::future<island_check_return>& ret = island_returns[ii];
+        if( island_results[ii].empty() )
+            continue;
 
-        if( ret.valid() )
-        {
-            for( auto& action_item : ret.get() )
-                action_item.first->DeletePolygonAndTriangulationData( action_item.second, true );
-        }
+        auto [zone, layer, minArea] = polys_to_check[ii];
+        SHAPE_POLY_SET* poly = zone->GetFill( layer );
+
+        for( int polyIdx : island_results[ii] )
+            poly->DeletePolygonAndTriangulationData( polyIdx, true );
     }
 
     for( ZONE* zone : aZones )
         zone->CalculateFilledArea();
 
+    // Record what the cached knockouts now correspond to.  A later refill will only trust
+    // them if the zone's fill is still this one.
+    for( auto& [ zoneLayer, refill ] : m_knockoutRefills )
+    {
+        const auto& [ zone, layer ] = zoneLayer;
+
+        if( !refill.m_HolesStored )
+            continue;
+
+        refill.m_Entry->m_OutlineHash = zone->Outline()->GetHash();
+        refill.m_Entry->m_FillHash = zone->GetFilledPolysList( layer )->GetHash();
+        refill.m_Entry->m_WorstClearance = m_worstClearance;
+        refill.m_Entry->m_Valid = true;
+    }
+
 
     if( aCheck )
     {
@@ -957,7 +1142,8 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                              const std::vector<PAD*> aNoConnectionPads,
-                                             SHAPE_POLY_SET& aHoles )
+                                             SHAPE_POLY_SET& aHoles,
+                                             const std::vector<BOX2I>& aAreas )
 {
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
     long                   ticker = 0;
@@ -978,6 +1164,27 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     // largest clearance value found in the netclasses and rules
     zone_boundingbox.Inflate( m_worstClearance + extra_margin );
 
+    // When rebuilding only some areas, skip items whose knockouts can't reach any of them
+    int knockoutGap = worstKnockoutGap();
+
+    auto reachesArea =
+            [&]( const BOX2I& aItemBBox ) -> bool
+            {
+                if( aAreas.empty() )
+                    return true;
+
+                BOX2I reach = aItemBBox;
+                reach.Inflate( knockoutGap );
+
+                for( const BOX2I& area : aAreas )
+                {
+                    if( area.Intersects( reach ) )
+                        return true;
+                }
+
+                return false;
+            };
+
     auto evalRulesForItems =
             [&bds]( DRC_CONSTRAINT_T aConstraint, const BOARD_ITEM* a, const BOARD_ITEM* b,
                     PCB_LAYER_ID aEvalLayer ) -> int
@@ -1028,6 +1235,9 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
         if( checkForCancel( m_progressReporter ) )
             return;
 
+        if( !reachesArea( pad->GetBoundingBox() ) )
+            continue;
+
         knockoutPadClearance( pad );
     }
 
@@ -1036,7 +1246,8 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     auto knockoutTrackClearance =
             [&]( PCB_TRACK* aTrack )
             {
-                if( aTrack->GetBoundingBox().Intersects( zone_boundingbox ) )
+                if( aTrack->GetBoundingBox().Intersects( zone_boundingbox )
+                        && reachesArea( aTrack->GetBoundingBox() ) )
                 {
                     bool sameNet = aTrack->GetNetCode() == aZone->GetNetCode()
                                         && aZone->GetNetCode() != 0;
@@ -1121,7 +1332,8 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                         || aItem->IsOnLayer( Edge_Cuts )
                         || aItem->IsOnLayer( Margin ) )
                 {
-                    if( aItem->GetBoundingBox().Intersects( zone_boundingbox ) )
+                    if( aItem->GetBoundingBox().Intersects( zone_boundingbox )
+                            && reachesArea( aItem->GetBoundingBox() ) )
                     {
                         bool ignoreLineWidths = false;
                         int  gap = evalRulesForItems( PHYSICAL_CLEARANCE_CONSTRAINT,
@@ -1226,7 +1438,8 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                 if( !aKnockout->GetLayerSet().test( aLayer ) )
                     return;
 
-                if( aKnockout->GetBoundingBox().Intersects( zone_boundingbox ) )
+                if( aKnockout->GetBoundingBox().Intersects( zone_boundingbox )
+                        && reachesArea( aKnockout->GetBoundingBox() ) )
                 {
                     if( aKnockout->GetIsRuleArea() )
                     {
@@ -1295,6 +1508,67 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
 }
 
 
+/**
+ * Builds the clearance holes for a zone layer.  For an incremental refill the cached holes are
+ * kept outside the dirty areas, and only the items reaching into those areas are knocked out
+ * again.  Unchanged items whose knockouts reach into a dirty area are knocked out in full, so
+ * the union is identical to a full rebuild.
+ */
+void ZONE_FILLER::buildCachedCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                                   const std::vector<PAD*> aNoConnectionPads,
+                                                   SHAPE_POLY_SET& aHoles )
+{
+    auto it = m_knockoutRefills.find( { aZone, aLayer } );
+
+    if( it == m_knockoutRefills.end() )
+    {
+        buildCopperItemClearances( aZone, aLayer, aNoConnectionPads, aHoles );
+        return;
+    }
+
+    KNOCKOUT_REFILL& refill = it->second;
+
+    if( !refill.m_Incremental )
+    {
+        buildCopperItemClearances( aZone, aLayer, aNoConnectionPads, aHoles );
+    }
+    else if( refill.m_Areas.empty() )
+    {
+        // Nothing changed near this zone layer
+        aHoles = refill.m_Entry->m_Holes;
+    }
+    else
+    {
+        SHAPE_POLY_SET dirtyAreas;
+        SHAPE_POLY_SET freshHoles;
+
+        for( const BOX2I& area : refill.m_Areas )
+        {
+            dirtyAreas.NewOutline();
+            dirtyAreas.Append( area.GetLeft(), area.GetTop() );
+            dirtyAreas.Append( area.GetRight(), area.GetTop() );
+            dirtyAreas.Append( area.GetRight(), area.GetBottom() );
+            dirtyAreas.Append( area.GetLeft(), area.GetBottom() );
+        }
+
+        dirtyAreas.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+        buildCopperItemClearances( aZone, aLayer, aNoConnectionPads, freshHoles, refill.m_Areas );
+
+        aHoles = refill.m_Entry->m_Holes;
+        aHoles.BooleanSubtract( dirtyAreas, SHAPE_POLY_SET::PM_FAST );
+        aHoles.BooleanAdd( freshHoles, SHAPE_POLY_SET::PM_FAST );
+    }
+
+    // Holes are incomplete if we were cancelled part way through
+    if( m_progressReporter && m_progressReporter->IsCancelled() )
+        return;
+
+    refill.m_Entry->m_Holes = aHoles;
+    refill.m_HolesStored = true;
+}
+
+
 /**
  * Removes the outlines of higher-proirity zones with the same net.  These zones should be
  * in charge of the fill parameters within their own outlines.
@@ -1424,7 +1698,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout electrical clearances.
      */
 
-    buildCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles );
+    buildCachedCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles );
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, wxT( "clearance-holes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1511,7 +1785,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    aFillPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aFillPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In8_Cu, wxT( "after-spoke-trimming" ) );
 
     /* -------------------------------------------------------------------------------------
@@ -1519,7 +1793,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      */
 
     if( half_min_width - epsilon > epsilon )
-        aFillPolys.Deflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
+        aFillPolys.DeflateTiled( half_min_width - epsilon, fastCornerStrategy, m_maxError );
 
     // Min-thickness is the web thickness.  On the other hand, a blob min-thickness by
     // min-thickness is not useful.  Since there's no obvious definition of web vs. blob, we
@@ -1580,7 +1854,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
 
     aFillPolys.BooleanIntersection( aMaxExtents, SHAPE_POLY_SET::PM_FAST );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In16_Cu, wxT( "after-trim-to-outline" ) );
-    aFillPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aFillPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In17_Cu, wxT( "after-trim-to-clearance-holes" ) );
 
     /* -------------------------------------------------------------------------------------
@@ -1644,7 +1918,7 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
     }
 
     aFillPolys = aSmoothedOutline;
-    aFillPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aFillPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
 
     for( ZONE* keepout : m_board->Zones() )
     {
@@ -1664,7 +1938,8 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
     int half_min_width = aZone->GetMinThickness() / 2;
     int epsilon = pcbIUScale.mmToIU( 0.001 );
 
-    aFillPolys.Deflate( half_min_width - epsilon, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError );
+    aFillPolys.DeflateTiled( half_min_width - epsilon, CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
+                             m_maxError );
 
     // Remove the non filled areas due to the hatch pattern
     if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
@@ -1675,7 +1950,8 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
 
     // Re-inflate after pruning of areas that don't meet minimum-width criteria
     if( half_min_width - epsilon > epsilon )
-        aFillPolys.Inflate( half_min_width - epsilon, CORNER_STRATEGY::ROUND_ALL_CORNERS, m_maxError );
+        aFillPolys.InflateTiled( half_min_width - epsilon, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                 m_maxError );
 
     aFillPolys.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
     return true;
@@ -26,6 +26,8 @@
 #ifndef ZONE_FILLER_H
 #define ZONE_FILLER_H
 
+#include <map>
+#include <memory>
 #include <vector>
 #include <zone.h>
 
@@ -34,6 +36,26 @@ class BOARD;
 class COMMIT;
 class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
+class ZONE_FILL_CACHE;
+
+
+/**
+ * The copper-item clearance knockouts built for a single zone layer by a previous fill.
+ *
+ * An incremental refill only rebuilds the knockouts inside the areas dirtied by a commit and
+ * reuses the rest.  An entry is only trusted if the zone outline, the worst clearance and the
+ * zone's fill are still those it was built for (the latter catches undo/redo).
+ */
+struct ZONE_KNOCKOUT_CACHE_ENTRY
+{
+    bool           m_Valid = false;
+    MD5_HASH       m_OutlineHash;
+    MD5_HASH       m_FillHash;
+    int            m_WorstClearance = 0;
+    SHAPE_POLY_SET m_Holes;
+};
+
+typedef std::map<std::pair<KIID, PCB_LAYER_ID>, ZONE_KNOCKOUT_CACHE_ENTRY> ZONE_KNOCKOUT_CACHE;
 
 
 class ZONE_FILLER
@@ -59,7 +81,50 @@ public:
 
     bool IsDebug() const { return m_debugZoneFiller; }
 
+    /**
+     * Enable incremental refilling.
+     *
+     * Zone layers with a valid entry in \a aCache only rebuild their copper-item knockouts
+     * around \a aDirtyAreas (the before and after bounding boxes of the items changed since the
+     * last fill, per layer); everything else is reused from the cache.  The cache is updated
+     * with the knockouts of every copper zone layer filled, and the entries of the zones not
+     * filled which \a aDirtyAreas reach are invalidated.
+     */
+    void SetKnockoutCache( ZONE_KNOCKOUT_CACHE* aCache,
+                           const std::map<PCB_LAYER_ID, std::vector<BOX2I>>& aDirtyAreas );
+
+    /**
+     * Use (or not) the on-disk fill cache next to the board file.  Fills whose inputs are
+     * identical to a previous fill are then loaded instead of computed.  Defaults to the
+     * ZoneFillDiskCache advanced config setting.
+     */
+    void SetUseFillCache( bool aUse ) { m_useFillCache = aUse; }
+
 private:
+    /**
+     * @return the on-disk fill cache key for \a aZone on \a aLayer.  Must only be called once
+     *         the zones \a aZone depends on have been filled.
+     */
+    std::string fillCacheKey( const ZONE* aZone, PCB_LAYER_ID aLayer ) const;
+
+    /**
+     * Per zone layer state of an incremental refill, prepared before the fill threads start so
+     * that each thread only touches its own cache entry.
+     */
+    struct KNOCKOUT_REFILL
+    {
+        ZONE_KNOCKOUT_CACHE_ENTRY* m_Entry = nullptr;
+        bool                       m_Incremental = false;
+        bool                       m_HolesStored = false;
+        std::vector<BOX2I>         m_Areas;        // dirty areas, inflated by the worst gap
+    };
+
+    void invalidateUnfilledKnockouts( const std::vector<ZONE*>& aZones );
+
+    void prepareKnockoutRefills( const std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& aToFill,
+                                 std::map<std::pair<ZONE*, PCB_LAYER_ID>, MD5_HASH>& aOldHashes );
+
+    int worstKnockoutGap() const;
 
     void addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_POLY_SET& aHoles );
 
@@ -72,9 +137,23 @@ private:
                                  std::vector<PAD*>& aThermalConnectionPads,
                                  std::vector<PAD*>& aNoConnectionPads );
 
+    /**
+     * Build the clearance holes of the copper items which share \a aLayer with \a aZone but
+     * are not connected to it.  If \a aAreas is not empty only items whose knockouts can
+     * reach into one of the areas are processed.
+     */
     void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                     const std::vector<PAD*> aNoConnectionPads,
-                                    SHAPE_POLY_SET& aHoles );
+                                    SHAPE_POLY_SET& aHoles,
+                                    const std::vector<BOX2I>& aAreas = {} );
+
+    /**
+     * Build the clearance holes for \a aZone on \a aLayer, reusing the cached knockouts
+     * outside the dirty areas when an incremental refill is possible.
+     */
+    void buildCachedCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                          const std::vector<PAD*> aNoConnectionPads,
+                                          SHAPE_POLY_SET& aHoles );
 
     void subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                       SHAPE_POLY_SET& aRawFill );
@@ -138,6 +217,13 @@ private:
     int                   m_worstClearance;
 
     bool                  m_debugZoneFiller;
+
+    ZONE_KNOCKOUT_CACHE*  m_knockoutCache;
+    std::map<PCB_LAYER_ID, std::vector<BOX2I>> m_dirtyAreas;
+    std::map<std::pair<const ZONE*, PCB_LAYER_ID>, KNOCKOUT_REFILL> m_knockoutRefills;
+
+    bool                             m_useFillCache;
+    std::unique_ptr<ZONE_FILL_CACHE> m_fillCache;
 };
 
 #endif
@@ -49,6 +49,18 @@ BOOST_AUTO_TEST_CASE( Seeding )
 }
 
 
+BOOST_AUTO_TEST_CASE( AsChars )
+{
+    for( int ii = 0; ii < 100; ++ii )
+    {
+        KIID kiid;
+        char buf[36];
+
+        BOOST_CHECK_EQUAL( std::string( buf, kiid.AsChars( buf ) ), kiid.AsString().ToStdString() );
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE( KiidPathTest )
 {
     KIID a, b, c, d;
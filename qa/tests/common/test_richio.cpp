@@ -28,7 +28,17 @@
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include <base_units.h>
+#include <eda_units.h>
+#include <locale_io.h>
+
 // Code under test
+#include <dsnlexer.h>
 #include <richio.h>
 
 /**
@@ -74,4 +84,171 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+
+static const std::string s_sexpr = "(kicad_pcb (version 20240108)\n"
+                                   "  (general (thickness 1.6) (legacy_teardrops no))\n"
+                                   "\r\n"
+                                   "  (net 1 \"/a \\\"quoted\\\" \\x41\\101 name\")\n"
+                                   "  (layers 0x00f +12 -3.5e2)\n"
+                                   "  (end \"\\x\" \"\\7\")\n"
+                                   ")";
+
+
+/**
+ * Check a #MAPPED_FILE_LINE_READER reads the same lines as a #STRING_LINE_READER, both
+ * copied and as views.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReader )
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "richio_mapped_tst.txt";
+
+    {
+        std::ofstream out( path, std::ios::binary );
+        out << s_sexpr;
+    }
+
+    STRING_LINE_READER      expected( s_sexpr, wxT( "string" ) );
+    MAPPED_FILE_LINE_READER copied( path.string() );
+    MAPPED_FILE_LINE_READER viewed( path.string() );
+    std::string_view        view;
+
+    BOOST_CHECK_EQUAL( copied.FileLength(), s_sexpr.size() );
+
+    while( expected.ReadLine() )
+    {
+        BOOST_REQUIRE( copied.ReadLine() );
+        BOOST_CHECK_EQUAL( std::string( copied.Line() ), std::string( expected.Line() ) );
+
+        BOOST_REQUIRE( viewed.ReadLineView( view ) );
+        BOOST_CHECK_EQUAL( view, std::string_view( expected.Line() ) );
+        BOOST_CHECK_EQUAL( viewed.LineNumber(), expected.LineNumber() );
+    }
+
+    BOOST_CHECK( !copied.ReadLine() );
+    BOOST_CHECK( viewed.ReadLineView( view ) && view.empty() );
+
+    viewed.Rewind();
+    BOOST_CHECK( viewed.ReadLineView( view ) );
+    BOOST_CHECK_EQUAL( viewed.LineNumber(), 1u );
+
+    std::filesystem::remove( path );
+}
+
+
+/**
+ * Check a #DSNLEXER tokenizes lines read as views exactly like copied lines.
+ */
+BOOST_AUTO_TEST_CASE( DsnLexerOverViews )
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "dsnlexer_mapped_tst.txt";
+
+    {
+        std::ofstream out( path, std::ios::binary );
+        out << s_sexpr;
+    }
+
+    STRING_LINE_READER      stringReader( s_sexpr, wxT( "string" ) );
+    MAPPED_FILE_LINE_READER mappedReader( path.string() );
+    DSNLEXER                expected( nullptr, 0, nullptr, &stringReader );
+    DSNLEXER                actual( nullptr, 0, nullptr, &mappedReader );
+    int                     tok;
+
+    do
+    {
+        tok = expected.NextTok();
+
+        BOOST_REQUIRE_EQUAL( actual.NextTok(), tok );
+        BOOST_CHECK_EQUAL( actual.CurStr(), expected.CurStr() );
+        BOOST_CHECK_EQUAL( actual.CurStrView(), expected.CurStrView() );
+        BOOST_CHECK_EQUAL( actual.CurLineNumber(), expected.CurLineNumber() );
+        BOOST_CHECK_EQUAL( actual.CurOffset(), expected.CurOffset() );
+
+        if( tok != DSN_EOF )
+            BOOST_CHECK_EQUAL( std::string( actual.CurLine() ), std::string( expected.CurLine() ) );
+
+    } while( tok != DSN_EOF );
+
+    std::filesystem::remove( path );
+}
+
+/**
+ * The floating point conversion FormatInternalUnits() used before switching to fixed point.
+ */
+static std::string formatIUReference( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    char   buf[64];
+    double engUnits = aValue / aIuScale.IU_PER_MM;
+
+    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+    {
+        snprintf( buf, sizeof( buf ), "%.10f", engUnits );
+
+        std::string str( buf );
+
+        while( str.back() == '0' )
+            str.pop_back();
+
+        if( str.back() == '.' )
+            str.pop_back();
+
+        return str;
+    }
+
+    snprintf( buf, sizeof( buf ), "%.10g", engUnits );
+    return buf;
+}
+
+
+/**
+ * Check the typed OUTPUTFORMATTER methods write exactly what Print() would.
+ */
+BOOST_AUTO_TEST_CASE( AppendMatchesPrint )
+{
+    LOCALE_IO toggle;
+
+    const std::vector<int> values = { 0, 1, -1, 9, 10, 99, 100, 101, 1000, 12345, -350000,
+                                      1000000, 1234567, -1234567, 25400000, 123456789,
+                                      std::numeric_limits<int>::max(),
+                                      std::numeric_limits<int>::min() };
+
+    for( const EDA_IU_SCALE& scale : { pcbIUScale, schIUScale, gerbIUScale, drawSheetIUScale,
+                                       unityScale, EDA_IU_SCALE( 25.4 ) } )
+    {
+        for( int value : values )
+        {
+            STRING_FORMATTER appended;
+            STRING_FORMATTER printed;
+
+            appended.AppendIndent( 2 );
+            appended.Append( "(xy " );
+            appended.AppendIU( scale, VECTOR2I( value, -( value / 3 ) ) );
+            appended.Append( ") " );
+            appended.AppendInt( value );
+
+            printed.Print( 2, "(xy %s) %d",
+                           EDA_UNIT_UTILS::FormatInternalUnits( scale,
+                                                      VECTOR2I( value, -( value / 3 ) ) ).c_str(),
+                           value );
+
+            BOOST_CHECK_EQUAL( appended.GetString(), printed.GetString() );
+            BOOST_CHECK_EQUAL( EDA_UNIT_UTILS::FormatInternalUnits( scale, value ),
+                               formatIUReference( scale, value ) );
+        }
+    }
+
+    for( const wxString& text : { wxString( wxS( "" ) ), wxString( wxS( "plain" ) ),
+                                  wxString( wxS( "a \"quoted\"\r\n\\ name" ) ),
+                                  wxString::FromUTF8( "\xc2\xb5\xc3\xa9 \\" ) } )
+    {
+        STRING_FORMATTER appended;
+        STRING_FORMATTER printed;
+
+        appended.AppendQuoted( text );
+        printed.Print( 0, "%s", printed.Quotew( text ).c_str() );
+
+        BOOST_CHECK_EQUAL( appended.GetString(), printed.GetString() );
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <core/sharded_cache.h>
+#include <core/task_scheduler.h>
+
+
+BOOST_AUTO_TEST_SUITE( ShardedCache )
+
+
+BOOST_AUTO_TEST_CASE( FindInsertClear )
+{
+    SHARDED_CACHE<int, int> cache;
+    int                     value = -1;
+
+    BOOST_CHECK( cache.Empty() );
+    BOOST_CHECK( !cache.Find( 1, value ) );
+    BOOST_CHECK_EQUAL( value, -1 );
+
+    cache.Insert( 1, 10 );
+    cache.Insert( 2, 20 );
+    cache.Insert( 1, 11 );
+
+    BOOST_CHECK( !cache.Empty() );
+    BOOST_CHECK( cache.Find( 1, value ) );
+    BOOST_CHECK_EQUAL( value, 11 );
+    BOOST_CHECK( cache.Find( 2, value ) );
+    BOOST_CHECK_EQUAL( value, 20 );
+
+    SHARDED_CACHE<int, int>::STATS stats = cache.GetStats();
+
+    BOOST_CHECK_EQUAL( stats.m_Lookups, 3 );
+    BOOST_CHECK_EQUAL( stats.m_Hits, 2 );
+
+    cache.Clear();
+
+    BOOST_CHECK( cache.Empty() );
+    BOOST_CHECK( !cache.Find( 1, value ) );
+
+    cache.ResetStats();
+
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Lookups, 0 );
+}
+
+
+/**
+ * FindOrInsert() must only build a value for a key that isn't cached yet
+ */
+BOOST_AUTO_TEST_CASE( FindOrInsert )
+{
+    SHARDED_CACHE<int, int> cache;
+    int                     builds = 0;
+
+    auto build =
+            [&]()
+            {
+                builds++;
+                return 42;
+            };
+
+    BOOST_CHECK_EQUAL( cache.FindOrInsert( 1, build ), 42 );
+    BOOST_CHECK_EQUAL( cache.FindOrInsert( 1, build ), 42 );
+    BOOST_CHECK_EQUAL( builds, 1 );
+
+    cache.Clear();
+
+    BOOST_CHECK_EQUAL( cache.FindOrInsert( 1, build ), 42 );
+    BOOST_CHECK_EQUAL( builds, 2 );
+}
+
+
+/**
+ * Concurrent lookups and insertions of overlapping keys must always see consistent values
+ */
+BOOST_AUTO_TEST_CASE( Concurrent )
+{
+    TASK_SCHEDULER          scheduler( 4 );
+    SHARDED_CACHE<int, int> cache;
+    std::atomic<int>        bad( 0 );
+
+    ParallelFor( scheduler, 0, 100000,
+                 [&]( size_t ii )
+                 {
+                     int key = (int) ( ii % 1000 );
+                     int value;
+
+                     if( !cache.Find( key, value ) )
+                         cache.Insert( key, key * 2 );
+                     else if( value != key * 2 )
+                         bad.fetch_add( 1 );
+                 } );
+
+    BOOST_CHECK_EQUAL( bad.load(), 0 );
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Lookups, 100000 );
+
+    for( int key = 0; key < 1000; ++key )
+    {
+        int value = -1;
+
+        BOOST_CHECK( cache.Find( key, value ) );
+        BOOST_CHECK_EQUAL( value, key * 2 );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,210 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <core/task_scheduler.h>
+
+#include <stdexcept>
+
+
+BOOST_AUTO_TEST_SUITE( TaskScheduler )
+
+
+/**
+ * Every index of a parallel loop is visited exactly once
+ */
+BOOST_AUTO_TEST_CASE( ParallelForVisitsAll )
+{
+    TASK_SCHEDULER                scheduler( 4 );
+    std::vector<std::atomic<int>> visits( 10000 );
+
+    ParallelFor( scheduler, 0, visits.size(),
+                 [&]( size_t ii )
+                 {
+                     visits[ii].fetch_add( 1 );
+                 } );
+
+    for( const std::atomic<int>& count : visits )
+        BOOST_REQUIRE_EQUAL( count.load(), 1 );
+}
+
+
+/**
+ * Nested loops must complete even when there are fewer workers than waiting tasks
+ */
+BOOST_AUTO_TEST_CASE( NestedParallelFor )
+{
+    for( unsigned threads : { 1, 2, 4 } )
+    {
+        BOOST_TEST_CONTEXT( threads << " threads" )
+        {
+            TASK_SCHEDULER   scheduler( threads );
+            std::atomic<int> count( 0 );
+
+            ParallelFor( scheduler, 0, 20,
+                         [&]( size_t )
+                         {
+                             ParallelFor( scheduler, 0, 20,
+                                          [&]( size_t )
+                                          {
+                                              ParallelFor( scheduler, 0, 5,
+                                                           [&]( size_t )
+                                                           {
+                                                               count.fetch_add( 1 );
+                                                           } );
+                                          } );
+                         } );
+
+            BOOST_CHECK_EQUAL( count.load(), 20 * 20 * 5 );
+        }
+    }
+}
+
+
+/**
+ * A limited loop visits every index once and never runs more iterations at a time than allowed
+ */
+BOOST_AUTO_TEST_CASE( ParallelForLimitedConcurrency )
+{
+    TASK_SCHEDULER scheduler( 8 );
+
+    for( unsigned limit : { 0, 1, 3 } )
+    {
+        BOOST_TEST_CONTEXT( "limit " << limit )
+        {
+            std::vector<std::atomic<int>> visits( 200 );
+            std::atomic<unsigned>         running( 0 );
+            std::atomic<unsigned>         maxRunning( 0 );
+
+            ParallelForLimited( scheduler, 0, visits.size(), limit,
+                                [&]( size_t ii )
+                                {
+                                    unsigned now = ++running;
+                                    unsigned seen = maxRunning.load();
+
+                                    while( now > seen
+                                           && !maxRunning.compare_exchange_weak( seen, now ) )
+                                    {
+                                    }
+
+                                    std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+                                    visits[ii].fetch_add( 1 );
+                                    --running;
+                                } );
+
+            for( const std::atomic<int>& count : visits )
+                BOOST_REQUIRE_EQUAL( count.load(), 1 );
+
+            BOOST_CHECK_LE( maxRunning.load(), limit ? limit : scheduler.GetThreadCount() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( Cancellation )
+{
+    TASK_SCHEDULER     scheduler( 2 );
+    std::atomic<int>   count( 0 );
+    CANCELLATION_TOKEN token;
+
+    TASK_GROUP group( scheduler, &token );
+
+    token.Cancel();
+
+    for( int ii = 0; ii < 100; ++ii )
+        group.Run( [&]() { count.fetch_add( 1 ); } );
+
+    group.Wait();
+
+    BOOST_CHECK_EQUAL( count.load(), 0 );
+
+    // A polled source cancels the remainder of a loop
+    CANCELLATION_TOKEN polled( [&]() { return count.load() >= 10; } );
+
+    ParallelFor( scheduler, 0, 100000,
+                 [&]( size_t )
+                 {
+                     count.fetch_add( 1 );
+                 },
+                 1, &polled );
+
+    BOOST_CHECK( polled.IsCancelled() );
+    BOOST_CHECK_LT( count.load(), 100000 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ExceptionPropagation )
+{
+    TASK_SCHEDULER scheduler( 3 );
+
+    BOOST_CHECK_THROW( ParallelFor( scheduler, 0, 1000,
+                                    []( size_t ii )
+                                    {
+                                        if( ii == 500 )
+                                            throw std::runtime_error( "task failed" );
+                                    } ),
+                       std::runtime_error );
+
+    // The scheduler is still usable afterwards
+    std::atomic<int> count( 0 );
+    TASK_GROUP       group( scheduler );
+
+    for( int ii = 0; ii < 10; ++ii )
+        group.Run( [&]() { count.fetch_add( 1 ); } );
+
+    while( !group.WaitFor( std::chrono::milliseconds( 10 ) ) )
+        ;
+
+    BOOST_CHECK_EQUAL( count.load(), 10 );
+}
+
+
+/**
+ * A worker polling a group with WaitFor() must run the group's tasks rather than starve them
+ */
+BOOST_AUTO_TEST_CASE( WaitForFromWorker )
+{
+    TASK_SCHEDULER   scheduler( 1 );
+    std::atomic<int> count( 0 );
+    TASK_GROUP       outer( scheduler );
+
+    outer.Run(
+            [&]()
+            {
+                TASK_GROUP inner( scheduler );
+
+                for( int ii = 0; ii < 10; ++ii )
+                    inner.Run( [&]() { count.fetch_add( 1 ); } );
+
+                while( !inner.WaitFor( std::chrono::milliseconds( 10 ) ) )
+                    ;
+            } );
+
+    outer.Wait();
+
+    BOOST_CHECK_EQUAL( count.load(), 10 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,7 +20,11 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include "eeschema_test_utils.h"
 
+#include <advanced_config.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
 #include <sch_sheet_path.h>
+#include <sch_symbol.h>
 #include <wildcards_and_files_ext.h>
 
 class TEST_SCH_SHEET_LIST_FIXTURE : public KI_TEST::SCHEMATIC_TEST_FIXTURE
@@ -162,4 +166,72 @@ BOOST_AUTO_TEST_CASE( TestEditPageNumbersInSharedDesign )
     }
 }
 
+
+BOOST_AUTO_TEST_CASE( TestSharedSheetsLoadedOnce )
+{
+    // The sub-sheet files may be parsed in parallel, but each file must still be loaded once
+    // and its screen shared by every sheet using it.
+    LoadSchematic( "complex_hierarchy_shared/complex_hierarchy" );
+
+    SCH_SHEET_LIST sheets = m_schematic.GetSheets();
+    SCH_SCREENS    screens( m_schematic.Root() );
+
+    BOOST_CHECK_EQUAL( sheets.size(), 5 );
+    BOOST_CHECK_EQUAL( screens.GetCount(), 3 );
+
+    for( const SCH_SHEET_PATH& path : sheets )
+    {
+        SCH_SHEET* sheet = path.Last();
+
+        BOOST_REQUIRE( sheet->GetScreen() );
+        BOOST_CHECK_EQUAL( wxFileName( sheet->GetScreen()->GetFileName() ).GetFullName(),
+                           wxFileName( sheet->GetFileName() ).GetFullName() );
+
+        for( const SCH_SHEET_PATH& other : sheets )
+        {
+            if( other.Last()->GetFileName() == sheet->GetFileName() )
+                BOOST_CHECK( other.LastScreen() == path.LastScreen() );
+        }
+    }
+
+    // The hierarchy and the instance data must be those of a serial load
+    auto describe =
+            [&]()
+            {
+                std::vector<wxString> desc;
+
+                for( const SCH_SHEET_PATH& path : m_schematic.GetSheets() )
+                {
+                    desc.push_back( path.Path().AsString() + wxS( " " )
+                                    + path.PathHumanReadable( false ) + wxS( " " )
+                                    + path.GetPageNumber() + wxS( " " )
+                                    + path.LastScreen()->GetFileName() );
+
+                    for( SCH_ITEM* item : path.LastScreen()->Items().OfType( SCH_SYMBOL_T ) )
+                    {
+                        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+                        desc.push_back( symbol->m_Uuid.AsString() + wxS( " " )
+                                        + symbol->GetRef( &path, true ) );
+                    }
+                }
+
+                return desc;
+            };
+
+    std::vector<wxString> parallelDesc = describe();
+
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    bool          wasParallel = cfg.m_ParallelSchematicLoad;
+
+    cfg.m_ParallelSchematicLoad = false;
+    LoadSchematic( "complex_hierarchy_shared/complex_hierarchy" );
+    cfg.m_ParallelSchematicLoad = wasParallel;
+
+    std::vector<wxString> serialDesc = describe();
+
+    BOOST_CHECK_EQUAL_COLLECTIONS( parallelDesc.begin(), parallelDesc.end(), serialDesc.begin(),
+                                   serialDesc.end() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,243 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <limits>
+#include <random>
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_circle.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_simple.h>
+
+
+/**
+ * A random walk of \a aCount points, longer than a block of SEG_BATCH.
+ */
+static SHAPE_LINE_CHAIN randomWalk( int aCount, bool aClosed )
+{
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> step( -30000, 30000 );
+    SHAPE_LINE_CHAIN                   chain;
+    VECTOR2I                           pt( 0, 0 );
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        chain.Append( pt, true );
+        pt += VECTOR2I( step( rng ), step( rng ) );
+    }
+
+    chain.SetClosed( aClosed );
+
+    return chain;
+}
+
+
+BOOST_AUTO_TEST_SUITE( SegBatch )
+
+
+/**
+ * Query() must visit, in order, exactly the segments whose bounding box intersects the query
+ * box, including the closing segment of closed chains.
+ */
+BOOST_AUTO_TEST_CASE( QueryMatchesBoundingBoxes )
+{
+    for( bool closed : { false, true } )
+    {
+        SHAPE_LINE_CHAIN chain = randomWalk( 300, closed );
+
+        for( int x = -200000; x <= 200000; x += 25000 )
+        {
+            VECTOR2I boxMin, boxMax;
+
+            SEG_BATCH::InflateBox( VECTOR2I( x, x / 2 ), VECTOR2I( x + 10000, x / 2 ), 20000,
+                                   boxMin, boxMax );
+
+            BOX2I box( boxMin, boxMax - boxMin );
+            std::vector<int> expected;
+            std::vector<int> visited;
+
+            for( int ii = 0; ii < chain.SegmentCount(); ++ii )
+            {
+                const SEG& seg = chain.CSegment( ii );
+                BOX2I      segBox( seg.A, seg.B - seg.A );
+
+                segBox.Normalize();
+
+                if( segBox.Intersects( box ) )
+                    expected.push_back( ii );
+            }
+
+            SEG_BATCH::Query( chain.CPoints(), chain.IsClosed(), boxMin, boxMax,
+                              [&]( int aSegment )
+                              {
+                                  visited.push_back( aSegment );
+                                  return true;
+                              } );
+
+            BOOST_CHECK( visited == expected );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( InflateBoxClamps )
+{
+    VECTOR2I boxMin, boxMax;
+
+    SEG_BATCH::InflateBox( VECTOR2I( std::numeric_limits<int>::min() + 5, 0 ),
+                           VECTOR2I( std::numeric_limits<int>::max() - 5, 0 ), 100,
+                           boxMin, boxMax );
+
+    BOOST_CHECK_EQUAL( boxMin, VECTOR2I( std::numeric_limits<int>::min(), -101 ) );
+    BOOST_CHECK_EQUAL( boxMax, VECTOR2I( std::numeric_limits<int>::max(), 101 ) );
+}
+
+
+/**
+ * Screening the segments of line chains and simple polygons must not change the collisions
+ * found against them.
+ */
+BOOST_AUTO_TEST_CASE( CollisionsMatchSegments )
+{
+    SHAPE_LINE_CHAIN chain = randomWalk( 200, true );
+    SHAPE_SIMPLE     simple( chain );
+
+    for( int x = -300000; x <= 300000; x += 7000 )
+    {
+        SHAPE_CIRCLE circle( VECTOR2I( x, -x / 3 ), 15000 );
+
+        bool expected = chain.PointInside( circle.GetCenter() );
+        int  expectedActual = expected ? 0 : std::numeric_limits<int>::max();
+
+        for( int ii = 0; ii < chain.SegmentCount(); ++ii )
+        {
+            int actual;
+
+            if( circle.Collide( chain.CSegment( ii ), 5000, &actual ) )
+            {
+                expected = true;
+                expectedActual = std::min( expectedActual, actual );
+            }
+        }
+
+        for( const SHAPE* shape : { static_cast<const SHAPE*>( &chain ),
+                                    static_cast<const SHAPE*>( &simple ) } )
+        {
+            int actual = -1;
+
+            BOOST_CHECK_EQUAL( shape->Collide( &circle, 5000, &actual ), expected );
+
+            if( expected )
+                BOOST_CHECK_EQUAL( actual, expectedActual );
+        }
+    }
+}
+
+
+/**
+ * A segment spanning the coordinate range must not overflow its search box.
+ */
+BOOST_AUTO_TEST_CASE( InflateBoxWideSegment )
+{
+    const int        big = std::numeric_limits<int>::max() - 10;
+    SEG              seg( VECTOR2I( -big, -big ), VECTOR2I( big, big ) );
+    SHAPE_LINE_CHAIN chain( { VECTOR2I( -1000, 1000 ), VECTOR2I( 1000, -1000 ) } );
+    VECTOR2I         boxMin, boxMax;
+
+    SEG_BATCH::InflateBox( seg, 100, boxMin, boxMax );
+
+    BOOST_CHECK_EQUAL( boxMin, VECTOR2I( std::numeric_limits<int>::min(),
+                                         std::numeric_limits<int>::min() ) );
+    BOOST_CHECK_EQUAL( boxMax, VECTOR2I( std::numeric_limits<int>::max(),
+                                         std::numeric_limits<int>::max() ) );
+    BOOST_CHECK( chain.Collide( seg, 0 ) );
+}
+
+
+/**
+ * The searches of packed segments must find what testing each of them finds.
+ */
+BOOST_AUTO_TEST_CASE( PackedSearchesMatchLinear )
+{
+    SHAPE_LINE_CHAIN chain = randomWalk( 300, false );
+    std::vector<SEG> segs;
+
+    for( int ii = 0; ii < chain.SegmentCount(); ++ii )
+        segs.push_back( chain.CSegment( ii ) );
+
+    for( int x = -300000; x <= 300000; x += 9000 )
+    {
+        SEG query( VECTOR2I( x, -x / 3 ), VECTOR2I( x + 20000, -x / 3 + 5000 ) );
+
+        for( int clearance : { 0, 4000, -4000 } )
+        {
+            int expected = -1;
+            int expectedActual = -1;
+            int actual = -1;
+
+            for( int ii = 0; ii < (int) segs.size() && expected < 0; ++ii )
+            {
+                if( segs[ii].Collide( query, clearance, &expectedActual ) )
+                    expected = ii;
+            }
+
+            BOOST_CHECK_EQUAL( SEG_BATCH::FirstHit( segs.data(), (int) segs.size(), query,
+                                                    clearance, &actual ),
+                               expected );
+
+            if( expected >= 0 )
+                BOOST_CHECK_EQUAL( actual, expectedActual );
+        }
+
+        SEG::ecoord expectedSeg = VECTOR2I::ECOORD_MAX;
+        SEG::ecoord expectedPt = VECTOR2I::ECOORD_MAX;
+
+        for( const SEG& seg : segs )
+        {
+            expectedSeg = std::min( expectedSeg, seg.SquaredDistance( query ) );
+            expectedPt = std::min( expectedPt, seg.SquaredDistance( query.A ) );
+        }
+
+        int index = -1;
+
+        BOOST_CHECK_EQUAL( SEG_BATCH::MinSquaredDistance( segs.data(), (int) segs.size(), query,
+                                                          &index ),
+                           expectedSeg );
+        BOOST_CHECK_EQUAL( segs[index].SquaredDistance( query ), expectedSeg );
+
+        BOOST_CHECK_EQUAL( SEG_BATCH::MinSquaredDistance( segs.data(), (int) segs.size(),
+                                                          query.A ),
+                           expectedPt );
+    }
+
+    int index = 0;
+
+    BOOST_CHECK_EQUAL( SEG_BATCH::MinSquaredDistance( segs.data(), 0, VECTOR2I(), &index ),
+                       VECTOR2I::ECOORD_MAX );
+    BOOST_CHECK_EQUAL( index, -1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
 #include <trigo.h>
@@ -514,4 +515,96 @@ BOOST_AUTO_TEST_CASE( ReplaceChain )
 }
 
 
+/**
+ * A closed, wavy outline with enough segments to be indexed.
+ */
+static SHAPE_LINE_CHAIN wavyOutline( int aCount )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        EDA_ANGLE angle = FULL_CIRCLE * ii / aCount;
+        double    radius = 1000000.0 * ( 1.0 + 0.2 * ( angle * 7 ).Sin() );
+
+        chain.Append( VECTOR2I( KiROUND( radius * angle.Cos() ),
+                                KiROUND( radius * angle.Sin() ) ) );
+    }
+
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+// The segment index of long chains must give the same results as searching them linearly
+BOOST_AUTO_TEST_CASE( EdgeIndexMatchesLinear )
+{
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    int           oldMinSegments = cfg.m_LineChainIndexMinSegments;
+
+    std::vector<VECTOR2I> points;
+
+    for( int x = -1300000; x <= 1300000; x += 21000 )
+    {
+        for( int y = -1300000; y <= 1300000; y += 23000 )
+            points.emplace_back( x, y );
+    }
+
+    auto collisions =
+            []( const SHAPE_LINE_CHAIN& aChain, const std::vector<VECTOR2I>& aPoints )
+            {
+                std::vector<int> results;
+
+                for( const VECTOR2I& pt : aPoints )
+                {
+                    int actual = -1;
+
+                    results.push_back( aChain.PointInside( pt ) );
+                    results.push_back( aChain.PointInside( pt, 10000 ) );
+                    results.push_back( aChain.Collide( pt, 10000, &actual ) );
+                    results.push_back( actual );
+                    results.push_back( aChain.Collide( SEG( pt, pt + VECTOR2I( 40000, -15000 ) ),
+                                                       5000 ) );
+                }
+
+                return results;
+            };
+
+    SHAPE_LINE_CHAIN chain = wavyOutline( 500 );
+
+    cfg.m_LineChainIndexMinSegments = std::numeric_limits<int>::max();
+    std::vector<int> expected = collisions( chain, points );
+
+    // Each chain reads the setting once, so the indexed searches need a chain of their own
+    cfg.m_LineChainIndexMinSegments = 0;
+    SHAPE_LINE_CHAIN indexed( chain );
+    BOOST_CHECK( collisions( indexed, points ) == expected );
+
+    // Collide() squares the clearance, so a negative one must still find what a search of
+    // every segment finds
+    for( const VECTOR2I& pt : points )
+    {
+        SEG seg( pt, pt + VECTOR2I( 40000, -15000 ) );
+
+        BOOST_CHECK_EQUAL( indexed.Collide( pt, -10000 ),
+                           indexed.SHAPE_LINE_CHAIN_BASE::Collide( pt, -10000 ) );
+        BOOST_CHECK_EQUAL( indexed.Collide( seg, -5000 ),
+                           indexed.SHAPE_LINE_CHAIN_BASE::Collide( seg, -5000 ) );
+    }
+
+    // The index must be dropped when the chain changes
+    chain.SetPoint( 100, VECTOR2I( 0, 0 ) );
+    indexed.SetPoint( 100, VECTOR2I( 0, 0 ) );
+
+    cfg.m_LineChainIndexMinSegments = std::numeric_limits<int>::max();
+    expected = collisions( chain, points );
+
+    cfg.m_LineChainIndexMinSegments = 0;
+    BOOST_CHECK( collisions( indexed, points ) == expected );
+
+    cfg.m_LineChainIndexMinSegments = oldMinSegments;
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
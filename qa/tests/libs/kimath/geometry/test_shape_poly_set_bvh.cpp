@@ -0,0 +1,201 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_rect.h>
+#include <geometry/shape_simple.h>
+
+
+/**
+ * A poly set large enough to be indexed: a plate perforated with a grid of square holes, and
+ * an island inside one of the holes.
+ */
+static SHAPE_POLY_SET perforatedPlate()
+{
+    SHAPE_POLY_SET plate;
+
+    plate.NewOutline();
+    plate.Append( 0, 0 );
+    plate.Append( 1000, 0 );
+    plate.Append( 1000, 1000 );
+    plate.Append( 0, 1000 );
+
+    for( int x = 50; x < 950; x += 100 )
+    {
+        for( int y = 50; y < 950; y += 100 )
+        {
+            SHAPE_LINE_CHAIN hole;
+
+            hole.Append( x, y );
+            hole.Append( x + 50, y );
+            hole.Append( x + 50, y + 50 );
+            hole.Append( x, y + 50 );
+            hole.SetClosed( true );
+            plate.AddHole( hole );
+        }
+    }
+
+    plate.NewOutline();
+    plate.Append( 160, 160 );
+    plate.Append( 190, 160 );
+    plate.Append( 175, 190 );
+
+    return plate;
+}
+
+
+BOOST_AUTO_TEST_SUITE( ShapePolySetBVH )
+
+
+/**
+ * Contains() using the edge index built by BuildBBoxCaches() must give the same answers as the
+ * plain test, including for points on or close to edges and vertices.
+ */
+BOOST_AUTO_TEST_CASE( ContainsMatchesLinear )
+{
+    SHAPE_POLY_SET plate = perforatedPlate();
+
+    plate.BuildBBoxCaches();
+
+    for( int accuracy : { 0, 1, 3 } )
+    {
+        for( int x = -5; x <= 1005; x += 5 )
+        {
+            for( int y = -5; y <= 1005; y += 5 )
+            {
+                VECTOR2I pt( x, y );
+
+                BOOST_TEST_CONTEXT( "pt " << x << "," << y << " accuracy " << accuracy )
+                {
+                    BOOST_CHECK_EQUAL( plate.Contains( pt, -1, accuracy, true ),
+                                       plate.Contains( pt, -1, accuracy, false ) );
+                    BOOST_CHECK_EQUAL( plate.Contains( pt, 1, accuracy, true ),
+                                       plate.Contains( pt, 1, accuracy, false ) );
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Collide() only tests the triangles the BVH finds near the shape; the result must match a
+ * test against every triangle.
+ */
+BOOST_AUTO_TEST_CASE( CollideMatchesAllTriangles )
+{
+    SHAPE_POLY_SET plate = perforatedPlate();
+
+    plate.CacheTriangulation( false );
+
+    auto collideAll =
+            [&]( const SHAPE* aShape, int aClearance, int* aActual )
+            {
+                bool collided = false;
+
+                *aActual = INT_MAX;
+
+                for( unsigned ii = 0; ii < plate.TriangulatedPolyCount(); ++ii )
+                {
+                    for( const auto& tri : plate.TriangulatedPolygon( ii )->Triangles() )
+                    {
+                        int actual;
+
+                        if( aShape->Collide( &tri, aClearance, &actual ) )
+                        {
+                            collided = true;
+                            *aActual = std::min( *aActual, actual );
+                        }
+                    }
+                }
+
+                return collided;
+            };
+
+    for( int x = -40; x <= 1000; x += 35 )
+    {
+        for( int y = -40; y <= 1000; y += 35 )
+        {
+            SHAPE_RECT   rect( VECTOR2I( x, y ), 20, 20 );
+            SHAPE_SIMPLE triangle;
+
+            triangle.Append( x, y );
+            triangle.Append( x + 20, y + 5 );
+            triangle.Append( x + 5, y + 20 );
+
+            for( const SHAPE* shape : std::initializer_list<const SHAPE*>{ &rect, &triangle } )
+            {
+                for( int clearance : { 0, 10 } )
+                {
+                    BOOST_TEST_CONTEXT( "shape at " << x << "," << y << " clearance "
+                                                    << clearance )
+                    {
+                        int  expectedActual;
+                        int  actual = -1;
+                        bool expected = collideAll( shape, clearance, &expectedActual );
+
+                        BOOST_CHECK_EQUAL( plate.Collide( shape, clearance ), expected );
+                        BOOST_CHECK_EQUAL( plate.Collide( shape, clearance, &actual ), expected );
+
+                        if( expected )
+                            BOOST_CHECK_EQUAL( actual, std::max( 0, expectedActual ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * The BVH is rebuilt when the polygons change.
+ */
+BOOST_AUTO_TEST_CASE( RebuiltAfterEdit )
+{
+    SHAPE_POLY_SET plate = perforatedPlate();
+    SHAPE_RECT     rect( VECTOR2I( 2000, 2000 ), 20, 20 );
+
+    BOOST_CHECK( !plate.Collide( &rect ) );
+
+    plate.Move( VECTOR2I( 1500, 1500 ) );
+
+    BOOST_CHECK( plate.Collide( &rect ) );
+
+    plate.BuildBBoxCaches();
+    BOOST_CHECK( plate.Contains( VECTOR2I( 2010, 2010 ), -1, 0, true ) );
+
+    plate.Move( VECTOR2I( -1500, -1500 ) );
+    plate.BuildBBoxCaches();
+    BOOST_CHECK( !plate.Contains( VECTOR2I( 2010, 2010 ), -1, 0, true ) );
+
+    // Editing an outline directly doesn't reset the index, but BuildBBoxCaches() must
+    plate.Outline( 0 ).Move( VECTOR2I( 1500, 1500 ) );
+    plate.BuildBBoxCaches();
+    BOOST_CHECK( plate.Contains( VECTOR2I( 2010, 2010 ), -1, 0, true ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,300 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <advanced_config.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+
+/**
+ * Make every operation on more than a few hundred vertices tiled.
+ */
+struct TILED_FIXTURE
+{
+    TILED_FIXTURE() :
+            m_cfg( const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() ) ),
+            m_oldTileVertices( m_cfg.m_PolygonTileVertices )
+    {
+        m_cfg.m_PolygonTileVertices = 100;
+    }
+
+    ~TILED_FIXTURE() { m_cfg.m_PolygonTileVertices = m_oldTileVertices; }
+
+    ADVANCED_CFG& m_cfg;
+    int           m_oldTileVertices;
+};
+
+
+/**
+ * A wavy copper pour with a slot cut out of it.
+ */
+static SHAPE_POLY_SET pour()
+{
+    SHAPE_POLY_SET pour;
+
+    pour.NewOutline();
+
+    for( int ii = 0; ii < 200; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / 200;
+        double radius = 40000000.0 * ( 1.0 + 0.1 * std::sin( 5.0 * angle ) );
+
+        pour.Append( KiROUND( radius * std::cos( angle ) ), KiROUND( radius * std::sin( angle ) ) );
+    }
+
+    SHAPE_LINE_CHAIN slot;
+
+    slot.Append( -20000000, -1000000 );
+    slot.Append( 20000000, -3000000 );
+    slot.Append( 20000000, 1000000 );
+    slot.Append( -20000000, 3000000 );
+    slot.SetClosed( true );
+    pour.AddHole( slot );
+
+    return pour;
+}
+
+
+/**
+ * Clearance holes around random pads, many of them overlapping each other or the edges of the
+ * pour, and a few long diagonal tracks crossing all the tiles.
+ */
+static SHAPE_POLY_SET clearances()
+{
+    SHAPE_POLY_SET                     holes;
+    std::mt19937                       rng( 7 );
+    std::uniform_int_distribution<int> coord( -48000000, 48000000 );
+    std::uniform_int_distribution<int> radius( 200000, 2000000 );
+
+    for( int ii = 0; ii < 300; ++ii )
+    {
+        TransformCircleToPolygon( holes, VECTOR2I( coord( rng ), coord( rng ) ), radius( rng ),
+                                  5000, ERROR_OUTSIDE );
+    }
+
+    for( int ii = 0; ii < 5; ++ii )
+    {
+        TransformOvalToPolygon( holes, VECTOR2I( coord( rng ), coord( rng ) ),
+                                VECTOR2I( coord( rng ), coord( rng ) ), 500000, 5000,
+                                ERROR_OUTSIDE );
+    }
+
+    return holes;
+}
+
+
+static int holeCount( const SHAPE_POLY_SET& aPolySet )
+{
+    int count = 0;
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ++ii )
+        count += aPolySet.HoleCount( ii );
+
+    return count;
+}
+
+
+/**
+ * The tiled result must cover the same area.  Intersections on edges crossing tile boundaries
+ * are found from the part of the edge within each tile, and may be a unit off, so the areas may
+ * only differ by slivers along these edges.
+ */
+static void checkSameArea( const SHAPE_POLY_SET& aTiled, const SHAPE_POLY_SET& aPlain )
+{
+    BOOST_REQUIRE_GT( aPlain.OutlineCount(), 0 );
+
+    SHAPE_POLY_SET diff;
+
+    diff.BooleanXor( aTiled, aPlain, SHAPE_POLY_SET::PM_FAST );
+    diff.Deflate( 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, 1 );
+
+    BOOST_CHECK_EQUAL( diff.OutlineCount(), 0 );
+}
+
+
+/**
+ * The tiled result must have the same outlines and holes, merged across the tile boundaries.
+ */
+static void checkSameTopology( const SHAPE_POLY_SET& aTiled, const SHAPE_POLY_SET& aPlain )
+{
+    BOOST_CHECK_EQUAL( aTiled.OutlineCount(), aPlain.OutlineCount() );
+    BOOST_CHECK_EQUAL( holeCount( aTiled ), holeCount( aPlain ) );
+}
+
+
+static void checkSame( const SHAPE_POLY_SET& aTiled, const SHAPE_POLY_SET& aPlain )
+{
+    checkSameArea( aTiled, aPlain );
+    checkSameTopology( aTiled, aPlain );
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( ShapePolySetTiled, TILED_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( BooleansMatchUntiled )
+{
+    SHAPE_POLY_SET holes = clearances();
+
+    SHAPE_POLY_SET plain = pour();
+    SHAPE_POLY_SET tiled = pour();
+
+    plain.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+    tiled.BooleanSubtractTiled( holes, SHAPE_POLY_SET::PM_FAST );
+    checkSame( tiled, plain );
+
+    plain = pour();
+    tiled = pour();
+    plain.BooleanAdd( holes, SHAPE_POLY_SET::PM_FAST );
+    tiled.BooleanAddTiled( holes, SHAPE_POLY_SET::PM_FAST );
+    checkSame( tiled, plain );
+
+    plain = pour();
+    tiled = pour();
+    plain.BooleanIntersection( holes, SHAPE_POLY_SET::PM_FAST );
+    tiled.BooleanIntersectionTiled( holes, SHAPE_POLY_SET::PM_FAST );
+    checkSame( tiled, plain );
+
+    plain = holes;
+    tiled = holes;
+    plain.Simplify( SHAPE_POLY_SET::PM_FAST );
+    tiled.SimplifyTiled( SHAPE_POLY_SET::PM_FAST );
+    checkSame( tiled, plain );
+}
+
+
+BOOST_AUTO_TEST_CASE( OffsetsMatchUntiled )
+{
+    SHAPE_POLY_SET fill = pour();
+
+    fill.BooleanSubtract( clearances(), SHAPE_POLY_SET::PM_FAST );
+
+    for( CORNER_STRATEGY strategy : { CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                      CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
+                                      CORNER_STRATEGY::ALLOW_ACUTE_CORNERS } )
+    {
+        for( int amount : { 250000, -250000 } )
+        {
+            SHAPE_POLY_SET plain = fill;
+            SHAPE_POLY_SET tiled = fill;
+
+            plain.Inflate( amount, strategy, 5000 );
+            tiled.InflateTiled( amount, strategy, 5000 );
+            checkSameArea( tiled, plain );
+
+            // The long miter spikes of acute corners nearly touch other holes here.  Whether
+            // they connect comes down to the rounding of a unit.
+            if( strategy != CORNER_STRATEGY::ALLOW_ACUTE_CORNERS )
+                checkSameTopology( tiled, plain );
+        }
+    }
+}
+
+
+/**
+ * Edges crossing the tile boundaries must come out as they went in.  Without intersections
+ * between the pour and the holes, that's the same vertices as the untiled result.
+ */
+BOOST_AUTO_TEST_CASE( SeamsAreExact )
+{
+    SHAPE_POLY_SET holes;
+
+    for( int x = -30000000; x <= 30000000; x += 3000000 )
+    {
+        for( int y = -30000000; y <= 30000000; y += 3000000 )
+        {
+            if( std::abs( y ) > 5000000 && std::hypot( x, y ) < 32000000 )
+            {
+                TransformCircleToPolygon( holes, VECTOR2I( x + 123457, y + 76543 ), 1000000,
+                                          5000, ERROR_OUTSIDE );
+            }
+        }
+    }
+
+    SHAPE_POLY_SET plain = pour();
+    SHAPE_POLY_SET tiled = pour();
+
+    plain.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+    tiled.BooleanSubtractTiled( holes, SHAPE_POLY_SET::PM_FAST );
+    checkSameTopology( tiled, plain );
+
+    auto vertices =
+            []( const SHAPE_POLY_SET& aPolySet )
+            {
+                std::vector<VECTOR2I> points;
+
+                for( auto it = aPolySet.CIterateWithHoles(); it; it++ )
+                    points.push_back( *it );
+
+                std::sort( points.begin(), points.end(),
+                           []( const VECTOR2I& aLhs, const VECTOR2I& aRhs )
+                           {
+                               return LexicographicalCompare( aLhs, aRhs ) < 0;
+                           } );
+
+                return points;
+            };
+
+    BOOST_CHECK( vertices( tiled ) == vertices( plain ) );
+}
+
+
+/**
+ * Small operations, and empty results, fall back to (or match) the untiled ones.
+ */
+BOOST_AUTO_TEST_CASE( Degenerate )
+{
+    SHAPE_POLY_SET square;
+
+    square.NewOutline();
+    square.Append( 0, 0 );
+    square.Append( 1000, 0 );
+    square.Append( 1000, 1000 );
+    square.Append( 0, 1000 );
+
+    SHAPE_POLY_SET result = square;
+
+    result.BooleanSubtractTiled( square, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_EQUAL( result.OutlineCount(), 0 );
+
+    SHAPE_POLY_SET far = pour();
+
+    far.Move( VECTOR2I( 200000000, 0 ) );
+    result = pour();
+    result.BooleanIntersectionTiled( far, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_EQUAL( result.OutlineCount(), 0 );
+
+    result = pour();
+    result.BooleanSubtractTiled( far, SHAPE_POLY_SET::PM_FAST );
+    checkSame( result, pour() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <board.h>
+#include <richio.h>
+#include <settings/settings_manager.h>
+#include <string_utf8_map.h>
+#include <pcb_io/ipc2581/ipc2581_xml_writer.h>
+#include <pcb_io/ipc2581/pcb_io_ipc2581.h>
+
+#include <wx/filename.h>
+#include <wx/xml/xml.h>
+
+
+struct IPC2581_EXPORT_FIXTURE
+{
+    IPC2581_EXPORT_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+static wxXmlNode* findChild( wxXmlNode* aParent, const wxString& aName )
+{
+    for( wxXmlNode* child = aParent->GetChildren(); child; child = child->GetNext() )
+    {
+        if( child->GetName() == aName )
+            return child;
+    }
+
+    return nullptr;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( Ipc2581Export, IPC2581_EXPORT_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( XmlWriterEscapes )
+{
+    wxXmlNode parent( wxXML_ELEMENT_NODE, "Parent" );
+    wxXmlNode* child = new wxXmlNode( &parent, wxXML_ELEMENT_NODE, "Child" );
+
+    child->AddAttribute( "name", wxS( "a<b & \"c\"\n" ) );
+    parent.AddAttribute( "units", "MILLIMETER" );
+
+    STRING_FORMATTER   formatter;
+    IPC2581_XML_WRITER writer( formatter, 1 );
+
+    writer.WriteNode( &parent );
+
+    BOOST_CHECK_EQUAL( formatter.GetString(),
+                       "  <Parent units=\"MILLIMETER\">\n"
+                       "    <Child name=\"a&lt;b &amp; &quot;c&quot;&#xA;\"/>\n"
+                       "  </Parent>\n" );
+}
+
+
+/**
+ * The layer features are written to a separate file while the rest of the document is built,
+ * and copied in at the end of the Step.  The result must be a well formed document with the
+ * Step's children in their usual order and the dictionaries filled in.
+ */
+BOOST_AUTO_TEST_CASE( StreamedLayerFeatures )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    wxString        path = wxFileName::CreateTempFileName( wxS( "qa_ipc2581" ) );
+    STRING_UTF8_MAP props;
+    PCB_IO_IPC2581  io;
+
+    io.SaveBoard( path, m_board.get(), &props );
+
+    wxXmlDocument doc;
+    bool          loaded = doc.Load( path );
+
+    wxRemoveFile( path );
+    BOOST_REQUIRE( loaded );
+
+    wxXmlNode* root = doc.GetRoot();
+    wxXmlNode* content = findChild( root, "Content" );
+    wxXmlNode* ecad = findChild( root, "Ecad" );
+
+    BOOST_REQUIRE( content && ecad );
+
+    wxXmlNode* cadData = findChild( ecad, "CadData" );
+    BOOST_REQUIRE( cadData );
+
+    wxXmlNode* step = findChild( cadData, "Step" );
+    BOOST_REQUIRE( step );
+
+    wxXmlNode* lineDict = findChild( content, "DictionaryLineDesc" );
+    BOOST_REQUIRE( lineDict );
+    BOOST_CHECK( lineDict->GetChildren() != nullptr );
+
+    int  components = 0;
+    int  layerFeatures = 0;
+    bool inFeatures = false;
+
+    for( wxXmlNode* child = step->GetChildren(); child; child = child->GetNext() )
+    {
+        if( child->GetName() == "LayerFeature" )
+        {
+            inFeatures = true;
+            layerFeatures++;
+        }
+        else
+        {
+            BOOST_CHECK_MESSAGE( !inFeatures, child->GetName() << " after the layer features" );
+
+            if( child->GetName() == "Component" )
+                components++;
+        }
+    }
+
+    BOOST_CHECK_EQUAL( components, (int) m_board->Footprints().size() );
+    BOOST_CHECK_GT( layerFeatures, 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -307,4 +307,34 @@ BOOST_AUTO_TEST_CASE( FlipUpDown )
 }
 
 
+/**
+ * Check that a footprint is recognized as a translation of its copy only when it was moved
+ * as a whole, as the undo list then stores only its position.
+ */
+BOOST_AUTO_TEST_CASE( FootprintTranslation )
+{
+    FOOTPRINT footprint( &m_board );
+    PAD*      pad = new PAD( &footprint );
+
+    pad->SetPosition( VECTOR2I( pcbIUScale.mmToIU( 1 ), 0 ) );
+    footprint.Add( pad );
+
+    auto copy = std::unique_ptr<FOOTPRINT>( static_cast<FOOTPRINT*>( footprint.Clone() ) );
+
+    BOOST_CHECK( footprint.IsTranslationOf( *copy ) );
+
+    footprint.Move( VECTOR2I( pcbIUScale.mmToIU( 10 ), pcbIUScale.mmToIU( -5 ) ) );
+    BOOST_CHECK( footprint.IsTranslationOf( *copy ) );
+
+    footprint.Rotate( footprint.GetPosition(), ANGLE_90 );
+    BOOST_CHECK( !footprint.IsTranslationOf( *copy ) );
+
+    footprint.Rotate( footprint.GetPosition(), -ANGLE_90 );
+    BOOST_CHECK( footprint.IsTranslationOf( *copy ) );
+
+    pad->Move( VECTOR2I( pcbIUScale.mmToIU( 1 ), 0 ) );
+    BOOST_CHECK( !footprint.IsTranslationOf( *copy ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -181,4 +181,103 @@ BOOST_AUTO_TEST_CASE( IntrospectedProperties )
     }
 }
 
+
+/**
+ * Only expressions depending on nothing but the types and nets of the items may have their
+ * results memoized by the DRC engine.
+ */
+BOOST_AUTO_TEST_CASE( MemoizableExpressions )
+{
+    PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
+    propMgr.Rebuild();
+
+    const std::vector<std::pair<wxString, bool>> expressions = {
+        { "A.NetClass == 'HV'", true },
+        { "A.NetClass == 'HV' && B.NetClass != 'HV'", true },
+        { "A.Type == 'Via' || A.NetName == '/GND'", true },
+        { "A.Width > 1mm", false },
+        { "A.NetClass == 'HV' && A.layer == 'F.Cu'", false },
+        { "A.NetClass == 'HV' && A.intersectsArea('zone')", false },
+        { "AB.isCoupledDiffPair()", false }
+    };
+
+    for( const auto& [ expr, memoizable ] : expressions )
+    {
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+        BOOST_TEST_MESSAGE( "Expr: '" << expr.c_str() << "'" );
+
+        BOOST_CHECK( compiler.Compile( expr, &ucode, &preflightContext ) );
+        BOOST_CHECK_EQUAL( ucode.IsMemoizable(), memoizable );
+    }
+}
+
+/**
+ * Constant sub-expressions are folded at compile time and && / || skip their second operand
+ * when the first already decides the result.
+ */
+BOOST_AUTO_TEST_CASE( OptimizedUCode )
+{
+    PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
+    propMgr.Rebuild();
+
+    auto countOps =
+            []( const PCBEXPR_UCODE& aUcode, const wxString& aMnemonic )
+            {
+                wxArrayString lines = wxSplit( aUcode.Dump(), '\n' );
+                int           count = 0;
+
+                for( const wxString& line : lines )
+                {
+                    if( line.StartsWith( aMnemonic ) )
+                        count++;
+                }
+
+                return count;
+            };
+
+    {
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+        PCBEXPR_CONTEXT  context( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+        BOOST_CHECK( compiler.Compile( "(1mm + 2mm) * 2 > 5mm", &ucode, &preflightContext ) );
+        BOOST_CHECK_EQUAL( ucode.Dump(), wxString( "PUSH NUM [1.0000000000]\n" ) );
+        BOOST_CHECK_EQUAL( ucode.Run( &context )->AsDouble(), 1.0 );
+    }
+
+    BOARD     brd;
+    PCB_TRACK trackA( &brd );
+    PCB_TRACK trackB( &brd );
+
+    trackA.SetWidth( pcbIUScale.MilsToIU( 10 ) );
+    trackB.SetWidth( pcbIUScale.MilsToIU( 20 ) );
+
+    const std::vector<std::pair<wxString, double>> expressions = {
+        { "A.intersectsArea('x') && A.Type == 'Via'", 0.0 },
+        { "A.isMicroVia() || A.Width < B.Width", 1.0 },
+        { "A.Type == 'Track' && (B.Width > 15mil || B.isMicroVia()) && !A.isMicroVia()", 1.0 },
+        { "A.Width + 10mil == B.Width && (1 || A.isBlindBuriedVia())", 1.0 }
+    };
+
+    for( const auto& [ expr, expected ] : expressions )
+    {
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+        PCBEXPR_CONTEXT  context( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+        BOOST_TEST_MESSAGE( "Expr: '" << expr.c_str() << "'" );
+
+        context.SetItems( &trackA, &trackB );
+
+        BOOST_CHECK( compiler.Compile( expr, &ucode, &preflightContext ) );
+        BOOST_CHECK( countOps( ucode, wxS( "JUMP IF" ) ) > 0 );
+        BOOST_CHECK_EQUAL( ucode.Run( &context )->AsDouble(), expected );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <footprint.h>
+#include <richio.h>
+#include <zone.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+
+
+BOOST_AUTO_TEST_SUITE( ParallelBoardLoad )
+
+
+static std::unique_ptr<BOARD> parseBoard( LINE_READER& aReader )
+{
+    PCB_IO_KICAD_SEXPR_PARSER parser( &aReader, nullptr, nullptr );
+
+    return std::unique_ptr<BOARD>( static_cast<BOARD*>( parser.Parse() ) );
+}
+
+
+static std::string formatBoard( const BOARD& aBoard )
+{
+    PCB_IO_KICAD_SEXPR io;
+
+    io.Format( &aBoard );
+    return io.GetStringOutput( true );
+}
+
+
+/**
+ * Boards parsed from a mapped file (footprints and zones on worker threads) must be identical
+ * to those parsed line by line, down to the order of their items.
+ */
+BOOST_AUTO_TEST_CASE( MatchesSerialLoad )
+{
+    for( const wxString& name : { "complex_hierarchy", "intersectingzones", "issue14412" } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            wxString path = KI_TEST::GetPcbnewTestDataDir() + name + ".kicad_pcb";
+
+            FILE_LINE_READER        serialReader( path );
+            MAPPED_FILE_LINE_READER parallelReader( path );
+
+            std::unique_ptr<BOARD> serial = parseBoard( serialReader );
+            std::unique_ptr<BOARD> parallel = parseBoard( parallelReader );
+
+            BOOST_REQUIRE( serial && parallel );
+            BOOST_REQUIRE_EQUAL( serial->Footprints().size(), parallel->Footprints().size() );
+            BOOST_REQUIRE_EQUAL( serial->Zones().size(), parallel->Zones().size() );
+
+            for( size_t ii = 0; ii < serial->Footprints().size(); ++ii )
+            {
+                BOOST_CHECK( serial->Footprints()[ii]->m_Uuid
+                             == parallel->Footprints()[ii]->m_Uuid );
+            }
+
+            for( size_t ii = 0; ii < serial->Zones().size(); ++ii )
+                BOOST_CHECK( serial->Zones()[ii]->m_Uuid == parallel->Zones()[ii]->m_Uuid );
+
+            BOOST_CHECK( formatBoard( *serial ) == formatBoard( *parallel ) );
+        }
+    }
+}
+
+
+/**
+ * Footprints, tracks and zones are formatted in chunks on worker threads; the chunks must be
+ * output in order so that saving gives the serial output and round-trips.
+ */
+BOOST_AUTO_TEST_CASE( FormatIsDeterministic )
+{
+    wxString path = KI_TEST::GetPcbnewTestDataDir() + "complex_hierarchy.kicad_pcb";
+
+    FILE_LINE_READER       reader( path );
+    std::unique_ptr<BOARD> board = parseBoard( reader );
+
+    BOOST_REQUIRE( board );
+
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    bool          wasParallel = cfg.m_ParallelBoardSave;
+
+    cfg.m_ParallelBoardSave = false;
+    std::string serial = formatBoard( *board );
+
+    cfg.m_ParallelBoardSave = true;
+    std::string first = formatBoard( *board );
+
+    cfg.m_ParallelBoardSave = wasParallel;
+
+    BOOST_CHECK( first == serial );
+    BOOST_CHECK( formatBoard( *board ) == first );
+
+    STRING_LINE_READER     savedReader( first, wxT( "saved board" ) );
+    std::unique_ptr<BOARD> reloaded = parseBoard( savedReader );
+
+    BOOST_REQUIRE( reloaded );
+    BOOST_CHECK( formatBoard( *reloaded ) == first );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
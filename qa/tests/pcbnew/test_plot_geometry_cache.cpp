@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <locale_io.h>
+#include <pcb_plot_params.h>
+#include <pcbplot.h>
+#include <plot_geometry_cache.h>
+#include <plotters/plotter.h>
+#include <settings/settings_manager.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+
+
+struct PLOT_GEOMETRY_CACHE_FIXTURE
+{
+    PLOT_GEOMETRY_CACHE_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    /**
+     * Plot \a aLayer to a Gerber file and return its content, without the lines holding the
+     * creation date.
+     */
+    wxString PlotLayer( PCB_LAYER_ID aLayer )
+    {
+        wxString        path = wxFileName::CreateTempFileName( wxS( "qa_plot_cache" ) );
+        PCB_PLOT_PARAMS plotOpts;
+        LOCALE_IO       toggle;
+
+        plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+        plotOpts.SetLayerSelection( LSET( aLayer ) );
+
+        PLOTTER* plotter = StartPlotBoard( m_board.get(), &plotOpts, aLayer, path, wxEmptyString,
+                                           wxEmptyString );
+
+        BOOST_REQUIRE( plotter );
+
+        PlotBoardLayers( m_board.get(), plotter, { aLayer }, plotOpts );
+        plotter->EndPlot();
+        delete plotter;
+
+        wxFFile  file( path );
+        wxString content;
+        wxString result;
+
+        BOOST_REQUIRE( file.ReadAll( &content ) );
+        file.Close();
+        wxRemoveFile( path );
+
+        wxStringTokenizer tokenizer( content, wxS( "\n" ) );
+
+        while( tokenizer.HasMoreTokens() )
+        {
+            wxString line = tokenizer.GetNextToken();
+
+            if( !line.Contains( wxS( "CreationDate" ) ) && !line.Contains( wxS( " date " ) ) )
+                result << line << wxS( "\n" );
+        }
+
+        return result;
+    }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PlotGeometryCache, PLOT_GEOMETRY_CACHE_FIXTURE )
+
+
+/**
+ * The cache must not change the plots: the layers plotted without it, with an empty cache and
+ * with the geometry left in the cache by the first pass must be identical.
+ */
+BOOST_AUTO_TEST_CASE( SameOutputWithAndWithoutCache )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue6039", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    // Go through the merged solder mask areas too
+    m_board->GetDesignSettings().m_SolderMaskMinWidth = pcbIUScale.mmToIU( 0.1 );
+
+    const std::vector<PCB_LAYER_ID> layers = { F_Cu, B_Cu, F_Mask, B_Mask, F_Paste, F_SilkS };
+    std::vector<wxString>           uncached;
+
+    for( PCB_LAYER_ID layer : layers )
+        uncached.push_back( PlotLayer( layer ) );
+
+    PLOT_GEOMETRY_CACHE_SCOPE plotCache( m_board.get() );
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        for( size_t ii = 0; ii < layers.size(); ++ii )
+        {
+            wxString layerName = m_board->GetLayerName( layers[ii] );
+
+            BOOST_TEST_CONTEXT( "Pass " << pass << ", layer " << layerName )
+            {
+                BOOST_CHECK( PlotLayer( layers[ii] ) == uncached[ii] );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,165 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <advanced_config.h>
+#include <board.h>
+#include <board_commit.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_data.h>
+#include <ratsnest/ratsnest_data.h>
+#include <settings/settings_manager.h>
+#include <tool/tool_manager.h>
+
+
+struct RATSNEST_TEST_FIXTURE
+{
+    RATSNEST_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+/**
+ * Check that the ratsnest of each net is a spanning tree as short as the one computed from
+ * scratch (the edges themselves may differ between equally long trees).
+ */
+static void checkMatchesFreshRatsnest( BOARD* aBoard )
+{
+    std::shared_ptr<CONNECTIVITY_DATA> current = aBoard->GetConnectivity();
+    std::shared_ptr<CONNECTIVITY_DATA> fresh = std::make_shared<CONNECTIVITY_DATA>();
+
+    fresh->Build( aBoard );
+    fresh->RecalculateRatsnest();
+
+    BOOST_REQUIRE_EQUAL( current->GetNetCount(), fresh->GetNetCount() );
+
+    for( int net = 1; net < current->GetNetCount(); ++net )
+    {
+        BOOST_TEST_CONTEXT( "net " << net )
+        {
+            const std::vector<CN_EDGE>& edges = current->GetRatsnestForNet( net )->GetEdges();
+            const std::vector<CN_EDGE>& expected = fresh->GetRatsnestForNet( net )->GetEdges();
+            int64_t                     length = 0;
+            int64_t                     expectedLength = 0;
+
+            for( const CN_EDGE& edge : edges )
+                length += edge.GetWeight();
+
+            for( const CN_EDGE& edge : expected )
+                expectedLength += edge.GetWeight();
+
+            BOOST_CHECK_EQUAL( edges.size(), expected.size() );
+
+            // Edge weights are rounded distances, so equally long trees may differ slightly
+            BOOST_CHECK_LE( std::abs( length - expectedLength ), (int64_t) edges.size() );
+        }
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( RatsnestIncrementalUpdate, RATSNEST_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    connectivity->RecalculateRatsnest();
+
+    // Drag the footprint with the most pads around, updating the ratsnest after each step as
+    // the move tool does
+    FOOTPRINT* moved = nullptr;
+
+    for( FOOTPRINT* fp : m_board->Footprints() )
+    {
+        if( !moved || fp->Pads().size() > moved->Pads().size() )
+            moved = fp;
+    }
+
+    BOOST_REQUIRE( moved );
+
+    for( int step = 0; step < 8; ++step )
+    {
+        moved->Move( VECTOR2I( pcbIUScale.mmToIU( 1.5 ), pcbIUScale.mmToIU( step % 2 ? -2 : 1 ) ) );
+        connectivity->Update( moved );
+        connectivity->RecalculateRatsnest();
+
+        checkMatchesFreshRatsnest( m_board.get() );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( RatsnestIncrementalCommit, RATSNEST_TEST_FIXTURE )
+{
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    bool          wasIncremental = cfg.m_IncrementalConnectivity;
+
+    cfg.m_IncrementalConnectivity = true;
+
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    connectivity->RecalculateRatsnest();
+
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    // Disconnect some tracks and move footprints away from others, so that clusters are both
+    // split and joined, then check that only searching the changed clusters gives the same
+    // ratsnest as a full rebuild
+    std::vector<PCB_TRACK*>                 tracks( m_board->Tracks().begin(),
+                                                    m_board->Tracks().end() );
+    std::vector<std::unique_ptr<PCB_TRACK>> removed;
+
+    for( size_t ii = 0; ii < tracks.size(); ii += 7 )
+    {
+        connectivity->Remove( tracks[ii] );
+        m_board->Remove( tracks[ii] );
+        removed.emplace_back( tracks[ii] );
+    }
+
+    for( size_t ii = 0; ii < m_board->Footprints().size(); ii += 3 )
+    {
+        FOOTPRINT* fp = m_board->Footprints()[ii];
+
+        fp->Move( VECTOR2I( pcbIUScale.mmToIU( 2.5 ), pcbIUScale.mmToIU( -1 ) ) );
+        connectivity->Update( fp );
+    }
+
+    BOARD_COMMIT commit( dummyTool );
+    connectivity->RecalculateRatsnest( &commit );
+
+    BOOST_CHECK( !connectivity->GetChangedNets().empty() );
+
+    checkMatchesFreshRatsnest( m_board.get() );
+
+    cfg.m_IncrementalConnectivity = wasIncremental;
+}
@@ -162,6 +162,46 @@ BOOST_FIXTURE_TEST_CASE( NotchedZones, ZONE_FILL_TEST_FIXTURE )
 }
 
 
+/**
+ * Copies of zones, such as the ones in the undo list, share the fills until either side
+ * modifies them.
+ */
+BOOST_FIXTURE_TEST_CASE( ZoneCopiesShareFills, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "notched_zones", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    ZONE* zone = nullptr;
+
+    for( ZONE* candidate : m_board->Zones() )
+    {
+        if( candidate->GetLayerSet().Contains( F_Cu ) )
+            zone = candidate;
+    }
+
+    BOOST_REQUIRE( zone );
+    BOOST_REQUIRE( !zone->GetFilledPolysList( F_Cu )->IsEmpty() );
+
+    std::unique_ptr<ZONE> copy( static_cast<ZONE*>( zone->Clone() ) );
+    BOX2I                 fillBox = zone->GetFilledPolysList( F_Cu )->BBox();
+
+    BOOST_CHECK( copy->GetFilledPolysList( F_Cu ) == zone->GetFilledPolysList( F_Cu ) );
+
+    zone->Move( VECTOR2I( 1000000, 0 ) );
+
+    BOOST_CHECK( copy->GetFilledPolysList( F_Cu ) != zone->GetFilledPolysList( F_Cu ) );
+    BOOST_CHECK( copy->GetFilledPolysList( F_Cu )->BBox() == fillBox );
+    BOOST_CHECK_EQUAL( zone->GetFilledPolysList( F_Cu )->BBox().GetX(), fillBox.GetX() + 1000000 );
+
+    std::unique_ptr<ZONE> secondCopy( static_cast<ZONE*>( copy->Clone() ) );
+
+    copy->UnFill();
+
+    BOOST_CHECK( copy->GetFilledPolysList( F_Cu )->IsEmpty() );
+    BOOST_CHECK( secondCopy->GetFilledPolysList( F_Cu )->BBox() == fillBox );
+}
+
+
 BOOST_FIXTURE_TEST_CASE( RegressionZoneFillTests, ZONE_FILL_TEST_FIXTURE )
 {
     std::vector<wxString> tests = { "issue18",
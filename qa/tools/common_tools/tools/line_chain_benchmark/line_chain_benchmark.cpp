@@ -0,0 +1,193 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <advanced_config.h>
+#include <geometry/seg.h>
+#include <geometry/shape_line_chain.h>
+#include <math/util.h>
+
+#include <qa_utils/utility_registry.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+
+
+/**
+ * A closed, wavy outline of \a aCount points, like a zone outline following a curved board
+ * edge.
+ */
+static SHAPE_LINE_CHAIN makeOutline( int aCount )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aCount;
+        double radius = 10000000.0 * ( 1.0 + 0.1 * std::sin( 7.0 * angle ) );
+
+        chain.Append( VECTOR2I( KiROUND( radius * std::cos( angle ) ),
+                                KiROUND( radius * std::sin( angle ) ) ) );
+    }
+
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+/// Numbers of searches made on each copy of an outline
+static const int SEARCH_COUNTS[] = { 1, 10, 100, 1000 };
+
+
+/**
+ * Time point in polygon and segment collision tests made through fresh copies of \a aChain,
+ * \a aSearches at a time, so that building the index (if any) is included.
+ *
+ * @param aHits is incremented by the number of points found inside or colliding.
+ * @return the time in ns per search.
+ */
+static double runBench( const SHAPE_LINE_CHAIN& aChain, int aSearches, int aMinSegments,
+                        int& aHits )
+{
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    int           oldMinSegments = cfg.m_LineChainIndexMinSegments;
+
+    cfg.m_LineChainIndexMinSegments = aMinSegments;
+
+    // Enough searches in total for a stable timing, without waiting minutes for big outlines
+    const int copies = std::max( 1, 4000000 / aChain.SegmentCount() / aSearches );
+
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> coord( -12000000, 12000000 );
+    std::vector<VECTOR2I>              points;
+
+    for( int ii = 0; ii < aSearches; ++ii )
+        points.emplace_back( coord( rng ), coord( rng ) );
+
+    CLOCK::duration elapsed = CLOCK::duration::zero();
+
+    for( int copy = 0; copy < copies; ++copy )
+    {
+        SHAPE_LINE_CHAIN  chain( aChain );
+        CLOCK::time_point start = CLOCK::now();
+
+        for( const VECTOR2I& pt : points )
+        {
+            aHits += chain.PointInside( pt ) ? 1 : 0;
+            aHits += chain.Collide( SEG( pt, pt + VECTOR2I( 100000, 50000 ) ), 10000 ) ? 1 : 0;
+        }
+
+        elapsed += CLOCK::now() - start;
+    }
+
+    cfg.m_LineChainIndexMinSegments = oldMinSegments;
+
+    return std::chrono::duration<double, std::nano>( elapsed ).count()
+           / ( (double) copies * aSearches );
+}
+
+
+int line_chain_benchmark_func( int argc, char* argv[] )
+{
+    if( argc > 1 )
+    {
+        std::printf( "Usage: %s\n\n", argv[0] );
+        std::printf( "Compare the indexed and linear SHAPE_LINE_CHAIN::PointInside() and\n"
+                     "Collide( SEG ) for outlines of growing size, searched a number of times\n"
+                     "between changes.  Ratios below 1 are speedups from the index.\n" );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::printf( "%8s %14s", "segments", "linear/search" );
+
+    for( int searches : SEARCH_COUNTS )
+        std::printf( " %7dx", searches );
+
+    std::printf( "\n" );
+
+    std::vector<int> crossovers( std::size( SEARCH_COUNTS ), -1 );
+
+    for( int count = 8; count <= 131072; count *= 2 )
+    {
+        SHAPE_LINE_CHAIN chain = makeOutline( count );
+        int              hits = 0;
+        double           linearNs = runBench( chain, 100, std::numeric_limits<int>::max(), hits );
+
+        std::printf( "%8d %11.0f ns", count, linearNs );
+
+        for( size_t ii = 0; ii < std::size( SEARCH_COUNTS ); ++ii )
+        {
+            int    linearHits = 0;
+            int    indexedHits = 0;
+            double linear = runBench( chain, SEARCH_COUNTS[ii], std::numeric_limits<int>::max(),
+                                      linearHits );
+            double indexed = runBench( chain, SEARCH_COUNTS[ii], 0, indexedHits );
+            double ratio = indexed / linear;
+
+            std::printf( " %8.2f%s", ratio, linearHits != indexedHits ? " MISMATCH" : "" );
+
+            if( ratio >= 1.0 )
+                crossovers[ii] = -1;
+            else if( crossovers[ii] < 0 )
+                crossovers[ii] = count;
+        }
+
+        std::printf( "\n" );
+    }
+
+    std::printf( "\n" );
+
+    for( size_t ii = 0; ii < std::size( SEARCH_COUNTS ); ++ii )
+    {
+        if( crossovers[ii] > 0 )
+        {
+            std::printf( "Searched %d times, the index is quicker from %d segments.\n",
+                         SEARCH_COUNTS[ii], crossovers[ii] );
+        }
+        else
+        {
+            std::printf( "Searched %d times, the index is slower.\n", SEARCH_COUNTS[ii] );
+        }
+    }
+
+    std::printf( "LineChainIndexMinSegments is %d.\n",
+                 ADVANCED_CFG::GetCfg().m_LineChainIndexMinSegments );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "line_chain_benchmark",
+        "Find the line chain size from which indexing its segments pays off",
+        line_chain_benchmark_func,
+} );
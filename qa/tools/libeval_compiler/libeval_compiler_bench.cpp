@@ -0,0 +1,123 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Micro-benchmark of the rule expression VM: evaluates typical DRC rule conditions against
+ * pairs of tracks and reports evaluations per second.
+ *
+ * Usage: libeval_compiler_bench [iterations]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <wx/init.h>
+
+#include <board.h>
+#include <netclass.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <pcbexpr_evaluator.h>
+#include <drc/drc_rule.h>
+#include <core/profile.h>
+
+
+static const char* expressions[] = {
+    "A.NetClass == 'HV'",
+    "A.NetClass == 'HV' && B.NetClass != 'HV'",
+    "A.NetName == '/GND' || B.NetName == '/GND'",
+    "A.Type == 'Track' && B.Type == 'Track'",
+    "A.Width > 0.2mm && B.Width > 0.2mm",
+    "A.Layer == 'F.Cu' && A.NetClass == 'HV'"
+};
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer;
+
+    int iterations = argc > 1 ? std::atoi( argv[1] ) : 1000000;
+
+    PROPERTY_MANAGER::Instance().Rebuild();
+
+    BOARD board;
+
+    std::shared_ptr<NETCLASS> hvClass = std::make_shared<NETCLASS>( wxT( "HV" ) );
+    NETINFO_ITEM*             gndNet = new NETINFO_ITEM( &board, wxT( "/GND" ), 1 );
+    NETINFO_ITEM*             hvNet = new NETINFO_ITEM( &board, wxT( "/HV_SUPPLY" ), 2 );
+
+    hvNet->SetNetClass( hvClass );
+    board.Add( gndNet );
+    board.Add( hvNet );
+
+    PCB_TRACK trackA( &board );
+    PCB_TRACK trackB( &board );
+
+    trackA.SetNet( hvNet );
+    trackA.SetLayer( F_Cu );
+    trackA.SetWidth( pcbIUScale.mmToIU( 0.25 ) );
+    trackB.SetNet( gndNet );
+    trackB.SetLayer( F_Cu );
+    trackB.SetWidth( pcbIUScale.mmToIU( 0.15 ) );
+
+    double totalRate = 0.0;
+
+    for( const char* expr : expressions )
+    {
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, F_Cu );
+
+        if( !compiler.Compile( expr, &ucode, &preflightContext ) )
+        {
+            printf( "Failed to compile \"%s\"\n", expr );
+            return 1;
+        }
+
+        double     checksum = 0.0;
+        PROF_TIMER timer;
+
+        for( int ii = 0; ii < iterations; ++ii )
+        {
+            // One context per evaluation, as in DRC_RULE_CONDITION::EvaluateFor()
+            PCBEXPR_CONTEXT ctx( CLEARANCE_CONSTRAINT, F_Cu );
+
+            ctx.SetItems( &trackA, &trackB );
+            checksum += ucode.Run( &ctx )->AsDouble();
+        }
+
+        timer.Stop();
+
+        double rate = iterations / ( timer.msecs() / 1000.0 );
+        totalRate += rate;
+
+        printf( "%-48s %12.0f evals/s  (result %g)\n", expr, rate, checksum / iterations );
+    }
+
+    printf( "%-48s %12.0f evals/s\n", "mean", totalRate / std::size( expressions ) );
+
+    return 0;
+}